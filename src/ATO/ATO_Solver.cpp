@@ -26,6 +26,19 @@ Please remove when issue is resolved
 #include "Epetra_LinearProblem.h"
 #include "AztecOO.h"
 
+#include "BelosLinearProblem.hpp"
+#include "BelosBlockCGSolMgr.hpp"
+#include "BelosBlockGmresSolMgr.hpp"
+#include "BelosTpetraAdapter.hpp"
+#include "Tpetra_RowMatrixTransposer.hpp"
+#include "Thyra_TpetraThyraWrappers.hpp"
+#ifdef ALBANY_MUELU
+#include "MueLu_CreateTpetraPreconditioner.hpp"
+#endif
+#ifdef ALBANY_IFPACK2
+#include "Ifpack2_RILUK.hpp"
+#endif
+
 #ifdef ATO_USES_ISOLIB
 #include "Albany_STKDiscretization.hpp"
 #include "STKExtract.hpp"
@@ -64,6 +77,8 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
   Teuchos::ParameterList& problemParams = appParams->sublist("Problem");
   _numPhysics = problemParams.get<int>("Number of Subproblems", 1);
 
+  createSubProblemGroups(comm);
+
   int numHomogProblems = problemParams.get<int>("Number of Homogenization Problems", 0);
   _homogenizationSets.resize(numHomogProblems);
 
@@ -101,7 +116,7 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
   ATO::OptimizerFactory optimizerFactory;
   _optimizer = optimizerFactory.create(optimizerParams);
   _optimizer->SetInterface(this);
-  _optimizer->SetCommunicator(comm);
+  _optimizer->SetCommunicator(_solverComm);
 
   _writeDesignFrequency = problemParams.get<int>("Design Output Frequency", 0);
 
@@ -179,6 +194,10 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
   // set verbosity
   _is_verbose = (comm->getRank() == 0) && problemParams.get<bool>("Verbose Output", false);
 
+  // group sub problems that can share one block solve.  This may reassign
+  // sub problems to groups, so it must precede creation of the input files.
+  findSharedOperatorSets();
+
 
 
 
@@ -257,7 +276,7 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
   Teuchos::RCP<Albany::AbstractProblem> problem = _subProblems[0].app->getProblem();
   _atoProblem = dynamic_cast<ATO::OptimizationProblem*>(problem.get());
   _atoProblem->setDiscretization(_subProblems[0].app->getDiscretization());
-  _atoProblem->setCommunicator(comm);
+  _atoProblem->setCommunicator(_solverComm);
   _atoProblem->InitTopOpt();
   
 
@@ -338,7 +357,7 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
     _objAggregator->SetInputVariablesT(_subProblems, responseMapT, responseDerivMapT);
     _objAggregator->SetOutputVariablesT(objectiveValue, ObjectiveGradientVecT);
   }
-  _objAggregator->SetCommunicator(comm);
+  _objAggregator->SetCommunicator(_solverComm);
   
   // pass subProblems to the constraint aggregator
   if( !_conAggregator.is_null() ){
@@ -350,7 +369,7 @@ Solver(const Teuchos::RCP<Teuchos::ParameterList>& appParams,
       _conAggregator->SetInputVariablesT(_subProblems, responseMapT, responseDerivMapT);
       _conAggregator->SetOutputVariablesT(constraintValue, ConstraintGradientVecT);
     }
-    _conAggregator->SetCommunicator(comm);
+    _conAggregator->SetCommunicator(_solverComm);
   }
   
 
@@ -376,9 +395,564 @@ ATO::Solver::zeroSet()
 
   _derivativeFilter   = Teuchos::null;
   _objAggregator      = Teuchos::null;
+
+  _numGroups      = 1;
+  _groupId        = 0;
+  _interGroupComm = Teuchos::null;
+
+  _sharedOperatorParams = Teuchos::null;
   
 }
 
+/******************************************************************************/
+void
+ATO::Solver::createSubProblemGroups(const Teuchos::RCP<const Teuchos_Comm>& comm)
+/******************************************************************************/
+{
+  Teuchos::ParameterList& problemParams = _mainAppParams->sublist("Problem");
+  _numGroups = problemParams.get<int>("Number of Subproblem Groups", 1);
+
+  int worldSize = comm->getSize();
+  int worldRank = comm->getRank();
+
+  TEUCHOS_TEST_FOR_EXCEPTION(
+    _numGroups < 1 || _numGroups > _numPhysics,
+    Teuchos::Exceptions::InvalidParameter, std::endl
+    << "Error!  'Number of Subproblem Groups' must be between 1 and "
+    << "'Number of Subproblems'." << std::endl);
+  TEUCHOS_TEST_FOR_EXCEPTION(
+    worldSize % _numGroups != 0,
+    Teuchos::Exceptions::InvalidParameter, std::endl
+    << "Error!  Number of ranks (" << worldSize << ") must be a multiple of "
+    << "'Number of Subproblem Groups' (" << _numGroups << ")." << std::endl);
+
+  // all sub problems share the mesh, so round robin balances the groups.
+  _subProblemGroup.resize(_numPhysics);
+  for(int i=0; i<_numPhysics; i++) _subProblemGroup[i] = i % _numGroups;
+
+  int groupSize = worldSize/_numGroups;
+  _groupId = worldRank/groupSize;
+
+  if( _numGroups == 1 ){
+    _solverComm = comm;
+    _interGroupComm = Teuchos::null;
+    return;
+  }
+
+  // each group has the same decomposition of the mesh, so the rank in
+  // _interGroupComm (i.e., the group id) addresses matching local data.
+  _solverComm = comm->split(_groupId, worldRank);
+  _interGroupComm = comm->split(worldRank % groupSize, _groupId);
+}
+
+/******************************************************************************/
+void
+ATO::Solver::solveSubProblems(const double* p)
+/******************************************************************************/
+{
+  // every group runs the optimizer redundantly. broadcast the topology from
+  // the first group so all groups solve for the same design.
+  std::vector<double> groupP;
+  if( _numGroups > 1 ){
+    int nOptDofs = GetNumOptDofs();
+    groupP.assign(p, p+nOptDofs);
+    Teuchos::broadcast(*_interGroupComm, 0, nOptDofs, groupP.data());
+    p = groupP.data();
+  }
+
+  for(int i=0; i<_numPhysics; i++){
+
+    // copy data from p into each stateManager
+    if( entityType == "State Variable" ){
+      Albany::StateManager& stateMgr = _subProblems[i].app->getStateMgr();
+      copyTopologyIntoStateMgr( p, stateMgr );
+    } else 
+    if( entityType == "Distributed Parameter"){
+      copyTopologyIntoParameter( p, _subProblems[i] );
+    }
+
+    // enforce PDE constraints for sub problems assigned to this group
+    if( _subProblemGroup[i] != _groupId ) continue;
+    if( _sharedOperatorSetIndex[i] >= 0 ) continue;
+    _subProblems[i].model->evalModel((*_subProblems[i].params_in),
+                                    (*_subProblems[i].responses_out));
+  }
+
+  // sub problems sharing an operator are solved together once the topology
+  // has been copied into all of them.
+  int nSets = _sharedOperatorSets.size();
+  for(int iset=0; iset<nSets; iset++){
+    SharedOperatorSet& opSet = _sharedOperatorSets[iset];
+    if( _subProblemGroup[opSet.subProblems[0]] != _groupId ) continue;
+    solveSharedOperatorSet(opSet);
+    if( _sharedOperatorParams->get<bool>("Verify Against Independent Solves", false) )
+      verifySharedOperatorSet(opSet);
+  }
+
+  if( _numGroups == 1 ) return;
+
+  for(int i=0; i<_numPhysics; i++)
+    shareSubProblemResults(_subProblems[i], _subProblemGroup[i]);
+}
+
+/******************************************************************************/
+void
+ATO::Solver::findSharedOperatorSets()
+/******************************************************************************/
+{
+  // Linear sub problems whose parameters differ only in the loading have
+  // the same stiffness operator.  Such sets are assembled once and solved
+  // for all load cases with a block Krylov method when requested.
+
+  _sharedOperatorSetIndex.assign(_numPhysics, -1);
+  _sharedOperatorSets.clear();
+
+  Teuchos::ParameterList& problemParams = _mainAppParams->sublist("Problem");
+  if( !problemParams.isSublist("Shared Operator Solve") ) return;
+  _sharedOperatorParams = Teuchos::rcpFromRef(problemParams.sublist("Shared Operator Solve"));
+
+  // parameters that define the right hand side only
+  std::vector<std::string> loadLists = {"Neumann BCs", "Body Force", "Response Functions"};
+
+  std::vector<Teuchos::ParameterList> operatorParams(_numPhysics);
+  std::vector<bool> isLinear(_numPhysics, false);
+  for(int i=0; i<_numPhysics; i++){
+    Teuchos::ParameterList& physParams = problemParams.sublist(Albany::strint("Physics Problem",i));
+    std::string problemName = physParams.get<std::string>("Name", "");
+    isLinear[i] = ( problemName.find("LinearElasticity") == 0 ||
+                    problemName.find("Poissons Equation") == 0 ) &&
+                  !physParams.isSublist("Parameters");
+    operatorParams[i] = physParams;
+    for( auto& name : loadLists )
+      if( operatorParams[i].isParameter(name) ) operatorParams[i].remove(name);
+  }
+
+  for(int i=0; i<_numPhysics; i++){
+    if( !isLinear[i] || _sharedOperatorSetIndex[i] >= 0 ) continue;
+    SharedOperatorSet opSet;
+    opSet.subProblems.push_back(i);
+    for(int j=i+1; j<_numPhysics; j++){
+      if( !isLinear[j] || _sharedOperatorSetIndex[j] >= 0 ) continue;
+      if( Teuchos::haveSameValues(operatorParams[i], operatorParams[j]) )
+        opSet.subProblems.push_back(j);
+    }
+    if( opSet.subProblems.size() < 2 ) continue;
+
+    // a set is solved by a single group, that of its first member.
+    int iset = _sharedOperatorSets.size();
+    for( int k : opSet.subProblems ){
+      _sharedOperatorSetIndex[k] = iset;
+      _subProblemGroup[k] = _subProblemGroup[i];
+    }
+    _sharedOperatorSets.push_back(opSet);
+
+    if( _is_verbose ){
+      std::cout << "ATO: subproblems";
+      for( int k : opSet.subProblems ) std::cout << " " << k;
+      std::cout << " share an operator and are solved as a block." << std::endl;
+    }
+  }
+}
+
+/******************************************************************************/
+void
+ATO::Solver::solveSharedOperatorSet(SharedOperatorSet& opSet)
+/******************************************************************************/
+{
+  typedef Tpetra_MultiVector MV;
+
+  int nrhs = opSet.subProblems.size();
+  Teuchos::RCP<Albany::Application> app0 = _subProblems[opSet.subProblems[0]].app;
+  Teuchos::RCP<const Tpetra_Map> mapT = app0->getMapT();
+
+  // the sub problems are linear, so R(x) = K x - f and one Newton step
+  // from x = 0 is the solution.
+  Teuchos::Array<ParamVec> noParams;
+  Tpetra_Vector zeroT(mapT);
+  Teuchos::RCP<MV> rhsT = Teuchos::rcp(new MV(mapT, nrhs));
+  Teuchos::RCP<MV> solT = Teuchos::rcp(new MV(mapT, nrhs, true));
+
+  // the operator depends on the topology, so it's reassembled for each design.
+  // the graph is fixed, so the matrix and preconditioner are reused.
+  if( opSet.jacobianT == Teuchos::null )
+    opSet.jacobianT = Teuchos::rcp(new Tpetra_CrsMatrix(app0->getJacobianGraphT()));
+
+  Tpetra_Vector residualT(mapT);
+  app0->computeGlobalJacobianT(0.0, 1.0, 0.0, 0.0, NULL, NULL, zeroT, noParams,
+                               &residualT, *opSet.jacobianT);
+  rhsT->getVectorNonConst(0)->update(-1.0, residualT, 0.0);
+  for(int k=1; k<nrhs; k++){
+    Teuchos::RCP<Albany::Application> app = _subProblems[opSet.subProblems[k]].app;
+    app->computeGlobalResidualT(0.0, NULL, NULL, zeroT, noParams, residualT);
+    rhsT->getVectorNonConst(k)->update(-1.0, residualT, 0.0);
+  }
+
+  updateSharedPreconditioner(opSet.jacobianT, opSet.preconditionerT);
+  blockSolve(opSet.jacobianT, opSet.preconditionerT, rhsT, solT, "Shared operator solve");
+
+  if( entityType == "Distributed Parameter" ){
+    // responses and their sensitivities need the adjoints
+    solveSharedAdjoints(opSet, *solT);
+  } else {
+    // evaluate responses at each solution.  This fills the element states that
+    // the aggregators read.
+    for(int k=0; k<nrhs; k++){
+      SolverSubSolver& sub = _subProblems[opSet.subProblems[k]];
+      Teuchos::RCP<const Tpetra_Vector> xT = solT->getVector(k);
+      int numResponses = sub.app->getNumResponses();
+      for(int ig=0; ig<numResponses; ig++){
+        Tpetra_Vector gT(sub.app->getResponse(ig)->responseMapT());
+        sub.app->evaluateResponseT(ig, 0.0, NULL, NULL, *xT, noParams, gT);
+        Teuchos::RCP<Epetra_Vector> g = sub.responses_out->get_g(ig);
+        if( g == Teuchos::null ) continue;
+        Teuchos::ArrayRCP<const ST> gView = gT.get1dView();
+        for(int i=0; i<g->MyLength(); i++) (*g)[i] = gView[i];
+      }
+    }
+  }
+
+  for(int k=0; k<nrhs; k++){
+    SolverSubSolver& sub = _subProblems[opSet.subProblems[k]];
+    Teuchos::RCP<const Tpetra_Vector> xT = solT->getVector(k);
+
+    // the last response is the solution
+    Teuchos::RCP<Epetra_Vector> xfinal = sub.responses_out->get_g(sub.responses_out->Ng()-1);
+    Teuchos::ArrayRCP<const ST> xView = xT->get1dView();
+    for(int i=0; i<xfinal->MyLength(); i++) (*xfinal)[i] = xView[i];
+
+    sub.app->getDiscretization()->writeSolutionT(*xT, 0.0);
+  }
+}
+
+/******************************************************************************/
+void
+ATO::Solver::solveSharedAdjoints(SharedOperatorSet& opSet, const Tpetra_MultiVector& solT)
+/******************************************************************************/
+{
+  // dg/dp = g_p - lambda^T R_p, with K^T lambda = g_x.  The adjoints of all
+  // responses of all load cases share K^T and are solved as one block.
+  typedef Tpetra_MultiVector MV;
+
+  const std::string& paramName = _topologyInfoStructsT[0]->topologyT->getName();
+
+  Teuchos::Array<ParamVec> noParams;
+  const Thyra::ModelEvaluatorBase::Derivative<ST> none;
+
+  struct AdjointColumns {
+    int subIndex;
+    int responseIndex;
+    int firstColumn;
+    Teuchos::RCP<MV> g_p;
+  };
+  std::vector<AdjointColumns> adjoints;
+  std::vector<Teuchos::RCP<MV> > g_x;
+  int ncols = 0;
+
+  Teuchos::RCP<const Tpetra_Map> mapT = opSet.jacobianT->getRowMap();
+
+  int nrhs = opSet.subProblems.size();
+  for(int k=0; k<nrhs; k++){
+    SolverSubSolver& sub = _subProblems[opSet.subProblems[k]];
+    Teuchos::RCP<const Tpetra_Vector> xT = solT.getVector(k);
+    int ip = sub.responses_out->Np()-1;
+    int numResponses = sub.app->getNumResponses();
+    for(int ig=0; ig<numResponses; ig++){
+      Teuchos::RCP<Epetra_Vector> g = sub.responses_out->get_g(ig);
+      if( g == Teuchos::null ) continue;
+
+      Tpetra_Vector gT(sub.app->getResponse(ig)->responseMapT());
+      int ng = gT.getGlobalLength();
+      Teuchos::RCP<MV> dgdxT = Teuchos::rcp(new MV(mapT, ng));
+      const Thyra::ModelEvaluatorBase::Derivative<ST> dg_dx(
+        Thyra::createMultiVector<ST, LO, Tpetra_GO, KokkosNode>(dgdxT),
+        Thyra::ModelEvaluatorBase::DERIV_TRANS_MV_BY_ROW);
+      sub.app->evaluateResponseDerivativeT(ig, 0.0, NULL, NULL, *xT, noParams, NULL,
+                                           &gT, dg_dx, none, none, none);
+
+      Teuchos::ArrayRCP<const ST> gView = gT.get1dView();
+      for(int i=0; i<g->MyLength(); i++) (*g)[i] = gView[i];
+
+      if( ip < 0 || sub.responses_out->supports(OUT_ARG_DgDp,ig,ip).none() ) continue;
+      if( sub.responses_out->get_DgDp(ig,ip).getMultiVector() == Teuchos::null ) continue;
+
+      // the response is called directly: Application would also add g_p to
+      // the sensitivity output field.
+      AdjointColumns adjoint;
+      adjoint.subIndex = k;
+      adjoint.responseIndex = ig;
+      adjoint.firstColumn = ncols;
+      adjoint.g_p = Teuchos::rcp(new MV(sub.app->getDistParamLib()->get(paramName)->map(), ng, true));
+      sub.app->getResponse(ig)->evaluateDistParamDerivT(0.0, NULL, NULL, *xT, noParams,
+                                                        paramName, adjoint.g_p.get());
+      adjoints.push_back(adjoint);
+      g_x.push_back(dgdxT);
+      ncols += ng;
+    }
+  }
+
+  if( ncols == 0 ) return;
+
+  Teuchos::RCP<MV> rhsT = Teuchos::rcp(new MV(mapT, ncols));
+  Teuchos::RCP<MV> lambdaT = Teuchos::rcp(new MV(mapT, ncols, true));
+  for(int a=0; a<adjoints.size(); a++)
+    for(int j=0; j<g_x[a]->getNumVectors(); j++)
+      rhsT->getVectorNonConst(adjoints[a].firstColumn+j)->update(1.0, *g_x[a]->getVector(j), 0.0);
+
+  // Dirichlet rows make K nonsymmetric, so the adjoint operator is formed
+  // explicitly.
+  Tpetra::RowMatrixTransposer<ST, LO, Tpetra_GO, KokkosNode> transposer(opSet.jacobianT);
+  Teuchos::RCP<Tpetra_CrsMatrix> jacobianTransT = transposer.createTranspose();
+
+  updateSharedPreconditioner(jacobianTransT, opSet.adjointPreconditionerT);
+  blockSolve(jacobianTransT, opSet.adjointPreconditionerT, rhsT, lambdaT, "Shared adjoint solve");
+
+  for(int a=0; a<adjoints.size(); a++){
+    const AdjointColumns& adjoint = adjoints[a];
+    SolverSubSolver& sub = _subProblems[opSet.subProblems[adjoint.subIndex]];
+    int ng = adjoint.g_p->getNumVectors();
+    int ip = sub.responses_out->Np()-1;
+
+    Teuchos::Range1D cols(adjoint.firstColumn, adjoint.firstColumn+ng-1);
+    Teuchos::RCP<MV> fpT = Teuchos::rcp(new MV(adjoint.g_p->getMap(), ng));
+    sub.app->applyGlobalDistParamDerivImplT(0.0, Teuchos::null, Teuchos::null,
+                                            solT.getVector(adjoint.subIndex),
+                                            noParams, paramName, true,
+                                            lambdaT->subView(cols), fpT);
+    fpT->update(1.0, *adjoint.g_p, -1.0);
+
+    Teuchos::RCP<Epetra_MultiVector> dgdp =
+      sub.responses_out->get_DgDp(adjoint.responseIndex,ip).getMultiVector();
+    for(int j=0; j<ng; j++){
+      Teuchos::ArrayRCP<const ST> fpView = fpT->getData(j);
+      for(int i=0; i<dgdp->MyLength(); i++) (*dgdp)[j][i] = fpView[i];
+    }
+  }
+}
+
+/******************************************************************************/
+void
+ATO::Solver::updateSharedPreconditioner(const Teuchos::RCP<Tpetra_CrsMatrix>& A,
+                                        Teuchos::RCP<Tpetra_Operator>& prec)
+/******************************************************************************/
+{
+  const Teuchos::ParameterList& solveParams = *_sharedOperatorParams;
+  std::string precType = solveParams.get<std::string>("Preconditioner Type", "MueLu");
+
+#ifdef ALBANY_MUELU
+  if( precType == "MueLu" ){
+    typedef MueLu::TpetraOperator<ST, LO, Tpetra_GO, KokkosNode> MueLuOp;
+    if( prec == Teuchos::null ){
+      Teuchos::ParameterList mueluParams;
+      if( solveParams.isSublist("MueLu") ) mueluParams = solveParams.sublist("MueLu");
+      Teuchos::RCP<Tpetra_Operator> opT = A;
+      prec = MueLu::CreateTpetraPreconditioner(opT, mueluParams);
+    } else {
+      Teuchos::RCP<MueLuOp> mueluOp = Teuchos::rcp_dynamic_cast<MueLuOp>(prec);
+      MueLu::ReuseTpetraPreconditioner(A, *mueluOp);
+    }
+  } else
+#endif
+#ifdef ALBANY_IFPACK2
+  if( precType == "Ifpack2 RILUK" ){
+    typedef Ifpack2::RILUK<Tpetra_RowMatrix> RILUK;
+    if( prec == Teuchos::null ){
+      Teuchos::ParameterList iluParams;
+      iluParams.set<int>("fact: iluk level-of-fill",
+                         solveParams.get<int>("Level of Fill", 0));
+      Teuchos::RCP<RILUK> rilu = Teuchos::rcp(new RILUK(A));
+      rilu->setParameters(iluParams);
+      rilu->initialize();
+      prec = rilu;
+    }
+    Teuchos::RCP<RILUK> rilu = Teuchos::rcp_dynamic_cast<RILUK>(prec);
+    if( rilu->getMatrix().get() != A.get() ){
+      rilu->setMatrix(A);
+      rilu->initialize();
+    }
+    rilu->compute();
+  } else
+#endif
+  TEUCHOS_TEST_FOR_EXCEPTION(
+    precType != "None", Teuchos::Exceptions::InvalidParameter, std::endl
+    << "Error!  Preconditioner Type '" << precType << "' is not available.  "
+    << "Options are 'MueLu', 'Ifpack2 RILUK', or 'None'." << std::endl);
+}
+
+/******************************************************************************/
+void
+ATO::Solver::blockSolve(const Teuchos::RCP<Tpetra_CrsMatrix>& A,
+                        const Teuchos::RCP<Tpetra_Operator>& prec,
+                        const Teuchos::RCP<Tpetra_MultiVector>& rhsT,
+                        const Teuchos::RCP<Tpetra_MultiVector>& solT,
+                        const std::string& label)
+/******************************************************************************/
+{
+  typedef Tpetra_MultiVector MV;
+  typedef Tpetra_Operator OP;
+  typedef Belos::LinearProblem<ST, MV, OP> LinearProblem;
+
+  const Teuchos::ParameterList& solveParams = *_sharedOperatorParams;
+  int nrhs = rhsT->getNumVectors();
+
+  Teuchos::RCP<OP> opT = A;
+  Teuchos::RCP<LinearProblem> problem = Teuchos::rcp(new LinearProblem(opT, solT, rhsT));
+  if( prec != Teuchos::null ) problem->setRightPrec(prec);
+  problem->setProblem();
+
+  Teuchos::RCP<Teuchos::ParameterList> belosParams = Teuchos::rcp(new Teuchos::ParameterList);
+  belosParams->set("Block Size", nrhs);
+  belosParams->set("Maximum Iterations", solveParams.get<int>("Maximum Iterations", 1000));
+  belosParams->set("Convergence Tolerance", solveParams.get<double>("Convergence Tolerance", 1.0e-10));
+
+  std::string method = solveParams.get<std::string>("Method", "Block CG");
+  Teuchos::RCP<Belos::SolverManager<ST, MV, OP> > solver;
+  if( method == "Block CG" ){
+    solver = Teuchos::rcp(new Belos::BlockCGSolMgr<ST, MV, OP>(problem, belosParams));
+  } else
+  if( method == "Block GMRES" ){
+    belosParams->set("Num Blocks", solveParams.get<int>("Num Blocks", 100));
+    solver = Teuchos::rcp(new Belos::BlockGmresSolMgr<ST, MV, OP>(problem, belosParams));
+  } else
+    TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter, std::endl
+      << "Error!  Unknown shared operator solve method '" << method << "'.  "
+      << "Options are 'Block CG' or 'Block GMRES'." << std::endl);
+
+  Belos::ReturnType ret = solver->solve();
+  if( ret != Belos::Converged && _solverComm->getRank() == 0 )
+    std::cout << "ATO: Warning! " << label << " did not converge in "
+              << solver->getNumIters() << " iterations." << std::endl;
+  else
+  if( _is_verbose )
+    std::cout << "ATO: " << label << " for " << nrhs << " right hand sides converged in "
+              << solver->getNumIters() << " iterations." << std::endl;
+}
+
+/******************************************************************************/
+void
+ATO::Solver::verifySharedOperatorSet(const SharedOperatorSet& opSet)
+/******************************************************************************/
+{
+  // Solve each sub problem of the set again on its own and require the same
+  // responses, sensitivities and element states.  The independent results
+  // are kept.
+  double tol = _sharedOperatorParams->get<double>("Verification Tolerance", 1.0e-6);
+
+  // relative difference of b from a
+  auto relDiff = [](const Epetra_MultiVector& a, const Epetra_MultiVector& b){
+    Epetra_MultiVector d(b);
+    d.Update(-1.0, a, 1.0);
+    std::vector<double> dnorm(d.NumVectors()), anorm(a.NumVectors());
+    d.NormInf(dnorm.data());
+    a.NormInf(anorm.data());
+    double maxDiff = 0.0;
+    for(int j=0; j<d.NumVectors(); j++)
+      maxDiff = std::max(maxDiff, dnorm[j]/std::max(anorm[j], 1.0e-14));
+    return maxDiff;
+  };
+
+  for( int k : opSet.subProblems ){
+    SolverSubSolver& sub = _subProblems[k];
+    EpetraExt::ModelEvaluator::OutArgs& responses = *sub.responses_out;
+    int numResponses = responses.Ng();
+    int ip = responses.Np()-1;
+
+    std::vector<Teuchos::RCP<Epetra_Vector> > gShared(numResponses);
+    std::vector<Teuchos::RCP<Epetra_MultiVector> > dgdpShared(numResponses);
+    for(int ig=0; ig<numResponses; ig++){
+      if( responses.get_g(ig) != Teuchos::null )
+        gShared[ig] = Teuchos::rcp(new Epetra_Vector(*responses.get_g(ig)));
+      if( ip < 0 || responses.supports(OUT_ARG_DgDp,ig,ip).none() ) continue;
+      Teuchos::RCP<Epetra_MultiVector> dgdp = responses.get_DgDp(ig,ip).getMultiVector();
+      if( dgdp != Teuchos::null ) dgdpShared[ig] = Teuchos::rcp(new Epetra_MultiVector(*dgdp));
+    }
+
+    Albany::StateArrayVec& states = sub.app->getStateMgr().getStateArrays().elemStateArrays;
+    std::vector<std::vector<double> > statesShared;
+    for(int ws=0; ws<states.size(); ws++)
+      for( auto& state : states[ws] ){
+        const Albany::MDArray& stateArray = state.second;
+        statesShared.push_back(std::vector<double>(stateArray.contiguous_data(),
+                               stateArray.contiguous_data()+stateArray.size()));
+      }
+
+    sub.model->evalModel(*sub.params_in, responses);
+
+    double maxDiff = 0.0;
+    for(int ig=0; ig<numResponses; ig++){
+      if( gShared[ig] != Teuchos::null )
+        maxDiff = std::max(maxDiff, relDiff(*responses.get_g(ig), *gShared[ig]));
+      if( dgdpShared[ig] != Teuchos::null )
+        maxDiff = std::max(maxDiff, relDiff(*responses.get_DgDp(ig,ip).getMultiVector(), *dgdpShared[ig]));
+    }
+
+    double localStateDiff = 0.0;
+    int istate = 0;
+    for(int ws=0; ws<states.size(); ws++)
+      for( auto& state : states[ws] ){
+        const Albany::MDArray& stateArray = state.second;
+        const std::vector<double>& shared = statesShared[istate++];
+        double amax = 0.0, dmax = 0.0;
+        for(int i=0; i<stateArray.size(); i++){
+          amax = std::max(amax, std::fabs(stateArray.contiguous_data()[i]));
+          dmax = std::max(dmax, std::fabs(stateArray.contiguous_data()[i]-shared[i]));
+        }
+        localStateDiff = std::max(localStateDiff, dmax/std::max(amax, 1.0e-14));
+      }
+    double stateDiff = 0.0;
+    Teuchos::reduceAll(*_solverComm, Teuchos::REDUCE_MAX, 1, &localStateDiff, &stateDiff);
+    maxDiff = std::max(maxDiff, stateDiff);
+
+    if( _solverComm->getRank() == 0 )
+      std::cout << "ATO: Subproblem " << k << " shared operator solve differs from the "
+                << "independent solve by " << maxDiff << std::endl;
+
+    TEUCHOS_TEST_FOR_EXCEPTION(
+      maxDiff > tol, std::logic_error, std::endl
+      << "Error!  Shared operator solve of subproblem " << k << " differs from the "
+      << "independent solve by " << maxDiff << " (tolerance " << tol << ")." << std::endl);
+  }
+}
+
+/******************************************************************************/
+void
+ATO::Solver::shareSubProblemResults(SolverSubSolver& subSolver, int owner)
+/******************************************************************************/
+{
+  const Teuchos_Comm& interComm = *_interGroupComm;
+
+  if( entityType == "State Variable" ){
+    // the aggregators read responses and sensitivities from the element states
+    Albany::StateArrayVec& states = 
+      subSolver.app->getStateMgr().getStateArrays().elemStateArrays;
+    int numWorksets = states.size();
+    for(int ws=0; ws<numWorksets; ws++){
+      for( auto& state : states[ws] ){
+        Albany::MDArray& stateArray = state.second;
+        int size = stateArray.size();
+        if( size > 0 )
+          Teuchos::broadcast(interComm, owner, size, stateArray.contiguous_data());
+      }
+    }
+  } else
+  if( entityType == "Distributed Parameter" ){
+    EpetraExt::ModelEvaluator::OutArgs& responses = *subSolver.responses_out;
+    int numResponses = responses.Ng();
+    int numParameters = responses.Np();
+    for(int ig=0; ig<numResponses; ig++){
+      Teuchos::RCP<Epetra_Vector> g = responses.get_g(ig);
+      if( g != Teuchos::null && g->MyLength() > 0 )
+        Teuchos::broadcast(interComm, owner, g->MyLength(), g->Values());
+      for(int ip=0; ip<numParameters; ip++){
+        if( responses.supports(OUT_ARG_DgDp,ig,ip).none() ) continue;
+        Teuchos::RCP<Epetra_MultiVector> dgdp = responses.get_DgDp(ig,ip).getMultiVector();
+        if( dgdp == Teuchos::null || dgdp->MyLength() == 0 ) continue;
+        for(int iv=0; iv<dgdp->NumVectors(); iv++)
+          Teuchos::broadcast(interComm, owner, dgdp->MyLength(), (*dgdp)(iv)->Values());
+      }
+    }
+  }
+}
+
   
 /******************************************************************************/
 void
@@ -390,7 +964,10 @@ ATO::Solver::evalModel(const InArgs& inArgs,
   for(int iHomog=0; iHomog<numHomogenizationSets; iHomog++){
     const HomogenizationSet& hs = _homogenizationSets[iHomog];
     int numColumns = hs.homogenizationProblems.size();
+    // the homogenized constants do not depend on the topology, so each
+    // column is solved by one group only and broadcast to the others.
     for(int i=0; i<numColumns; i++){
+      if( i % _numGroups != _groupId ) continue;
 
       // enforce PDE constraints
       hs.homogenizationProblems[i].model->evalModel((*hs.homogenizationProblems[i].params_in),
@@ -400,10 +977,17 @@ ATO::Solver::evalModel(const InArgs& inArgs,
     if(numColumns > 0){
       // collect homogenized values
       Kokkos::DynRankView<RealType, PHX::Device> Cvals("ZZZ", numColumns,numColumns);
+      std::vector<double> column(numColumns);
       for(int i=0; i<numColumns; i++){
-        Teuchos::RCP<const Epetra_Vector> g = hs.homogenizationProblems[i].responses_out->get_g(hs.responseIndex);
+        int owner = i % _numGroups;
+        if( owner == _groupId ){
+          Teuchos::RCP<const Epetra_Vector> g = hs.homogenizationProblems[i].responses_out->get_g(hs.responseIndex);
+          for(int j=0; j<numColumns; j++) column[j] = (*g)[j];
+        }
+        if( _numGroups > 1 )
+          Teuchos::broadcast(*_interGroupComm, owner, numColumns, column.data());
         for(int j=0; j<numColumns; j++){
-          Cvals(i,j) = (*g)[j];
+          Cvals(i,j) = column[j];
         }
       }
       if(_solverComm->getRank() == 0){
@@ -578,21 +1162,7 @@ ATO::Solver::ComputeObjective(const double* p, double& g, double* dgdp)
   Teuchos::RCP<Teuchos::FancyOStream> out(Teuchos::VerboseObjectBase::getDefaultOStream());
   *out << "IKT, 12/22/16, WARNING: Tpetra-converted ComputeObjective has not been tested " 
        << "yet and may not work correctly! \n"; 
-  for(int i=0; i<_numPhysics; i++){
-
-    // copy data from p into each stateManager
-    if( entityType == "State Variable" ){
-      Albany::StateManager& stateMgr = _subProblems[i].app->getStateMgr();
-      copyTopologyIntoStateMgr( p, stateMgr );
-    } else 
-    if( entityType == "Distributed Parameter"){
-      copyTopologyIntoParameter( p, _subProblems[i] );
-    }
-
-    // enforce PDE constraints
-    _subProblems[i].model->evalModel((*_subProblems[i].params_in),
-                                    (*_subProblems[i].responses_out));
-  }
+  solveSubProblems(p);
 
   if ( entityType == "Distributed Parameter" ) {
     updateTpetraResponseMaps(); 
@@ -616,22 +1186,7 @@ ATO::Solver::ComputeObjective(double* p, double& g, double* dgdp)
        << "yet and may not work correctly! \n"; 
   if(_iteration!=1) smoothTopologyT(p);
 
-  for(int i=0; i<_numPhysics; i++){
-    
-
-    // copy data from p into each stateManager
-    if( entityType == "State Variable" ){
-      Albany::StateManager& stateMgr = _subProblems[i].app->getStateMgr();
-      copyTopologyIntoStateMgr( p, stateMgr );
-    } else 
-    if( entityType == "Distributed Parameter"){
-      copyTopologyIntoParameter( p, _subProblems[i] );
-    }
-
-    // enforce PDE constraints
-    _subProblems[i].model->evalModel((*_subProblems[i].params_in),
-                                    (*_subProblems[i].responses_out));
-  }
+  solveSubProblems(p);
 
   if ( entityType == "Distributed Parameter" ) {
     updateTpetraResponseMaps(); 
@@ -658,7 +1213,7 @@ ATO::Solver::ComputeObjective(double* p, double& g, double* dgdp)
    }
 
    // Output a new result file if requested
-   if(_writeDesignFrequency && (_iteration % _writeDesignFrequency == 0) )
+   if(_writeDesignFrequency && (_iteration % _writeDesignFrequency == 0) && _groupId == 0 )
      writeCurrentDesign();
   _iteration++;
 }
@@ -1164,21 +1719,7 @@ void
 ATO::Solver::Compute(const double* p, double& g, double* dgdp, double& c, double* dcdp)
 /******************************************************************************/
 {
-  for(int i=0; i<_numPhysics; i++){
-
-    // copy data from p into each stateManager
-    if( entityType == "State Variable" ){
-      Albany::StateManager& stateMgr = _subProblems[i].app->getStateMgr();
-      copyTopologyIntoStateMgr( p, stateMgr );
-    } else 
-    if( entityType == "Distributed Parameter"){
-      copyTopologyIntoParameter( p, _subProblems[i] );
-    }
-
-    // enforce PDE constraints
-    _subProblems[i].model->evalModel((*_subProblems[i].params_in),
-                                    (*_subProblems[i].responses_out));
-  }
+  solveSubProblems(p);
 
   if ( entityType == "Distributed Parameter" ) {
     updateTpetraResponseMaps(); 
@@ -1444,6 +1985,10 @@ ATO::Solver::createInputFile( const Teuchos::RCP<Teuchos::ParameterList>& appPar
     newname << "physics_" << physIndex << "_" 
             << physics_discList.get<std::string>("Exodus Output File Name");
     physics_discList.set("Exodus Output File Name",newname.str());
+
+    // only the group that solves this sub problem writes its output
+    if( _subProblemGroup[physIndex] != _groupId )
+      physics_discList.remove("Exodus Output File Name");
   }
 
   int ntopos = _topologyInfoStructsT.size();
@@ -1645,6 +2190,8 @@ ATO::Solver::getValidProblemParameters() const
   // Basic set-up
   validPL->set<int>("Number of Subproblems", 1, "Number of PDE constraint problems");
   validPL->set<int>("Number of Homogenization Problems", 0, "Number of homogenization problems");
+  validPL->set<int>("Number of Subproblem Groups", 1, "Number of rank groups solving subproblems concurrently");
+  validPL->sublist("Shared Operator Solve", false, "Block solve for linear subproblems that differ only in loading");
   validPL->set<bool>("Verbose Output", false, "Enable detailed output mode");
   validPL->set<int>("Design Output Frequency", 0, "Write isosurface every N iterations");
   validPL->set<std::string>("Name", "", "String to designate Problem");
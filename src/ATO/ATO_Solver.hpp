@@ -156,6 +156,29 @@ namespace ATO {
 
     int _numPhysics; // number of sub problems
 
+    // sub problems are distributed over _numGroups groups of ranks and solved
+    // concurrently.  Each group holds all sub problems on its own _solverComm
+    // but only evaluates those assigned to it in _subProblemGroup.
+    int _numGroups;
+    int _groupId;
+    std::vector<int> _subProblemGroup;
+    Teuchos::RCP<const Teuchos_Comm> _interGroupComm; // same rank in each group
+
+    // linear sub problems that differ only in their loading share one operator.
+    // Each set is assembled once per design and solved with a block Krylov
+    // method for all load cases at once.  Distributed parameter topologies
+    // also solve the adjoints of all responses as one block.
+    typedef struct SharedOperatorSet {
+      std::vector<int> subProblems;
+      Teuchos::RCP<Tpetra_CrsMatrix> jacobianT;
+      Teuchos::RCP<Tpetra_Operator> preconditionerT;
+      Teuchos::RCP<Tpetra_Operator> adjointPreconditionerT;
+    } SharedOperatorSet;
+
+    std::vector<SharedOperatorSet> _sharedOperatorSets;
+    std::vector<int> _sharedOperatorSetIndex;  // -1 if solved independently
+    Teuchos::RCP<Teuchos::ParameterList> _sharedOperatorParams;
+
     std::vector<int> _wsOffset;  //index offsets to map to/from workset to/from 1D array.
 
     bool _is_verbose;    // verbose or not for topological optimization solver
@@ -235,6 +258,20 @@ namespace ATO {
     void copyObjectiveFromStateMgr( double& g, double* dgdp );
     void copyConstraintFromStateMgr( double& c, double* dcdp );
     void zeroSet();
+    void createSubProblemGroups(const Teuchos::RCP<const Teuchos_Comm>& comm);
+    void solveSubProblems(const double* p);
+    void shareSubProblemResults(SolverSubSolver& subSolver, int owner);
+    void findSharedOperatorSets();
+    void solveSharedOperatorSet(SharedOperatorSet& opSet);
+    void solveSharedAdjoints(SharedOperatorSet& opSet, const Tpetra_MultiVector& solT);
+    void updateSharedPreconditioner(const Teuchos::RCP<Tpetra_CrsMatrix>& A,
+                                    Teuchos::RCP<Tpetra_Operator>& prec);
+    void blockSolve(const Teuchos::RCP<Tpetra_CrsMatrix>& A,
+                    const Teuchos::RCP<Tpetra_Operator>& prec,
+                    const Teuchos::RCP<Tpetra_MultiVector>& rhsT,
+                    const Teuchos::RCP<Tpetra_MultiVector>& solT,
+                    const std::string& label);
+    void verifySharedOperatorSet(const SharedOperatorSet& opSet);
     Teuchos::RCP<const Teuchos::ParameterList> getValidProblemParameters() const;
 
     Teuchos::RCP<const Epetra_Map> get_g_map(int j) const;
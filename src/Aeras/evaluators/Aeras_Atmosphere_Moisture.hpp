@@ -16,22 +16,19 @@
 #include "Aeras_Dimension.hpp"
 
 #include "Teuchos_ParameterList.hpp"
+#include "Teuchos_Time.hpp"
 
 namespace Aeras {
 
-//static
-//void kessler(int Km, double dt_in,
-//             std::vector<double> & rho, 
-//             std::vector<double> & p, 
-//             std::vector<double> & exner, 
-//             std::vector<double> & dz8w,
-//             std::vector<double> & t,  
-//             std::vector<double> & qv, 
-//             std::vector<double> & qc, 
-//             std::vector<double> & qr,
-//             double &rainnc,  double &rainncv,
-//             std::vector<double> &z);
-
+// Kessler warm rain microphysics, operator split from the dynamics: it runs
+// once per physics step ("Cloud Physics Time Step", usually the time step of
+// the integrator), starting at a solution accepted by the integrator
+// (PHAL::Workset::previous_time), on the state of the first evaluation of
+// that time step, and its tendencies are applied as sources by every
+// evaluation of the step (Runge-Kutta stages, Newton and Krylov residuals,
+// Jacobians). Columns are packed in batches of
+// batchSize, level major, so the microphysics vectorizes across columns.
+// Its cost is timed separately, by the "Aeras: Moist Physics" timer.
 template<typename EvalT, typename Traits> 
 class Atmosphere_Moisture : public PHX::EvaluatorWithBaseImpl<Traits>,
                             public PHX::EvaluatorDerived<EvalT, Traits>  {
@@ -49,17 +46,11 @@ public:
   void evaluateFields(typename Traits::EvalData d);
   
 private:
-void kessler(const int Km, const double dt_in,
-             const std::vector<double> & rho, 
-             const std::vector<double> & p, 
-             const std::vector<double> & exner, 
-             const std::vector<double> & dz8w,
-             std::vector<double> & t,  
-             std::vector<double> & qv, 
-             std::vector<double> & qc, 
-             std::vector<double> & qr,
-             double &rainnc,  double &rainncv,
-             const std::vector<double> &z);
+  //! Columns handed to the microphysics at once
+  static const int batchSize = 32;
+
+  //! Kessler microphysics over the first nCols columns of the batch, in place
+  void kessler(const int nCols, const double dt_in);
 
   PHX::MDField<const ScalarT,Cell,QuadPoint,Level,VecDim> Velx;
   PHX::MDField<const ScalarT,Cell,QuadPoint,VecDim> Temp;
@@ -73,6 +64,29 @@ void kessler(const int Km, const double dt_in,
   std::map<std::string, PHX::MDField<const ScalarT,Cell,QuadPoint,Level> > TracerIn;
   std::map<std::string, PHX::MDField<ScalarT,Cell,QuadPoint,Level> > TracerSrc;
 
+  // The moist tracers, looked up once
+  PHX::MDField<const ScalarT,Cell,QuadPoint,Level> VaporIn, CloudIn, RainIn;
+  PHX::MDField<ScalarT,Cell,QuadPoint,Level> VaporSrc, CloudSrc, RainSrc;
+
+  // A batch of columns, level major: entry k*batchSize+i is level k (from the
+  // bottom) of column i, so the microphysics loops over columns innermost.
+  struct ColumnBatch {
+    void resize(const int n);
+    std::vector<double> rho, p, exner, dz8w, t, qv, qc, qr, z;
+    std::vector<double> vt, qrk, vtden, rdzk, rhok, rcgsk, factor, rdzw, qrcond;
+    std::vector<double> crmax, dtfall, time_sediment;
+    std::vector<int>    nfall;
+  };
+  ColumnBatch batch;
+
+  // Physics tendencies dT/dt, dqv/dt, dqc/dt, dqr/dt of each workset, for
+  // ((cell*numQPs + qp)*numLevels + level), computed once per physics step
+  std::vector<std::vector<double> > tendencies;
+  std::vector<double> physicsTime;  // start of the current physics step
+  double physicsStep;               // length of the physics steps
+
+  Teuchos::RCP<Teuchos::Time> physicsTimer;
+
 
   const Teuchos::ArrayRCP<std::string> tracerNames;
   const Teuchos::ArrayRCP<std::string> tracerSrcNames;
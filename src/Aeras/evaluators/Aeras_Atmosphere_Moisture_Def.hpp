@@ -7,8 +7,10 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cmath>
 
 #include "Teuchos_TestForException.hpp"
+#include "Teuchos_TimeMonitor.hpp"
 #include "Phalanx_DataLayout.hpp"
 #include "PHAL_Utilities.hpp"
 
@@ -52,6 +54,9 @@ Atmosphere_Moisture(Teuchos::ParameterList& p,
 
   compute_cloud_physics = xzhydrostatic_params->get<bool>("Compute Cloud Physics", false); 
   //std::cout << "Atmosphere_Moisture: Computing Cloud Physics = " << compute_cloud_physics << std::endl;
+  physicsStep = xzhydrostatic_params->get<double>("Cloud Physics Time Step", 0.0);
+  TEUCHOS_TEST_FOR_EXCEPTION(compute_cloud_physics && !(physicsStep > 0.0), std::logic_error,
+    "Aeras::Atmosphere_Moisture requires a positive Cloud Physics Time Step.");
 
   Teuchos::ArrayRCP<std::string> RequiredTracers(3);
   RequiredTracers[0] = "Vapor";
@@ -83,9 +88,26 @@ Atmosphere_Moisture(Teuchos::ParameterList& p,
     this->addDependentField(TracerIn   [tracerNames[i]]);
     this->addEvaluatedField(TracerSrc[tracerSrcNames[i]]);
   }
+  if (compute_cloud_physics) batch.resize(numLevels*batchSize);
+  physicsTimer = Teuchos::TimeMonitor::getNewTimer("Aeras: Moist Physics");
+
   this->setName("Aeras::Atmosphere_Moisture" + PHX::typeAsString<EvalT>());
 }
 
+// **********************************************************************
+template<typename EvalT, typename Traits>
+void Atmosphere_Moisture<EvalT, Traits>::ColumnBatch::resize(const int n)
+{
+  std::vector<double>* v[] = {&rho, &p, &exner, &dz8w, &t, &qv, &qc, &qr, &z,
+                              &vt, &qrk, &vtden, &rdzk, &rhok, &rcgsk, &factor,
+                              &rdzw, &qrcond};
+  for (std::vector<double>* a : v) a->assign(n, 0.0);
+  crmax.assign(batchSize, 0.0);
+  dtfall.assign(batchSize, 0.0);
+  time_sediment.assign(batchSize, 0.0);
+  nfall.assign(batchSize, 0);
+}
+
 // **********************************************************************
 template<typename EvalT, typename Traits> 
 void Atmosphere_Moisture<EvalT, Traits>::postRegistrationSetup(typename Traits::SetupData d,
@@ -103,21 +125,22 @@ void Atmosphere_Moisture<EvalT, Traits>::postRegistrationSetup(typename Traits::
   for (int i = 0; i < TracerIn.size();  ++i) this->utils.setFieldData(TracerIn[tracerNames[i]], fm);
   for (int i = 0; i < TracerSrc.size(); ++i) this->utils.setFieldData(TracerSrc[tracerSrcNames[i]],fm);
 
+  if (compute_cloud_physics) {
+    VaporIn  = TracerIn["Vapor"];
+    CloudIn  = TracerIn["Cloud"];
+    RainIn   = TracerIn["Rain"];
+    VaporSrc = TracerSrc[namesToSrc["Vapor"]];
+    CloudSrc = TracerSrc[namesToSrc["Cloud"]];
+    RainSrc  = TracerSrc[namesToSrc["Rain"]];
+  }
 }
 
 // **********************************************************************
 template<typename EvalT, typename Traits>
 void Atmosphere_Moisture<EvalT, Traits>::evaluateFields(typename Traits::EvalData workset)
 { 
-  const Eta<EvalT> &E = Eta<EvalT>::self();
-  unsigned int numCells = workset.numCells;
-  //Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> > wsCoords = workset.wsCoords;
-
-  //amb workset.previous_time is never set. We need to do something about that.
-  const double dt_in = workset.current_time - workset.previous_time;
-  double rainnc, rainncv;
-  //const double zbot = 25.0;
-  //const double ztop = 10000.0;
+  const int numCells = workset.numCells;
+  const int numCols  = numCells*numQPs;
   const double gravity = 9.80616;
 
   PHAL::set(TempSrc, 0.0);
@@ -125,88 +148,105 @@ void Atmosphere_Moisture<EvalT, Traits>::evaluateFields(typename Traits::EvalDat
   for (int t=0; t < TracerSrc.size(); ++t)  
     PHAL::set(TracerSrc[tracerSrcNames[t]], 0.0);
 
-  if (compute_cloud_physics == true) {
-
-    std::vector<double> rho(numLevels, 0.0);
-    std::vector<double> p(numLevels, 0.0);
-    std::vector<double> t(numLevels, 0.0);
-    std::vector<double> exner(numLevels, 0.0);
-    std::vector<double> qv(numLevels, 0.0);
-    std::vector<double> qc(numLevels, 0.0);
-    std::vector<double> qr(numLevels, 0.0);
-    std::vector<double> z(numLevels, 0.0);
-    std::vector<double> dz8w(numLevels, 0.0);
+  if (compute_cloud_physics == false) return;
 
-    double Piinv, Pival, Pi_dot;
-  
-    for (int cell=0; cell < numCells; ++cell) {
-      for (int qp=0; qp < numQPs; ++qp) {
-  
-        for (int level=0; level < numLevels; ++level) { 
-          int k    = numLevels - level - 1;
-          rho[k]   = Albany::ADValue( Density(cell,qp,level) );
-          p[k]     = Albany::ADValue( Pressure(cell,qp,level) );
-          t[k]     = Albany::ADValue( Temp(cell,qp,level) );
-          exner[k] = pow( (p[k]/100000.0),(0.286) );
-          rho[k]   = Albany::ADValue( Density(cell,qp,level) );
-          Piinv    = 1.0/Albany::ADValue( Pi(cell,qp,level) );
-          qv[k]    = Piinv*Albany::ADValue( TracerIn["Vapor"](cell,qp,level) ); 
-          qc[k]    = Piinv*Albany::ADValue( TracerIn["Cloud"](cell,qp,level) );
-          qr[k]    = Piinv*Albany::ADValue( TracerIn["Rain"] (cell,qp,level) );
-          z[k]     = Albany::ADValue( GeoPotential(cell,qp,level) ) / gravity;
-          dz8w[k]  = z[k];
+  const unsigned int ws = workset.wsIndex;
+  if (ws >= tendencies.size()) {
+    tendencies.resize(ws+1);
+    physicsTime.resize(ws+1, 0.0);
+  }
+  std::vector<double>& tend = tendencies[ws];
+
+  // The physics steps are physicsStep long and start with time steps of the
+  // integrator: the first one with the first accepted solution, each
+  // following one with the first accepted solution at or after the end of
+  // the previous one. The physics runs on the first evaluation of that time
+  // step, the accepted state itself for the first stage of a Runge-Kutta
+  // step, and every later stage, including one at the end of the step,
+  // reuses its tendencies. A step that starts before the current physics
+  // step restarts from an earlier state: start over there. Without an
+  // observer the accepted solutions are unknown, and the evaluation times
+  // stand in for them.
+  const double time = std::isfinite(workset.previous_time) ?
+    workset.previous_time : workset.current_time;
+  const bool newStep = tend.empty() || time < physicsTime[ws] ||
+    time >= physicsTime[ws] + (1.0 - 1.0e-10)*physicsStep;
+
+  if (newStep) {
+    Teuchos::TimeMonitor timer(*physicsTimer);
+
+    physicsTime[ws] = time;
+    const double dt_in = physicsStep;
+
+    tend.assign(4*numCols*numLevels, 0.0);
+    const int B = batchSize;
+    for (int c0 = 0; c0 < numCols; c0 += B) {
+      const int nCols = std::min(B, numCols - c0);
+
+      for (int level=0; level < numLevels; ++level) {
+        const int k = numLevels - level - 1;
+        for (int i=0; i < nCols; ++i) {
+          const int cell = (c0+i) / numQPs, qp = (c0+i) % numQPs;
+          const int j = k*B + i;
+          const double Piinv = 1.0/Albany::ADValue( Pi(cell,qp,level) );
+          batch.rho[j]   = Albany::ADValue( Density(cell,qp,level) );
+          batch.p[j]     = Albany::ADValue( Pressure(cell,qp,level) );
+          batch.t[j]     = Albany::ADValue( Temp(cell,qp,level) );
+          batch.exner[j] = pow( (batch.p[j]/100000.0),(0.286) );
+          batch.qv[j]    = Piinv*Albany::ADValue( VaporIn(cell,qp,level) );
+          batch.qc[j]    = Piinv*Albany::ADValue( CloudIn(cell,qp,level) );
+          batch.qr[j]    = Piinv*Albany::ADValue( RainIn (cell,qp,level) );
+          batch.z[j]     = Albany::ADValue( GeoPotential(cell,qp,level) ) / gravity;
+          batch.dz8w[j]  = batch.z[j];
         }
+      }
 
-        kessler(numLevels, dt_in,
-                rho, p, exner, dz8w,
-                t, qv, qc, qr,
-                rainnc,  rainncv,
-                z);
-  
-        for (int level=0; level < numLevels; ++level) { 
-          int k = numLevels - level - 1;
-
-          TempSrc(cell,qp,level) = -( t[k] - Albany::ADValue(Temp(cell,qp,level)) ) / dt_in;
-          //TempSrc(cell,qp,level) = 0.0; 
-
-          //src = pi*dqdt + q*dpidt
-          Pival  = Albany::ADValue( Pi(cell,qp,level) );
-          Pi_dot = Albany::ADValue( PiDot(cell,qp,level) );
-          Piinv  = 1.0/Albany::ADValue( Pi(cell,qp,level) );
-          
-          double qv_old = Piinv*Albany::ADValue( TracerIn["Vapor"](cell,qp,level) );
-          double qc_old = Piinv*Albany::ADValue( TracerIn["Cloud"](cell,qp,level) );
-          double qr_old = Piinv*Albany::ADValue( TracerIn["Rain"] (cell,qp,level) );
-
-          TracerSrc[namesToSrc["Vapor"]](cell,qp,level) = -( Pival*( qv[k] - qv_old )/dt_in + qv_old * Pi_dot );
-          TracerSrc[namesToSrc["Cloud"]](cell,qp,level) = -( Pival*( qc[k] - qc_old )/dt_in + qc_old * Pi_dot );
-          TracerSrc[namesToSrc["Rain"]] (cell,qp,level) = -( Pival*( qr[k] - qr_old )/dt_in + qr_old * Pi_dot );
-          //TracerSrc[namesToSrc["Vapor"]](cell,qp,level) = 0.0;
-          //TracerSrc[namesToSrc["Cloud"]](cell,qp,level) = 0.0;
-          //TracerSrc[namesToSrc["Rain"]] (cell,qp,level) = 0.0;
+      kessler(nCols, dt_in);
+
+      for (int level=0; level < numLevels; ++level) {
+        const int k = numLevels - level - 1;
+        for (int i=0; i < nCols; ++i) {
+          const int cell = (c0+i) / numQPs, qp = (c0+i) % numQPs;
+          const int j = k*B + i;
+          const double Piinv = 1.0/Albany::ADValue( Pi(cell,qp,level) );
+          double* d = &tend[4*((c0+i)*numLevels + level)];
+          d[0] = ( batch.t[j]  - Albany::ADValue( Temp(cell,qp,level) ) ) / dt_in;
+          d[1] = ( batch.qv[j] - Piinv*Albany::ADValue( VaporIn(cell,qp,level) ) ) / dt_in;
+          d[2] = ( batch.qc[j] - Piinv*Albany::ADValue( CloudIn(cell,qp,level) ) ) / dt_in;
+          d[3] = ( batch.qr[j] - Piinv*Albany::ADValue( RainIn (cell,qp,level) ) ) / dt_in;
         }
       }
     }
   }
 
+  // Sources from the tendencies of the step: src = pi*dqdt + q*dpidt
+  for (int cell=0; cell < numCells; ++cell) {
+    for (int qp=0; qp < numQPs; ++qp) {
+      for (int level=0; level < numLevels; ++level) { 
+        const double* d = &tend[4*((cell*numQPs + qp)*numLevels + level)];
+        const double Pival  = Albany::ADValue( Pi(cell,qp,level) );
+        const double Pi_dot = Albany::ADValue( PiDot(cell,qp,level) );
+        const double Piinv  = 1.0/Pival;
+
+        const double qv_old = Piinv*Albany::ADValue( VaporIn(cell,qp,level) );
+        const double qc_old = Piinv*Albany::ADValue( CloudIn(cell,qp,level) );
+        const double qr_old = Piinv*Albany::ADValue( RainIn (cell,qp,level) );
+
+        TempSrc (cell,qp,level) = -d[0];
+        VaporSrc(cell,qp,level) = -( Pival*d[1] + qv_old * Pi_dot );
+        CloudSrc(cell,qp,level) = -( Pival*d[2] + qc_old * Pi_dot );
+        RainSrc (cell,qp,level) = -( Pival*d[3] + qr_old * Pi_dot );
+      }
+    }
+  }
 }
 
 // **********************************************************************
 template<typename EvalT, typename Traits>
-void Atmosphere_Moisture<EvalT, Traits>::kessler(const int Km, const double dt_in,
-             const std::vector<double> & rho, 
-             const std::vector<double> & p, 
-             const std::vector<double> & exner, 
-             const std::vector<double> & dz8w,
-             std::vector<double> & t,  
-             std::vector<double> & qv, 
-             std::vector<double> & qc, 
-             std::vector<double> & qr,
-             double &rainnc,  double &rainncv,
-             const std::vector<double> & z)
+void Atmosphere_Moisture<EvalT, Traits>::kessler(const int nCols, const double dt_in)
 {
-
-  int nfall, nfall_new;
+  const int Km = numLevels;
+  const int B  = batchSize;
 
   const double xlv          = 2.501e+6; // Latent heat of vaporization at 0C [J/kg]
   const double cp           = 1005.7;   // Specific heat capacity at constant pressure [J/kg/K]
@@ -215,136 +255,152 @@ void Atmosphere_Moisture<EvalT, Traits>::kessler(const int Km, const double dt_i
   const double eps          = 0.622;    // epsilon, Ratio of Rd/Rv [unitless]
   const double csvp3        = 29.65;    // Constant for saturation vapor pressure 
   const double K_temp_C     = 273.15;   // Temperature in K at 0 C                     
-  const double mm_per_m     = 1000.;    // Convert, 1000 mm per m
   const double mbar_per_bar = 1000.;    // Convert, 1000 mbar per bar 
   const double mks_to_cgs   = 0.001;    // Convert mks to cgs
-  const double rhowater     = 1.0;      // Density of water [1g/cm3=1000kg/m3]
 
   const double max_cr_sedimentation = 0.75;
 
-  double qrprod;
-  double qrvent;
-  double qrevap;
-  double gam;
-  double qrr;     // Rainwater mixing ratio in the column [kg/kg] 
-  double temp;    // temperature [K]
-  double es;      // Saturation vapor pressure [mbar] from Bolton or Teton's formula 
-  double qvs;     // Saturation mixing ratio (Rogers & Yau Eq. 2.18) [bar]
-  double dz; 
-  double f5; 
-  double dtfall; 
-  double rdz; 
-  double prodct;
-  double crmax; 
-  double factorn; 
-  double time_sediment; 
-  double qcr; 
-  double factorr; 
-  double ppt;     // Precipitation at surface [m]
-
-  std::vector<double> vt(Km, 0.0);
-  std::vector<double> qrk(Km,0.0);
-  std::vector<double> vtden(Km,0.0);
-  std::vector<double> rdzk(Km,0.0);
-  std::vector<double> rhok(Km,0.0);
-  std::vector<double> rcgsk(Km,0.0);
-  std::vector<double> factor(Km,0.0);
-  std::vector<double> rdzw(Km,0.0);
-  std::vector<double> qrcond(Km,1.0);
+  // Column data: inputs and outputs
+  const double* rho   = &batch.rho[0];
+  const double* p     = &batch.p[0];
+  const double* exner = &batch.exner[0];
+  const double* dz8w  = &batch.dz8w[0];
+  const double* z     = &batch.z[0];
+  double* t  = &batch.t[0];
+  double* qv = &batch.qv[0];
+  double* qc = &batch.qc[0];
+  double* qr = &batch.qr[0];
+
+  // Scratch
+  double* vt     = &batch.vt[0];
+  double* qrk    = &batch.qrk[0];
+  double* vtden  = &batch.vtden[0];
+  double* rdzk   = &batch.rdzk[0];
+  double* rhok   = &batch.rhok[0];
+  double* rcgsk  = &batch.rcgsk[0];
+  double* factor = &batch.factor[0];
+  double* rdzw   = &batch.rdzw[0];
+  double* qrcond = &batch.qrcond[0];
+  double* crmax         = &batch.crmax[0];
+  double* dtfall        = &batch.dtfall[0];
+  double* time_sediment = &batch.time_sediment[0];
+  int*    nfall         = &batch.nfall[0];
 
   const double dt = dt_in;
-  f5 = 17.67*243.5*xlv/cp;    // changes?
-
-   for (int k=0; k<Km; ++k) {             // construct column data
-     qrk[k]   = qr[k];                // Save 3D rain to column
-     rhok[k]  = rho[k];               // Save 3D dry air density to column
-     rcgsk[k] = mks_to_cgs * rho[k];  // Save 3D dry air density to column
-   }
-
-  crmax = 0.0;
+  const double f5 = 17.67*243.5*xlv/cp;    // changes?
+
+  for (int k=0; k<Km; ++k) {             // construct column data
+    for (int i=0; i<nCols; ++i) {
+      const int j = k*B + i;
+      qrk[j]    = qr[j];                 // Save 3D rain to column
+      rhok[j]   = rho[j];                // Save 3D dry air density to column
+      rcgsk[j]  = mks_to_cgs * rho[j];   // Save 3D dry air density to column
+      qrcond[j] = 1.0;
+    }
+  }
 
   // Set-up coefficients and compute stable timestep for
   // calculation of terminal velocity and vertical advection. 
 
+  for (int i=0; i<nCols; ++i) crmax[i] = 0.0;
   for (int k=0; k<Km; ++k) {    //do k = kts, kte
+    for (int i=0; i<nCols; ++i) {
+      const int j = k*B + i;
+      const double qrr = std::max( 0.0,qrk[j]*rcgsk[j] );   // Total precip content 
 
-    qrr = std::max( 0.0,qrk[k]*rcgsk[k] );             // Total precip content 
+      vtden[j] = sqrt(rcgsk[B+i]/rcgsk[j]);                  // Kessler Eq. 4.3
+      vt[j]    = 36.34 * pow(qrr,0.1364) * vtden[j];         // Kessler Eq. 8.11
 
-    vtden[k] = sqrt(rcgsk[1]/rcgsk[k]);               // Kessler Eq. 4.3
-    vt[k]    = 36.34 * pow(qrr,0.1364) * vtden[k];    // Kessler Eq. 8.11
+      rdzw[j]  = 1.0/dz8w[j];
 
-    rdzw[k]  = 1.0/dz8w[k];
-
-    crmax = std::max( vt[k]*dt*rdzw[k],crmax );  // Max precip speed in this column 
+      crmax[i] = std::max( vt[j]*dt*rdzw[j],crmax[i] );     // Max precip speed in this column 
+    }
   } 
 
   for (int k=0; k<Km-1; ++k) { // do k = kts, kte-1               // Recompute ratio of vertical levels
-    rdzk[k] = 1.0/(z[k+1] - z[k]);
+    for (int i=0; i<nCols; ++i)
+      rdzk[k*B+i] = 1.0/(z[(k+1)*B+i] - z[k*B+i]);
   } 
-  rdzk[Km-1] = 1.0/(z[Km-1] - z[Km-2]);
+  for (int i=0; i<nCols; ++i)
+    rdzk[(Km-1)*B+i] = 1.0/(z[(Km-1)*B+i] - z[(Km-2)*B+i]);
 
   // nint() - nearest whole number ???
   // nfall      = max(1,nint(0.5+crmax/max_cr_sedimentation))  
-  nfall         = std::max( 1,int(0.5+crmax/max_cr_sedimentation) );  // courant number for big timestep.
-  dtfall        = dt / double(nfall);                                 // splitting so courant number for sedimentation
-  time_sediment = dt;                                                 // is stable
+  for (int i=0; i<nCols; ++i) {
+    nfall[i]         = std::max( 1,int(0.5+crmax[i]/max_cr_sedimentation) );  // courant number for big timestep.
+    dtfall[i]        = dt / double(nfall[i]);                                 // splitting so courant number for sedimentation
+    time_sediment[i] = dt;                                                    // is stable
+  }
 
   // Calculate terminal velocity and vertical advection. 
-  // Do a time split loop on this for stability.
+  // Do a time split loop on this for stability. Each column takes its own
+  // number of split steps; finished columns (nfall == 0) are skipped.
 
-  while ( nfall > 0 ) { //column_sedimentation: do while ( nfall > 0 )
+  int active = nCols;
+  while ( active > 0 ) { //column_sedimentation: do while ( nfall > 0 )
 
-    time_sediment = time_sediment - dtfall;
+    for (int i=0; i<nCols; ++i)
+      if (nfall[i] > 0) time_sediment[i] = time_sediment[i] - dtfall[i];
     for (int k=0; k<Km; ++k) {  //do k = kts, kte-1
-      factor[k] = dtfall*rdzk[k]/rhok[k];
+      for (int i=0; i<nCols; ++i)
+        factor[k*B+i] = dtfall[i]*rdzk[k*B+i]/rhok[k*B+i];
     } //enddo
-    factor[Km-1] = dtfall*rdzk[Km-1];
-
-
-    // Update cumulative large-scale prescipitation at surface
-    ppt     = 0.0;
-    ppt     = rhok[0]*qrk[0]*vt[0]*dtfall/rhowater; 
-    rainncv = ppt*mm_per_m;                          // convert units to mm
-    rainnc  = rainnc + ppt*mm_per_m;                 // keep track of cumulative value
-
+    for (int i=0; i<nCols; ++i)
+      factor[(Km-1)*B+i] = dtfall[i]*rdzk[(Km-1)*B+i];
 
     // Time split loop, fallout done with flux upstream
     for (int k=0; k<Km-1; ++k) {    //do k = kts, kte-1
-      qrk[k] = qrk[k] - factor[k] * ( rhok[k] * qrk[k] * vt[k] 
-                                    - rhok[k+1] * qrk[k+1] * vt[k+1] );
+      for (int i=0; i<nCols; ++i) {
+        if (nfall[i] == 0) continue;
+        const int j = k*B + i;
+        qrk[j] = qrk[j] - factor[j] * ( rhok[j] * qrk[j] * vt[j] 
+                                      - rhok[j+B] * qrk[j+B] * vt[j+B] );
+      }
     } 
     // Update rain at model top
-    qrk[Km-1] = qrk[Km-1] - factor[Km-1]*qrk[Km-1]*vt[Km-1];
+    for (int i=0; i<nCols; ++i) {
+      if (nfall[i] == 0) continue;
+      const int j = (Km-1)*B + i;
+      qrk[j] = qrk[j] - factor[j]*qrk[j]*vt[j];
+    }
 
     // Compute new sedimentation velocity, and check/recompute new 
     // sedimentation timestep if this isn't the last split step.
 
-    if( nfall > 1 ) { // this wasn't the last split sedimentation timestep
-
-      nfall = nfall - 1;
-      crmax = 0.0;
-      
-      for (int k=0; k<Km; ++k) { //do k = kts, kte 
-        qrr   = std::max( 0.0,qrk[k]*rcgsk[k] );
-        vt[k] = 36.34 * pow(qrr,0.1364) * vtden[k];
-        crmax = std::max( vt[k]*time_sediment*rdzw[k],crmax );
+    for (int i=0; i<nCols; ++i)
+      if (nfall[i] > 1) crmax[i] = 0.0;
+    for (int k=0; k<Km; ++k) { //do k = kts, kte 
+      for (int i=0; i<nCols; ++i) {
+        if (nfall[i] <= 1) continue;
+        const int j = k*B + i;
+        const double qrr = std::max( 0.0,qrk[j]*rcgsk[j] );
+        vt[j]    = 36.34 * pow(qrr,0.1364) * vtden[j];
+        crmax[i] = std::max( vt[j]*time_sediment[i]*rdzw[j],crmax[i] );
       } // enddo
+    }
 
-      //NINT - Macro for nearest whole number
-      int nearwh = NINT( 0.5+crmax/max_cr_sedimentation );
-      nfall_new = std::max( 1,nearwh );
-      if (nfall_new != nfall ) {
-        nfall  = nfall_new;
-        dtfall = time_sediment/nfall;
-      } 
+    for (int i=0; i<nCols; ++i) {
+      if( nfall[i] > 1 ) { // this wasn't the last split sedimentation timestep
 
-    } else { // this was the last timestep
+        nfall[i] = nfall[i] - 1;
 
-      for (int k=0; k<Km; ++k) { //do k=kts,kte
-        qrcond[k] = qrk[k];
-      }
-      nfall = 0;  // exit condition for sedimentation loop
+        //NINT - Macro for nearest whole number
+        int nearwh = NINT( 0.5+crmax[i]/max_cr_sedimentation );
+        const int nfall_new = std::max( 1,nearwh );
+        if (nfall_new != nfall[i] ) {
+          nfall[i]  = nfall_new;
+          dtfall[i] = time_sediment[i]/nfall[i];
+        } 
+
+      } else if( nfall[i] == 1 ) { // this was the last timestep
 
+        for (int k=0; k<Km; ++k) { //do k=kts,kte
+          qrcond[k*B+i] = qrk[k*B+i];
+        }
+        nfall[i] = 0;  // exit condition for sedimentation loop
+        --active;
+
+      }
     }
 
   } //enddo column_sedimentation
@@ -353,57 +409,47 @@ void Atmosphere_Moisture<EvalT, Traits>::kessler(const int Km, const double dt_i
   // Production of qc from supersaturation
   // Evaporation of qr
 
-  //static bool first = true;
-
   for (int k=0; k<Km; ++k) {  //do k = kts, kte
-    factorn = 1.0 / (1.0+2.2*dt*std::max( 0.0,pow( qr[k],0.875 ) ));
-    qrprod  = qc[k] * (1.0 - factorn)           
-            + factorn*0.001*dt*std::max( qc[k]-0.001,0.0 );      
- 
-    qc[k] = std::max( qc[k]-qrprod,0.0 );
-    qr[k] = (qr[k] + qrcond[k]-qr[k]);
-    qr[k] = std::max( qr[k] + qrprod,0.0 );
+    for (int i=0; i<nCols; ++i) {
+      const int j = k*B + i;
+      const double factorn = 1.0 / (1.0+2.2*dt*std::max( 0.0,pow( qr[j],0.875 ) ));
+      const double qrprod  = qc[j] * (1.0 - factorn)           
+                           + factorn*0.001*dt*std::max( qc[j]-0.001,0.0 );      
  
-    temp = exner[k]*t[k];          // Convert from potential temperature to temperature [K]
-    temp = temp - K_temp_C;        // Convert from Kelvin to Celsius [C] 
+      qc[j] = std::max( qc[j]-qrprod,0.0 );
+      qr[j] = (qr[j] + qrcond[j]-qr[j]);
+      qr[j] = std::max( qr[j] + qrprod,0.0 );
  
-    es  = 6.112 * exp( 17.67 * temp / (temp + 243.5)); // Saturation vapor pressure [mbar]
-    es  = mbar_per_bar * es;                           // Saturation vapor pressure [bar]
-    qvs = eps * es / (p[k] - es);                      // Saturation mixing ratio [bar]
+      double temp = exner[j]*t[j];   // Convert from potential temperature to temperature [K]
+      temp = temp - K_temp_C;        // Convert from Kelvin to Celsius [C] 
  
+      double es = 6.112 * exp( 17.67 * temp / (temp + 243.5)); // Saturation vapor pressure [mbar]
+      es = mbar_per_bar * es;                                  // Saturation vapor pressure [bar]
+      const double qvs = eps * es / (p[j] - es);               // Saturation mixing ratio [bar]
  
-    // Production of rain by condensation 
-    qrcond[k] = (qv[k]-qvs) / (1.0 + p[k] / (p[k] - es)*qvs*f5/pow( (temp+243.5),2 ));
+      // Production of rain by condensation 
+      qrcond[j] = (qv[j]-qvs) / (1.0 + p[j] / (p[j] - es)*qvs*f5/pow( (temp+243.5),2 ));
   
-    // Ventilation factor
-    qrvent = 1.6 + 124.9 * pow( (rcgsk[k] * qr[k]),0.2046 );
- 
-    // Evaporation of rain 
-    double dim  = DIM( qvs,qv[k] );
-    double arg1 = dt*((qrvent * pow( rcgsk[k]*qr[k],0.525 ))/(2.55E+08/(p[k]*qvs) + 5.4E+05))*(dim/(rcgsk[k]*qvs));
-    double arg2 = std::max( -qrcond[k]-qc[k],0.0 );
-    double arg3 = qr[k];
-    qrevap      = std::min( arg1,arg2 );
-    qrevap      = std::min( qrevap,arg3 );
-
-    // Update all variables
-    prodct    = std::max( qrcond[k],-qc[k] );
-    gam       = xlv/(cp*exner[k]);
-    t [k]     = t[k] + gam*(prodct - qrevap);
-    qv[k]     = std::max( qv[k]-prodct+qrevap,0.0 );
-    qc[k]     = qc[k] + prodct;
-    qr[k]     = qr[k] - qrevap;
+      // Ventilation factor
+      const double qrvent = 1.6 + 124.9 * pow( (rcgsk[j] * qr[j]),0.2046 );
  
-    //if (first) {
-    //  std::cout << "gam,prodct,qrevap: " << " " << gam << " " << prodct << " " << qrevap << std::endl;
-    //  std::cout << "k,z,rho,p,t,qv,qc,qr: " 
-    //            << k << " " << z[k] << " " << rho[k] << " " << p[k] << " " << t[k] << " " 
-    //            << qv[k] << " " << qc[k] << " " << qr[k] << std::endl;
-    ////if (qv[k] != 0.0) std::cout << k << " " << qv[k] << " " << qc[k] << " " << qr[k] << std::endl;
-    //}
+      // Evaporation of rain 
+      double dim  = DIM( qvs,qv[j] );
+      double arg1 = dt*((qrvent * pow( rcgsk[j]*qr[j],0.525 ))/(2.55E+08/(p[j]*qvs) + 5.4E+05))*(dim/(rcgsk[j]*qvs));
+      double arg2 = std::max( -qrcond[j]-qc[j],0.0 );
+      double arg3 = qr[j];
+      double qrevap = std::min( arg1,arg2 );
+      qrevap        = std::min( qrevap,arg3 );
+
+      // Update all variables
+      const double prodct = std::max( qrcond[j],-qc[j] );
+      const double gam    = xlv/(cp*exner[j]);
+      t [j]     = t[j] + gam*(prodct - qrevap);
+      qv[j]     = std::max( qv[j]-prodct+qrevap,0.0 );
+      qc[j]     = qc[j] + prodct;
+      qr[j]     = qr[j] - qrevap;
+    }
   } //enddo
-
-  //first = false;
 }
 
 }
@@ -22,7 +22,9 @@
 #endif
 
 #include "Albany_DataTypes.hpp"
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "Albany_DummyParameterAccessor.hpp"
 
@@ -58,6 +60,10 @@
 #include "SolutionSniffer.hpp"
 #endif // ALBANY_LCM
 
+#ifdef ALBANY_CONTACT
+#include "Albany_ContactManager.hpp"
+#endif
+
 //#define WRITE_TO_MATRIX_MARKET
 //#define DEBUG_OUTPUT
 //#define DEBUG_OUTPUT2
@@ -130,6 +136,101 @@ Albany::Application::Application(const RCP<const Teuchos_Comm> &comm_)
 }
 
 namespace {
+#if defined(ALBANY_TAN_SLFAD_SIZE)
+// Directions of a tangent fill: columns [x_begin, x_begin + x_count) of Vx,
+// Vxdot, Vxdotdot and JV, and [p_begin, p_begin + p_count) of Vp, or of the
+// parameters, and fp.
+struct TangentChunk {
+  int x_begin, x_count, p_begin, p_count;
+};
+
+// Split the directions into chunks of at most chunk_size. Summed x and p
+// derivatives share their columns; separate ones are chunked one after the
+// other. A summed chunk only covers the columns its side actually has, so a
+// side without directions gets none.
+std::vector<TangentChunk> tangentChunks(const bool sum_derivs,
+                                        const int num_cols_x,
+                                        const int num_cols_p,
+                                        const int chunk_size) {
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      sum_derivs && (num_cols_x != 0) && (num_cols_p != 0) &&
+          (num_cols_x != num_cols_p),
+      std::logic_error,
+      "Seed matrices Vx and Vp must have the same number "
+          << " of columns when sum_derivs is true and both are "
+          << "non-null!" << std::endl);
+  std::vector<TangentChunk> chunks;
+  const int num_cols_tot = sum_derivs ? std::max(num_cols_x, num_cols_p)
+                                      : num_cols_x + num_cols_p;
+  if (num_cols_tot <= chunk_size) {
+    chunks.push_back({0, num_cols_x, 0, num_cols_p});
+  } else if (sum_derivs) {
+    for (int k = 0; k < num_cols_tot; k += chunk_size) {
+      const int count = std::min(chunk_size, num_cols_tot - k);
+      chunks.push_back({k, std::max(0, std::min(count, num_cols_x - k)), k,
+                        std::max(0, std::min(count, num_cols_p - k))});
+    }
+  } else {
+    for (int k = 0; k < num_cols_x; k += chunk_size)
+      chunks.push_back({k, std::min(chunk_size, num_cols_x - k), 0, 0});
+    for (int k = 0; k < num_cols_p; k += chunk_size)
+      chunks.push_back({0, 0, k, std::min(chunk_size, num_cols_p - k)});
+  }
+  return chunks;
+}
+
+int numTangentColumnsX(const Tpetra_MultiVector *VxT,
+                       const Tpetra_MultiVector *VxdotT,
+                       const Tpetra_MultiVector *VxdotdotT) {
+  if (VxT != NULL)
+    return VxT->getNumVectors();
+  if (VxdotT != NULL)
+    return VxdotT->getNumVectors();
+  if (VxdotdotT != NULL)
+    return VxdotdotT->getNumVectors();
+  return 0;
+}
+
+int numTangentColumnsP(const ParamVec *deriv_par,
+                       const Tpetra_MultiVector *VpT) {
+  if (deriv_par == NULL)
+    return 0;
+  return VpT != NULL ? VpT->getNumVectors() : deriv_par->size();
+}
+
+// Columns [begin, begin + count) of V, null if there are none
+Teuchos::RCP<const Tpetra_MultiVector>
+columnsT(const Tpetra_MultiVector *V, const int begin, const int count) {
+  if (V == NULL || count == 0)
+    return Teuchos::null;
+  return V->subView(Teuchos::Range1D(begin, begin + count - 1));
+}
+
+Teuchos::RCP<Tpetra_MultiVector>
+columnsNonConstT(Tpetra_MultiVector *V, const int begin, const int count) {
+  if (V == NULL || count == 0)
+    return Teuchos::null;
+  return V->subViewNonConst(Teuchos::Range1D(begin, begin + count - 1));
+}
+
+// Parameters [begin, begin + count) of params
+ParamVec subParams(const ParamVec &params, const int begin,
+                   const int count) {
+  ParamVec sub;
+  for (int i = begin; i < begin + count; ++i)
+    sub.addParam(params[i].family, params[i].baseValue);
+  return sub;
+}
+
+// The parameters of a chunk back to values without derivatives
+void resetParams(const ParamVec *params) {
+  if (params == NULL)
+    return;
+  for (unsigned int i = 0; i < params->size(); ++i)
+    (*params)[i].family->setRealValueForAllTypes((*params)[i].baseValue);
+}
+#endif // ALBANY_TAN_SLFAD_SIZE
+
 int calcTangentDerivDimension(
     const Teuchos::RCP<Teuchos::ParameterList> &problemParams) {
   Teuchos::ParameterList &parameterParams =
@@ -225,6 +326,10 @@ void Albany::Application::initialSetUp(
   } catch (...) {
     tangent_deriv_dim = 1;
   }
+#if defined(ALBANY_TAN_SLFAD_SIZE)
+  // Tangents are filled in chunks of this many directions
+  tangent_deriv_dim = ALBANY_TAN_SLFAD_SIZE;
+#endif
 
 #ifdef ALBANY_EPETRA
 #ifdef ALBANY_MOR
@@ -295,8 +400,10 @@ void Albany::Application::initialSetUp(
     solMethod = Eigensolve;
   } else if (solutionMethod == "Aeras Hyperviscosity") {
     solMethod = Transient;
+  } else if (solutionMethod == "Transient Explicit") {
+    solMethod = Transient;
   } else if (solutionMethod == "Transient Tempus" ||
-             "Transient Tempus No Piro") {
+             solutionMethod == "Transient Tempus No Piro") {
 #ifdef ALBANY_TEMPUS
     solMethod = TransientTempus;
 
@@ -406,8 +513,8 @@ void Albany::Application::initialSetUp(
   } else {
     TEUCHOS_TEST_FOR_EXCEPTION(
         true, std::logic_error,
-        "Solution Method must be Steady, Transient, Transient Tempus, "
-        "Transient Tempus No Piro, "
+        "Solution Method must be Steady, Transient, Transient Explicit, "
+        "Transient Tempus, Transient Tempus No Piro, "
             << "Continuation, Eigensolve, or Aeras Hyperviscosity, not : "
             << solutionMethod);
   }
@@ -542,11 +649,20 @@ void Albany::Application::initialSetUp(
   writeToMatrixMarketJac =
       debugParams->get("Write Jacobian to MatrixMarket", 0);
   computeJacCondNum = debugParams->get("Compute Jacobian Condition Number", 0);
+  jacSpectrumFrequency =
+      debugParams->get("Jacobian Spectrum Estimate Frequency", 0);
+  jacSpectrumIterations =
+      debugParams->get("Jacobian Spectrum Estimate Iterations", 30);
+  jacSpectrumTolerance =
+      debugParams->get("Jacobian Spectrum Estimate Tolerance", 1.0e-2);
   writeToMatrixMarketRes =
       debugParams->get("Write Residual to MatrixMarket", 0);
   writeToCoutJac = debugParams->get("Write Jacobian to Standard Output", 0);
   writeToCoutRes = debugParams->get("Write Residual to Standard Output", 0);
   derivatives_check_ = debugParams->get<int>("Derivative Check", 0);
+  if (debugParams->get<bool>("Profile Phalanx DAG", false))
+    dagProfiler.enable(debugParams->get<std::string>(
+        "Phalanx DAG Profile File Name", "phalanx_dag_profile.json"));
   // the above 4 parameters cannot have values < -1
   if (writeToMatrixMarketJac < -1) {
     TEUCHOS_TEST_FOR_EXCEPTION(
@@ -593,6 +709,15 @@ void Albany::Application::initialSetUp(
                "Acceptable values are -1, 0, 1, 2, ... "
             << std::endl);
   }
+  if (jacSpectrumFrequency < 0 || jacSpectrumIterations < 1) {
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        true, Teuchos::Exceptions::InvalidParameter,
+        std::endl
+            << "Error in Albany::Application constructor:  "
+            << "Invalid Parameter Jacobian Spectrum Estimate Frequency or "
+               "Iterations.  Acceptable values are 0, 1, 2, ... and 1, 2, ... "
+            << std::endl);
+  }
   countJac = 0; // initiate counter that counts instances of Jacobian matrix to
                 // 0
   countRes = 0; // initiate counter that counts instances of residual vector to
@@ -770,6 +895,25 @@ void Albany::Application::finalSetUp(
   if (Teuchos::nonnull(rc_mgr))
     rc_mgr->setSolutionManager(solMgrT);
 
+  if (params->isSublist("Checkpoint") && Teuchos::is_null(checkpoint_)) {
+    checkpoint_ = rcp(new Albany::Checkpoint(
+        Teuchos::sublist(params, "Checkpoint"), commT));
+    // The explicit solver and the AlbanyTempus driver restore the rest of
+    // their integrator state from the checkpoint and restart bit for bit.
+    // Piro's Tempus, LOCA and fixed step integrators only start again at the
+    // checkpoint time and step.
+    if (checkpoint_->restarting()) {
+      Tpetra_MultiVector soln(*solMgrT->getInitialSolution(), Teuchos::Copy);
+      checkpoint_->restoreSolution(soln);
+      solMgrT->setInitialSolution(soln);
+      checkpoint_->restoreStates(stateMgr);
+      solMgrT->setAdaptationStep(checkpoint_->restartAdaptationStep());
+      checkpoint_->adjustIntegratorParameters(params->sublist("Piro"));
+      *out << "Restarting from the checkpoint at time "
+           << checkpoint_->restartTime() << std::endl;
+    }
+  }
+
 #ifdef ALBANY_PERIDIGM
 #if defined(ALBANY_EPETRA)
   if (Teuchos::nonnull(LCM::PeridigmManager::self())) {
@@ -947,6 +1091,58 @@ Albany::Application::~Application() {
 #endif
 }
 
+namespace {
+template <typename EvalT>
+void collectDagProfile(PHAL::DagProfiler &profiler,
+                       const Albany::Application *app,
+                       const PHX::FieldManager<PHAL::AlbanyTraits> &fm,
+                       const std::string &name, const int ps,
+                       const bool explicit_scheme) {
+  if (profiler.wasEvaluated<EvalT>(fm))
+    profiler.collect<EvalT>(
+        fm, name,
+        PHAL::getDerivativeDimensions<EvalT>(app, ps, explicit_scheme));
+}
+
+void collectDagProfile(
+    PHAL::DagProfiler &profiler, const Albany::Application *app,
+    const Teuchos::RCP<PHX::FieldManager<PHAL::AlbanyTraits>> &fm,
+    const std::string &name, const int ps, const bool explicit_scheme) {
+  if (fm.is_null())
+    return;
+  if (profiler.wasEvaluated<PHAL::AlbanyTraits::Residual>(*fm))
+    profiler.collect<PHAL::AlbanyTraits::Residual>(*fm, name, 0);
+  collectDagProfile<PHAL::AlbanyTraits::Jacobian>(profiler, app, *fm, name, ps,
+                                                  explicit_scheme);
+  collectDagProfile<PHAL::AlbanyTraits::Tangent>(profiler, app, *fm, name, ps,
+                                                 explicit_scheme);
+  collectDagProfile<PHAL::AlbanyTraits::DistParamDeriv>(
+      profiler, app, *fm, name, ps, explicit_scheme);
+}
+} // namespace
+
+void Albany::Application::reportDagProfile() {
+  if (!dagProfiler.enabled())
+    return;
+
+  dagProfiler.clearCollected();
+  for (int ps = 0; ps < fm.size(); ++ps) {
+    const std::string suffix = " " + std::to_string(ps);
+    collectDagProfile(dagProfiler, this, fm[ps], "fm" + suffix, ps,
+                      explicit_scheme);
+    if (ps < nfm.size())
+      collectDagProfile(dagProfiler, this, nfm[ps], "nfm" + suffix, ps,
+                        explicit_scheme);
+    if (ps < sfm.size())
+      collectDagProfile(dagProfiler, this, sfm[ps], "sfm" + suffix, ps,
+                        explicit_scheme);
+  }
+  collectDagProfile(dagProfiler, this, dfm, "dfm", 0, explicit_scheme);
+
+  dagProfiler.report(*out);
+  dagProfiler.write(commT->getRank(), commT->getSize());
+}
+
 RCP<Albany::AbstractDiscretization>
 Albany::Application::getDiscretization() const {
   return disc;
@@ -1349,8 +1545,8 @@ void Albany::Application::computeGlobalResidualImplT(
 #ifdef DEBUG_OUTPUT2
       std::cout << "calling FM evaluate fields in computeGlobalResidualImplT" << std::endl;
 #endif
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Residual>(
-          workset);
+      dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+          *fm[wsPhysIndex[ws]], workset);
       if (nfm != Teuchos::null) {
 #ifdef ALBANY_PERIDIGM
         // DJL this is a hack to avoid running a block with sphere elements
@@ -1364,12 +1560,12 @@ void Albany::Application::computeGlobalResidualImplT(
         // elements, and we want to apply Neumann BC to the standard solid
         // elements.
         if (workset.sideSets->size() != 0) {
-          deref_nfm(nfm, wsPhysIndex, ws)
-              ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+          dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+              *deref_nfm(nfm, wsPhysIndex, ws), workset);
         }
 #else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+            *deref_nfm(nfm, wsPhysIndex, ws), workset);
 #endif
       }
     }
@@ -1378,6 +1574,16 @@ void Albany::Application::computeGlobalResidualImplT(
   // Assemble the residual into a non-overlapping vector
   fT->doExport(*overlapped_fT, *exporterT, Tpetra::ADD);
 
+#ifdef ALBANY_CONTACT
+  // Impose the contact conditions on the assembled equations
+  Teuchos::RCP<const Albany::ContactManager> const contactManager =
+      disc->getContactManager();
+  if (Teuchos::nonnull(contactManager) && contactManager->haveContact()) {
+    contactManager->applyContactConstraints(*xT, current_time, *fT,
+                                            Teuchos::null, 0.0);
+  }
+#endif
+
   // Allocate scaleVec_
 #ifdef ALBANY_MPI
   if (scale != 1.0) {
@@ -1458,7 +1664,7 @@ void Albany::Application::computeGlobalResidualImplT(
 #ifdef DEBUG_OUTPUT2
     std::cout << "calling DFM evaluate fields in computeGlobalResidualImplT" << std::endl;
 #endif
-    dfm->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+    dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(*dfm, workset);
   }
 
   // scale residual by scaleVec_ if scaleBCdofs is on
@@ -1615,6 +1821,22 @@ void Albany::Application::computeGlobalJacobianImplT(
     const Teuchos::RCP<Tpetra_CrsMatrix> &jacT) {
   TEUCHOS_FUNC_TIME_MONITOR("> Albany Fill: Jacobian");
 
+#ifdef ALBANY_CONTACT
+  // The contact active set follows from the residual. Without one, reuse the
+  // active set of the last residual if it was assembled at the same point, as
+  // it is in a Newton step, or else assemble the residual as well.
+  Teuchos::RCP<const Albany::ContactManager> const contactManager =
+      disc->getContactManager();
+  if (Teuchos::nonnull(contactManager) && contactManager->haveContact() &&
+      Teuchos::is_null(fT) &&
+      !contactManager->haveActiveSet(*xT, current_time)) {
+    computeGlobalJacobianImplT(
+        alpha, beta, omega, current_time, xdotT, xdotdotT, xT, p,
+        Teuchos::rcp(new Tpetra_Vector(jacT->getRowMap())), jacT);
+    return;
+  }
+#endif
+
   postRegSetup("Jacobian");
 
   // Load connectivity map and coordinates
@@ -1705,19 +1927,19 @@ void Albany::Application::computeGlobalJacobianImplT(
 #ifdef DEBUG_OUTPUT2
       std::cout << "calling FM evaluate fields in computeGlobalJacobianImplT" << std::endl;
 #endif
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Jacobian>(
-          workset);
+      dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(
+          *fm[wsPhysIndex[ws]], workset);
       if (Teuchos::nonnull(nfm))
 #ifdef ALBANY_PERIDIGM
         // DJL avoid passing a sphere mesh through a nfm that was
         // created for non-sphere topology.
         if (workset.sideSets->size() != 0) {
-          deref_nfm(nfm, wsPhysIndex, ws)
-              ->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+          dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(
+              *deref_nfm(nfm, wsPhysIndex, ws), workset);
         }
 #else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(
+            *deref_nfm(nfm, wsPhysIndex, ws), workset);
 #endif
     }
   }
@@ -1740,6 +1962,17 @@ void Albany::Application::computeGlobalJacobianImplT(
     // Assemble global Jacobian
     jacT->doExport(*overlapped_jacT, *exporterT, Tpetra::ADD);
 
+#ifdef ALBANY_CONTACT
+    // Impose the contact conditions on the assembled equations
+    if (Teuchos::nonnull(contactManager) && contactManager->haveContact()) {
+      if (Teuchos::nonnull(fT))
+        contactManager->applyContactConstraints(*xT, current_time, *fT, jacT,
+                                                beta);
+      else
+        contactManager->applyContactJacobian(jacT, beta);
+    }
+#endif
+
 #ifdef ALBANY_PERIDIGM
 #if defined(ALBANY_EPETRA)
     if (Teuchos::nonnull(LCM::PeridigmManager::self())) {
@@ -1831,7 +2064,7 @@ void Albany::Application::computeGlobalJacobianImplT(
 #ifdef DEBUG_OUTPUT2
     std::cout << "calling DFM evaluate fields in computeGlobalJacobianImplT" << std::endl;
 #endif
-    dfm->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+    dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(*dfm, workset);
   }
   jacT->fillComplete();
 
@@ -1990,19 +2223,19 @@ void Albany::Application::computeGlobalJacobianSDBCsImplT(
 #ifdef DEBUG_OUTPUT2
       std::cout << "calling FM evaluate fields in computeGlobalJacobianSDBCsImplT" << std::endl;
 #endif
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Jacobian>(
-          workset);
+      dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(
+          *fm[wsPhysIndex[ws]], workset);
       if (Teuchos::nonnull(nfm))
 #ifdef ALBANY_PERIDIGM
         // DJL avoid passing a sphere mesh through a nfm that was
         // created for non-sphere topology.
         if (workset.sideSets->size() != 0) {
-          deref_nfm(nfm, wsPhysIndex, ws)
-              ->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+          dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(
+              *deref_nfm(nfm, wsPhysIndex, ws), workset);
         }
 #else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(
+            *deref_nfm(nfm, wsPhysIndex, ws), workset);
 #endif
     }
     prev_times_[app_no] = this_time;
@@ -2067,7 +2300,7 @@ void Albany::Application::computeGlobalJacobianSDBCsImplT(
 #ifdef DEBUG_OUTPUT2
     std::cout << "calling DFM evaluate fields in computeGlobalJacobianSDBCsImplT" << std::endl;
 #endif
-    dfm->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+    dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(*dfm, workset);
     xT_post_SDBCs = Teuchos::rcp(new Tpetra_Vector(*workset.xT));
   }
   jacT->fillComplete();
@@ -2133,19 +2366,19 @@ void Albany::Application::computeGlobalJacobianSDBCsImplT(
 #ifdef DEBUG_OUTPUT2
       std::cout << "calling FM evaluate fields AGAIN in computeGlobalJacobianSDBCsImplT" << std::endl;
 #endif
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Jacobian>(
-          workset);
+      dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(
+          *fm[wsPhysIndex[ws]], workset);
       if (nfm != Teuchos::null) {
 #ifdef ALBANY_PERIDIGM
         // DJL avoid passing a sphere mesh through a nfm that was
         // created for non-sphere topology.
         if (workset.sideSets->size() != 0) {
-          deref_nfm(nfm, wsPhysIndex, ws)
-              ->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+          dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(
+              *deref_nfm(nfm, wsPhysIndex, ws), workset);
         }
 #else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(
+            *deref_nfm(nfm, wsPhysIndex, ws), workset);
 #endif
       }
     }
@@ -2202,7 +2435,7 @@ void Albany::Application::computeGlobalJacobianSDBCsImplT(
 #ifdef DEBUG_OUTPUT2
         std::cout << "calling DFM evaluate fields AGAIN in computeGlobalJacobianSDBCsImplT" << std::endl;
 #endif
-        dfm->evaluateFields<PHAL::AlbanyTraits::Jacobian>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::Jacobian>(*dfm, workset);
       }
     }
     jacT->fillComplete();
@@ -2369,6 +2602,7 @@ void Albany::Application::computeGlobalJacobianT(
       }
     }
   }
+  bool spectrumEstimated = false;
   if (computeJacCondNum != 0) { // If requesting computation of condition number
 #if defined(ALBANY_EPETRA)
     Teuchos::RCP<Epetra_CrsMatrix> jac =
@@ -2388,24 +2622,41 @@ void Albany::Application::computeGlobalJacobianT(
       }
     }
 #else
-    TEUCHOS_TEST_FOR_EXCEPTION(
-        true, std::logic_error,
-        "Error in Albany::Application: Compute Jacobian Condition Number debug "
-        "option "
-            << " currently relies on an Epetra-based routine in AztecOO.  To "
-               "use this option, please "
-            << " rebuild Albany with ENABLE_ALBANY_EPETRA_EXE=ON.  You will "
-               "then be able to have Albany "
-            << " output the Jacobian condition number when running either the "
-               "Albany or AlbanyT executable.\n");
+    // Without Epetra, the Lanczos estimate of the Jacobian spectrum
+    if (computeJacCondNum == -1 || countJac == computeJacCondNum) {
+      estimateJacobianSpectrumT(jacT);
+      spectrumEstimated = true;
+      *out << "Jacobian #" << countJac << " condition number = "
+           << jacSpectrum.condition_number << "\n";
+    }
 #endif
   }
+  // Once per Jacobian, also when the condition number used the estimate
+  if (jacSpectrumFrequency != 0 && countJac % jacSpectrumFrequency == 0 &&
+      !spectrumEstimated) {
+    estimateJacobianSpectrumT(jacT);
+  }
   if (writeToMatrixMarketJac != 0 || writeToCoutJac != 0 ||
-      computeJacCondNum != 0) {
+      computeJacCondNum != 0 || jacSpectrumFrequency != 0) {
     countJac++; // increment Jacobian counter
   }
 }
 
+void Albany::Application::estimateJacobianSpectrumT(
+    const Tpetra_CrsMatrix &jacT) {
+  const SpectrumEstimatorT estimator(jacSpectrumIterations,
+                                     jacSpectrumTolerance);
+  jacSpectrum = estimator.estimate(jacT);
+  *out << "Jacobian #" << countJac
+       << " spectrum estimate: sigma_max = " << jacSpectrum.sigma_max
+       << ", sigma_min = " << jacSpectrum.sigma_min
+       << ", condition number = " << jacSpectrum.condition_number << " ("
+       << jacSpectrum.num_iterations << " Lanczos iterations, "
+       << jacSpectrum.num_matvecs << " products, relative residuals "
+       << jacSpectrum.residual_max << " and " << jacSpectrum.residual_min
+       << ")\n";
+}
+
 void Albany::Application::computeGlobalPreconditionerT(
     const RCP<Tpetra_CrsMatrix> &jac, const RCP<Tpetra_Operator> &prec) {
 //#if defined(ATO_USES_COGENT)
@@ -2475,6 +2726,41 @@ void Albany::Application::computeGlobalTangentImplT(
     const Teuchos::RCP<Tpetra_MultiVector> &fpT) {
   TEUCHOS_FUNC_TIME_MONITOR("> Albany Fill: Tangent");
 
+#if defined(ALBANY_TAN_SLFAD_SIZE)
+  // TanFadType holds ALBANY_TAN_SLFAD_SIZE derivatives: fill more directions
+  // than that in chunks, one fill per chunk. The residual comes with the
+  // first one.
+  {
+    const std::vector<TangentChunk> chunks = tangentChunks(
+        sum_derivs, numTangentColumnsX(VxT.get(), VxdotT.get(), VxdotdotT.get()),
+        numTangentColumnsP(deriv_par, VpT.get()), ALBANY_TAN_SLFAD_SIZE);
+    if (chunks.size() > 1) {
+      for (std::size_t n = 0; n < chunks.size(); ++n) {
+        const TangentChunk &c = chunks[n];
+        ParamVec chunk_par;
+        ParamVec *chunk_deriv_par = NULL;
+        if (c.p_count > 0 && Teuchos::nonnull(VpT)) {
+          chunk_deriv_par = deriv_par;
+        } else if (c.p_count > 0) {
+          chunk_par = subParams(*deriv_par, c.p_begin, c.p_count);
+          chunk_deriv_par = &chunk_par;
+        }
+        computeGlobalTangentImplT(
+            alpha, beta, omega, current_time, sum_derivs, xdotT, xdotdotT, xT,
+            par, chunk_deriv_par, columnsT(VxT.get(), c.x_begin, c.x_count),
+            columnsT(VxdotT.get(), c.x_begin, c.x_count),
+            columnsT(VxdotdotT.get(), c.x_begin, c.x_count),
+            columnsT(VpT.get(), c.p_begin, c.p_count),
+            n == 0 ? fT : Teuchos::null,
+            columnsNonConstT(JVT.get(), c.x_begin, c.x_count),
+            columnsNonConstT(fpT.get(), c.p_begin, c.p_count));
+        resetParams(chunk_deriv_par);
+      }
+      return;
+    }
+  }
+#endif
+
   postRegSetup("Tangent");
 
   // Load connectivity map and coordinates
@@ -2630,10 +2916,11 @@ void Albany::Application::computeGlobalTangentImplT(
 #ifdef DEBUG_OUTPUT2
       std::cout << "calling FM evaluate fields in computeGlobalTangentImplT" << std::endl;
 #endif
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Tangent>(workset);
+      dagProfiler.evaluateFields<PHAL::AlbanyTraits::Tangent>(
+          *fm[wsPhysIndex[ws]], workset);
       if (nfm != Teuchos::null)
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Tangent>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::Tangent>(
+            *deref_nfm(nfm, wsPhysIndex, ws), workset);
     }
 
     // fill Tangent derivative dimensions
@@ -2695,7 +2982,7 @@ void Albany::Application::computeGlobalTangentImplT(
 #ifdef DEBUG_OUTPUT2
     std::cout << "calling DFM evaluate fields in computeGlobalTangentImplT" << std::endl;
 #endif
-    dfm->evaluateFields<PHAL::AlbanyTraits::Tangent>(workset);
+    dagProfiler.evaluateFields<PHAL::AlbanyTraits::Tangent>(*dfm, workset);
   }
 }
 
@@ -2863,7 +3150,8 @@ void Albany::Application::applyGlobalDistParamDerivImplT(
 #ifdef DEBUG_OUTPUT2
     std::cout << "calling DFM evaluate fields in applyGlobalDistParamDerivImplT" << std::endl;
 #endif
-    dfm->evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(workset);
+    dagProfiler.evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(
+        *dfm, workset);
   }
 
   // Import V (after BC's applied) to overlapped distribution
@@ -2901,19 +3189,19 @@ void Albany::Application::applyGlobalDistParamDerivImplT(
 #ifdef DEBUG_OUTPUT2
       std::cout << "calling FM evaluate fields in applyGlobalDistParamDerivImplT" << std::endl;
 #endif
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(
-          workset);
+      dagProfiler.evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(
+          *fm[wsPhysIndex[ws]], workset);
       if (nfm != Teuchos::null)
 #ifdef ALBANY_PERIDIGM
         // DJL avoid passing a sphere mesh through a nfm that was
         // created for non-sphere topology.
         if (workset.sideSets->size() != 0) {
-          deref_nfm(nfm, wsPhysIndex, ws)
-              ->evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(workset);
+          dagProfiler.evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(
+              *deref_nfm(nfm, wsPhysIndex, ws), workset);
         }
 #else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(
+            *deref_nfm(nfm, wsPhysIndex, ws), workset);
 #endif
     }
   }
@@ -2965,7 +3253,8 @@ void Albany::Application::applyGlobalDistParamDerivImplT(
 #ifdef DEBUG_OUTPUT2
     std::cout << "calling DFM evaluate fields AGAIN in applyGlobalDistParamDerivImplT" << std::endl;
 #endif
-    dfm->evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(workset);
+    dagProfiler.evaluateFields<PHAL::AlbanyTraits::DistParamDeriv>(
+        *dfm, workset);
   }
 }
 
@@ -2990,6 +3279,44 @@ void Albany::Application::evaluateResponseTangentT(
     Tpetra_MultiVector *gpT) {
   double const
   this_time = fixTime(current_time);
+#if defined(ALBANY_TAN_SLFAD_SIZE)
+  // In chunks of directions, as in computeGlobalTangentImplT
+  const std::vector<TangentChunk> chunks =
+      tangentChunks(sum_derivs, numTangentColumnsX(VxT, VxdotT, VxdotdotT),
+                    numTangentColumnsP(deriv_p, VpT), ALBANY_TAN_SLFAD_SIZE);
+  if (chunks.size() > 1) {
+    for (std::size_t n = 0; n < chunks.size(); ++n) {
+      const TangentChunk &c = chunks[n];
+      ParamVec chunk_p;
+      ParamVec *chunk_deriv_p = NULL;
+      if (c.p_count > 0 && VpT != NULL) {
+        chunk_deriv_p = deriv_p;
+      } else if (c.p_count > 0) {
+        chunk_p = subParams(*deriv_p, c.p_begin, c.p_count);
+        chunk_deriv_p = &chunk_p;
+      }
+      const RCP<const Tpetra_MultiVector> chunk_VxdotT =
+          columnsT(VxdotT, c.x_begin, c.x_count);
+      const RCP<const Tpetra_MultiVector> chunk_VxdotdotT =
+          columnsT(VxdotdotT, c.x_begin, c.x_count);
+      const RCP<const Tpetra_MultiVector> chunk_VxT =
+          columnsT(VxT, c.x_begin, c.x_count);
+      const RCP<const Tpetra_MultiVector> chunk_VpT =
+          columnsT(VpT, c.p_begin, c.p_count);
+      const RCP<Tpetra_MultiVector> chunk_gxT =
+          columnsNonConstT(gxT, c.x_begin, c.x_count);
+      const RCP<Tpetra_MultiVector> chunk_gpT =
+          columnsNonConstT(gpT, c.p_begin, c.p_count);
+      responses[response_index]->evaluateTangentT(
+          alpha, beta, omega, this_time, sum_derivs, xdotT, xdotdotT, xT, p,
+          chunk_deriv_p, chunk_VxdotT.get(), chunk_VxdotdotT.get(),
+          chunk_VxT.get(), chunk_VpT.get(), n == 0 ? gT : NULL,
+          chunk_gxT.get(), chunk_gpT.get());
+      resetParams(chunk_deriv_p);
+    }
+    return;
+  }
+#endif
   responses[response_index]->evaluateTangentT(
       alpha, beta, omega, this_time, sum_derivs, xdotT, xdotdotT, xT, p,
       deriv_p, VxdotT, VxdotdotT, VxT, VpT, gT, gxT, gpT);
@@ -3098,6 +3425,10 @@ void Albany::Application::evaluateStateFieldManagerT(
 void Albany::Application::evaluateStateFieldManagerT(
     const double current_time, Teuchos::Ptr<const Tpetra_Vector> xdotT,
     Teuchos::Ptr<const Tpetra_Vector> xdotdotT, const Tpetra_Vector &xT) {
+  // The observers evaluate the states on every solution the time integrator
+  // accepts
+  accepted_time_ = current_time;
+
   {
     const std::string eval = "SFM_Jacobian";
     if (setupSet.find(eval) == setupSet.end()) {
@@ -3159,7 +3490,8 @@ void Albany::Application::evaluateStateFieldManagerT(
     rc_mgr->beginEvaluatingSfm();
   for (int ws = 0; ws < numWorksets; ws++) {
     loadWorksetBucketInfo<PHAL::AlbanyTraits::Residual>(workset, ws);
-    sfm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+    dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+        *sfm[wsPhysIndex[ws]], workset);
   }
   if (Teuchos::nonnull(rc_mgr))
     rc_mgr->endEvaluatingSfm();
@@ -3444,6 +3776,7 @@ void Albany::Application::loadBasicWorksetInfo(PHAL::Workset &workset,
   workset.xdot = solMgr->get_overlapped_xdot();
   workset.xdotdot = solMgr->get_overlapped_xdotdot();
   workset.current_time = current_time;
+  workset.previous_time = accepted_time_;
   workset.distParamLib = distParamLib;
   workset.disc = disc;
   // workset.delta_time = delta_time;
@@ -3472,6 +3805,7 @@ void Albany::Application::loadBasicWorksetInfoT(PHAL::Workset &workset,
                          ? overlapped_MV->getVectorNonConst(2)
                          : Teuchos::null;
   workset.current_time = current_time;
+  workset.previous_time = accepted_time_;
   workset.distParamLib = distParamLib;
   workset.disc = disc;
   // workset.delta_time = delta_time;
@@ -3502,6 +3836,7 @@ void Albany::Application::loadBasicWorksetInfoSDBCsT(
                          ? overlapped_MV->getVectorNonConst(2)
                          : Teuchos::null;
   workset.current_time = current_time;
+  workset.previous_time = accepted_time_;
   workset.distParamLib = distParamLib;
   workset.disc = disc;
   // workset.delta_time = delta_time;
@@ -4128,8 +4463,8 @@ void Albany::Application::computeGlobalResidualSDBCsImplT(
 #ifdef DEBUG_OUTPUT2
       std::cout << "calling FM evaluate fields in computeGlobalResidualSDBCsImplT" << std::endl;
 #endif
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Residual>(
-          workset);
+      dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+          *fm[wsPhysIndex[ws]], workset);
       if (nfm != Teuchos::null) {
 #ifdef ALBANY_PERIDIGM
         // DJL this is a hack to avoid running a block with sphere elements
@@ -4143,12 +4478,12 @@ void Albany::Application::computeGlobalResidualSDBCsImplT(
         // elements, and we want to apply Neumann BC to the standard solid
         // elements.
         if (workset.sideSets->size() != 0) {
-          deref_nfm(nfm, wsPhysIndex, ws)
-              ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+          dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+              *deref_nfm(nfm, wsPhysIndex, ws), workset);
         }
 #else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+            *deref_nfm(nfm, wsPhysIndex, ws), workset);
 #endif
       }
     }
@@ -4198,7 +4533,7 @@ void Albany::Application::computeGlobalResidualSDBCsImplT(
 #ifdef DEBUG_OUTPUT2
     std::cout << "calling DFM evaluate fields in computeGlobalResidualSDBCsImplT" << std::endl;
 #endif
-    dfm->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+    dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(*dfm, workset);
     xT_post_SDBCs = Teuchos::rcp(new Tpetra_Vector(*workset.xT));
   }
 
@@ -4233,8 +4568,8 @@ void Albany::Application::computeGlobalResidualSDBCsImplT(
 #ifdef DEBUG_OUTPUT2
       std::cout << "calling FM evaluate fields AGAIN in computeGlobalResidualSDBCsImplT" << std::endl;
 #endif
-      fm[wsPhysIndex[ws]]->evaluateFields<PHAL::AlbanyTraits::Residual>(
-          workset);
+      dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+          *fm[wsPhysIndex[ws]], workset);
       if (nfm != Teuchos::null) {
 #ifdef ALBANY_PERIDIGM
         // DJL this is a hack to avoid running a block with sphere elements
@@ -4248,12 +4583,12 @@ void Albany::Application::computeGlobalResidualSDBCsImplT(
         // elements, and we want to apply Neumann BC to the standard solid
         // elements.
         if (workset.sideSets->size() != 0) {
-          deref_nfm(nfm, wsPhysIndex, ws)
-              ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+          dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+              *deref_nfm(nfm, wsPhysIndex, ws), workset);
         }
 #else
-        deref_nfm(nfm, wsPhysIndex, ws)
-            ->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(
+            *deref_nfm(nfm, wsPhysIndex, ws), workset);
 #endif
       }
     }
@@ -4297,7 +4632,7 @@ void Albany::Application::computeGlobalResidualSDBCsImplT(
 #ifdef DEBUG_OUTPUT2
         std::cout << "calling DFM evaluate fields AGAIN in computeGlobalResidualSDBCsImplT" << std::endl;
 #endif
-        dfm->evaluateFields<PHAL::AlbanyTraits::Residual>(workset);
+        dagProfiler.evaluateFields<PHAL::AlbanyTraits::Residual>(*dfm, workset);
       }
     }
   } // endif (begin_time_step == true)
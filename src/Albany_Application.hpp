@@ -25,6 +25,8 @@
 #include "Albany_AbstractDiscretization.hpp"
 #include "Albany_AbstractProblem.hpp"
 #include "Albany_AbstractResponseFunction.hpp"
+#include "Albany_Checkpoint.hpp"
+#include "Albany_SpectrumEstimatorT.hpp"
 #include "Albany_StateManager.hpp"
 
 #if defined(ALBANY_EPETRA)
@@ -40,7 +42,9 @@
 #include "Sacado_ScalarParameterVector.hpp"
 
 #include "PHAL_AlbanyTraits.hpp"
+#include "PHAL_DagProfiler.hpp"
 #include "PHAL_Workset.hpp"
+#include <limits>
 #include <set>
 
 #if defined(ALBANY_EPETRA)
@@ -163,6 +167,9 @@ public:
     return solMgrT;
   }
 
+  //! Get the checkpoint writer, null without a "Checkpoint" list
+  Teuchos::RCP<Albany::Checkpoint> getCheckpoint() { return checkpoint_; }
+
   //! Get parameter library
   Teuchos::RCP<ParamLib> getParamLib() const;
 
@@ -181,6 +188,12 @@ public:
 
   Teuchos::RCP<Albany::AbstractDiscretization> getDisc() const { return disc; }
 
+  //! Last estimate of the Jacobian spectrum, see "Jacobian Spectrum
+  //! Estimate Frequency" in the Debug Output list
+  const SpectrumEstimateT &getJacobianSpectrumEstimate() const {
+    return jacSpectrum;
+  }
+
   //! Get response function
   Teuchos::RCP<AbstractResponseFunction> getResponse(int i) const;
 
@@ -602,6 +615,17 @@ public:
            coupled_app_index_block_nodeset_names_map_.end();
   }
 
+  // Local DOFs whose Jacobian rows the Schwarz BC coupled to app_index
+  // replaced in the last Jacobian fill.
+  void setSchwarzDOFs(int const app_index, std::set<LO> const &dofs) {
+    schwarz_dofs_[app_index] = dofs;
+  }
+
+  std::set<LO> getSchwarzDOFs(int const app_index) const {
+    auto it = schwarz_dofs_.find(app_index);
+    return it == schwarz_dofs_.end() ? std::set<LO>() : it->second;
+  }
+
   // Few coupled applications, so do this by brute force.
   std::string getAppName(int app_index = -1) const {
     if (app_index == -1)
@@ -626,6 +650,15 @@ public:
   Teuchos::RCP<Tpetra_Vector const> const &
   getX() const { return x_; }
 
+  // Solution seen by coupled applications through the Schwarz BCs.
+  // For additive Schwarz it is frozen at the start of each sweep so that
+  // all subdomains use boundary data from the same iterate.
+  Teuchos::RCP<Tpetra_Vector const> const &
+  getCoupledX() const { return frozen_x_.is_null() ? x_ : frozen_x_; }
+
+  void
+  setFrozenX(Teuchos::RCP<Tpetra_Vector const> const &fx) { frozen_x_ = fx; }
+
   Teuchos::RCP<Tpetra_Vector const> const &
   getXdot() const { return xdot_; }
 
@@ -638,6 +671,11 @@ public:
   bool
   getSchwarzAlternating() const {return is_schwarz_alternating_;}
 
+  //! If "Profile Phalanx DAG" is set, collect, print and write the DAG
+  //! profile accumulated so far. Called by the drivers at the end of the
+  //! solve; a later call replaces the earlier report.
+  void reportDagProfile();
+
 private:
   Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> apps_;
 
@@ -648,8 +686,12 @@ private:
   std::map<int, std::pair<std::string, std::string>>
       coupled_app_index_block_nodeset_names_map_;
 
+  std::map<int, std::set<LO>> schwarz_dofs_;
+
   Teuchos::RCP<Tpetra_Vector const> x_{Teuchos::null};
 
+  Teuchos::RCP<Tpetra_Vector const> frozen_x_{Teuchos::null};
+
   Teuchos::RCP<Tpetra_Vector const> xdot_{Teuchos::null};
 
   Teuchos::RCP<Tpetra_Vector const> xdotdot_{Teuchos::null};
@@ -714,6 +756,14 @@ protected:
   //! Solution memory manager
   Teuchos::RCP<AAdapt::AdaptiveSolutionManagerT> solMgrT;
 
+  //! Checkpoints of the solver state
+  Teuchos::RCP<Albany::Checkpoint> checkpoint_;
+
+  //! Time of the last solution the time integrator accepted, i.e. the start
+  //! of its current step, as seen by the observer; handed to the evaluators
+  //! as PHAL::Workset::previous_time
+  double accepted_time_{-std::numeric_limits<double>::infinity()};
+
   //! Reference configuration (update) manager
   Teuchos::RCP<AAdapt::rc::Manager> rc_mgr;
 
@@ -758,6 +808,12 @@ protected:
   int writeToMatrixMarketJac;
   int writeToMatrixMarketRes;
   int computeJacCondNum;
+  //! Estimate the spectrum of every N^th Jacobian (0: never) with a few
+  //! Lanczos iterations, see SpectrumEstimatorT
+  int jacSpectrumFrequency;
+  int jacSpectrumIterations;
+  double jacSpectrumTolerance;
+  SpectrumEstimateT jacSpectrum;
   //! Integer specifying whether user wants to write Jacobian and residual to
   //! Standard output (cout)
   int writeToCoutJac;
@@ -809,6 +865,12 @@ protected:
 
   int derivatives_check_;
 
+  //! Per evaluator profile of the field managers, see PHAL::DagProfiler
+  PHAL::DagProfiler dagProfiler;
+
+  //! Estimate the spectrum of jacT into jacSpectrum and log it
+  void estimateJacobianSpectrumT(const Tpetra_CrsMatrix &jacT);
+
   int num_time_deriv;
 
   // The following are for Jacobian/residual scaling
@@ -0,0 +1,562 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_Checkpoint.hpp"
+
+#include <sys/stat.h>  // for mkdir
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+
+#include "Teuchos_CommHelpers.hpp"
+#include "Teuchos_TestForException.hpp"
+#include "Teuchos_VerboseObject.hpp"
+
+namespace {
+
+char const* const magic = "Albany checkpoint 1";
+
+// FNV-1a over the bytes of the record
+std::uint64_t
+hash(std::vector<double> const& data)
+{
+  std::uint64_t     h     = 14695981039346656037ULL;
+  auto const*       bytes = reinterpret_cast<unsigned char const*>(data.data());
+  std::size_t const n     = data.size() * sizeof(double);
+  for (std::size_t i = 0; i < n; ++i) {
+    h ^= bytes[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// Hexadecimal floating point, read back exactly by strtod
+std::string
+exact(double const value)
+{
+  char buf[64];
+  std::snprintf(buf, sizeof(buf), "%a", value);
+  return buf;
+}
+
+std::vector<double>
+copyVector(Tpetra_Vector const& v)
+{
+  Teuchos::ArrayRCP<ST const> const data = v.getData();
+  return std::vector<double>(data.begin(), data.end());
+}
+
+void
+copyToVector(std::vector<double> const& data, Tpetra_Vector& v,
+             std::string const& name)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      data.size() != v.getLocalLength(), std::logic_error,
+      "Checkpoint: size of " << name << " is " << data.size()
+      << ", the current map has " << v.getLocalLength() << " entries.\n");
+  Teuchos::ArrayRCP<ST> const values = v.getDataNonConst();
+  for (std::size_t i = 0; i < data.size(); ++i) values[i] = data[i];
+}
+
+// Records of all state arrays, keyed "elem <ws> <name>" or "node <ws> <name>"
+template <typename F>
+void
+forEachState(Albany::StateArrays& sa, F f)
+{
+  for (std::size_t ws = 0; ws < sa.elemStateArrays.size(); ++ws) {
+    for (auto& s : sa.elemStateArrays[ws]) {
+      f("elem " + std::to_string(ws) + " " + s.first, s.second);
+    }
+  }
+  for (std::size_t ws = 0; ws < sa.nodeStateArrays.size(); ++ws) {
+    for (auto& s : sa.nodeStateArrays[ws]) {
+      f("node " + std::to_string(ws) + " " + s.first, s.second);
+    }
+  }
+}
+
+}  // namespace
+
+namespace Albany {
+
+Checkpoint::Checkpoint(
+    const Teuchos::RCP<Teuchos::ParameterList>& params,
+    const Teuchos::RCP<const Teuchos_Comm>&     comm)
+    : params_(params),
+      comm_(comm),
+      rank_(comm->getRank()),
+      number_(0),
+      num_observed_(0),
+      step_(0),
+      restart_step_(0),
+      time_(0.0),
+      last_time_(0.0),
+      adaptation_step_(0),
+      restarting_(false)
+{
+  params_->validateParametersAndSetDefaults(*getValidCheckpointParameters());
+  directory_ = params_->get<std::string>("Directory");
+  interval_  = params_->get<int>("Write Interval");
+  keep_      = params_->get<int>("Keep");
+
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      interval_ < 0, std::logic_error,
+      "Checkpoint: Write Interval must be non-negative.\n");
+  // The last checkpoint may be incomplete on some rank, keep the one before
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      keep_ < 2, std::logic_error, "Checkpoint: Keep must be at least 2.\n");
+
+  if (interval_ > 0) {
+    int const err = mkdir(directory_.c_str(), 0755);
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        err != 0 && errno != EEXIST, std::runtime_error,
+        "Checkpoint: cannot create directory " << directory_ << ".\n");
+  }
+
+  if (params_->get<bool>("Restart") == false) return;
+
+  int           latest = 0;
+  std::ifstream is(path("latest." + std::to_string(rank_)).c_str());
+  if (is) is >> latest;
+  // Checkpoint n is complete on all ranks if every rank has written it
+  int global_latest = 0;
+  Teuchos::reduceAll(
+      *comm_, Teuchos::REDUCE_MIN, latest, Teuchos::ptr(&global_latest));
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      global_latest <= 0, std::runtime_error,
+      "Checkpoint: no complete checkpoint in " << directory_ << ".\n");
+
+  // A checkpoint that does not read back on some rank, e.g. a data file
+  // whose hash does not match, is skipped for the one before it
+  for (int number = global_latest; number > 0; --number) {
+    std::string error;
+    try {
+      read(number);
+    } catch (std::exception const& e) {
+      error = e.what();
+    }
+    int const local_ok  = error.empty() ? 1 : 0;
+    int       global_ok = 0;
+    Teuchos::reduceAll(
+        *comm_, Teuchos::REDUCE_MIN, local_ok, Teuchos::ptr(&global_ok));
+    if (global_ok == 1) break;
+
+    Teuchos::RCP<Teuchos::FancyOStream> const out =
+        Teuchos::VerboseObjectBase::getDefaultOStream();
+    if (error.empty() == false) {
+      *out << "Checkpoint: rank " << rank_ << ": " << error;
+    }
+    if (rank_ == 0) {
+      *out << "Checkpoint: checkpoint " << number
+           << " is not readable on all ranks, trying checkpoint "
+           << number - 1 << "\n";
+    }
+    reset();
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      restarting_ == false, std::runtime_error,
+      "Checkpoint: no readable checkpoint in " << directory_ << ".\n");
+}
+
+Checkpoint::~Checkpoint()
+{
+  if (writer_.joinable()) writer_.join();
+}
+
+Teuchos::RCP<const Teuchos::ParameterList>
+Checkpoint::getValidCheckpointParameters()
+{
+  Teuchos::RCP<Teuchos::ParameterList> validPL =
+      Teuchos::rcp(new Teuchos::ParameterList("Valid Checkpoint Params"));
+  validPL->set<std::string>(
+      "Directory", "checkpoint", "Local directory of the checkpoint files");
+  validPL->set<int>(
+      "Write Interval", 0,
+      "Write a checkpoint every this many observed solutions, 0 for never");
+  validPL->set<int>("Keep", 2, "Number of checkpoints kept, at least 2");
+  validPL->set<bool>(
+      "Restart", false, "Restart from the last complete checkpoint");
+  return validPL;
+}
+
+void
+Checkpoint::setVector(
+    const std::string& name, const Teuchos::RCP<const Tpetra_Vector>& v)
+{
+  vectors_[name] = v;
+}
+
+void
+Checkpoint::setScalar(const std::string& name, const double value)
+{
+  scalars_[name] = value;
+}
+
+void
+Checkpoint::unset(const std::string& prefix)
+{
+  auto const starts = [&prefix](std::string const& name) {
+    return name.compare(0, prefix.size(), prefix) == 0;
+  };
+  for (auto v = vectors_.begin(); v != vectors_.end();) {
+    v = starts(v->first) ? vectors_.erase(v) : std::next(v);
+  }
+  for (auto s = scalars_.begin(); s != scalars_.end();) {
+    s = starts(s->first) ? scalars_.erase(s) : std::next(s);
+  }
+}
+
+void
+Checkpoint::addSaver(const std::function<void(Checkpoint&)>& saver)
+{
+  savers_.push_back(saver);
+}
+
+void
+Checkpoint::observe(
+    const double         time,
+    const Tpetra_Vector& x,
+    const Tpetra_Vector* xdot,
+    const Tpetra_Vector* xdotdot,
+    const StateManager&  stateMgr,
+    const int            adaptation_step)
+{
+  int const index = num_observed_++;
+  if (index > 0) setScalar("Observed Time Step", time - last_time_);
+  last_time_ = time;
+  step_      = index;
+
+  if (interval_ == 0 || index == 0 || index % interval_ != 0) return;
+  // After a restart the integrator observes the restored solution again
+  if (restarting_ && index == restart_step_) return;
+
+  write(time, x, xdot, xdotdot, stateMgr, adaptation_step);
+}
+
+void
+Checkpoint::write(
+    const double         time,
+    const Tpetra_Vector& x,
+    const Tpetra_Vector* xdot,
+    const Tpetra_Vector* xdotdot,
+    const StateManager&  stateMgr,
+    const int            adaptation_step)
+{
+  for (auto const& saver : savers_) saver(*this);
+
+  // Copy now, the solver changes the data while the writer runs
+  auto records = std::make_shared<std::vector<Record>>();
+  records->push_back(Record{"x", copyVector(x)});
+  if (xdot != nullptr) records->push_back(Record{"xdot", copyVector(*xdot)});
+  if (xdotdot != nullptr) {
+    records->push_back(Record{"xdotdot", copyVector(*xdotdot)});
+  }
+  for (auto const& v : vectors_) {
+    records->push_back(Record{"vector " + v.first, copyVector(*v.second)});
+  }
+  forEachState(
+      stateMgr.getStateArrays(),
+      [&records](std::string const& name, MDArray const& a) {
+        double const* data = a.contiguous_data();
+        records->push_back(
+            Record{name, std::vector<double>(data, data + a.size())});
+      });
+  auto scalars = std::make_shared<std::map<std::string, double>>(scalars_);
+
+  // Newest checkpoint complete on all ranks. A restart may need it, so the
+  // writer must not prune it, whatever Keep says. The reduction happens here,
+  // on the calling thread, before a failed write is reported.
+  if (writer_.joinable()) writer_.join();
+  int const local_complete  = write_error_.empty() ? number_ : number_ - 1;
+  int       global_complete = 0;
+  Teuchos::reduceAll(
+      *comm_, Teuchos::REDUCE_MIN, local_complete,
+      Teuchos::ptr(&global_complete));
+  wait();
+
+  int const number = ++number_;
+  int const step   = step_;
+  writer_ = std::thread([this, number, global_complete, records, scalars,
+                         time, step, adaptation_step]() {
+    try {
+      writeFiles(
+          number, global_complete, *records, *scalars, time, step,
+          adaptation_step);
+    } catch (std::exception const& e) {
+      write_error_ = e.what();
+    }
+  });
+}
+
+void
+Checkpoint::wait()
+{
+  if (writer_.joinable()) writer_.join();
+  std::string const error = write_error_;
+  write_error_.clear();
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      error.empty() == false, std::runtime_error,
+      "Checkpoint: writing failed: " << error << "\n");
+}
+
+void
+Checkpoint::writeFiles(
+    const int                            number,
+    const int                            global_complete,
+    const std::vector<Record>&           records,
+    const std::map<std::string, double>& scalars,
+    const double                         time,
+    const int                            step,
+    const int                            adaptation_step)
+{
+  std::string const rank = std::to_string(rank_);
+  std::ostringstream manifest;
+  manifest << magic << "\n";
+  manifest << "time " << exact(time) << "\n";
+  manifest << "step " << step << "\n";
+  manifest << "adaptation " << adaptation_step << "\n";
+  for (auto const& s : scalars) {
+    manifest << "scalar " << exact(s.second) << " " << s.first << "\n";
+  }
+
+  for (std::size_t k = 0; k < records.size(); ++k) {
+    Record const&       r = records[k];
+    std::uint64_t const h = hash(r.data);
+    auto                w = last_written_.find(r.name);
+    if (w == last_written_.end() || w->second.count != r.data.size() ||
+        w->second.hash != h) {
+      FileInfo info;
+      info.file = "data." + std::to_string(number) + "." + std::to_string(k) +
+                  "." + rank;
+      info.count = r.data.size();
+      info.hash  = h;
+      std::ofstream os(path(info.file).c_str(), std::ios::binary);
+      os.write(
+          reinterpret_cast<char const*>(r.data.data()),
+          r.data.size() * sizeof(double));
+      TEUCHOS_TEST_FOR_EXCEPTION(
+          !os, std::runtime_error, "cannot write " << path(info.file));
+      last_written_[r.name] = info;
+    }
+    FileInfo const& info = last_written_[r.name];
+    file_last_use_[info.file] = number;
+    manifest << "blob " << info.file << " " << info.count << " " << info.hash
+             << " " << r.name << "\n";
+  }
+
+  // The manifest and the pointer to it are replaced atomically
+  std::string const name = "checkpoint." + std::to_string(number) + "." + rank;
+  {
+    std::ofstream os(path(name + ".tmp").c_str());
+    os << manifest.str();
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        !os, std::runtime_error, "cannot write " << path(name));
+  }
+  std::rename(path(name + ".tmp").c_str(), path(name).c_str());
+  {
+    std::ofstream os(path("latest." + rank + ".tmp").c_str());
+    os << number << "\n";
+  }
+  std::rename(
+      path("latest." + rank + ".tmp").c_str(), path("latest." + rank).c_str());
+
+  // Drop the checkpoints beyond Keep and the files only they use, but never
+  // the newest one that all ranks have completed
+  int const oldest = std::min(number - keep_ + 1, global_complete);
+  for (int n = oldest - 1; n > 0; --n) {
+    if (std::remove(
+            path("checkpoint." + std::to_string(n) + "." + rank).c_str()) != 0)
+      break;
+  }
+  for (auto f = file_last_use_.begin(); f != file_last_use_.end();) {
+    if (f->second < oldest) {
+      std::remove(path(f->first).c_str());
+      f = file_last_use_.erase(f);
+    } else {
+      ++f;
+    }
+  }
+}
+
+void
+Checkpoint::read(const int number)
+{
+  std::string const rank = std::to_string(rank_);
+  std::string const name =
+      path("checkpoint." + std::to_string(number) + "." + rank);
+  std::ifstream is(name.c_str());
+  std::string   line;
+  std::getline(is, line);
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      !is || line != magic, std::runtime_error,
+      "Checkpoint: " << name << " is not a checkpoint.\n");
+
+  while (std::getline(is, line)) {
+    std::istringstream ls(line);
+    std::string        key;
+    ls >> key;
+    if (key == "time" || key == "scalar") {
+      std::string value;
+      ls >> value;
+      double const v = std::strtod(value.c_str(), nullptr);
+      if (key == "time") {
+        time_ = v;
+      } else {
+        std::string s;
+        std::getline(ls >> std::ws, s);
+        scalars_[s] = v;
+      }
+    } else if (key == "step") {
+      ls >> step_;
+    } else if (key == "adaptation") {
+      ls >> adaptation_step_;
+    } else if (key == "blob") {
+      FileInfo    info;
+      std::string record;
+      ls >> info.file >> info.count >> info.hash;
+      std::getline(ls >> std::ws, record);
+      std::vector<double> data(info.count);
+      std::ifstream       bs(path(info.file).c_str(), std::ios::binary);
+      bs.read(reinterpret_cast<char*>(data.data()), info.count * sizeof(double));
+      TEUCHOS_TEST_FOR_EXCEPTION(
+          !bs || hash(data) != info.hash, std::runtime_error,
+          "Checkpoint: " << path(info.file) << " is missing or corrupt.\n");
+      restored_[record] = std::move(data);
+      // Later checkpoints continue the incremental writes from this one
+      last_written_[record]     = info;
+      file_last_use_[info.file] = number;
+    }
+  }
+
+  number_       = number;
+  restart_step_ = step_;
+  num_observed_ = step_;
+  last_time_    = time_;
+  restarting_   = true;
+}
+
+void
+Checkpoint::reset()
+{
+  restored_.clear();
+  scalars_.clear();
+  last_written_.clear();
+  file_last_use_.clear();
+  number_          = 0;
+  step_            = 0;
+  restart_step_    = 0;
+  num_observed_    = 0;
+  time_            = 0.0;
+  last_time_       = 0.0;
+  adaptation_step_ = 0;
+  restarting_      = false;
+}
+
+bool
+Checkpoint::getVector(const std::string& name, Tpetra_Vector& v) const
+{
+  auto const r = restored_.find("vector " + name);
+  if (r == restored_.end()) return false;
+  copyToVector(r->second, v, name);
+  return true;
+}
+
+bool
+Checkpoint::getScalar(const std::string& name, double& value) const
+{
+  auto const s = scalars_.find(name);
+  if (s == scalars_.end()) return false;
+  value = s->second;
+  return true;
+}
+
+void
+Checkpoint::restoreSolution(Tpetra_MultiVector& soln) const
+{
+  char const* const names[] = {"x", "xdot", "xdotdot"};
+  for (std::size_t i = 0; i < soln.getNumVectors() && i < 3; ++i) {
+    auto const r = restored_.find(names[i]);
+    if (r == restored_.end()) continue;
+    copyToVector(r->second, *soln.getVectorNonConst(i), names[i]);
+  }
+}
+
+void
+Checkpoint::restoreStates(StateManager& stateMgr) const
+{
+  forEachState(
+      stateMgr.getStateArrays(),
+      [this](std::string const& name, MDArray& a) {
+        auto const r = restored_.find(name);
+        TEUCHOS_TEST_FOR_EXCEPTION(
+            r == restored_.end() || r->second.size() != a.size(),
+            std::logic_error,
+            "Checkpoint: state " << name
+            << " is missing or has a different size.\n");
+        std::copy(r->second.begin(), r->second.end(), a.contiguous_data());
+      });
+}
+
+void
+Checkpoint::adjustIntegratorParameters(Teuchos::ParameterList& piroParams) const
+{
+  if (piroParams.isSublist("Tempus")) {
+    Teuchos::ParameterList& tempus = piroParams.sublist("Tempus");
+    std::string const integrator =
+        tempus.get<std::string>("Integrator Name", "Tempus Integrator");
+    Teuchos::ParameterList& control =
+        tempus.sublist(integrator).sublist("Time Step Control");
+    control.set("Initial Time", time_);
+    control.set("Initial Time Index", restart_step_);
+    double dt = 0.0;
+    if (getScalar("Observed Time Step", dt)) {
+      control.set("Initial Time Step", dt);
+    }
+  }
+
+  // Continuation of Piro: the parameter plays the role of the time. The
+  // predictor starts again with its First Step Predictor.
+  if (piroParams.isSublist("LOCA")) {
+    Teuchos::ParameterList& loca = piroParams.sublist("LOCA");
+    Teuchos::ParameterList& stepper = loca.sublist("Stepper");
+    if (stepper.isParameter("Initial Value")) {
+      stepper.set("Initial Value", time_);
+      int const max_steps = stepper.get<int>("Max Steps", 100);
+      stepper.set("Max Steps", std::max(max_steps - restart_step_, 0));
+      double dp = 0.0;
+      if (getScalar("Observed Time Step", dp)) {
+        loca.sublist("Step Size").set("Initial Step Size", dp);
+      }
+    }
+  }
+
+  // Fixed step integrators of Piro: same step, fewer of them
+  char const* const fixed[] = {"Trapezoid Rule", "Velocity Verlet", "Newmark"};
+  for (char const* name : fixed) {
+    if (piroParams.isSublist(name) == false) continue;
+    Teuchos::ParameterList& p  = piroParams.sublist(name);
+    double const            t0 = p.get<double>("Initial Time", 0.0);
+    double const            tf = p.get<double>("Final Time", 0.1);
+    int const               n  = p.get<int>("Num Time Steps", 10);
+    double const            dt = (tf - t0) / n;
+    p.set("Initial Time", time_);
+    p.set("Num Time Steps", static_cast<int>(std::lround((tf - time_) / dt)));
+  }
+}
+
+std::string
+Checkpoint::path(const std::string& file) const
+{
+  return directory_ + "/" + file;
+}
+
+}  // namespace Albany
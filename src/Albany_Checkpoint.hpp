@@ -0,0 +1,226 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_CHECKPOINT_HPP
+#define ALBANY_CHECKPOINT_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Albany_DataTypes.hpp"
+#include "Albany_StateManager.hpp"
+
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_RCP.hpp"
+
+namespace Albany {
+
+/*!
+ * \brief Checkpoints of the solver state for exact restart
+ *
+ * Enable it in the top level "Checkpoint" list:
+ *
+ *   Directory          Local directory of the files, default "checkpoint".
+ *   Write Interval     Write every this many observed solutions; 0 (default)
+ *                      never writes.
+ *   Keep               Number of checkpoints kept on disk, at least 2.
+ *   Restart            Restore the last complete checkpoint of Directory.
+ *
+ * A checkpoint holds, bit for bit, the time and step count, the solution
+ * and its time derivatives, every element and nodal state array of the
+ * StateManager (the old states included), the adaptation step, and the
+ * vectors and scalars that a time integrator registers with setVector()
+ * and setScalar() (e.g. the lumped mass of the explicit solver).
+ *
+ * The data are copied on the calling thread and written to disk by a
+ * background thread, one checkpoint at a time; the next write, or the
+ * destructor, waits for the previous one. Writes are incremental: a
+ * record whose content did not change since the last checkpoint is not
+ * written again, the new manifest points to the existing file.
+ *
+ * Every rank writes its own files: "checkpoint.<n>.<rank>" is the manifest
+ * of checkpoint n, "latest.<rank>" names the last complete one. A restart
+ * uses the newest checkpoint complete on all ranks. Before each write the
+ * ranks agree on that checkpoint, and no rank prunes it or a newer one.
+ *
+ * A checkpoint that does not read back on every rank, e.g. because a data
+ * file is missing or its hash does not match, is skipped for the previous
+ * one, down to the oldest kept.
+ *
+ * On restart Application restores the solution, states and adaptation step,
+ * and moves the start of the Tempus, LOCA continuation and fixed step Piro
+ * integrators to the checkpoint time. Integrators with more state register
+ * it with addSaver() and query it through restarting(), getVector() and
+ * getScalar(): the explicit solver its lumped mass, the AlbanyTempus driver
+ * the solution history of its integrator, with the step sizes, orders,
+ * errors and nonlinear solver failure counts of the states.
+ */
+class Checkpoint
+{
+ public:
+  Checkpoint(
+      const Teuchos::RCP<Teuchos::ParameterList>& params,
+      const Teuchos::RCP<const Teuchos_Comm>&     comm);
+
+  //! Waits for the pending write
+  ~Checkpoint();
+
+  static Teuchos::RCP<const Teuchos::ParameterList>
+  getValidCheckpointParameters();
+
+  //! Record data of the time integrator, saved with every checkpoint
+  void
+  setVector(const std::string& name, const Teuchos::RCP<const Tpetra_Vector>& v);
+  void
+  setScalar(const std::string& name, const double value);
+
+  //! Forget the vectors and scalars whose name starts with prefix
+  void
+  unset(const std::string& prefix);
+
+  //! Called at the start of every write, to record the data of the time
+  //! integrator that are not fixed at setup, e.g. its solution history
+  void
+  addSaver(const std::function<void(Checkpoint&)>& saver);
+
+  //! Called after each accepted solution; writes every Write Interval calls
+  void
+  observe(
+      const double         time,
+      const Tpetra_Vector& x,
+      const Tpetra_Vector* xdot,
+      const Tpetra_Vector* xdotdot,
+      const StateManager&  stateMgr,
+      const int            adaptation_step);
+
+  //! Write a checkpoint now, in the background
+  void
+  write(
+      const double         time,
+      const Tpetra_Vector& x,
+      const Tpetra_Vector* xdot,
+      const Tpetra_Vector* xdotdot,
+      const StateManager&  stateMgr,
+      const int            adaptation_step);
+
+  //! Wait for the background write
+  void
+  wait();
+
+  //! True if a checkpoint was read at construction
+  bool
+  restarting() const
+  {
+    return restarting_;
+  }
+
+  double
+  restartTime() const
+  {
+    return time_;
+  }
+
+  int
+  restartStep() const
+  {
+    return restart_step_;
+  }
+
+  int
+  restartAdaptationStep() const
+  {
+    return adaptation_step_;
+  }
+
+  //! Restored vector or scalar; false if the checkpoint does not have it
+  bool
+  getVector(const std::string& name, Tpetra_Vector& v) const;
+  bool
+  getScalar(const std::string& name, double& value) const;
+
+  //! Copy the restored solution and time derivatives into the columns of soln
+  void
+  restoreSolution(Tpetra_MultiVector& soln) const;
+
+  //! Copy the restored state arrays into those of stateMgr
+  void
+  restoreStates(StateManager& stateMgr) const;
+
+  //! Start the Piro time integrators at the restored time
+  void
+  adjustIntegratorParameters(Teuchos::ParameterList& piroParams) const;
+
+ private:
+  struct Record
+  {
+    std::string         name;
+    std::vector<double> data;
+  };
+
+  struct FileInfo
+  {
+    std::string   file;
+    std::size_t   count;
+    std::uint64_t hash;
+  };
+
+  void
+  writeFiles(
+      const int                            number,
+      const int                            global_complete,
+      const std::vector<Record>&           records,
+      const std::map<std::string, double>& scalars,
+      const double                         time,
+      const int                            step,
+      const int                            adaptation_step);
+
+  void
+  read(const int number);
+
+  //! Forget what a failed read() restored
+  void
+  reset();
+
+  std::string
+  path(const std::string& file) const;
+
+  Teuchos::RCP<Teuchos::ParameterList> params_;
+  Teuchos::RCP<const Teuchos_Comm>     comm_;
+  std::string                          directory_;
+  int                                  rank_;
+  int                                  interval_;
+  int                                  keep_;
+
+  int    number_;           //!< number of the last checkpoint written or read
+  int    num_observed_;
+  int    step_;             //!< index of the last observed solution
+  int    restart_step_;
+  double time_;             //!< time of the restored checkpoint
+  double last_time_;
+  int    adaptation_step_;
+  bool   restarting_;
+
+  std::map<std::string, Teuchos::RCP<const Tpetra_Vector>> vectors_;
+  std::map<std::string, double>                            scalars_;
+  std::vector<std::function<void(Checkpoint&)>>            savers_;
+
+  //! Restored records, by name
+  std::map<std::string, std::vector<double>> restored_;
+
+  //! Background writer and the data only it touches
+  std::thread                     writer_;
+  std::string                     write_error_;
+  std::map<std::string, FileInfo> last_written_;
+  std::map<std::string, int>      file_last_use_;
+};
+
+}  // namespace Albany
+
+#endif  // ALBANY_CHECKPOINT_HPP
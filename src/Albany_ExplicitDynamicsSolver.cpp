@@ -0,0 +1,548 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_ExplicitDynamicsSolver.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "Albany_Checkpoint.hpp"
+#include "Albany_Utils.hpp"
+#include "Petra_Converters.hpp"
+
+#include "Teuchos_CommHelpers.hpp"
+#include "Teuchos_TestForException.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "Teuchos_VerboseObject.hpp"
+#include "Thyra_VectorStdOps.hpp"
+
+namespace {
+
+// Relative size below which a lumped mass or a Dirichlet slope is zero
+const ST zero_tol = 1.0e-12;
+
+// Perturbation of the displacements, relative to the element size, used to
+// probe the residual
+const ST probe_size = 1.0e-6;
+
+}  // namespace
+
+Albany::ExplicitDynamicsSolver::ExplicitDynamicsSolver(
+    const Teuchos::RCP<Teuchos::ParameterList>&    piroParams,
+    const Teuchos::RCP<Albany::Application>&       app,
+    const Teuchos::RCP<Thyra::ModelEvaluator<ST>>& model,
+    const Teuchos::RCP<Piro::ObserverBase<ST>>&    observer)
+    : explicitParams_(Teuchos::sublist(piroParams, "Explicit Dynamics")),
+      app_(app),
+      model_(model),
+      observer_(observer),
+      out_(Teuchos::VerboseObjectBase::getDefaultOStream()),
+      num_p_(model->Np()),
+      num_g_(model->Ng())
+{
+  explicitParams_->validateParametersAndSetDefaults(
+      *getValidExplicitDynamicsParameters(), 0);
+
+  const Thyra::ModelEvaluatorBase::InArgs<ST> inArgs = model_->createInArgs();
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      !inArgs.supports(Thyra::ModelEvaluatorBase::IN_ARG_x_dot_dot),
+      std::logic_error,
+      "Error in Albany::ExplicitDynamicsSolver: Solution Method = Transient "
+      "Explicit requires a model with accelerations "
+      "(Number Of Time Derivatives = 2).\n");
+}
+
+Teuchos::RCP<const Teuchos::ParameterList>
+Albany::ExplicitDynamicsSolver::getValidExplicitDynamicsParameters()
+{
+  Teuchos::RCP<Teuchos::ParameterList> validPL =
+      Teuchos::rcp(new Teuchos::ParameterList("ValidExplicitDynamicsParams"));
+  validPL->set<double>("Initial Time", 0.0, "Start of the time interval");
+  validPL->set<double>("Final Time", 1.0, "End of the time interval");
+  validPL->set<double>(
+      "Time Step", 0.0, "Fixed time step, 0 to compute a stable one");
+  validPL->set<double>(
+      "Wave Speed",
+      0.0,
+      "Wave speed for the element size based stable time step, 0 to estimate "
+      "the step from the highest frequency instead");
+  validPL->set<double>(
+      "Stable Time Step Factor", 0.9, "Safety factor on the stable time step");
+  validPL->set<int>(
+      "Power Iterations",
+      20,
+      "Residual evaluations used to estimate the highest frequency");
+  validPL->set<int>("Output Interval", 1, "Steps between observer calls");
+  return validPL;
+}
+
+Teuchos::RCP<const Thyra::VectorSpaceBase<ST>>
+Albany::ExplicitDynamicsSolver::get_p_space(int l) const
+{
+  return model_->get_p_space(l);
+}
+
+Teuchos::RCP<const Thyra::VectorSpaceBase<ST>>
+Albany::ExplicitDynamicsSolver::get_g_space(int j) const
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      j > num_g_ || j < 0,
+      Teuchos::Exceptions::InvalidParameter,
+      "Error in Albany::ExplicitDynamicsSolver::get_g_space(): "
+          << "Invalid response index j = " << j << "\n");
+  // The last response is the final solution, as for the Piro solvers.
+  if (j == num_g_) return model_->get_x_space();
+  return model_->get_g_space(j);
+}
+
+Teuchos::RCP<const Teuchos::Array<std::string>>
+Albany::ExplicitDynamicsSolver::get_p_names(int l) const
+{
+  return model_->get_p_names(l);
+}
+
+Thyra::ModelEvaluatorBase::InArgs<ST>
+Albany::ExplicitDynamicsSolver::getNominalValues() const
+{
+  Thyra::ModelEvaluatorBase::InArgs<ST> result = this->createInArgs();
+  const Thyra::ModelEvaluatorBase::InArgs<ST> modelNominal =
+      model_->getNominalValues();
+  for (int l = 0; l < num_p_; ++l) result.set_p(l, modelNominal.get_p(l));
+  return result;
+}
+
+Thyra::ModelEvaluatorBase::InArgs<ST>
+Albany::ExplicitDynamicsSolver::createInArgs() const
+{
+  Thyra::ModelEvaluatorBase::InArgsSetup<ST> result;
+  result.setModelEvalDescription(this->description());
+  result.set_Np(num_p_);
+  return result;
+}
+
+Thyra::ModelEvaluatorBase::OutArgs<ST>
+Albany::ExplicitDynamicsSolver::createOutArgsImpl() const
+{
+  Thyra::ModelEvaluatorBase::OutArgsSetup<ST> result;
+  result.setModelEvalDescription(this->description());
+  result.set_Np_Ng(num_p_, num_g_ + 1);
+  return result;
+}
+
+void
+Albany::ExplicitDynamicsSolver::evalResidual(
+    const ST                                     t,
+    const Teuchos::RCP<Thyra::VectorBase<ST>>&   x,
+    const Teuchos::RCP<Thyra::VectorBase<ST>>&   v,
+    const Teuchos::RCP<Thyra::VectorBase<ST>>&   a,
+    const Thyra::ModelEvaluatorBase::InArgs<ST>& params,
+    const Teuchos::RCP<Thyra::VectorBase<ST>>&   f) const
+{
+  Thyra::ModelEvaluatorBase::InArgs<ST> inArgs = params;
+  inArgs.set_x(x);
+  inArgs.set_x_dot(v);
+  inArgs.set_x_dot_dot(a);
+  inArgs.set_t(t);
+  // Albany::ModelEvaluatorT takes x_dot_dot from the InArgs only when this
+  // coefficient is nonzero; it plays no other role in a residual evaluation.
+  inArgs.set_W_x_dot_dot_coeff(1.0);
+
+  Thyra::ModelEvaluatorBase::OutArgs<ST> outArgs = model_->createOutArgs();
+  outArgs.set_f(f);
+  model_->evalModel(inArgs, outArgs);
+}
+
+ST
+Albany::ExplicitDynamicsSolver::minElementSize() const
+{
+  const Teuchos::RCP<Albany::AbstractDiscretization> disc =
+      app_->getDiscretization();
+  const auto& coords  = disc->getCoords();
+  const int   numDim  = disc->getNumDim();
+
+  ST h2 = std::numeric_limits<ST>::max();
+  for (int ws = 0; ws < coords.size(); ++ws) {
+    for (int el = 0; el < coords[ws].size(); ++el) {
+      const Teuchos::ArrayRCP<double*>& nodes = coords[ws][el];
+      for (int i = 0; i < nodes.size(); ++i) {
+        for (int j = i + 1; j < nodes.size(); ++j) {
+          ST d2 = 0.0;
+          for (int k = 0; k < numDim; ++k) {
+            const ST d = nodes[i][k] - nodes[j][k];
+            d2 += d * d;
+          }
+          // Coincident nodes (degenerate or collapsed elements) say nothing
+          // about the element size.
+          if (d2 > 0.0 && d2 < h2) h2 = d2;
+        }
+      }
+    }
+  }
+
+  ST global_h2 = h2;
+  Teuchos::reduceAll<int, ST>(
+      *app_->getComm(), Teuchos::REDUCE_MIN, h2, Teuchos::outArg(global_h2));
+  return std::sqrt(global_h2);
+}
+
+ST
+Albany::ExplicitDynamicsSolver::estimateMaxEigenvalue(
+    const ST                                     t,
+    const Teuchos::RCP<Thyra::VectorBase<ST>>&   x,
+    const Teuchos::RCP<Thyra::VectorBase<ST>>&   v,
+    const Teuchos::RCP<Thyra::VectorBase<ST>>&   a,
+    const Tpetra_Vector&                         f0,
+    const Tpetra_Vector&                         mass,
+    const ST                                     h_min,
+    const Thyra::ModelEvaluatorBase::InArgs<ST>& params) const
+{
+  const Teuchos::RCP<const Thyra::VectorSpaceBase<ST>> space =
+      model_->get_x_space();
+  const Teuchos::RCP<Thyra::VectorBase<ST>> x_pert = Thyra::createMember(space);
+  const Teuchos::RCP<Thyra::VectorBase<ST>> f      = Thyra::createMember(space);
+
+  const Teuchos::RCP<const Tpetra_Vector> xT = ConverterT::getConstTpetraVector(x);
+  const Teuchos::RCP<Tpetra_Vector> x_pertT = ConverterT::getTpetraVector(x_pert);
+  const Teuchos::RCP<Tpetra_Vector> fT      = ConverterT::getTpetraVector(f);
+
+  const Teuchos::ArrayRCP<const ST> m  = mass.get1dView();
+  const Teuchos::ArrayRCP<const ST> r0 = f0.get1dView();
+
+  // Power iteration on M_L^{-1} K, with K z = (f(x + delta z) - f(x)) / delta
+  // restricted to the free rows.
+  Tpetra_Vector z(mass.getMap());
+  z.randomize();
+  {
+    const Teuchos::ArrayRCP<ST> zv = z.get1dViewNonConst();
+    for (int i = 0; i < zv.size(); ++i)
+      if (m[i] == 0.0) zv[i] = 0.0;
+  }
+
+  const int num_iter = explicitParams_->get<int>("Power Iterations");
+  ST        lambda   = 0.0;
+  for (int iter = 0; iter < num_iter; ++iter) {
+    const ST z_max = z.normInf();
+    if (z_max == 0.0) break;
+    const ST delta = probe_size * h_min / z_max;
+    x_pertT->update(1.0, *xT, delta, z, 0.0);
+    evalResidual(t, x_pert, v, a, params, f);
+
+    const ST                          z_norm = z.norm2();
+    const Teuchos::ArrayRCP<const ST> r      = fT->get1dView();
+    const Teuchos::ArrayRCP<ST>       zv     = z.get1dViewNonConst();
+    for (int i = 0; i < zv.size(); ++i)
+      zv[i] = m[i] == 0.0 ? 0.0 : (r[i] - r0[i]) / (delta * m[i]);
+    lambda = z.norm2() / z_norm;
+  }
+  return lambda;
+}
+
+void
+Albany::ExplicitDynamicsSolver::evalModelImpl(
+    const Thyra::ModelEvaluatorBase::InArgs<ST>&  inArgs,
+    const Thyra::ModelEvaluatorBase::OutArgs<ST>& outArgs) const
+{
+  Teuchos::TimeMonitor timer(
+      *Teuchos::TimeMonitor::getNewTimer("Albany: Explicit Dynamics"));
+
+  // Nominal values of the model, with the parameters passed in
+  Thyra::ModelEvaluatorBase::InArgs<ST> params = model_->getNominalValues();
+  for (int l = 0; l < num_p_; ++l) {
+    const Teuchos::RCP<const Thyra::VectorBase<ST>> p = inArgs.get_p(l);
+    if (Teuchos::nonnull(p)) params.set_p(l, p);
+  }
+
+  const Teuchos::RCP<const Thyra::VectorSpaceBase<ST>> space =
+      model_->get_x_space();
+  const Teuchos::RCP<Thyra::VectorBase<ST>> x     = Thyra::createMember(space);
+  const Teuchos::RCP<Thyra::VectorBase<ST>> v     = Thyra::createMember(space);
+  const Teuchos::RCP<Thyra::VectorBase<ST>> a     = Thyra::createMember(space);
+  const Teuchos::RCP<Thyra::VectorBase<ST>> f     = Thyra::createMember(space);
+  const Teuchos::RCP<Thyra::VectorBase<ST>> mass  = Thyra::createMember(space);
+  const Teuchos::RCP<Thyra::VectorBase<ST>> slope = Thyra::createMember(space);
+
+  Thyra::copy(*params.get_x(), x.ptr());
+  if (Teuchos::nonnull(params.get_x_dot()))
+    Thyra::copy(*params.get_x_dot(), v.ptr());
+  else
+    Thyra::assign(v.ptr(), 0.0);
+  Thyra::assign(a.ptr(), 0.0);
+
+  const Teuchos::RCP<Tpetra_Vector> xT     = ConverterT::getTpetraVector(x);
+  const Teuchos::RCP<Tpetra_Vector> vT     = ConverterT::getTpetraVector(v);
+  const Teuchos::RCP<Tpetra_Vector> aT     = ConverterT::getTpetraVector(a);
+  const Teuchos::RCP<Tpetra_Vector> fT     = ConverterT::getTpetraVector(f);
+  const Teuchos::RCP<Tpetra_Vector> massT  = ConverterT::getTpetraVector(mass);
+  const Teuchos::RCP<Tpetra_Vector> slopeT = ConverterT::getTpetraVector(slope);
+
+  ST       t0    = explicitParams_->get<double>("Initial Time");
+  const ST tf    = explicitParams_->get<double>("Final Time");
+  const ST h_min = minElementSize();
+  ST       dt    = explicitParams_->get<double>("Time Step");
+
+  const Teuchos::RCP<Albany::Checkpoint> checkpoint = app_->getCheckpoint();
+  const bool restart = Teuchos::nonnull(checkpoint) && checkpoint->restarting();
+
+  Teuchos::ArrayRCP<const ST> m;
+  Teuchos::ArrayRCP<const ST> s;
+
+  // Given the residual at x, enforce the Dirichlet rows and compute the
+  // acceleration of the free rows. With h > 0 the velocity of the Dirichlet
+  // rows follows their prescribed motion over the step h.
+  auto update = [&](const Tpetra_Vector& res, const ST h) {
+    const Teuchos::ArrayRCP<const ST> r  = res.get1dView();
+    const Teuchos::ArrayRCP<ST>       xv = xT->get1dViewNonConst();
+    const Teuchos::ArrayRCP<ST>       vv = vT->get1dViewNonConst();
+    const Teuchos::ArrayRCP<ST>       av = aT->get1dViewNonConst();
+    for (int i = 0; i < xv.size(); ++i) {
+      if (m[i] != 0.0) {
+        av[i] = -r[i] / m[i];
+      } else {
+        const ST dx = s[i] != 0.0 ? -r[i] / s[i] : 0.0;
+        xv[i] += dx;
+        if (h > 0.0) vv[i] = dx / h;
+        av[i] = 0.0;
+      }
+    }
+  };
+
+  int first_step = 1;
+  if (restart) {
+    // The checkpoint has the solution after step first_step - 1 and all the
+    // steps depend on, so the run continues exactly as if not interrupted.
+    double     step     = 0.0;
+    const bool complete = checkpoint->getVector("Lumped Mass", *massT) &&
+                          checkpoint->getVector("Dirichlet Slope", *slopeT) &&
+                          checkpoint->getScalar("Time Step", dt) &&
+                          checkpoint->getScalar("Initial Time", t0) &&
+                          checkpoint->getScalar("Step", step);
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        !complete,
+        std::logic_error,
+        "Error in Albany::ExplicitDynamicsSolver: the checkpoint was not "
+        "written by the explicit dynamics solver.\n");
+    first_step = static_cast<int>(step) + 1;
+    if (Teuchos::nonnull(params.get_x_dot_dot()))
+      Thyra::copy(*params.get_x_dot_dot(), a.ptr());
+    m = massT->get1dView();
+    s = slopeT->get1dView();
+    *out_ << "Explicit Dynamics: restart after step " << first_step - 1
+          << "\n";
+  } else {
+    //
+    // Lumped mass: M 1 = f(x, v, 1) - f(x, v, 0)
+    //
+    evalResidual(t0, x, v, a, params, f);
+    Tpetra_Vector f0(*fT, Teuchos::Copy);
+    Thyra::assign(a.ptr(), 1.0);
+    evalResidual(t0, x, v, a, params, mass);
+    Thyra::assign(a.ptr(), 0.0);
+    massT->update(-1.0, f0, 1.0);
+
+    const ST mass_max = massT->normInf();
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        !(mass_max > 0.0),
+        std::logic_error,
+        "Error in Albany::ExplicitDynamicsSolver: the lumped mass is zero. "
+        "Is the problem dynamic?\n");
+
+    {
+      const Teuchos::ArrayRCP<ST> mv = massT->get1dViewNonConst();
+      for (int i = 0; i < mv.size(); ++i)
+        if (std::abs(mv[i]) <= zero_tol * mass_max) mv[i] = 0.0;
+
+      // A negative lumped mass (e.g. from higher-order serendipity elements)
+      // makes central differences unconditionally unstable.
+      LO num_negative = 0;
+      for (int i = 0; i < mv.size(); ++i)
+        if (mv[i] < 0.0) ++num_negative;
+      LO num_negative_global = 0;
+      Teuchos::reduceAll<int, LO>(
+          *app_->getComm(),
+          Teuchos::REDUCE_SUM,
+          num_negative,
+          Teuchos::outArg(num_negative_global));
+      TEUCHOS_TEST_FOR_EXCEPTION(
+          num_negative_global > 0,
+          std::logic_error,
+          "Error in Albany::ExplicitDynamicsSolver: "
+              << num_negative_global
+              << " lumped mass entries are negative. Use an element with a "
+                 "positive lumped mass.\n");
+    }
+
+    //
+    // Slope of the residual of the Dirichlet rows in their own DOF
+    //
+    {
+      const ST delta = probe_size * h_min;
+      const Teuchos::ArrayRCP<const ST> mv = massT->get1dView();
+      const Teuchos::ArrayRCP<ST>       sv = slopeT->get1dViewNonConst();
+      for (int i = 0; i < sv.size(); ++i) sv[i] = mv[i] == 0.0 ? delta : 0.0;
+      slopeT->update(1.0, *xT, 1.0);
+      evalResidual(t0, slope, v, a, params, f);
+
+      const Teuchos::ArrayRCP<const ST> r  = fT->get1dView();
+      const Teuchos::ArrayRCP<const ST> r0 = f0.get1dView();
+      for (int i = 0; i < sv.size(); ++i)
+        sv[i] = mv[i] == 0.0 ? (r[i] - r0[i]) / delta : 0.0;
+      const ST slope_max = slopeT->normInf();
+      for (int i = 0; i < sv.size(); ++i)
+        if (std::abs(sv[i]) <= zero_tol * slope_max) sv[i] = 0.0;
+
+      // A row with neither mass nor a Dirichlet slope is left where it is;
+      // it is most likely a DOF the problem does not couple to an inertia.
+      LO num_singular = 0;
+      for (int i = 0; i < sv.size(); ++i)
+        if (mv[i] == 0.0 && sv[i] == 0.0) ++num_singular;
+      LO num_singular_global = 0;
+      Teuchos::reduceAll<int, LO>(
+          *app_->getComm(),
+          Teuchos::REDUCE_SUM,
+          num_singular,
+          Teuchos::outArg(num_singular_global));
+      if (num_singular_global > 0)
+        *out_ << "Warning in Albany::ExplicitDynamicsSolver: "
+              << num_singular_global
+              << " DOFs have a zero lumped mass and are not constrained; "
+                 "they are held fixed\n";
+    }
+
+    m = massT->get1dView();
+    s = slopeT->get1dView();
+    update(f0, 0.0);
+
+    //
+    // Time step
+    //
+    const ST factor = explicitParams_->get<double>("Stable Time Step Factor");
+    const ST c      = explicitParams_->get<double>("Wave Speed");
+    if (dt <= 0.0) {
+      if (c > 0.0) {
+        dt = factor * h_min / c;
+        *out_ << "Explicit Dynamics: h_min = " << h_min
+              << ", wave speed = " << c << "\n";
+      } else {
+        evalResidual(t0, x, v, a, params, f);
+        const ST lambda =
+            estimateMaxEigenvalue(t0, x, v, a, *fT, *massT, h_min, params);
+        TEUCHOS_TEST_FOR_EXCEPTION(
+            !(lambda > 0.0),
+            std::logic_error,
+            "Error in Albany::ExplicitDynamicsSolver: could not estimate the "
+            "highest frequency; set Wave Speed or Time Step.\n");
+        dt = factor * 2.0 / std::sqrt(lambda);
+        *out_ << "Explicit Dynamics: h_min = " << h_min
+              << ", omega_max = " << std::sqrt(lambda) << "\n";
+      }
+    }
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      !(tf > t0),
+      Teuchos::Exceptions::InvalidParameter,
+      "Error in Albany::ExplicitDynamicsSolver: Final Time must be greater "
+      "than Initial Time.\n");
+  const int num_steps = static_cast<int>(std::ceil((tf - t0) / dt - 1.0e-12));
+  // A step that divides the interval is kept as is, so that runs to different
+  // final times take the same steps.
+  if (!restart && std::abs(num_steps * dt - (tf - t0)) > 1.0e-12 * (tf - t0))
+    dt = (tf - t0) / num_steps;
+
+  const LO num_rows      = massT->getLocalLength();
+  LO       num_dirichlet = 0;
+  for (LO i = 0; i < num_rows; ++i)
+    if (m[i] == 0.0) ++num_dirichlet;
+  LO num_dirichlet_global = 0;
+  Teuchos::reduceAll<int, LO>(
+      *app_->getComm(),
+      Teuchos::REDUCE_SUM,
+      num_dirichlet,
+      Teuchos::outArg(num_dirichlet_global));
+  *out_ << "Explicit Dynamics: " << num_steps << " steps of dt = " << dt
+        << ", " << massT->getGlobalLength() - num_dirichlet_global
+        << " free and " << num_dirichlet_global << " Dirichlet DOFs\n";
+
+  if (Teuchos::nonnull(checkpoint)) {
+    checkpoint->setScalar("Initial Time", t0);
+    checkpoint->setScalar("Time Step", dt);
+    checkpoint->setScalar("Step", first_step - 1);
+    checkpoint->setVector("Lumped Mass", massT);
+    checkpoint->setVector("Dirichlet Slope", slopeT);
+  }
+
+  const int output_interval =
+      std::max(1, explicitParams_->get<int>("Output Interval"));
+  if (Teuchos::nonnull(observer_))
+    observer_->observeSolution(*x, *v, *a, t0 + (first_step - 1) * dt);
+
+  //
+  // Central difference steps
+  //
+  Teuchos::Time wall("Explicit Dynamics Steps");
+  wall.start(true);
+  ST t = t0 + (first_step - 1) * dt;
+  for (int step = first_step; step <= num_steps; ++step) {
+    {
+      const Teuchos::ArrayRCP<ST>       xv = xT->get1dViewNonConst();
+      const Teuchos::ArrayRCP<ST>       vv = vT->get1dViewNonConst();
+      const Teuchos::ArrayRCP<const ST> av = aT->get1dView();
+      for (LO i = 0; i < num_rows; ++i) {
+        if (m[i] == 0.0) continue;
+        vv[i] += 0.5 * dt * av[i];
+        xv[i] += dt * vv[i];
+      }
+    }
+    t = t0 + step * dt;
+
+    // Acceleration is zero here, so f is the internal minus external force.
+    Thyra::assign(a.ptr(), 0.0);
+    evalResidual(t, x, v, a, params, f);
+    update(*fT, dt);
+
+    {
+      const Teuchos::ArrayRCP<ST>       vv = vT->get1dViewNonConst();
+      const Teuchos::ArrayRCP<const ST> av = aT->get1dView();
+      for (LO i = 0; i < num_rows; ++i)
+        if (m[i] != 0.0) vv[i] += 0.5 * dt * av[i];
+    }
+
+    if (Teuchos::nonnull(observer_) &&
+        (step % output_interval == 0 || step == num_steps)) {
+      if (Teuchos::nonnull(checkpoint)) checkpoint->setScalar("Step", step);
+      observer_->observeSolution(*x, *v, *a, t);
+    }
+  }
+  wall.stop();
+
+  const double seconds = wall.totalElapsedTime();
+  *out_ << "Explicit Dynamics: " << num_steps - first_step + 1
+        << " steps in " << seconds
+        << " s";
+  if (seconds > 0.0)
+    *out_ << ", " << (num_steps - first_step + 1) / seconds << " steps/s";
+  *out_ << "\n";
+
+  //
+  // Responses at the final time, and the final solution
+  //
+  for (int j = 0; j < num_g_; ++j) {
+    const Teuchos::RCP<Thyra::VectorBase<ST>> g = outArgs.get_g(j);
+    if (Teuchos::is_null(g)) continue;
+    Thyra::ModelEvaluatorBase::InArgs<ST> modelInArgs = params;
+    modelInArgs.set_x(x);
+    modelInArgs.set_x_dot(v);
+    modelInArgs.set_x_dot_dot(a);
+    modelInArgs.set_t(t);
+    modelInArgs.set_W_x_dot_dot_coeff(1.0);
+    Thyra::ModelEvaluatorBase::OutArgs<ST> modelOutArgs =
+        model_->createOutArgs();
+    modelOutArgs.set_g(j, g);
+    model_->evalModel(modelInArgs, modelOutArgs);
+  }
+
+  const Teuchos::RCP<Thyra::VectorBase<ST>> x_final = outArgs.get_g(num_g_);
+  if (Teuchos::nonnull(x_final)) Thyra::copy(*x, x_final.ptr());
+}
@@ -0,0 +1,145 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_EXPLICITDYNAMICSSOLVER_HPP
+#define ALBANY_EXPLICITDYNAMICSSOLVER_HPP
+
+#include "Albany_Application.hpp"
+#include "Albany_DataTypes.hpp"
+
+#include "Piro_ObserverBase.hpp"
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_RCP.hpp"
+#include "Thyra_ResponseOnlyModelEvaluatorBase.hpp"
+
+namespace Albany {
+
+/*!
+ * \brief Explicit central difference integrator for second order problems
+ *
+ * Selected with Solution Method = "Transient Explicit". The step is the
+ * velocity Verlet form of the central difference method (explicit Newmark,
+ * beta = 0, gamma = 1/2):
+ *
+ *   v_{n+1/2} = v_n + dt/2 a_n
+ *   x_{n+1}   = x_n + dt v_{n+1/2}
+ *   a_{n+1}   = -M_L^{-1} f(t_{n+1}, x_{n+1}, v_{n+1/2}, 0)
+ *   v_{n+1}   = v_{n+1/2} + dt/2 a_{n+1}
+ *
+ * Only the Residual evaluation type is used, once per step. The lumped mass
+ * M_L is assembled once, before the first step, as the difference of two
+ * residuals with unit and zero acceleration, which is the row sum of the
+ * consistent mass. Its inverse is applied as a vector scaling, so no
+ * Jacobian is formed and no linear system is solved. The STK discretization
+ * only reserves the diagonal in its graphs for this solution method.
+ *
+ * Rows with zero mass are Dirichlet rows. Their residual f_i = s_i (x_i - g)
+ * is linear in x_i, so they are enforced as x_i -= f_i / s_i after each
+ * evaluation, with s_i measured once at the start. Rows with no dependence
+ * on x_i either (strong Dirichlet rows, unused DOFs) keep their value.
+ *
+ * Parameters, in the "Explicit Dynamics" sublist of "Piro":
+ *
+ *   Initial Time, Final Time        Time interval, default [0, 1].
+ *   Time Step                       Fixed step; 0 (default) for automatic.
+ *                                   A step that divides the time interval
+ *                                   (to 1e-12 relative) is used unchanged;
+ *                                   any other step, fixed or automatic, is
+ *                                   shrunk to the next one that divides it.
+ *   Wave Speed                      If > 0, the automatic step is
+ *                                   factor * h_min / c, with h_min the
+ *                                   smallest distance between two nodes of
+ *                                   an element.
+ *   Stable Time Step Factor         Safety factor, default 0.9.
+ *   Power Iterations                Without a wave speed, the automatic step
+ *                                   is factor * 2 / omega_max, with omega_max^2
+ *                                   the largest eigenvalue of M_L^{-1} K
+ *                                   estimated by this many residual
+ *                                   evaluations, default 20.
+ *   Output Interval                 Steps between observer calls, default 1.
+ *
+ * With a "Checkpoint" list the lumped mass, Dirichlet slopes, time step and
+ * step count are saved with the checkpoints, and a restart continues with the
+ * step after the checkpoint; the steps taken are the same as without the
+ * interruption. That is why a dividing Time Step is not recomputed as
+ * (Final Time - Initial Time) / steps: the round off of that quotient
+ * depends on the final time, so a run stopped early for a checkpoint would
+ * take different steps.
+ */
+class ExplicitDynamicsSolver : public Thyra::ResponseOnlyModelEvaluatorBase<ST>
+{
+ public:
+  ExplicitDynamicsSolver(
+      const Teuchos::RCP<Teuchos::ParameterList>&  piroParams,
+      const Teuchos::RCP<Albany::Application>&     app,
+      const Teuchos::RCP<Thyra::ModelEvaluator<ST>>& model,
+      const Teuchos::RCP<Piro::ObserverBase<ST>>&  observer);
+
+  Teuchos::RCP<const Thyra::VectorSpaceBase<ST>>
+  get_p_space(int l) const;
+
+  Teuchos::RCP<const Thyra::VectorSpaceBase<ST>>
+  get_g_space(int j) const;
+
+  Teuchos::RCP<const Teuchos::Array<std::string>>
+  get_p_names(int l) const;
+
+  Thyra::ModelEvaluatorBase::InArgs<ST>
+  getNominalValues() const;
+
+  Thyra::ModelEvaluatorBase::InArgs<ST>
+  createInArgs() const;
+
+  static Teuchos::RCP<const Teuchos::ParameterList>
+  getValidExplicitDynamicsParameters();
+
+ private:
+  Thyra::ModelEvaluatorBase::OutArgs<ST>
+  createOutArgsImpl() const;
+
+  void
+  evalModelImpl(
+      const Thyra::ModelEvaluatorBase::InArgs<ST>&  inArgs,
+      const Thyra::ModelEvaluatorBase::OutArgs<ST>& outArgs) const;
+
+  //! f = residual of the model at (t, x, v, a)
+  void
+  evalResidual(
+      const ST                                      t,
+      const Teuchos::RCP<Thyra::VectorBase<ST>>&    x,
+      const Teuchos::RCP<Thyra::VectorBase<ST>>&    v,
+      const Teuchos::RCP<Thyra::VectorBase<ST>>&    a,
+      const Thyra::ModelEvaluatorBase::InArgs<ST>&  params,
+      const Teuchos::RCP<Thyra::VectorBase<ST>>&    f) const;
+
+  //! Smallest distance between two nodes of an element, over the mesh
+  ST
+  minElementSize() const;
+
+  //! Largest eigenvalue of M_L^{-1} K on the free rows, by power iteration
+  ST
+  estimateMaxEigenvalue(
+      const ST                                      t,
+      const Teuchos::RCP<Thyra::VectorBase<ST>>&    x,
+      const Teuchos::RCP<Thyra::VectorBase<ST>>&    v,
+      const Teuchos::RCP<Thyra::VectorBase<ST>>&    a,
+      const Tpetra_Vector&                          f0,
+      const Tpetra_Vector&                          mass,
+      const ST                                      h_min,
+      const Thyra::ModelEvaluatorBase::InArgs<ST>&  params) const;
+
+  Teuchos::RCP<Teuchos::ParameterList>  explicitParams_;
+  Teuchos::RCP<Albany::Application>     app_;
+  Teuchos::RCP<Thyra::ModelEvaluator<ST>> model_;
+  Teuchos::RCP<Piro::ObserverBase<ST>>  observer_;
+  Teuchos::RCP<Teuchos::FancyOStream>   out_;
+  int num_p_;
+  int num_g_;
+};
+
+}  // namespace Albany
+
+#endif  // ALBANY_EXPLICITDYNAMICSSOLVER_HPP
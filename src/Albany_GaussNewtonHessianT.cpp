@@ -0,0 +1,266 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_GaussNewtonHessianT.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Teuchos_TestForException.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "Teuchos_VerboseObject.hpp"
+#include "Thyra_TpetraThyraWrappers.hpp"
+
+namespace {
+
+// Perturbs a distributed parameter for the lifetime of the object, and
+// restores it when it goes out of scope, also on an exception.
+class ParameterPerturbation
+{
+ public:
+  ParameterPerturbation(
+      const Teuchos::RCP<const DistParam>& param,
+      const ST                             eps,
+      const Tpetra_Vector&                 v)
+      : param_(param), saved_(*param->vector(), Teuchos::Copy)
+  {
+    param_->vector()->update(eps, v, 1.0);
+    param_->scatter();
+  }
+
+  ~ParameterPerturbation()
+  {
+    param_->vector()->assign(saved_);
+    param_->scatter();
+  }
+
+ private:
+  ParameterPerturbation(const ParameterPerturbation&);
+  ParameterPerturbation& operator=(const ParameterPerturbation&);
+
+  const Teuchos::RCP<const DistParam> param_;
+  const Tpetra_Vector                 saved_;
+};
+
+}  // namespace
+
+Albany::GaussNewtonHessianT::GaussNewtonHessianT(
+    const Teuchos::RCP<Application>&                                   app,
+    const Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>>& lowsFactory,
+    const int          response_index,
+    const std::string& dist_param_name)
+    : app_(app),
+      lowsFactory_(lowsFactory),
+      response_index_(response_index),
+      param_name_(dist_param_name),
+      num_linear_solves_(0)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      response_index < 0 || response_index >= app_->getNumResponses(),
+      std::logic_error,
+      "Error in Albany::GaussNewtonHessianT: invalid response index "
+          << response_index << ".\n");
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      !app_->getResponse(response_index)->isScalarResponse() ||
+          app_->getResponse(response_index)
+                  ->responseMapT()
+                  ->getGlobalNumElements() != 1,
+      std::logic_error,
+      "Error in Albany::GaussNewtonHessianT: response " << response_index
+          << " is not a single scalar; use Collection Method = Sum "
+             "Responses.\n");
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      !app_->getDistParamLib()->has(param_name_),
+      std::logic_error,
+      "Error in Albany::GaussNewtonHessianT: no distributed parameter named \""
+          << param_name_ << "\".\n");
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      Teuchos::is_null(lowsFactory_),
+      std::logic_error,
+      "Error in Albany::GaussNewtonHessianT: no linear solver.\n");
+
+  g_   = Teuchos::rcp(
+      new Tpetra_Vector(app_->getResponse(response_index)->responseMapT()));
+  g_x_ = Teuchos::rcp(new Tpetra_Vector(app_->getMapT()));
+  g_p_ = Teuchos::rcp(new Tpetra_Vector(getParameterMap()));
+}
+
+Teuchos::RCP<const Tpetra_Map>
+Albany::GaussNewtonHessianT::getParameterMap() const
+{
+  return app_->getDistParamLib()->get(param_name_)->map();
+}
+
+ST
+Albany::GaussNewtonHessianT::evaluateResponse(const Tpetra_Vector& x)
+{
+  Tpetra_Vector g(app_->getResponse(response_index_)->responseMapT());
+  app_->evaluateResponseT(response_index_, 0.0, NULL, NULL, x, params_, g);
+  return g.getData()[0];
+}
+
+void
+Albany::GaussNewtonHessianT::setPoint(const Tpetra_Vector& x)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("Albany: Gauss-Newton Hessian Setup");
+
+  x_ = Teuchos::rcp(new Tpetra_Vector(x, Teuchos::Copy));
+
+  if (Teuchos::is_null(jac_)) {
+    jac_ = Teuchos::rcp(new Tpetra_CrsMatrix(app_->getJacobianGraphT()));
+  }
+  app_->computeGlobalJacobianT(
+      1.0, 0.0, 0.0, 0.0, NULL, NULL, *x_, params_, NULL, *jac_);
+
+  Tpetra_RowMatrixTransposer transposer(jac_);
+  const Teuchos::RCP<Tpetra_CrsMatrix> jac_trans =
+      transposer.createTranspose();
+
+  // Initializing a solver builds its preconditioner, which every solve at
+  // this point then reuses.
+  solver_ = lowsFactory_->createOp();
+  Thyra::initializeOp<ST>(
+      *lowsFactory_,
+      Thyra::createConstLinearOp(
+          Teuchos::rcp_implicit_cast<const Tpetra_Operator>(jac_)),
+      solver_.ptr());
+  solver_trans_ = lowsFactory_->createOp();
+  Thyra::initializeOp<ST>(
+      *lowsFactory_,
+      Thyra::createConstLinearOp(
+          Teuchos::rcp_implicit_cast<const Tpetra_Operator>(jac_trans)),
+      solver_trans_.ptr());
+
+  evaluateResponseDerivatives(*x_, *g_x_, *g_p_, g_.get());
+}
+
+ST
+Albany::GaussNewtonHessianT::computeGradient(Tpetra_Vector& gradient)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("Albany: Reduced Gradient");
+
+  // J^T mu = g_x, dG/dp = g_p - f_p^T mu
+  Tpetra_Vector mu(app_->getMapT());
+  solve(*solver_trans_, *g_x_, mu);
+  applyDistParamDeriv(true, mu, gradient);
+  gradient.update(1.0, *g_p_, -1.0);
+  return g_->getData()[0];
+}
+
+void
+Albany::GaussNewtonHessianT::apply(const Tpetra_Vector& v, Tpetra_Vector& Hv)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("Albany: Gauss-Newton Hessian Apply");
+
+  // w = -J^{-1} f_p v, the change of the state along v
+  Tpetra_Vector fpv(app_->getMapT());
+  applyDistParamDeriv(false, v, fpv);
+  Tpetra_Vector w(app_->getMapT());
+  solve(*solver_, fpv, w);
+  w.scale(-1.0);
+
+  // Second derivatives of g along (w, v) by differences of g_x and g_p
+  const Teuchos::RCP<Tpetra_Vector> p =
+      app_->getDistParamLib()->get(param_name_)->vector();
+  const ST norm_xp = std::sqrt(
+      x_->norm2() * x_->norm2() + p->norm2() * p->norm2());
+  const ST norm_wv = std::sqrt(w.norm2() * w.norm2() + v.norm2() * v.norm2());
+  if (norm_wv == 0.0) {
+    Hv.putScalar(0.0);
+    return;
+  }
+  const ST eps = std::sqrt(std::numeric_limits<ST>::epsilon()) *
+                 std::max(norm_xp, 1.0) / norm_wv;
+
+  Tpetra_Vector g_xx(app_->getMapT());
+  Tpetra_Vector g_pp(getParameterMap());
+  {
+    const ParameterPerturbation perturbation(
+        app_->getDistParamLib()->get(param_name_), eps, v);
+    Tpetra_Vector x_pert(*x_, Teuchos::Copy);
+    x_pert.update(eps, w, 1.0);
+    evaluateResponseDerivatives(x_pert, g_xx, g_pp, NULL);
+  }
+
+  g_xx.update(-1.0 / eps, *g_x_, 1.0 / eps);
+  g_pp.update(-1.0 / eps, *g_p_, 1.0 / eps);
+
+  // Hv = g_pp - f_p^T J^{-T} g_xx
+  Tpetra_Vector lambda(app_->getMapT());
+  solve(*solver_trans_, g_xx, lambda);
+  applyDistParamDeriv(true, lambda, Hv);
+  Hv.update(1.0, g_pp, -1.0);
+}
+
+void
+Albany::GaussNewtonHessianT::evaluateResponseDerivatives(
+    const Tpetra_Vector& x,
+    Tpetra_Vector&       g_x,
+    Tpetra_Vector&       g_p,
+    Tpetra_Vector*       g)
+{
+  const Thyra::ModelEvaluatorBase::Derivative<ST> dg_dx(
+      Thyra::createMultiVector<ST, LO, Tpetra_GO, KokkosNode>(
+          Teuchos::rcp_implicit_cast<Tpetra_MultiVector>(
+              Teuchos::rcpFromRef(g_x))),
+      Thyra::ModelEvaluatorBase::DERIV_TRANS_MV_BY_ROW);
+  const Thyra::ModelEvaluatorBase::Derivative<ST> none;
+  app_->evaluateResponseDerivativeT(
+      response_index_, 0.0, NULL, NULL, x, params_, NULL, g, dg_dx, none, none,
+      none);
+
+  // The response is called directly: Application would also add g_p to the
+  // "<name>_sensitivity" output field.
+  g_p.putScalar(0.0);
+  app_->getResponse(response_index_)
+      ->evaluateDistParamDerivT(0.0, NULL, NULL, x, params_, param_name_, &g_p);
+}
+
+void
+Albany::GaussNewtonHessianT::applyDistParamDeriv(
+    const bool           trans,
+    const Tpetra_Vector& v,
+    Tpetra_Vector&       result)
+{
+  app_->applyGlobalDistParamDerivImplT(
+      0.0,
+      Teuchos::null,
+      Teuchos::null,
+      x_,
+      params_,
+      param_name_,
+      trans,
+      Teuchos::rcp_implicit_cast<const Tpetra_MultiVector>(
+          Teuchos::rcpFromRef(v)),
+      Teuchos::rcp_implicit_cast<Tpetra_MultiVector>(
+          Teuchos::rcpFromRef(result)));
+}
+
+void
+Albany::GaussNewtonHessianT::solve(
+    const Thyra::LinearOpWithSolveBase<ST>& solver,
+    const Tpetra_Vector&                    b,
+    Tpetra_Vector&                          y)
+{
+  y.putScalar(0.0);
+  const Teuchos::RCP<const Thyra::MultiVectorBase<ST>> bT =
+      Thyra::createConstMultiVector<ST, LO, Tpetra_GO, KokkosNode>(
+          Teuchos::rcp_implicit_cast<const Tpetra_MultiVector>(
+              Teuchos::rcpFromRef(b)));
+  const Teuchos::RCP<Thyra::MultiVectorBase<ST>> yT =
+      Thyra::createMultiVector<ST, LO, Tpetra_GO, KokkosNode>(
+          Teuchos::rcp_implicit_cast<Tpetra_MultiVector>(
+              Teuchos::rcpFromRef(y)));
+  const Thyra::SolveStatus<ST> status =
+      Thyra::solve<ST>(solver, Thyra::NOTRANS, *bT, yT.ptr());
+  ++num_linear_solves_;
+  if (status.solveStatus == Thyra::SOLVE_STATUS_UNCONVERGED) {
+    *Teuchos::VerboseObjectBase::getDefaultOStream()
+        << "Warning: Albany::GaussNewtonHessianT: linear solve did not converge."
+        << std::endl;
+  }
+}
@@ -0,0 +1,128 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_GAUSSNEWTONHESSIANT_HPP
+#define ALBANY_GAUSSNEWTONHESSIANT_HPP
+
+#include <string>
+
+#include "Albany_Application.hpp"
+#include "Albany_DataTypes.hpp"
+
+#include "Teuchos_RCP.hpp"
+#include "Thyra_LinearOpWithSolveBase.hpp"
+#include "Thyra_LinearOpWithSolveFactoryBase.hpp"
+
+namespace Albany {
+
+/*!
+ * \brief Gradient and Hessian-vector products of a reduced objective
+ *
+ * For a steady problem f(x, p) = 0, a scalar response g(x, p) and a
+ * distributed parameter p, the reduced objective is G(p) = g(x(p), p). At a
+ * solution x of f(x, p) = 0, with J = f_x, its gradient is
+ *
+ *   dG/dp = g_p - f_p^T J^{-T} g_x
+ *
+ * and its Gauss-Newton Hessian applied to a direction v is
+ *
+ *   H v = (g_px w + g_pp v) - f_p^T J^{-T} (g_xx w + g_xp v),
+ *   w   = -J^{-1} f_p v.
+ *
+ * H drops the terms with the second derivatives of f, which are weighted by
+ * the adjoint and so vanish with the misfit; it is positive semi-definite
+ * for a convex g, as conjugate gradients needs. A product costs one solve
+ * with J, one with J^T and no nonlinear solve.
+ *
+ * The second derivatives of g are the directional differences of g_x and
+ * g_p along (w, v), both given by the Jacobian and DistParamDeriv response
+ * fills. They are exact for the quadratic misfits and regularizations used
+ * in inversion (Surface Velocity Mismatch, Squared L2 Difference, ...).
+ *
+ * setPoint() assembles J, its explicit transpose and their preconditioners
+ * once; the products at that point reuse them. The current value of p is
+ * the one in the distributed parameter library of the Application.
+ */
+class GaussNewtonHessianT
+{
+ public:
+  GaussNewtonHessianT(
+      const Teuchos::RCP<Application>&                                app,
+      const Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>>& lowsFactory,
+      const int                                                       response_index,
+      const std::string&                                              dist_param_name);
+
+  //! Response g(x, p)
+  ST
+  evaluateResponse(const Tpetra_Vector& x);
+
+  //! Linearize at the solution x of f(x, p) = 0
+  void
+  setPoint(const Tpetra_Vector& x);
+
+  //! G(p) and dG/dp at the point; one solve with J^T
+  ST
+  computeGradient(Tpetra_Vector& gradient);
+
+  //! Hv = H v at the point; one solve with J and one with J^T
+  void
+  apply(const Tpetra_Vector& v, Tpetra_Vector& Hv);
+
+  //! Map of the distributed parameter
+  Teuchos::RCP<const Tpetra_Map>
+  getParameterMap() const;
+
+  int
+  getNumLinearSolves() const
+  {
+    return num_linear_solves_;
+  }
+
+ private:
+  //! g_x and g_p at (x, p); also g if not NULL
+  void
+  evaluateResponseDerivatives(
+      const Tpetra_Vector& x,
+      Tpetra_Vector&       g_x,
+      Tpetra_Vector&       g_p,
+      Tpetra_Vector*       g);
+
+  //! f_p v, or f_p^T v if trans
+  void
+  applyDistParamDeriv(
+      const bool           trans,
+      const Tpetra_Vector& v,
+      Tpetra_Vector&       result);
+
+  void
+  solve(
+      const Thyra::LinearOpWithSolveBase<ST>& solver,
+      const Tpetra_Vector&                    b,
+      Tpetra_Vector&                          y);
+
+  Teuchos::RCP<Application>                                   app_;
+  Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>> lowsFactory_;
+  int                                                         response_index_;
+  std::string                                                 param_name_;
+
+  //! No scalar parameters are varied
+  Teuchos::Array<ParamVec> params_;
+
+  Teuchos::RCP<Tpetra_Vector>    x_;
+  Teuchos::RCP<Tpetra_Vector>    g_;
+  Teuchos::RCP<Tpetra_Vector>    g_x_;
+  Teuchos::RCP<Tpetra_Vector>    g_p_;
+  Teuchos::RCP<Tpetra_CrsMatrix> jac_;
+
+  Teuchos::RCP<Thyra::LinearOpWithSolveBase<ST>> solver_;
+  Teuchos::RCP<Thyra::LinearOpWithSolveBase<ST>> solver_trans_;
+
+  int num_linear_solves_;
+};
+
+}  // namespace Albany
+
+#endif  // ALBANY_GAUSSNEWTONHESSIANT_HPP
@@ -201,7 +201,8 @@ void subtractCentroid(const Teuchos::RCP<Tpetra_MultiVector> &coordMV)
 
 RigidBodyModes::RigidBodyModes(int numPDEs_)
   : numPDEs(numPDEs_), numElasticityDim(0), nullSpaceDim(0),
-    numScalar(0), mlUsed(false), mueLuUsed(false), setNonElastRBM(false)
+    numScalar(0), mlUsed(false), mueLuUsed(false), setNonElastRBM(false),
+    numLevels(0)
 {}
 
 void RigidBodyModes::
@@ -244,6 +245,35 @@ void RigidBodyModes::setParameters(
   setNonElastRBM = setNonElastRBM_;
 }
 
+void RigidBodyModes::
+setVerticalLines(const int numLevels_)
+{
+  numLevels = numLevels_;
+}
+
+void RigidBodyModes::setLineDetection()
+{
+  // Without the number of nodes per column, MueLu guesses it from the
+  // coordinates, and aggregation that ignores the columns mixes the layers
+  // of a thin, extruded mesh. With it, semi-coarsening halves the columns
+  // until they are collapsed and line smoothers relax whole columns, so the
+  // iteration counts do not grow with the number of layers.
+  if (numLevels <= 0) return;
+
+  // The verbose input deck configures LineDetectionFactory itself, and a
+  // deck that sets line detection keeps its own settings.
+  if (plist->isSublist("Factories")) return;
+  if (plist->isParameter("linedetection: orientation") ||
+      plist->isParameter("linedetection: num layers")) return;
+
+  // MueLu finds the lines by sorting the coordinates. The "vertical"
+  // orientation would instead assume that the local nodes of each column
+  // are consecutive, which neither the node map of STK nor a reordering
+  // guarantees, even for columnwise numbering.
+  plist->set("linedetection: num layers", numLevels);
+  plist->set<std::string>("linedetection: orientation", "coordinates");
+}
+
 void RigidBodyModes::
 setCoordinates(const Teuchos::RCP<Tpetra_MultiVector> &coordMV_)
 {
@@ -294,6 +324,7 @@ setCoordinates(const Teuchos::RCP<Tpetra_MultiVector> &coordMV_)
       plist->set("Coordinates", coordMV);
       plist->set("number of equations", numPDEs);
     }
+    setLineDetection();
   }
 }
 
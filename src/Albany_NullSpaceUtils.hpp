@@ -100,10 +100,21 @@ public:
   //! Pass only the coordinates.
   void setCoordinates(const Teuchos::RCP<Tpetra_MultiVector> &coordMV);
 
+  //! Describe the vertical columns of an extruded mesh: each column has
+  //! numLevels nodes. Used by MueLu line detection, for semi-coarsening and
+  //! line smoothing, when the next coordinates are passed, unless the input
+  //! deck sets line detection itself.
+  void setVerticalLines(const int numLevels);
+
 private:
+  //! Fill the MueLu line detection parameters the user left unset.
+  void setLineDetection();
+
   int numPDEs, numElasticityDim, numScalar, nullSpaceDim;
   bool mlUsed, mueLuUsed, setNonElastRBM;
 
+  int numLevels;
+
   Teuchos::RCP<Teuchos::ParameterList> plist;
 
   Teuchos::RCP<Tpetra_MultiVector> coordMV;
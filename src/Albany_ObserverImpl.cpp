@@ -88,6 +88,12 @@ void ObserverImpl::observeSolutionT(
 
   StatelessObserverImpl::observeSolutionT(stamp, nonOverlappedSolutionT,
                                           nonOverlappedSolutionDotT, nonOverlappedSolutionDotDotT);
+
+  const Teuchos::RCP<Checkpoint> checkpoint = app_->getCheckpoint();
+  if (Teuchos::nonnull(checkpoint))
+    checkpoint->observe(stamp, nonOverlappedSolutionT,
+                        nonOverlappedSolutionDotT.get(), nonOverlappedSolutionDotDotT.get(),
+                        app_->getStateMgr(), app_->getAdaptSolMgrT()->getAdaptationStep());
 }
 
 void ObserverImpl::observeSolutionT(
@@ -97,6 +103,15 @@ void ObserverImpl::observeSolutionT(
   app_->getStateMgr().updateStates();
 
   StatelessObserverImpl::observeSolutionT(stamp, nonOverlappedSolutionT);
+
+  const Teuchos::RCP<Checkpoint> checkpoint = app_->getCheckpoint();
+  if (Teuchos::nonnull(checkpoint)) {
+    const int n = nonOverlappedSolutionT.getNumVectors();
+    checkpoint->observe(stamp, *nonOverlappedSolutionT.getVector(0),
+                        n > 1 ? nonOverlappedSolutionT.getVector(1).get() : NULL,
+                        n > 2 ? nonOverlappedSolutionT.getVector(2).get() : NULL,
+                        app_->getStateMgr(), app_->getAdaptSolMgrT()->getAdaptationStep());
+  }
 }
 
 } // namespace Albany
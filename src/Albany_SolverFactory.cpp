@@ -15,6 +15,7 @@
 #include "Petra_Converters.hpp"
 #include "Piro_Epetra_SolverFactory.hpp"
 #endif
+#include "Albany_ExplicitDynamicsSolver.hpp"
 #include "Albany_ModelFactory.hpp"
 #include "Albany_PiroObserverT.hpp"
 
@@ -863,6 +864,22 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
   }
 #endif /* LCM and Schwarz */
 
+  if (solutionMethod == "Transient Explicit") {
+    // Explicit central differences with a lumped mass: only residuals are
+    // evaluated, so neither Piro nor a linear solver is set up.
+    if (createAlbanyApp) {
+      albanyApp = rcp(new Albany::Application(
+          appComm, appParams, initial_guess, is_schwarz_));
+    }
+    problemParams->sublist("Response Functions")
+        .validateParameters(*getValidResponseParameters(), 0);
+    Albany::ModelFactory modelFactory(appParams, albanyApp);
+    modelT_    = modelFactory.createT();
+    observerT_ = rcp(new PiroObserverT(albanyApp, modelT_));
+    return rcp(new Albany::ExplicitDynamicsSolver(
+        Teuchos::sublist(appParams, "Piro"), albanyApp, modelT_, observerT_));
+  }
+
   RCP<Albany::Application> app = albanyApp;
   modelT_ =
       createAlbanyAppAndModelT(app, appComm, initial_guess, createAlbanyApp);
@@ -892,6 +909,7 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
   RCP<Thyra::ModelEvaluator<ST>> modelWithSolveT;
   if (Teuchos::nonnull(modelT_->get_W_factory())) {
     modelWithSolveT = modelT_;
+    lowsFactoryT_   = modelT_->get_W_factory();
   } else {
     // Setup linear solver
     Stratimikos::DefaultLinearSolverBuilder linearSolverBuilder;
@@ -907,6 +925,7 @@ Albany::SolverFactory::createAndGetAlbanyAppT(
 
     modelWithSolveT = rcp(new Thyra::DefaultModelEvaluatorWithSolveFactory<ST>(
         modelT_, lowsFactory));
+    lowsFactoryT_ = lowsFactory;
   }
 
   const RCP<Thyra::AdaptiveSolutionManager> solMgrT = app->getAdaptSolMgrT();
@@ -1437,6 +1456,7 @@ Albany::SolverFactory::getValidAppParameters() const
   validPL->sublist("Regression Results", false, "Regression Results sublist");
   validPL->sublist("VTK", false, "DEPRECATED  VTK sublist");
   validPL->sublist("Piro", false, "Piro sublist");
+  validPL->sublist("Checkpoint", false, "Checkpoint and restart sublist");
   validPL->sublist("Coupled System", false, "Coupled system sublist");
   validPL->sublist("Alternating System", false, "Alternating system sublist");
 
@@ -208,6 +208,13 @@ class SolverFactory {
     return observerT_;
   };
 
+  //! Linear solver of the model returned by returnModelT()
+  Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>>
+  returnLinearSolveFactoryT() const
+  {
+    return lowsFactoryT_;
+  };
+
 #if defined(ALBANY_EPETRA)
   /** \brief Function that does regression testing for SG runs. */
   int
@@ -241,6 +248,8 @@ class SolverFactory {
 
   Teuchos::RCP<Piro::ObserverBase<double>> observerT_;
 
+  Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>> lowsFactoryT_;
+
  protected:
   //! Parameter list specifying what solver to create
   Teuchos::RCP<Teuchos::ParameterList> appParams;
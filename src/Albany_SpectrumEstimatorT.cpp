@@ -0,0 +1,124 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_SpectrumEstimatorT.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "Teuchos_LAPACK.hpp"
+#include "Teuchos_TestForException.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+
+Albany::SpectrumEstimatorT::SpectrumEstimatorT(
+    const int max_iterations,
+    const ST  tolerance)
+    : max_iterations_(max_iterations), tolerance_(tolerance)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      max_iterations_ < 1,
+      std::logic_error,
+      "Error in Albany::SpectrumEstimatorT: the number of iterations must be "
+      "positive.\n");
+}
+
+Albany::SpectrumEstimateT
+Albany::SpectrumEstimatorT::estimate(const Tpetra_Operator& J) const
+{
+  TEUCHOS_FUNC_TIME_MONITOR("Albany: Spectrum Estimate");
+
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      !J.hasTransposeApply(),
+      std::logic_error,
+      "Error in Albany::SpectrumEstimatorT: the operator does not support "
+      "transpose products.\n");
+
+  const Teuchos::RCP<const Tpetra_Map> map = J.getDomainMap();
+
+  // Lanczos vectors of J^T J
+  Tpetra_MultiVector V(map, max_iterations_ + 1);
+  Tpetra_Vector      Jv(J.getRangeMap());
+  Tpetra_Vector      w(map);
+
+  // Start vector with pseudo-random entries that only depend on the global
+  // index, so the estimates, and the logs, do not change from run to run or
+  // with the number of processes
+  const Teuchos::RCP<Tpetra_Vector> v0 = V.getVectorNonConst(0);
+  {
+    const Teuchos::ArrayRCP<ST> v0_view = v0->get1dViewNonConst();
+    for (LO i = 0; i < static_cast<LO>(v0_view.size()); ++i) {
+      const ST x = std::sin(12.9898 * map->getGlobalElement(i)) * 43758.5453;
+      v0_view[i] = 0.5 + (x - std::floor(x));
+    }
+  }
+  v0->scale(1.0 / v0->norm2());
+
+  std::vector<ST>          alpha;
+  std::vector<ST>          beta;
+  SpectrumEstimateT        result;
+  Teuchos::LAPACK<int, ST> lapack;
+
+  for (int j = 0; j < max_iterations_; ++j) {
+    const Teuchos::RCP<const Tpetra_Vector> v = V.getVector(j);
+    J.apply(*v, Jv);
+    J.apply(Jv, w, Teuchos::TRANS);
+    result.num_matvecs += 2;
+
+    // Three-term recurrence, then one pass of full reorthogonalization
+    alpha.push_back(w.dot(*v));
+    w.update(-alpha[j], *v, 1.0);
+    if (j > 0) w.update(-beta[j - 1], *V.getVector(j - 1), 1.0);
+    for (int i = 0; i <= j; ++i) {
+      const Teuchos::RCP<const Tpetra_Vector> v_i = V.getVector(i);
+      w.update(-w.dot(*v_i), *v_i, 1.0);
+    }
+    beta.push_back(w.norm2());
+    result.num_iterations = j + 1;
+
+    // Ritz values in ascending order and the last components of the Ritz
+    // vectors, which give their residuals beta_j |z_m|
+    const int       m = j + 1;
+    std::vector<ST> d(alpha);
+    std::vector<ST> e(beta.begin(), beta.end() - 1);
+    std::vector<ST> z(m * m);
+    std::vector<ST> work(std::max(1, 2 * m - 2));
+    int             info = 0;
+    lapack.STEQR(
+        'I', m, d.data(), e.data(), z.data(), m, work.data(), &info);
+    TEUCHOS_TEST_FOR_EXCEPTION(
+        info != 0,
+        std::runtime_error,
+        "Error in Albany::SpectrumEstimatorT: STEQR returned " << info
+                                                                << ".\n");
+
+    const ST theta_min = std::max(d[0], 0.0);
+    const ST theta_max = d[m - 1];
+    const ST r_min     = beta[j] * std::abs(z[m - 1]);
+    const ST r_max     = beta[j] * std::abs(z[m - 1 + (m - 1) * m]);
+    const ST inf       = std::numeric_limits<ST>::infinity();
+
+    result.sigma_max    = std::sqrt(theta_max);
+    result.sigma_min    = std::sqrt(theta_min);
+    result.residual_max = theta_max > 0.0 ? r_max / theta_max : inf;
+    result.residual_min = theta_min > 0.0 ? r_min / theta_min : inf;
+    result.condition_number =
+        theta_min > 0.0 ? result.sigma_max / result.sigma_min : inf;
+
+    if (result.residual_max <= tolerance_ && result.residual_min <= tolerance_)
+      break;
+
+    // Invariant subspace: the Ritz values are eigenvalues
+    if (beta[j] <= std::numeric_limits<ST>::epsilon() * theta_max) break;
+
+    if (j + 1 < max_iterations_)
+      V.getVectorNonConst(j + 1)->update(1.0 / beta[j], w, 0.0);
+  }
+
+  result.valid = true;
+  return result;
+}
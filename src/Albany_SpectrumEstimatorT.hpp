@@ -0,0 +1,65 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_SPECTRUMESTIMATORT_HPP
+#define ALBANY_SPECTRUMESTIMATORT_HPP
+
+#include "Albany_DataTypes.hpp"
+
+namespace Albany {
+
+//! Extreme singular values and condition number of an operator
+struct SpectrumEstimateT
+{
+  //! False until an estimate has been computed
+  bool valid = false;
+
+  ST sigma_max        = 0.0;
+  ST sigma_min        = 0.0;
+  ST condition_number = 0.0;
+
+  //! Relative residuals of the extreme Ritz pairs of J^T J
+  ST residual_max = 0.0;
+  ST residual_min = 0.0;
+
+  int num_iterations = 0;
+  int num_matvecs    = 0;
+};
+
+/*!
+ * \brief Cheap estimate of the extreme singular values of a Jacobian
+ *
+ * Runs a few Lanczos iterations on J^T J, with one product by J and one by
+ * J^T each, and takes the square roots of the extreme Ritz values of the
+ * tridiagonal matrix. The Lanczos vectors are kept and reorthogonalized,
+ * which for a few dozen iterations costs less than the products. The
+ * iterations stop once both extreme Ritz pairs have a relative residual
+ * below the tolerance, or after the maximum number of iterations.
+ *
+ * Ritz values lie inside the spectrum, so sigma_max and sigma_min are a
+ * lower and an upper bound, and the condition number is a lower bound.
+ * sigma_max converges in a few iterations; sigma_min, and so the condition
+ * number, is an order of magnitude estimate unless residual_min is small.
+ * It replaces the Epetra-only AztecOO estimate, which runs a full Krylov
+ * solve.
+ */
+class SpectrumEstimatorT
+{
+ public:
+  SpectrumEstimatorT(const int max_iterations, const ST tolerance);
+
+  //! Estimate for J, which must support transpose products
+  SpectrumEstimateT
+  estimate(const Tpetra_Operator& J) const;
+
+ private:
+  int max_iterations_;
+  ST  tolerance_;
+};
+
+}  // namespace Albany
+
+#endif  // ALBANY_SPECTRUMESTIMATORT_HPP
@@ -0,0 +1,278 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "Albany_TruncatedGaussNewtonT.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Albany_GaussNewtonHessianT.hpp"
+#include "Albany_Utils.hpp"
+
+#include "Teuchos_TestForException.hpp"
+#include "Teuchos_TimeMonitor.hpp"
+#include "Teuchos_VerboseObject.hpp"
+#include "Thyra_TpetraThyraWrappers.hpp"
+
+namespace {
+
+// Relative distance to a bound below which the bound is active
+const ST bound_tol = 1.0e-8;
+
+}  // namespace
+
+Albany::TruncatedGaussNewtonT::TruncatedGaussNewtonT(
+    const Teuchos::RCP<Teuchos::ParameterList>&                        params,
+    const Teuchos::RCP<Thyra::ModelEvaluator<ST>>&                     solver,
+    const Teuchos::RCP<Application>&                                   app,
+    const Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>>& lowsFactory)
+    : params_(params),
+      solver_(solver),
+      app_(app),
+      lowsFactory_(lowsFactory),
+      out_(Teuchos::VerboseObjectBase::getDefaultOStream()),
+      has_lower_bound_(false),
+      has_upper_bound_(false),
+      num_state_solves_(0)
+{
+  params_->validateParametersAndSetDefaults(
+      *getValidTruncatedGaussNewtonParameters(), 0);
+
+  // The parameter and its bounds, from the problem's Distributed Parameters
+  const Teuchos::ParameterList& distParams =
+      app_->getProblemPL()->sublist("Distributed Parameters");
+  const int num_dist_params =
+      distParams.get("Number of Parameter Vectors", 0);
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      num_dist_params == 0,
+      std::logic_error,
+      "Error in Albany::TruncatedGaussNewtonT: the problem has no distributed "
+      "parameters.\n");
+
+  param_name_ = params_->get<std::string>("Parameter Name");
+  for (int i = 0; i < num_dist_params; ++i) {
+    const std::string sublist_name = Albany::strint("Distributed Parameter", i);
+    if (!distParams.isSublist(sublist_name)) continue;
+    const Teuchos::ParameterList& paramList = distParams.sublist(sublist_name);
+    const std::string name = paramList.get<std::string>("Name", "");
+    if (param_name_.empty() && i == 0) param_name_ = name;
+    if (name != param_name_) continue;
+    has_lower_bound_ = paramList.isParameter("Lower Bound");
+    has_upper_bound_ = paramList.isParameter("Upper Bound");
+  }
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      !app_->getDistParamLib()->has(param_name_),
+      std::logic_error,
+      "Error in Albany::TruncatedGaussNewtonT: no distributed parameter named \""
+          << param_name_ << "\".\n");
+}
+
+Teuchos::RCP<const Teuchos::ParameterList>
+Albany::TruncatedGaussNewtonT::getValidTruncatedGaussNewtonParameters()
+{
+  Teuchos::RCP<Teuchos::ParameterList> validPL =
+      Teuchos::rcp(new Teuchos::ParameterList("ValidTruncatedGaussNewtonParams"));
+  validPL->set<int>("Response Index", 0, "Scalar response to minimize");
+  validPL->set<std::string>(
+      "Parameter Name",
+      "",
+      "Distributed parameter, empty for the first one");
+  validPL->set<int>("Max Iterations", 20, "Gauss-Newton iterations");
+  validPL->set<double>(
+      "Gradient Tolerance",
+      1.0e-6,
+      "Reduction of the gradient norm that stops the iterations");
+  validPL->set<int>(
+      "Max CG Iterations", 50, "Hessian-vector products per iteration");
+  validPL->set<double>(
+      "Forcing Term", 0.5, "Largest relative residual of the CG solve");
+  validPL->set<double>(
+      "Sufficient Decrease", 1.0e-4, "Armijo constant of the line search");
+  validPL->set<int>("Max Backtracks", 10, "Step halvings per iteration");
+  return validPL;
+}
+
+Teuchos::RCP<Tpetra_Vector>
+Albany::TruncatedGaussNewtonT::solveState()
+{
+  app_->getDistParamLib()->get(param_name_)->scatter();
+
+  // The solution is the last response of the Piro solver
+  const Thyra::ModelEvaluatorBase::InArgs<ST> inArgs =
+      solver_->getNominalValues();
+  Thyra::ModelEvaluatorBase::OutArgs<ST> outArgs = solver_->createOutArgs();
+  const int solution_index = outArgs.Ng() - 1;
+  const Teuchos::RCP<Thyra::VectorBase<ST>> x =
+      Thyra::createMember(solver_->get_g_space(solution_index));
+  outArgs.set_g(solution_index, x);
+  solver_->evalModel(inArgs, outArgs);
+  ++num_state_solves_;
+
+  return Teuchos::rcp(
+      new Tpetra_Vector(*ConverterT::getConstTpetraVector(x), Teuchos::Copy));
+}
+
+void
+Albany::TruncatedGaussNewtonT::project(Tpetra_Vector& p) const
+{
+  const Teuchos::RCP<const DistParam> param =
+      app_->getDistParamLib()->get(param_name_);
+  const Teuchos::ArrayRCP<ST> p_view = p.get1dViewNonConst();
+  if (has_lower_bound_) {
+    const Teuchos::ArrayRCP<const ST> lower =
+        param->lower_bounds_vector()->get1dView();
+    for (int i = 0; i < p_view.size(); ++i)
+      p_view[i] = std::max(p_view[i], lower[i]);
+  }
+  if (has_upper_bound_) {
+    const Teuchos::ArrayRCP<const ST> upper =
+        param->upper_bounds_vector()->get1dView();
+    for (int i = 0; i < p_view.size(); ++i)
+      p_view[i] = std::min(p_view[i], upper[i]);
+  }
+}
+
+void
+Albany::TruncatedGaussNewtonT::freeVariables(
+    const Tpetra_Vector& p,
+    const Tpetra_Vector& grad,
+    Tpetra_Vector&       free) const
+{
+  const Teuchos::RCP<const DistParam> param =
+      app_->getDistParamLib()->get(param_name_);
+  const Teuchos::ArrayRCP<const ST> p_view    = p.get1dView();
+  const Teuchos::ArrayRCP<const ST> grad_view = grad.get1dView();
+  const Teuchos::ArrayRCP<ST>       free_view = free.get1dViewNonConst();
+  free.putScalar(1.0);
+  if (has_lower_bound_) {
+    const Teuchos::ArrayRCP<const ST> lower =
+        param->lower_bounds_vector()->get1dView();
+    for (int i = 0; i < p_view.size(); ++i)
+      if (p_view[i] <= lower[i] + bound_tol * (1.0 + std::abs(lower[i])) &&
+          grad_view[i] > 0.0)
+        free_view[i] = 0.0;
+  }
+  if (has_upper_bound_) {
+    const Teuchos::ArrayRCP<const ST> upper =
+        param->upper_bounds_vector()->get1dView();
+    for (int i = 0; i < p_view.size(); ++i)
+      if (p_view[i] >= upper[i] - bound_tol * (1.0 + std::abs(upper[i])) &&
+          grad_view[i] < 0.0)
+        free_view[i] = 0.0;
+  }
+}
+
+int
+Albany::TruncatedGaussNewtonT::run(Teuchos::RCP<Thyra::VectorBase<ST>>& p_out)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("Albany: Truncated Gauss-Newton");
+
+  const int response_index = params_->get<int>("Response Index");
+  const int max_iter       = params_->get<int>("Max Iterations");
+  const ST  grad_tol       = params_->get<double>("Gradient Tolerance");
+  const int max_cg_iter    = params_->get<int>("Max CG Iterations");
+  const ST  forcing        = params_->get<double>("Forcing Term");
+  const ST  armijo         = params_->get<double>("Sufficient Decrease");
+  const int max_backtracks = params_->get<int>("Max Backtracks");
+
+  GaussNewtonHessianT hessian(app_, lowsFactory_, response_index, param_name_);
+  const Teuchos::RCP<const Tpetra_Map> map = hessian.getParameterMap();
+  const Teuchos::RCP<Tpetra_Vector>    p =
+      app_->getDistParamLib()->get(param_name_)->vector();
+
+  project(*p);
+  hessian.setPoint(*solveState());
+
+  Tpetra_Vector grad(map), free(map), d(map), r(map), z(map), Hz(map);
+  Tpetra_Vector p_old(map);
+  ST G = hessian.computeGradient(grad);
+  freeVariables(*p, grad, free);
+  r.elementWiseMultiply(1.0, free, grad, 0.0);
+  const ST grad_norm0   = r.norm2();
+  int      num_hess_vec = 0;
+  bool     converged    = false;
+  int      iter         = 0;
+
+  for (;; ++iter) {
+    // Projected gradient, zero where a bound is active
+    r.elementWiseMultiply(-1.0, free, grad, 0.0);
+    const ST grad_norm = r.norm2();
+    *out_ << "Truncated Gauss-Newton iteration " << iter << ": objective " << G
+          << ", projected gradient norm " << grad_norm << std::endl;
+    if (grad_norm <= grad_tol * grad_norm0) {
+      converged = true;
+      break;
+    }
+    if (iter == max_iter) break;
+
+    // Inexact solve of H d = -grad on the free variables by conjugate
+    // gradients
+    const ST eta = std::min(forcing, std::sqrt(grad_norm / grad_norm0));
+    d.putScalar(0.0);
+    z.assign(r);
+    ST rr = r.dot(r);
+    for (int k = 0; k < max_cg_iter; ++k) {
+      hessian.apply(z, Hz);
+      Hz.elementWiseMultiply(1.0, free, Hz, 0.0);
+      ++num_hess_vec;
+      const ST zHz = z.dot(Hz);
+      if (zHz <= 0.0) {
+        // Direction of non-positive curvature: keep the step so far, or
+        // fall back to steepest descent
+        if (k == 0) d.assign(r);
+        break;
+      }
+      const ST alpha = rr / zHz;
+      d.update(alpha, z, 1.0);
+      r.update(-alpha, Hz, 1.0);
+      const ST rr_new = r.dot(r);
+      if (std::sqrt(rr_new) <= eta * grad_norm) break;
+      z.update(1.0, r, rr_new / rr);
+      rr = rr_new;
+    }
+    if (grad.dot(d) >= 0.0) d.elementWiseMultiply(-1.0, free, grad, 0.0);
+
+    // Backtracking along the projected path p(s) = P(p + s d)
+    p_old.assign(*p);
+    Teuchos::RCP<Tpetra_Vector> x_trial;
+    ST   G_trial  = G;
+    bool accepted = false;
+    ST   step     = 1.0;
+    for (int b = 0; b <= max_backtracks; ++b, step *= 0.5) {
+      p->update(1.0, p_old, step, d, 0.0);
+      project(*p);
+      x_trial = solveState();
+      G_trial = hessian.evaluateResponse(*x_trial);
+      Tpetra_Vector s(*p, Teuchos::Copy);
+      s.update(-1.0, p_old, 1.0);
+      if (G_trial <= G + armijo * grad.dot(s)) {
+        accepted = true;
+        break;
+      }
+    }
+    if (!accepted) {
+      *out_ << "Truncated Gauss-Newton: line search failed" << std::endl;
+      p->assign(p_old);
+      app_->getDistParamLib()->get(param_name_)->scatter();
+      break;
+    }
+
+    hessian.setPoint(*x_trial);
+    G = hessian.computeGradient(grad);
+    freeVariables(*p, grad, free);
+  }
+
+  *out_ << "Truncated Gauss-Newton " << (converged ? "converged" : "did not converge")
+        << " after " << iter << " iterations: " << num_state_solves_
+        << " nonlinear solves, " << hessian.getNumLinearSolves()
+        << " linear solves, " << num_hess_vec << " Hessian-vector products"
+        << std::endl;
+
+  p_out = Thyra::createVector<ST, LO, Tpetra_GO, KokkosNode>(
+      Teuchos::rcp(new Tpetra_Vector(*p, Teuchos::Copy)),
+      Thyra::createVectorSpace<ST, LO, Tpetra_GO, KokkosNode>(map));
+  return converged ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_TRUNCATEDGAUSSNEWTONT_HPP
+#define ALBANY_TRUNCATEDGAUSSNEWTONT_HPP
+
+#include <string>
+
+#include "Albany_Application.hpp"
+#include "Albany_DataTypes.hpp"
+
+#include "Teuchos_ParameterList.hpp"
+#include "Teuchos_RCP.hpp"
+#include "Thyra_LinearOpWithSolveFactoryBase.hpp"
+#include "Thyra_ModelEvaluator.hpp"
+#include "Thyra_VectorBase.hpp"
+
+namespace Albany {
+
+/*!
+ * \brief Truncated Gauss-Newton inversion for a distributed parameter
+ *
+ * Selected with Analysis Package = "Truncated Gauss-Newton" in the
+ * "Analysis" list of "Piro", and run by AlbanyAnalysisT. It minimizes a
+ * scalar response of a steady problem over a distributed parameter,
+ * starting from its current value. Each iteration solves the Gauss-Newton
+ * system H d = -dG/dp of GaussNewtonHessianT by conjugate gradients,
+ * stopped early by the forcing term, and backtracks along d projected on
+ * the parameter bounds. Variables held at a bound by the gradient are left
+ * out of the system (projected Newton), and convergence is measured on the
+ * projected gradient.
+ *
+ * H is not the full reduced Hessian: the second derivatives of the residual
+ * would need second-order PHAL evaluation types. The method converges fast
+ * when the misfit at the optimum is small, and linearly otherwise.
+ *
+ * Only the trial points of the line search need a nonlinear solve; the
+ * gradient costs one linear solve and each Hessian-vector product two, with
+ * the preconditioners built once per iteration. A gradient-only method
+ * instead pays a nonlinear and an adjoint solve for every iteration and
+ * takes many more of them on ill-conditioned inversions.
+ *
+ * Parameters, in the "Truncated Gauss-Newton" sublist of "Analysis":
+ *
+ *   Response Index             Scalar response minimized, default 0.
+ *   Parameter Name             Distributed parameter, default the first one.
+ *   Max Iterations             Gauss-Newton iterations, default 20.
+ *   Gradient Tolerance         Stop when |dG/dp| <= tol |dG/dp|_0, default
+ *                              1e-6.
+ *   Max CG Iterations          Hessian-vector products per iteration,
+ *                              default 50.
+ *   Forcing Term               Largest relative CG residual, default 0.5. It
+ *                              decreases as sqrt(|dG/dp| / |dG/dp|_0).
+ *   Sufficient Decrease        Armijo constant, default 1e-4.
+ *   Max Backtracks             Step halvings per iteration, default 10.
+ *
+ * The bounds are the Lower Bound and Upper Bound of the parameter in the
+ * "Distributed Parameters" list of the problem, when given.
+ */
+class TruncatedGaussNewtonT
+{
+ public:
+  TruncatedGaussNewtonT(
+      const Teuchos::RCP<Teuchos::ParameterList>&                        params,
+      const Teuchos::RCP<Thyra::ModelEvaluator<ST>>&                     solver,
+      const Teuchos::RCP<Application>&                                   app,
+      const Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>>& lowsFactory);
+
+  //! Minimize and return the parameter in p; 0 if converged
+  int
+  run(Teuchos::RCP<Thyra::VectorBase<ST>>& p);
+
+  static Teuchos::RCP<const Teuchos::ParameterList>
+  getValidTruncatedGaussNewtonParameters();
+
+ private:
+  //! Solution of f(x, p) = 0 for the current parameter
+  Teuchos::RCP<Tpetra_Vector>
+  solveState();
+
+  //! Clip p to the parameter bounds
+  void
+  project(Tpetra_Vector& p) const;
+
+  //! 0 where p is at a bound and -grad points out of the bounds, 1 elsewhere
+  void
+  freeVariables(
+      const Tpetra_Vector& p,
+      const Tpetra_Vector& grad,
+      Tpetra_Vector&       free) const;
+
+  Teuchos::RCP<Teuchos::ParameterList>                        params_;
+  Teuchos::RCP<Thyra::ModelEvaluator<ST>>                     solver_;
+  Teuchos::RCP<Application>                                   app_;
+  Teuchos::RCP<const Thyra::LinearOpWithSolveFactoryBase<ST>> lowsFactory_;
+  Teuchos::RCP<Teuchos::FancyOStream>                         out_;
+
+  std::string param_name_;
+  bool        has_lower_bound_;
+  bool        has_upper_bound_;
+  int         num_state_solves_;
+};
+
+}  // namespace Albany
+
+#endif  // ALBANY_TRUNCATEDGAUSSNEWTONT_HPP
@@ -23,6 +23,19 @@ namespace LCM {
 ///  This evaluator checks whether a material point has become
 ///  unstable
 ///
+///  The minimum of det(A(n)) over the unit sphere, with A(n) the acoustic
+///  tensor, is bracketed by a sweep of the selected parametrization on the
+///  values of the tangent and refined by Newton-Raphson on the full ScalarT.
+///
+///  With "Bifurcation Warm Start" the Newton-Raphson starts instead from the
+///  direction of the last converged step, read from the old state of the
+///  direction field, which must then be registered with its old state. The
+///  sweep is skipped while the normalized ellipticity margin
+///  det(A) / (tr(A) / 3)^3 at the minimum so found, 1 for A = a I and 0 at
+///  bifurcation, stays above "Bifurcation Screening Margin". Below it the
+///  sweep runs and the lower of both minima is kept, so the onset is the one
+///  of the full check.
+///
 template <typename EvalT, typename Traits>
 class BifurcationCheck : public PHX::EvaluatorWithBaseImpl<Traits>,
                          public PHX::EvaluatorDerived<EvalT, Traits> {
@@ -60,6 +73,15 @@ class BifurcationCheck : public PHX::EvaluatorWithBaseImpl<Traits>,
   //! Input: Parametrization sweep interval
   double parametrization_interval_;
 
+  //! Input: start from the direction of the last converged step
+  bool warm_start_;
+
+  //! Input: ellipticity margin above which the sweep is skipped
+  double screening_margin_;
+
+  //! Name of the direction field, whose old state holds the last direction
+  std::string direction_name_;
+
   //! Input: material tangent
   PHX::MDField<const ScalarT, Cell, QuadPoint, Dim, Dim, Dim, Dim> tangent_;
 
@@ -79,50 +101,80 @@ class BifurcationCheck : public PHX::EvaluatorWithBaseImpl<Traits>,
   int num_dims_;
 
   ///
-  /// Spherical parametrization sweep
+  /// Sweep of the selected parametrization followed by Newton-Raphson
+  ///
+  ScalarT sweep_minimum(
+      minitensor::Tensor4<ScalarT, 3> const&  tangent,
+      minitensor::Tensor4<RealType, 3> const& tangent_val,
+      minitensor::Vector<ScalarT, 3>&         direction);
+
+  ///
+  /// Newton-Raphson of the selected parametrization from a given direction
   ///
-  ScalarT spherical_sweep(
+  ScalarT local_minimum(
       minitensor::Tensor4<ScalarT, 3> const& tangent,
-      minitensor::Vector<ScalarT, 2>&        arg_minimum,
-      minitensor::Vector<ScalarT, 3>&        direction,
-      double const&                          interval);
+      minitensor::Vector<RealType, 3> const& guess,
+      minitensor::Vector<ScalarT, 3>&        direction);
 
   ///
-  /// Stereographic parametrization sweep
+  /// det(A(n)) / (tr(A(n)) / 3)^3, or -1 if tr(A(n)) <= 0
+  ///
+  RealType ellipticity_margin(
+      minitensor::Tensor4<RealType, 3> const& tangent,
+      minitensor::Vector<RealType, 3> const&  direction);
+
+  ///
+  /// det(A(n)) with A(n) the acoustic tensor
   ///
-  ScalarT stereographic_sweep(
+  ScalarT acoustic_det(
       minitensor::Tensor4<ScalarT, 3> const& tangent,
-      minitensor::Vector<ScalarT, 2>&        arg_minimum,
-      minitensor::Vector<ScalarT, 3>&        direction,
-      double const&                          interval);
+      minitensor::Vector<ScalarT, 3> const&  direction);
+
+  ///
+  /// Spherical parametrization sweep
+  ///
+  RealType spherical_sweep(
+      minitensor::Tensor4<RealType, 3> const& tangent,
+      minitensor::Vector<RealType, 2>&        arg_minimum,
+      minitensor::Vector<RealType, 3>&        direction,
+      double const&                           interval);
+
+  ///
+  /// Stereographic parametrization sweep
+  ///
+  RealType stereographic_sweep(
+      minitensor::Tensor4<RealType, 3> const& tangent,
+      minitensor::Vector<RealType, 2>&        arg_minimum,
+      minitensor::Vector<RealType, 3>&        direction,
+      double const&                           interval);
 
   ///
   /// Projective parametrization sweep
   ///
-  ScalarT projective_sweep(
-      minitensor::Tensor4<ScalarT, 3> const& tangent,
-      minitensor::Vector<ScalarT, 3>&        arg_minimum,
-      minitensor::Vector<ScalarT, 3>&        direction,
-      double const&                          interval);
+  RealType projective_sweep(
+      minitensor::Tensor4<RealType, 3> const& tangent,
+      minitensor::Vector<RealType, 3>&        arg_minimum,
+      minitensor::Vector<RealType, 3>&        direction,
+      double const&                           interval);
 
   ///
   /// Tangent parametrization sweep
   ///
-  ScalarT tangent_sweep(
-      minitensor::Tensor4<ScalarT, 3> const& tangent,
-      minitensor::Vector<ScalarT, 2>&        arg_minimum,
-      minitensor::Vector<ScalarT, 3>&        direction,
-      double const&                          interval);
+  RealType tangent_sweep(
+      minitensor::Tensor4<RealType, 3> const& tangent,
+      minitensor::Vector<RealType, 2>&        arg_minimum,
+      minitensor::Vector<RealType, 3>&        direction,
+      double const&                           interval);
 
   ///
   /// Cartesian parametrization sweep
   ///
-  ScalarT cartesian_sweep(
-      minitensor::Tensor4<ScalarT, 3> const& tangent,
-      minitensor::Vector<ScalarT, 2>&        arg_minimum,
-      int                                    surface_index,
-      minitensor::Vector<ScalarT, 3>&        direction,
-      double const&                          interval);
+  RealType cartesian_sweep(
+      minitensor::Tensor4<RealType, 3> const& tangent,
+      minitensor::Vector<RealType, 2>&        arg_minimum,
+      int                                     surface_index,
+      minitensor::Vector<RealType, 3>&        direction,
+      double const&                           interval);
 
   ///
   /// Newton-Raphson method to find exact min DetA and direction
@@ -161,10 +213,10 @@ class BifurcationCheck : public PHX::EvaluatorWithBaseImpl<Traits>,
   ///
   /// PSO method
   ///
-  ScalarT stereographic_pso(
-      minitensor::Tensor4<ScalarT, 3> const& tangent,
-      minitensor::Vector<ScalarT, 2>&        arg_minimum,
-      minitensor::Vector<ScalarT, 3>&        direction);
+  RealType stereographic_pso(
+      minitensor::Tensor4<RealType, 3> const& tangent,
+      minitensor::Vector<RealType, 2>&        arg_minimum,
+      minitensor::Vector<RealType, 3>&        direction);
 
   ///
   /// Get normal
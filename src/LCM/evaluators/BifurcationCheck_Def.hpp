@@ -4,6 +4,8 @@
 //    in the file "license.txt" in the top-level Albany directory  //
 //*****************************************************************//
 
+#include <algorithm>
+#include <cmath>
 #include <random>
 #include <typeinfo>
 
@@ -22,6 +24,14 @@ BifurcationCheck<EvalT, Traits>::BifurcationCheck(
     const Teuchos::RCP<Albany::Layouts>& dl)
     : parametrization_type_(p.get<std::string>("Parametrization Type Name")),
       parametrization_interval_(p.get<double>("Parametrization Interval Name")),
+      warm_start_(
+          p.isParameter("Bifurcation Warm Start") &&
+          p.get<bool>("Bifurcation Warm Start")),
+      screening_margin_(
+          p.isParameter("Bifurcation Screening Margin") ?
+              p.get<double>("Bifurcation Screening Margin") :
+              0.5),
+      direction_name_(p.get<std::string>("Bifurcation Direction Name")),
       tangent_(p.get<std::string>("Material Tangent Name"), dl->qp_tensor4),
       ellipticity_flag_(
           p.get<std::string>("Ellipticity Flag Name"),
@@ -63,97 +73,66 @@ void
 BifurcationCheck<EvalT, Traits>::evaluateFields(
     typename Traits::EvalData workset)
 {
-  minitensor::Vector<ScalarT, 3>  direction(1.0, 0.0, 0.0);
-  minitensor::Tensor4<ScalarT, 3> tangent;
-  bool                            ellipticity_flag(false);
-  ScalarT                         min_detA(1.0);
+  minitensor::Vector<ScalarT, 3>   direction(1.0, 0.0, 0.0);
+  minitensor::Vector<ScalarT, 3>   sweep_direction(1.0, 0.0, 0.0);
+  minitensor::Vector<RealType, 3>  guess;
+  minitensor::Vector<RealType, 3>  direction_val;
+  minitensor::Tensor4<ScalarT, 3>  tangent;
+  minitensor::Tensor4<RealType, 3> tangent_val;
+  bool                             ellipticity_flag(false);
+  ScalarT                          min_detA(1.0);
+
+  // The check of Oliver has no parametrization to start from a direction.
+  bool const warm_start = warm_start_ && parametrization_type_ != "Oliver";
+
+  Albany::MDArray direction_old;
+  if (warm_start) {
+    direction_old = (*workset.stateArrayPtr)[direction_name_ + "_old"];
+  }
 
   for (int cell(0); cell < workset.numCells; ++cell) {
     for (int pt(0); pt < num_pts_; ++pt) {
       tangent.fill(tangent_, cell, pt, 0, 0, 0, 0);
       ellipticity_flag_(cell, pt) = 0;
 
-      double interval = parametrization_interval_;
-
-      if (parametrization_type_ == "Oliver") {
-        boost::tie(ellipticity_flag, direction) =
-            minitensor::check_strong_ellipticity(tangent);
-        min_detA = minitensor::det(
-            minitensor::dot2(direction, minitensor::dot(tangent, direction)));
-      } else if (parametrization_type_ == "PSO") {
-        minitensor::Vector<ScalarT, 2> arg_minimum;
-
-        min_detA = stereographic_pso(tangent, arg_minimum, direction);
-
-      } else if (parametrization_type_ == "Spherical") {
-        minitensor::Vector<ScalarT, 2> arg_minimum;
-
-        min_detA = spherical_sweep(tangent, arg_minimum, direction, interval);
-        spherical_newton_raphson(tangent, arg_minimum, direction, min_detA);
-
-      } else if (parametrization_type_ == "Stereographic") {
-        minitensor::Vector<ScalarT, 2> arg_minimum;
-
-        min_detA =
-            stereographic_sweep(tangent, arg_minimum, direction, interval);
-        stereographic_newton_raphson(tangent, arg_minimum, direction, min_detA);
-
-      } else if (parametrization_type_ == "Projective") {
-        minitensor::Vector<ScalarT, 3> arg_minimum;
-
-        min_detA = projective_sweep(tangent, arg_minimum, direction, interval);
-        projective_newton_raphson(tangent, arg_minimum, direction, min_detA);
-
-      } else if (parametrization_type_ == "Tangent") {
-        minitensor::Vector<ScalarT, 2> arg_minimum;
-
-        min_detA = tangent_sweep(tangent, arg_minimum, direction, interval);
-        tangent_newton_raphson(tangent, arg_minimum, direction, min_detA);
-
-      } else if (parametrization_type_ == "Cartesian") {
-        minitensor::Vector<ScalarT, 2> arg_minimum1;
-        minitensor::Vector<ScalarT, 2> arg_minimum2;
-        minitensor::Vector<ScalarT, 2> arg_minimum3;
-        minitensor::Vector<ScalarT, 3> direction1(1.0, 0.0, 0.0);
-        minitensor::Vector<ScalarT, 3> direction2(0.0, 1.0, 0.0);
-        minitensor::Vector<ScalarT, 3> direction3(0.0, 0.0, 1.0);
-
-        ScalarT min_detA1 =
-            cartesian_sweep(tangent, arg_minimum1, 1, direction1, interval);
-
-        ScalarT min_detA2 =
-            cartesian_sweep(tangent, arg_minimum2, 2, direction2, interval);
-
-        ScalarT min_detA3 =
-            cartesian_sweep(tangent, arg_minimum3, 3, direction3, interval);
-
-        if (min_detA1 <= min_detA2 && min_detA1 <= min_detA3) {
-          cartesian_newton_raphson(
-              tangent, arg_minimum1, 1, direction1, min_detA1);
-
-          min_detA  = min_detA1;
-          direction = direction1;
-
-        } else if (min_detA2 <= min_detA1 && min_detA2 <= min_detA3) {
-          cartesian_newton_raphson(
-              tangent, arg_minimum2, 2, direction2, min_detA2);
-
-          min_detA  = min_detA2;
-          direction = direction2;
-
-        } else if (min_detA3 <= min_detA1 && min_detA3 <= min_detA2) {
-          cartesian_newton_raphson(
-              tangent, arg_minimum3, 3, direction3, min_detA3);
+      for (int i(0); i < 3; ++i) {
+        for (int j(0); j < 3; ++j) {
+          for (int k(0); k < 3; ++k) {
+            for (int l(0); l < 3; ++l) {
+              tangent_val(i, j, k, l) =
+                  Sacado::ScalarValue<ScalarT>::eval(tangent(i, j, k, l));
+            }
+          }
+        }
+      }
 
-          min_detA  = min_detA3;
-          direction = direction3;
+      // Zero before the first converged step
+      bool has_guess = false;
+      if (warm_start) {
+        guess.fill(minitensor::Filler::ZEROS);
+        for (int i(0); i < num_dims_; ++i) {
+          guess(i) = direction_old(cell, pt, i);
         }
+        has_guess = minitensor::norm(guess) > 0.0;
+      }
 
-      } else {
-        minitensor::Vector<ScalarT, 2> arg_minimum;
+      bool screened = false;
+      if (has_guess) {
+        min_detA = local_minimum(tangent, guess, direction);
+        for (int i(0); i < 3; ++i) {
+          direction_val(i) = Sacado::ScalarValue<ScalarT>::eval(direction(i));
+        }
+        screened =
+            ellipticity_margin(tangent_val, direction_val) > screening_margin_;
+      }
 
-        min_detA = spherical_sweep(tangent, arg_minimum, direction, interval);
-        spherical_newton_raphson(tangent, arg_minimum, direction, min_detA);
+      if (!screened) {
+        ScalarT const sweep_min_detA =
+            sweep_minimum(tangent, tangent_val, sweep_direction);
+        if (!has_guess || sweep_min_detA < min_detA) {
+          min_detA  = sweep_min_detA;
+          direction = sweep_direction;
+        }
       }
 
       ellipticity_flag = true;
@@ -173,36 +152,221 @@ BifurcationCheck<EvalT, Traits>::evaluateFields(
 
 //----------------------------------------------------------------------------
 template <typename EvalT, typename Traits>
-typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::spherical_sweep(
+typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::sweep_minimum(
+    minitensor::Tensor4<ScalarT, 3> const&  tangent,
+    minitensor::Tensor4<RealType, 3> const& tangent_val,
+    minitensor::Vector<ScalarT, 3>&         direction)
+{
+  double const interval = parametrization_interval_;
+
+  // The sweeps see the values of the tangent only. The minimum at the
+  // direction they find is evaluated again on the full ScalarT, so that it
+  // carries the derivatives when Newton-Raphson does not improve on it.
+  minitensor::Vector<RealType, 3> direction_val;
+  ScalarT                         min_detA;
+
+  if (parametrization_type_ == "Oliver") {
+    bool ellipticity_flag;
+    boost::tie(ellipticity_flag, direction) =
+        minitensor::check_strong_ellipticity(tangent);
+    min_detA = acoustic_det(tangent, direction);
+
+  } else if (parametrization_type_ == "PSO") {
+    minitensor::Vector<RealType, 2> arg_minimum;
+
+    stereographic_pso(tangent_val, arg_minimum, direction_val);
+    for (int i(0); i < 3; ++i) direction(i) = direction_val(i);
+    min_detA = acoustic_det(tangent, direction);
+
+  } else if (parametrization_type_ == "Stereographic") {
+    minitensor::Vector<RealType, 2> arg_minimum_val;
+    minitensor::Vector<ScalarT, 2>  arg_minimum;
+
+    stereographic_sweep(tangent_val, arg_minimum_val, direction_val, interval);
+    for (int i(0); i < 2; ++i) arg_minimum(i) = arg_minimum_val(i);
+    for (int i(0); i < 3; ++i) direction(i) = direction_val(i);
+    min_detA = acoustic_det(tangent, direction);
+    stereographic_newton_raphson(tangent, arg_minimum, direction, min_detA);
+
+  } else if (parametrization_type_ == "Projective") {
+    minitensor::Vector<RealType, 3> arg_minimum_val;
+    minitensor::Vector<ScalarT, 3>  arg_minimum;
+
+    projective_sweep(tangent_val, arg_minimum_val, direction_val, interval);
+    for (int i(0); i < 3; ++i) arg_minimum(i) = arg_minimum_val(i);
+    for (int i(0); i < 3; ++i) direction(i) = direction_val(i);
+    min_detA = acoustic_det(tangent, direction);
+    projective_newton_raphson(tangent, arg_minimum, direction, min_detA);
+
+  } else if (parametrization_type_ == "Tangent") {
+    minitensor::Vector<RealType, 2> arg_minimum_val;
+    minitensor::Vector<ScalarT, 2>  arg_minimum;
+
+    tangent_sweep(tangent_val, arg_minimum_val, direction_val, interval);
+    for (int i(0); i < 2; ++i) arg_minimum(i) = arg_minimum_val(i);
+    for (int i(0); i < 3; ++i) direction(i) = direction_val(i);
+    min_detA = acoustic_det(tangent, direction);
+    tangent_newton_raphson(tangent, arg_minimum, direction, min_detA);
+
+  } else if (parametrization_type_ == "Cartesian") {
+    RealType                        min_detA_val = 0.0;
+    int                             surface_index(0);
+    minitensor::Vector<RealType, 2> arg_minimum_val;
+
+    for (int surface(1); surface <= 3; ++surface) {
+      minitensor::Vector<RealType, 2> arg_surface;
+      minitensor::Vector<RealType, 3> direction_surface;
+
+      RealType const min_detA_surface = cartesian_sweep(
+          tangent_val, arg_surface, surface, direction_surface, interval);
+
+      if (surface_index == 0 || min_detA_surface < min_detA_val) {
+        min_detA_val    = min_detA_surface;
+        surface_index   = surface;
+        arg_minimum_val = arg_surface;
+        direction_val   = direction_surface;
+      }
+    }
+
+    minitensor::Vector<ScalarT, 2> arg_minimum;
+    for (int i(0); i < 2; ++i) arg_minimum(i) = arg_minimum_val(i);
+    for (int i(0); i < 3; ++i) direction(i) = direction_val(i);
+    min_detA = acoustic_det(tangent, direction);
+    cartesian_newton_raphson(
+        tangent, arg_minimum, surface_index, direction, min_detA);
+
+  } else {
+    minitensor::Vector<RealType, 2> arg_minimum_val;
+    minitensor::Vector<ScalarT, 2>  arg_minimum;
+
+    spherical_sweep(tangent_val, arg_minimum_val, direction_val, interval);
+    for (int i(0); i < 2; ++i) arg_minimum(i) = arg_minimum_val(i);
+    for (int i(0); i < 3; ++i) direction(i) = direction_val(i);
+    min_detA = acoustic_det(tangent, direction);
+    spherical_newton_raphson(tangent, arg_minimum, direction, min_detA);
+  }
+
+  return min_detA;
+}
+
+//----------------------------------------------------------------------------
+template <typename EvalT, typename Traits>
+typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::local_minimum(
     minitensor::Tensor4<ScalarT, 3> const& tangent,
-    minitensor::Vector<ScalarT, 2>&        arg_minimum,
-    minitensor::Vector<ScalarT, 3>&        direction,
-    double const&                          interval)
+    minitensor::Vector<RealType, 3> const& guess,
+    minitensor::Vector<ScalarT, 3>&        direction)
+{
+  // A(n) is even in n. Each parametrization gets the half of the sphere
+  // away from its singular point.
+  minitensor::Vector<RealType, 3> n = minitensor::unit(guess);
+
+  for (int i(0); i < 3; ++i) direction(i) = n(i);
+  ScalarT min_detA = acoustic_det(tangent, direction);
+
+  if (parametrization_type_ == "Stereographic" ||
+      parametrization_type_ == "PSO") {
+    // n = (2 x, 2 y, r^2 - 1) / (r^2 + 1), singular at n_2 = 1
+    if (n(2) > 0.0) n = -n;
+    minitensor::Vector<ScalarT, 2> parameters(
+        n(0) / (1.0 - n(2)), n(1) / (1.0 - n(2)));
+    stereographic_newton_raphson(tangent, parameters, direction, min_detA);
+
+  } else if (parametrization_type_ == "Projective") {
+    minitensor::Vector<ScalarT, 3> parameters(n(0), n(1), n(2));
+    projective_newton_raphson(tangent, parameters, direction, min_detA);
+
+  } else if (parametrization_type_ == "Tangent") {
+    // n = (x sin(r) / r, y sin(r) / r, cos(r)), singular at n_2 = -1
+    if (n(2) < 0.0) n = -n;
+    RealType const r     = std::acos(std::min(n(2), 1.0));
+    RealType const scale = r > 0.0 ? r / std::sin(r) : 1.0;
+    minitensor::Vector<ScalarT, 2> parameters(scale * n(0), scale * n(1));
+    tangent_newton_raphson(tangent, parameters, direction, min_detA);
+
+  } else if (parametrization_type_ == "Cartesian") {
+    // n is scaled to 1 on the surface of its largest component
+    int surface_index(0);
+    for (int i(1); i < 3; ++i) {
+      if (std::abs(n(i)) > std::abs(n(surface_index))) surface_index = i;
+    }
+    minitensor::Vector<ScalarT, 2> parameters;
+    for (int i(0), j(0); i < 3; ++i) {
+      if (i != surface_index) parameters(j++) = n(i) / n(surface_index);
+    }
+    cartesian_newton_raphson(
+        tangent, parameters, surface_index + 1, direction, min_detA);
+
+  } else {
+    // n = (sin(phi) cos(theta), sin(phi) sin(theta), cos(phi))
+    minitensor::Vector<ScalarT, 2> parameters(
+        std::acos(std::max(std::min(n(2), 1.0), -1.0)),
+        std::atan2(n(1), n(0)));
+    spherical_newton_raphson(tangent, parameters, direction, min_detA);
+  }
+
+  return min_detA;
+}
+
+//----------------------------------------------------------------------------
+template <typename EvalT, typename Traits>
+RealType BifurcationCheck<EvalT, Traits>::ellipticity_margin(
+    minitensor::Tensor4<RealType, 3> const& tangent,
+    minitensor::Vector<RealType, 3> const&  direction)
+{
+  minitensor::Vector<RealType, 3> const n = minitensor::unit(direction);
+
+  minitensor::Tensor<RealType, 3> const A =
+      minitensor::dot2(n, minitensor::dot(tangent, n));
+
+  RealType const mean = minitensor::trace(A) / 3.0;
+
+  if (mean <= 0.0) return -1.0;
+
+  return minitensor::det(A) / (mean * mean * mean);
+}
+
+//----------------------------------------------------------------------------
+template <typename EvalT, typename Traits>
+typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::acoustic_det(
+    minitensor::Tensor4<ScalarT, 3> const& tangent,
+    minitensor::Vector<ScalarT, 3> const&  direction)
+{
+  return minitensor::det(
+      minitensor::dot2(direction, minitensor::dot(tangent, direction)));
+}
+
+//----------------------------------------------------------------------------
+template <typename EvalT, typename Traits>
+RealType BifurcationCheck<EvalT, Traits>::spherical_sweep(
+    minitensor::Tensor4<RealType, 3> const& tangent,
+    minitensor::Vector<RealType, 2>&        arg_minimum,
+    minitensor::Vector<RealType, 3>&        direction,
+    double const&                           interval)
 {
   minitensor::Index const p_number = floor(1.0 / interval);
 
-  ScalarT const domain_min = 0;
+  RealType const domain_min = 0;
 
-  ScalarT const domain_max = std::acos(-1.0);
+  RealType const domain_max = std::acos(-1.0);
 
-  ScalarT const p_mean = (domain_max + domain_min) / 2.0;
+  RealType const p_mean = (domain_max + domain_min) / 2.0;
 
-  ScalarT const p_span = domain_max - domain_min;
+  RealType const p_span = domain_max - domain_min;
 
-  ScalarT const p_min = p_mean - p_span / 2.0 * interval * p_number;
+  RealType const p_min = p_mean - p_span / 2.0 * interval * p_number;
   // p_min = domain_min;
 
-  ScalarT const p_max = p_mean + p_span / 2.0 * interval * p_number;
+  RealType const p_max = p_mean + p_span / 2.0 * interval * p_number;
   // p_max = domain_min + p_span * interval * p_number;
 
   // Initialize parameters
-  ScalarT const phi_min = p_min;
+  RealType const phi_min = p_min;
 
-  ScalarT const phi_max = p_max;
+  RealType const phi_max = p_max;
 
-  ScalarT const theta_min = p_min;
+  RealType const theta_min = p_min;
 
-  ScalarT const theta_max = p_max;
+  RealType const theta_max = p_max;
 
   minitensor::Index const phi_num_points = p_number * 2 + 1;
   // phi_num_points = p_number + 1;
@@ -210,19 +374,19 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::spherical_sweep(
   minitensor::Index const theta_num_points = p_number * 2 + 1;
   // theta_num_points = p_number + 1;
 
-  minitensor::Vector<ScalarT, 2> const sphere_min(phi_min, theta_min);
+  minitensor::Vector<RealType, 2> const sphere_min(phi_min, theta_min);
 
-  minitensor::Vector<ScalarT, 2> const sphere_max(phi_max, theta_max);
+  minitensor::Vector<RealType, 2> const sphere_max(phi_max, theta_max);
 
   minitensor::Vector<minitensor::Index, 2> const sphere_num_points(
       phi_num_points, theta_num_points);
 
   // Build the parametric grid with the specified parameters.
-  minitensor::ParametricGrid<ScalarT, 2> sphere_grid(
+  minitensor::ParametricGrid<RealType, 2> sphere_grid(
       sphere_min, sphere_max, sphere_num_points);
 
   // Build a spherical parametrization for this elasticity.
-  minitensor::SphericalParametrization<ScalarT, 3> sphere_param(tangent);
+  minitensor::SphericalParametrization<RealType, 3> sphere_param(tangent);
 
   // Traverse the grid with the parametrization.
   sphere_grid.traverse(sphere_param);
@@ -233,7 +397,7 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::spherical_sweep(
   // std::cout << sphere_param.get_minimum()
   //<< "  " << sphere_param.get_normal_minimum() << std::endl;
 
-  ScalarT min_detA = sphere_param.get_minimum();
+  RealType min_detA = sphere_param.get_minimum();
   for (int i(0); i < 3; ++i) {
     direction(i) = (sphere_param.get_normal_minimum())(i);
   }
@@ -247,36 +411,36 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::spherical_sweep(
 
 //----------------------------------------------------------------------------
 template <typename EvalT, typename Traits>
-typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_sweep(
-    minitensor::Tensor4<ScalarT, 3> const& tangent,
-    minitensor::Vector<ScalarT, 2>&        arg_minimum,
-    minitensor::Vector<ScalarT, 3>&        direction,
-    double const&                          interval)
+RealType BifurcationCheck<EvalT, Traits>::stereographic_sweep(
+    minitensor::Tensor4<RealType, 3> const& tangent,
+    minitensor::Vector<RealType, 2>&        arg_minimum,
+    minitensor::Vector<RealType, 3>&        direction,
+    double const&                           interval)
 {
   minitensor::Index const p_number = floor(1.0 / interval);
 
-  ScalarT const domain_min = -1.0;
+  RealType const domain_min = -1.0;
 
-  ScalarT const domain_max = 1.0;
+  RealType const domain_max = 1.0;
 
-  ScalarT const p_mean = (domain_max + domain_min) / 2.0;
+  RealType const p_mean = (domain_max + domain_min) / 2.0;
 
-  ScalarT const p_span = domain_max - domain_min;
+  RealType const p_span = domain_max - domain_min;
 
-  ScalarT const p_min = p_mean - p_span / 2.0 * interval * p_number;
+  RealType const p_min = p_mean - p_span / 2.0 * interval * p_number;
   // p_min = domain_min;
 
-  ScalarT const p_max = p_mean + p_span / 2.0 * interval * p_number;
+  RealType const p_max = p_mean + p_span / 2.0 * interval * p_number;
   // p_max = domain_min + p_span * interval * p_number;
 
   // Initialize parametres
-  ScalarT const x_min = p_min;
+  RealType const x_min = p_min;
 
-  ScalarT const x_max = p_max;
+  RealType const x_max = p_max;
 
-  ScalarT const y_min = p_min;
+  RealType const y_min = p_min;
 
-  ScalarT const y_max = p_max;
+  RealType const y_max = p_max;
 
   minitensor::Index const x_num_points = p_number * 2 + 1;
   // x_num_points = p_number + 1;
@@ -284,19 +448,19 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_sweep(
   minitensor::Index const y_num_points = p_number * 2 + 1;
   // y_num_points = p_number + 1;
 
-  minitensor::Vector<ScalarT, 2> const stereographic_min(x_min, y_min);
+  minitensor::Vector<RealType, 2> const stereographic_min(x_min, y_min);
 
-  minitensor::Vector<ScalarT, 2> const stereographic_max(x_max, y_max);
+  minitensor::Vector<RealType, 2> const stereographic_max(x_max, y_max);
 
   minitensor::Vector<minitensor::Index, 2> const stereographic_num_points(
       x_num_points, y_num_points);
 
   // Build the parametric grid with the specified parameters.
-  minitensor::ParametricGrid<ScalarT, 2> stereographic_grid(
+  minitensor::ParametricGrid<RealType, 2> stereographic_grid(
       stereographic_min, stereographic_max, stereographic_num_points);
 
   // Build a stereographic parametrization for this elasticity.
-  minitensor::StereographicParametrization<ScalarT, 3> stereographic_param(
+  minitensor::StereographicParametrization<RealType, 3> stereographic_param(
       tangent);
 
   // Traverse the grid with the parametrization.
@@ -309,7 +473,7 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_sweep(
   //<< "  " << stereographic_param.get_arg_minimum() << std::endl
   //<< "  " << stereographic_param.get_normal_minimum() << std::endl;
 
-  ScalarT min_detA = stereographic_param.get_minimum();
+  RealType min_detA = stereographic_param.get_minimum();
   for (int i(0); i < 3; ++i) {
     direction(i) = (stereographic_param.get_normal_minimum())(i);
   }
@@ -323,40 +487,40 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_sweep(
 
 //----------------------------------------------------------------------------
 template <typename EvalT, typename Traits>
-typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::projective_sweep(
-    minitensor::Tensor4<ScalarT, 3> const& tangent,
-    minitensor::Vector<ScalarT, 3>&        arg_minimum,
-    minitensor::Vector<ScalarT, 3>&        direction,
-    double const&                          interval)
+RealType BifurcationCheck<EvalT, Traits>::projective_sweep(
+    minitensor::Tensor4<RealType, 3> const& tangent,
+    minitensor::Vector<RealType, 3>&        arg_minimum,
+    minitensor::Vector<RealType, 3>&        direction,
+    double const&                           interval)
 {
   minitensor::Index const p_number = floor(1.0 / interval);
 
-  ScalarT const domain_min = -1.0;
+  RealType const domain_min = -1.0;
 
-  ScalarT const domain_max = 1.0;
+  RealType const domain_max = 1.0;
 
-  ScalarT const p_mean = (domain_max + domain_min) / 2.0;
+  RealType const p_mean = (domain_max + domain_min) / 2.0;
 
-  ScalarT const p_span = domain_max - domain_min;
+  RealType const p_span = domain_max - domain_min;
 
-  ScalarT const p_min = p_mean - p_span / 2.0 * interval * p_number;
+  RealType const p_min = p_mean - p_span / 2.0 * interval * p_number;
   // p_min = domain_min;
 
-  ScalarT const p_max = p_mean + p_span / 2.0 * interval * p_number;
+  RealType const p_max = p_mean + p_span / 2.0 * interval * p_number;
   // p_max = domain_min + p_span * interval * p_number;
 
   // Initialize parametres
-  ScalarT const x_min = p_min;
+  RealType const x_min = p_min;
 
-  ScalarT const x_max = p_max;
+  RealType const x_max = p_max;
 
-  ScalarT const y_min = p_min;
+  RealType const y_min = p_min;
 
-  ScalarT const y_max = p_max;
+  RealType const y_max = p_max;
 
-  ScalarT const z_min = p_min;
+  RealType const z_min = p_min;
 
-  ScalarT const z_max = p_max;
+  RealType const z_max = p_max;
 
   minitensor::Index const x_num_points = p_number * 2 + 1;
   // x_num_points = p_number + 1;
@@ -367,19 +531,19 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::projective_sweep(
   minitensor::Index const z_num_points = p_number * 2 + 1;
   // z_num_points = p_number + 1;
 
-  minitensor::Vector<ScalarT, 3> const projective_min(x_min, y_min, z_min);
+  minitensor::Vector<RealType, 3> const projective_min(x_min, y_min, z_min);
 
-  minitensor::Vector<ScalarT, 3> const projective_max(x_max, y_max, z_max);
+  minitensor::Vector<RealType, 3> const projective_max(x_max, y_max, z_max);
 
   minitensor::Vector<minitensor::Index, 3> const projective_num_points(
       x_num_points, y_num_points, z_num_points);
 
   // Build the parametric grid with the specified parameters.
-  minitensor::ParametricGrid<ScalarT, 3> projective_grid(
+  minitensor::ParametricGrid<RealType, 3> projective_grid(
       projective_min, projective_max, projective_num_points);
 
   // Build a projective parametrization for this elasticity.
-  minitensor::ProjectiveParametrization<ScalarT, 3> projective_param(tangent);
+  minitensor::ProjectiveParametrization<RealType, 3> projective_param(tangent);
 
   // Traverse the grid with the parametrization.
   projective_grid.traverse(projective_param);
@@ -390,7 +554,7 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::projective_sweep(
   // std::cout << projective_param.get_minimum()
   //<< "  " << projective_param.get_normal_minimum() << std::endl;
 
-  ScalarT min_detA = projective_param.get_minimum();
+  RealType min_detA = projective_param.get_minimum();
   for (int i(0); i < 3; ++i) {
     direction(i) = (projective_param.get_normal_minimum())(i);
   }
@@ -403,36 +567,36 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::projective_sweep(
 }
 //----------------------------------------------------------------------------
 template <typename EvalT, typename Traits>
-typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::tangent_sweep(
-    minitensor::Tensor4<ScalarT, 3> const& tangent,
-    minitensor::Vector<ScalarT, 2>&        arg_minimum,
-    minitensor::Vector<ScalarT, 3>&        direction,
-    double const&                          interval)
+RealType BifurcationCheck<EvalT, Traits>::tangent_sweep(
+    minitensor::Tensor4<RealType, 3> const& tangent,
+    minitensor::Vector<RealType, 2>&        arg_minimum,
+    minitensor::Vector<RealType, 3>&        direction,
+    double const&                           interval)
 {
   minitensor::Index const p_number = floor(1.0 / interval);
 
-  ScalarT const domain_min = -std::acos(-1.0) / 2.0;
+  RealType const domain_min = -std::acos(-1.0) / 2.0;
 
-  ScalarT const domain_max = std::acos(-1.0) / 2.0;
+  RealType const domain_max = std::acos(-1.0) / 2.0;
 
-  ScalarT const p_mean = (domain_max + domain_min) / 2.0;
+  RealType const p_mean = (domain_max + domain_min) / 2.0;
 
-  ScalarT const p_span = domain_max - domain_min;
+  RealType const p_span = domain_max - domain_min;
 
-  ScalarT const p_min = p_mean - p_span / 2.0 * interval * p_number;
+  RealType const p_min = p_mean - p_span / 2.0 * interval * p_number;
   // p_min = domain_min;
 
-  ScalarT const p_max = p_mean + p_span / 2.0 * interval * p_number;
+  RealType const p_max = p_mean + p_span / 2.0 * interval * p_number;
   // p_max = domain_min + p_span * interval * p_number;
 
   // Initialize parametres
-  ScalarT const x_min = p_min;
+  RealType const x_min = p_min;
 
-  ScalarT const x_max = p_max;
+  RealType const x_max = p_max;
 
-  ScalarT const y_min = p_min;
+  RealType const y_min = p_min;
 
-  ScalarT const y_max = p_max;
+  RealType const y_max = p_max;
 
   minitensor::Index const x_num_points = p_number * 2 + 1;
   // x_num_points = p_number + 1;
@@ -440,19 +604,19 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::tangent_sweep(
   minitensor::Index const y_num_points = p_number * 2 + 1;
   // y_num_points = p_number + 1;
 
-  minitensor::Vector<ScalarT, 2> const tangent_min(x_min, y_min);
+  minitensor::Vector<RealType, 2> const tangent_min(x_min, y_min);
 
-  minitensor::Vector<ScalarT, 2> const tangent_max(x_max, y_max);
+  minitensor::Vector<RealType, 2> const tangent_max(x_max, y_max);
 
   minitensor::Vector<minitensor::Index, 2> const tangent_num_points(
       x_num_points, y_num_points);
 
   // Build the parametric grid with the specified parameters.
-  minitensor::ParametricGrid<ScalarT, 2> tangent_grid(
+  minitensor::ParametricGrid<RealType, 2> tangent_grid(
       tangent_min, tangent_max, tangent_num_points);
 
   // Build a tangent parametrization for this elasticity.
-  minitensor::TangentParametrization<ScalarT, 3> tangent_param(tangent);
+  minitensor::TangentParametrization<RealType, 3> tangent_param(tangent);
 
   // Traverse the grid with the parametrization.
   tangent_grid.traverse(tangent_param);
@@ -463,7 +627,7 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::tangent_sweep(
   // std::cout << tangent_param.get_minimum()
   //<< "  " << tangent_param.get_normal_minimum() << std::endl;
 
-  ScalarT min_detA = tangent_param.get_minimum();
+  RealType min_detA = tangent_param.get_minimum();
   for (int i(0); i < 3; ++i) {
     direction(i) = (tangent_param.get_normal_minimum())(i);
   }
@@ -476,56 +640,56 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::tangent_sweep(
 }
 //----------------------------------------------------------------------------
 template <typename EvalT, typename Traits>
-typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::cartesian_sweep(
-    minitensor::Tensor4<ScalarT, 3> const& tangent,
-    minitensor::Vector<ScalarT, 2>&        arg_minimum,
-    int                                    surface_index,
-    minitensor::Vector<ScalarT, 3>&        direction,
-    double const&                          interval)
+RealType BifurcationCheck<EvalT, Traits>::cartesian_sweep(
+    minitensor::Tensor4<RealType, 3> const& tangent,
+    minitensor::Vector<RealType, 2>&        arg_minimum,
+    int                                     surface_index,
+    minitensor::Vector<RealType, 3>&        direction,
+    double const&                           interval)
 {
   minitensor::Index const p_number = floor(1.0 / interval);
 
-  ScalarT const domain_min = -1.0;
+  RealType const domain_min = -1.0;
 
-  ScalarT const domain_max = 1.0;
+  RealType const domain_max = 1.0;
 
-  ScalarT const p_mean = (domain_max + domain_min) / 2.0;
+  RealType const p_mean = (domain_max + domain_min) / 2.0;
 
-  ScalarT const p_span = domain_max - domain_min;
+  RealType const p_span = domain_max - domain_min;
 
-  ScalarT const p_min = p_mean - p_span / 2.0 * interval * p_number;
+  RealType const p_min = p_mean - p_span / 2.0 * interval * p_number;
   // p_min = domain_min;
 
-  ScalarT const p_max = p_mean + p_span / 2.0 * interval * p_number;
+  RealType const p_max = p_mean + p_span / 2.0 * interval * p_number;
   // p_max = domain_min + p_span * interval * p_number;
 
   // Initialize parametres
-  ScalarT const p_surface = 1.0;
+  RealType const p_surface = 1.0;
 
   minitensor::Index const p_num_points = p_number * 2 + 1;
   // p_num_points = p_number + 1;
 
   minitensor::Index const p_surface_num_points = 1;
 
-  ScalarT min_detA(1.0);
+  RealType min_detA(1.0);
 
   if (surface_index == 1) {
     // x surface
-    minitensor::Vector<ScalarT, 3> const cartesian1_min(
+    minitensor::Vector<RealType, 3> const cartesian1_min(
         p_surface, p_min, p_min);
 
-    minitensor::Vector<ScalarT, 3> const cartesian1_max(
+    minitensor::Vector<RealType, 3> const cartesian1_max(
         p_surface, p_max, p_max);
 
     minitensor::Vector<minitensor::Index, 3> const cartesian1_num_points(
         p_surface_num_points, p_num_points, p_num_points);
 
     // Build the parametric grid with the specified parameters.
-    minitensor::ParametricGrid<ScalarT, 3> cartesian1_grid(
+    minitensor::ParametricGrid<RealType, 3> cartesian1_grid(
         cartesian1_min, cartesian1_max, cartesian1_num_points);
 
     // Build a cartesian parametrization for this elasticity.
-    minitensor::CartesianParametrization<ScalarT, 3> cartesian1_param(tangent);
+    minitensor::CartesianParametrization<RealType, 3> cartesian1_param(tangent);
 
     // Traverse the grid with the parametrization.
     cartesian1_grid.traverse(cartesian1_param);
@@ -546,21 +710,21 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::cartesian_sweep(
 
   if (surface_index == 2) {
     // y surface
-    minitensor::Vector<ScalarT, 3> const cartesian2_min(
+    minitensor::Vector<RealType, 3> const cartesian2_min(
         p_min, p_surface, p_min);
 
-    minitensor::Vector<ScalarT, 3> const cartesian2_max(
+    minitensor::Vector<RealType, 3> const cartesian2_max(
         p_max, p_surface, p_max);
 
     minitensor::Vector<minitensor::Index, 3> const cartesian2_num_points(
         p_num_points, p_surface_num_points, p_num_points);
 
     // Build the parametric grid with the specified parameters.
-    minitensor::ParametricGrid<ScalarT, 3> cartesian2_grid(
+    minitensor::ParametricGrid<RealType, 3> cartesian2_grid(
         cartesian2_min, cartesian2_max, cartesian2_num_points);
 
     // Build a cartesian parametrization for this elasticity.
-    minitensor::CartesianParametrization<ScalarT, 3> cartesian2_param(tangent);
+    minitensor::CartesianParametrization<RealType, 3> cartesian2_param(tangent);
 
     // Traverse the grid with the parametrization.
     cartesian2_grid.traverse(cartesian2_param);
@@ -581,21 +745,21 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::cartesian_sweep(
 
   if (surface_index == 3) {
     // z surface
-    minitensor::Vector<ScalarT, 3> const cartesian3_min(
+    minitensor::Vector<RealType, 3> const cartesian3_min(
         p_min, p_min, p_surface);
 
-    minitensor::Vector<ScalarT, 3> const cartesian3_max(
+    minitensor::Vector<RealType, 3> const cartesian3_max(
         p_max, p_max, p_surface);
 
     minitensor::Vector<minitensor::Index, 3> const cartesian3_num_points(
         p_num_points, p_num_points, p_surface_num_points);
 
     // Build the parametric grid with the specified parameters.
-    minitensor::ParametricGrid<ScalarT, 3> cartesian3_grid(
+    minitensor::ParametricGrid<RealType, 3> cartesian3_grid(
         cartesian3_min, cartesian3_max, cartesian3_num_points);
 
     // Build a cartesian parametrization for this elasticity.
-    minitensor::CartesianParametrization<ScalarT, 3> cartesian3_param(tangent);
+    minitensor::CartesianParametrization<RealType, 3> cartesian3_param(tangent);
 
     // Traverse the grid with the parametrization.
     cartesian3_grid.traverse(cartesian3_param);
@@ -1162,10 +1326,10 @@ void BifurcationCheck<EvalT, Traits>::cartesian_newton_raphson(
 
 //----------------------------------------------------------------------------
 template <typename EvalT, typename Traits>
-typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_pso(
-    minitensor::Tensor4<ScalarT, 3> const& tangent,
-    minitensor::Vector<ScalarT, 2>&        arg_minimum,
-    minitensor::Vector<ScalarT, 3>&        direction)
+RealType BifurcationCheck<EvalT, Traits>::stereographic_pso(
+    minitensor::Tensor4<RealType, 3> const& tangent,
+    minitensor::Vector<RealType, 2>&        arg_minimum,
+    minitensor::Vector<RealType, 3>&        direction)
 {
   double w  = 0.7;
   double c1 = 0.5;
@@ -1174,22 +1338,22 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_pso(
 
   int const group_size = 10;
 
-  std::vector<minitensor::Vector<ScalarT, 2>> arg_group(group_size);
-  std::vector<minitensor::Vector<ScalarT, 2>> arg_velocity_group(group_size);
+  std::vector<minitensor::Vector<RealType, 2>> arg_group(group_size);
+  std::vector<minitensor::Vector<RealType, 2>> arg_velocity_group(group_size);
 
-  std::vector<minitensor::Vector<ScalarT, 2>> arg_ibest(group_size);
-  std::vector<ScalarT>                        detA_ibest(group_size);
+  std::vector<minitensor::Vector<RealType, 2>> arg_ibest(group_size);
+  std::vector<RealType>                        detA_ibest(group_size);
 
-  minitensor::Vector<ScalarT, 2> arg_gbest;
-  ScalarT detA_gbest = std::numeric_limits<ScalarT>::max();
+  minitensor::Vector<RealType, 2> arg_gbest;
+  RealType detA_gbest = std::numeric_limits<RealType>::max();
 
   std::random_device                     rd;
   std::mt19937                           mt_eng(rd());
   std::uniform_real_distribution<double> real_dist(-1.0, 1.0);
 
   for (int i = 0; i < group_size; i++) {
-    minitensor::Vector<ScalarT, 2> arg_tmp;
-    minitensor::Vector<ScalarT, 2> arg_velocity_tmp;
+    minitensor::Vector<RealType, 2> arg_tmp;
+    minitensor::Vector<RealType, 2> arg_velocity_tmp;
 
     for (int j = 0; j < 2; j++) {
       arg_tmp(j)          = real_dist(mt_eng);
@@ -1199,9 +1363,9 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_pso(
     arg_group[i]          = arg_tmp;
     arg_velocity_group[i] = arg_velocity_tmp;
 
-    ScalarT r2 = arg_tmp[0] * arg_tmp[0] + arg_tmp[1] * arg_tmp[1];
+    RealType r2 = arg_tmp[0] * arg_tmp[0] + arg_tmp[1] * arg_tmp[1];
 
-    minitensor::Vector<ScalarT, 3> n(
+    minitensor::Vector<RealType, 3> n(
         2.0 * arg_tmp[0], 2.0 * arg_tmp[1], r2 - 1.0);
     n /= (r2 + 1.0);
 
@@ -1218,9 +1382,9 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_pso(
   bool      converged = false;
   int       iter      = 0;
   int const iter_max  = 1000;
-  ScalarT   error0    = 1.0;
+  RealType   error0    = 1.0;
   while (!converged) {
-    ScalarT error = 0.0;
+    RealType error = 0.0;
 
     for (int i = 0; i < group_size; i++) {
       arg_velocity_group[i] =
@@ -1229,15 +1393,15 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_pso(
           c2 * real_dist(mt_eng) * (arg_gbest - arg_group[i]);
       arg_group[i] += r * arg_velocity_group[i];
 
-      minitensor::Vector<ScalarT, 2> arg_tmp = arg_group[i];
+      minitensor::Vector<RealType, 2> arg_tmp = arg_group[i];
 
-      ScalarT r2 = arg_tmp[0] * arg_tmp[0] + arg_tmp[1] * arg_tmp[1];
+      RealType r2 = arg_tmp[0] * arg_tmp[0] + arg_tmp[1] * arg_tmp[1];
 
-      minitensor::Vector<ScalarT, 3> n(
+      minitensor::Vector<RealType, 3> n(
           2.0 * arg_tmp[0], 2.0 * arg_tmp[1], r2 - 1.0);
       n /= (r2 + 1.0);
 
-      ScalarT detA_tmp =
+      RealType detA_tmp =
           minitensor::det(minitensor::dot2(n, minitensor::dot(tangent, n)));
 
       if (detA_ibest[i] > detA_tmp) {
@@ -1264,9 +1428,9 @@ typename EvalT::ScalarT BifurcationCheck<EvalT, Traits>::stereographic_pso(
 
   }  // group generation iteration
 
-  ScalarT r2 = arg_gbest[0] * arg_gbest[0] + arg_gbest[1] * arg_gbest[1];
+  RealType r2 = arg_gbest[0] * arg_gbest[0] + arg_gbest[1] * arg_gbest[1];
 
-  minitensor::Vector<ScalarT, 3> n(
+  minitensor::Vector<RealType, 3> n(
       2.0 * arg_gbest[0], 2.0 * arg_gbest[1], r2 - 1.0);
   n /= (r2 + 1.0);
 
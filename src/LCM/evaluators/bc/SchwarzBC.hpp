@@ -147,6 +147,21 @@ template<typename SchwarzBC, typename Traits>
 void
 fillResidual(SchwarzBC & sbc, typename Traits::EvalData d);
 
+//
+// Interpolation of the solution of the coupled application at node ns_node
+// of the Schwarz boundary of this_app: the global DOFs, by component, of the
+// nodes of the coupled element that contains it and the values of their
+// shape functions there. Component j of the boundary value is
+// sum_i weights[i] * x[coupled_dofs[i][j]].
+//
+void
+computeSchwarzInterpolation(
+    Albany::Application const & this_app,
+    int const coupled_app_index,
+    size_t const ns_node,
+    std::vector<std::vector<GO>> & coupled_dofs,
+    std::vector<RealType> & weights);
+
 //
 // Residual
 //
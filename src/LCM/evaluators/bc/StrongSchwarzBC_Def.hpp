@@ -79,7 +79,7 @@ computeBCs(size_t const ns_node, T & x_val, T & y_val, T & z_val)
   coupled_app = getApplication(coupled_app_index);
 
   Teuchos::RCP<Tpetra_Vector const>
-  coupled_solution = coupled_app.getX();
+  coupled_solution = coupled_app.getCoupledX();
 
   if (coupled_solution == Teuchos::null) {
     x_val = 0.0;
@@ -165,6 +165,10 @@ class ProjectIPtoNodalField<PHAL::AlbanyTraits::Residual, Traits>
   initManager(Teuchos::ParameterList* const pl, const std::string& key_suffix);
   void
   fillRHS(const typename Traits::EvalData workset);
+  // Make the nonoverlapping mass matrix and its solver from the assembled
+  // overlapping mass matrix.
+  void
+  assembleSolver();
 };
 
 }  // namespace LCM
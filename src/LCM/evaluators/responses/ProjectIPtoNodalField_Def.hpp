@@ -42,7 +42,48 @@ class ProjectIPtoNodalFieldManager : public Adapt::NodalDataBase::Manager {
   // using.
   int ndb_start, ndb_numvecs;
 
-  ProjectIPtoNodalFieldManager() : nwrkr_(0), prectr_(0), postctr_(0) {}
+  // If reuse_mass_matrix is set, the nonoverlapping mass matrix, the transfers
+  // between the overlapping and nonoverlapping maps, and the initialized solver
+  // (hence the preconditioner) or, for the lumped mass matrix, the inverse of
+  // its diagonal are kept across output steps. They are then rebuilt only if
+  // the discretization changes, so reuse is valid only while the element
+  // geometry is fixed between mesh changes. It is off by default.
+  Teuchos::RCP<Tpetra_Export>                    exporter;
+  Teuchos::RCP<Tpetra_Import>                    importer;
+  Teuchos::RCP<Thyra::LinearOpWithSolveBase<ST>> solver;
+  Teuchos::RCP<Tpetra_Vector>                    inverse_diagonal;
+  bool                                           reuse_mass_matrix;
+  bool                                           assemble_mass_matrix;
+
+  ProjectIPtoNodalFieldManager()
+      : reuse_mass_matrix(false),
+        assemble_mass_matrix(true),
+        nwrkr_(0),
+        prectr_(0),
+        postctr_(0)
+  {
+  }
+
+  // The discretization is identified by the overlapping nodal map and the
+  // nodal graph; both are replaced whenever the mesh changes.
+  bool
+  isMassMatrixCurrent(
+      const Teuchos::RCP<const Tpetra_Map>&      ovl_map,
+      const Teuchos::RCP<const Tpetra_CrsGraph>& graph) const
+  {
+    if (!reuse_mass_matrix) return false;
+    if (Teuchos::is_null(solver) && Teuchos::is_null(inverse_diagonal))
+      return false;
+    return ovl_map.get() == ovl_map_.get() && graph.get() == graph_.get();
+  }
+  void
+  setMassMatrixCurrent(
+      const Teuchos::RCP<const Tpetra_Map>&      ovl_map,
+      const Teuchos::RCP<const Tpetra_CrsGraph>& graph)
+  {
+    ovl_map_ = ovl_map;
+    graph_   = graph;
+  }
 
   void
   registerWorker()
@@ -72,7 +113,9 @@ class ProjectIPtoNodalFieldManager : public Adapt::NodalDataBase::Manager {
   }
 
  private:
-  int nwrkr_, prectr_, postctr_;
+  int                                 nwrkr_, prectr_, postctr_;
+  Teuchos::RCP<const Tpetra_Map>      ovl_map_;
+  Teuchos::RCP<const Tpetra_CrsGraph> graph_;
 };
 
 typedef Intrepid2::Basis<PHX::Device, RealType, RealType> Intrepid2Basis;
@@ -258,6 +301,11 @@ getValidProjectIPtoNodalFieldParameters()
       "Whether nodal field info should be output to a file");
   valid_pl->set<std::string>("Mass Matrix Type", "Full", "Full or Lumped");
   valid_pl->set<double>("Solver Tolerance", 1e-12, "Linear solver tolerance");
+  valid_pl->set<bool>(
+      "Reuse Mass Matrix",
+      false,
+      "Keep the mass matrix and its preconditioner until the mesh changes; "
+      "only valid if the element geometry does not change otherwise");
 
   return valid_pl;
 }
@@ -333,6 +381,13 @@ class ProjectIPtoNodalFieldManager::MassMatrix {
       const PHX::MDField<const RealType, Cell, Node, QuadPoint>& bf,
       const PHX::MDField<const RealType, Cell, Node, QuadPoint>& wbf) = 0;
 
+  // A diagonal mass matrix is inverted directly rather than by the solver.
+  virtual bool
+  isDiagonal() const
+  {
+    return false;
+  }
+
   Teuchos::RCP<Tpetra_CrsMatrix>&
   matrix()
   {
@@ -392,6 +447,12 @@ class ProjectIPtoNodalFieldManager::FullMassMatrix
 class ProjectIPtoNodalFieldManager::LumpedMassMatrix
     : public ProjectIPtoNodalFieldManager::MassMatrix {
  public:
+  virtual bool
+  isDiagonal() const
+  {
+    return true;
+  }
+
   virtual void
   fill(
       const PHAL::Workset&                                       workset,
@@ -456,6 +517,7 @@ ProjectIPtoNodalField<PHAL::AlbanyTraits::Residual, Traits>::initManager(
     mgr_              = Teuchos::rcp(new ProjectIPtoNodalFieldManager());
     mgr_->mass_matrix = Teuchos::rcp(
         ProjectIPtoNodalFieldManager::MassMatrix::create(mass_matrix_type));
+    mgr_->reuse_mass_matrix = pl->get<bool>("Reuse Mass Matrix", false);
     // Find out our starting position in the nodal database.
     mgr_->ndb_start =
         p_state_mgr_->getStateInfoStruct()->getNodalDataBase()->getVecsize();
@@ -663,27 +725,34 @@ ProjectIPtoNodalField<PHAL::AlbanyTraits::Residual, Traits>::preEvaluate(
   const bool am_first = ctr == 1;
   if (!am_first) return;
 
+  Teuchos::RCP<Adapt::NodalDataBase> ndb =
+      p_state_mgr_->getStateInfoStruct()->getNodalDataBase();
+  Teuchos::RCP<const Tpetra_CrsGraph> current_graph = ndb->getNodalGraph();
+  const Teuchos::RCP<const Tpetra_Map> current_ovl_map =
+      ndb->getNodalDataVector()->getOverlapMap();
+
+  // If the mesh has not changed since the last projection, the mass matrix and
+  // its solver are still valid and only the right-hand side is assembled.
+  mgr_->assemble_mass_matrix =
+      !mgr_->isMassMatrixCurrent(current_ovl_map, current_graph);
+  if (!mgr_->assemble_mass_matrix) {
+    mgr_->ip_field->putScalar(0.0);
+    return;
+  }
+
   // Reallocate the mass matrix for assembly. Since the matrix is overwritten by
   // a version used for linear algebra having a nonoverlapping row map, we can't
-  // just resumeFill. ip_field also alternates between overlapping
-  // and nonoverlapping maps and so must be reallocated.
-  Teuchos::RCP<const Tpetra_CrsGraph> current_graph =
-      p_state_mgr_->getStateInfoStruct()->getNodalDataBase()->getNodalGraph();
+  // just resumeFill.
   if (Teuchos::nonnull(current_graph)) {
     // Use a graph if it's available.
     mgr_->mass_matrix->matrix() =
         Teuchos::rcp(new Tpetra_CrsMatrix(current_graph));
   } else {
     // Otherwise, construct the graph on the fly.
-    const Teuchos::RCP<const Tpetra_Map> ovl_map =
-        (p_state_mgr_->getStateInfoStruct()
-             ->getNodalDataBase()
-             ->getNodalDataVector()
-             ->getOverlapMap());
     // Enough for first-order hex, but only a hint.
     const size_t max_num_entries = 27;
-    mgr_->mass_matrix->matrix() =
-        Teuchos::rcp(new Tpetra_CrsMatrix(ovl_map, ovl_map, max_num_entries));
+    mgr_->mass_matrix->matrix() = Teuchos::rcp(new Tpetra_CrsMatrix(
+        current_ovl_map, current_ovl_map, max_num_entries));
   }
   mgr_->ip_field = Teuchos::rcp(new Tpetra_MultiVector(
       mgr_->mass_matrix->matrix()->getRowMap(), mgr_->ndb_numvecs, true));
@@ -760,12 +829,14 @@ void
 ProjectIPtoNodalField<PHAL::AlbanyTraits::Residual, Traits>::evaluateFields(
     typename Traits::EvalData workset)
 {
-  if (Teuchos::nonnull(quad_mgr_)) {
-    quad_mgr_->evaluateBasis(coords_verts_);
-    mgr_->mass_matrix->fill(
-        workset, quad_mgr_->bf_const(), quad_mgr_->wbf_const());
-  } else
-    mgr_->mass_matrix->fill(workset, BF, wBF);
+  if (mgr_->assemble_mass_matrix) {
+    if (Teuchos::nonnull(quad_mgr_)) {
+      quad_mgr_->evaluateBasis(coords_verts_);
+      mgr_->mass_matrix->fill(
+          workset, quad_mgr_->bf_const(), quad_mgr_->wbf_const());
+    } else
+      mgr_->mass_matrix->fill(workset, BF, wBF);
+  }
 #ifdef PROJ_INTERP_TEST
   for (unsigned int cell = 0; cell < workset.numCells; ++cell)
     for (std::size_t qp = 0; qp < num_pts_; ++qp)
@@ -793,82 +864,51 @@ ProjectIPtoNodalField<PHAL::AlbanyTraits::Residual, Traits>::postEvaluate(
   Teuchos::RCP<Teuchos::FancyOStream> out =
       Teuchos::VerboseObjectBase::getDefaultOStream();
 
-  mgr_->mass_matrix->matrix()->fillComplete();
+  if (mgr_->assemble_mass_matrix) assembleSolver();
+
+  // Export ip_field to b, which has the mass matrix's range map.
+  Teuchos::RCP<Tpetra_MultiVector> ipf = rcp(new Tpetra_MultiVector(
+      mgr_->mass_matrix->matrix()->getRangeMap(),
+      mgr_->ip_field->getNumVectors()));
+  ipf->doExport(*mgr_->ip_field, *mgr_->exporter, Tpetra::ADD);
 
-  // Right now, ip_field and mass_matrix->matrix() have the same overlapping
-  // (row) map.
-  //   1. If we're not using a preconditioner, then we could fillComplete the
-  // mass matrix with valid 1-1 domain and range maps, export ip_field to b,
-  // where b has the mass matrix's range map, and proceed. The linear algebra
-  // using the matrix would be limited to matrix-vector products, which would
-  // use these valid range and domain maps.
-  //   2. However, we want to use Ifpack2, and Ifpack2 assumes the row map is
-  // nonoverlapping. (This assumption makes sense because of the type of
-  // operations Ifpack2 performs.) Hence I export mass matrix to a new matrix
-  // having nonoverlapping row and col maps. As in case 1, I also have to create
-  // a compatible b.
-  {
-    // Get overlapping and nonoverlapping maps.
-    const Teuchos::RCP<const Tpetra_CrsMatrix>& mm_ovl =
-        mgr_->mass_matrix->matrix();
-    if (!mm_ovl->isStaticGraph()) {
-      // If this matrix was constructed without a graph, grab the graph now and
-      // store it for possible reuse later.
-      p_state_mgr_->getStateInfoStruct()->getNodalDataBase()->updateNodalGraph(
-          mm_ovl->getCrsGraph());
-    }
-    const Teuchos::RCP<const Tpetra_Map> ovl_map = mm_ovl->getRowMap();
-    const Teuchos::RCP<const Tpetra_Map> map = Tpetra::createOneToOne(ovl_map);
-    // Export the mass matrix.
-    Teuchos::RCP<Tpetra_Export> e =
-        Teuchos::rcp(new Tpetra_Export(ovl_map, map));
-    Teuchos::RCP<Tpetra_CrsMatrix> mm =
-        rcp(new Tpetra_CrsMatrix(map, mm_ovl->getGlobalMaxNumRowEntries()));
-    mm->doExport(*mm_ovl, *e, Tpetra::ADD);
-    mm->fillComplete();
-    // We don't need the assemble form of the mass matrix any longer.
-    mgr_->mass_matrix->matrix() = mm;
-    // Now export ip_field.
-    Teuchos::RCP<Tpetra_MultiVector> ipf = rcp(new Tpetra_MultiVector(
-        mm->getRangeMap(), mgr_->ip_field->getNumVectors()));
-    ipf->doExport(*mgr_->ip_field, *e, Tpetra::ADD);
-    // Don't need the assemble form of the ip_field either.
-    mgr_->ip_field = ipf;
-  }
   // Create x in A x = b.
   Teuchos::RCP<Tpetra_MultiVector> node_projected_ip_field =
       rcp(new Tpetra_MultiVector(
-          mgr_->mass_matrix->matrix()->getDomainMap(),
-          mgr_->ip_field->getNumVectors()));
-  const Teuchos::RCP<Tpetra_Operator> tpetra_A = mgr_->mass_matrix->matrix();
-  const Teuchos::RCP<Thyra::LinearOpBase<ST>> A =
-      Thyra::createLinearOp(tpetra_A);
-  Teuchos::RCP<Thyra::LinearOpWithSolveBase<ST>> nsA = lowsFactory_->createOp();
-  Thyra::initializeOp<ST>(*lowsFactory_, A, nsA.ptr());
+          mgr_->mass_matrix->matrix()->getDomainMap(), ipf->getNumVectors()));
   Teuchos::RCP<Thyra::MultiVectorBase<ST>>
       x = Thyra::createMultiVector<ST, LO, Tpetra_GO, KokkosNode>(
           node_projected_ip_field),
-      b = Thyra::createMultiVector<ST, LO, Tpetra_GO, KokkosNode>(
-          mgr_->ip_field);
+      b = Thyra::createMultiVector<ST, LO, Tpetra_GO, KokkosNode>(ipf);
 
   // Compute the column norms of the right-hand side b. If b = 0, no need to
   // proceed.
-  Teuchos::Array<MT> norm_b(mgr_->ip_field->getNumVectors());
+  Teuchos::Array<MT> norm_b(ipf->getNumVectors());
   Thyra::norms_2(*b, norm_b());
   bool b_is_zero = true;
-  for (int i = 0; i < mgr_->ip_field->getNumVectors(); ++i)
+  for (int i = 0; i < ipf->getNumVectors(); ++i)
     if (norm_b[i] != 0) {
       b_is_zero = false;
       break;
     }
   if (b_is_zero) return;
 
-  Thyra::SolveStatus<ST> solveStatus =
-      Thyra::solve(*nsA, Thyra::NOTRANS, *b, x.ptr());
+  // All fields are projected at once, one column of the multivector each.
+  if (Teuchos::nonnull(mgr_->inverse_diagonal)) {
+    node_projected_ip_field->elementWiseMultiply(
+        one, *mgr_->inverse_diagonal, *ipf, 0.0);
+  } else {
+    Thyra::SolveStatus<ST> solveStatus =
+        Thyra::solve(*mgr_->solver, Thyra::NOTRANS, *b, x.ptr());
+#ifdef ALBANY_DEBUG
+    *out << "\nBelos LOWS Status: " << solveStatus << std::endl;
+#endif
+  }
 #ifdef ALBANY_DEBUG
-  *out << "\nBelos LOWS Status: " << solveStatus << std::endl;
-
   // Compute residual and ST check convergence.
+  const Teuchos::RCP<Tpetra_Operator> tpetra_A = mgr_->mass_matrix->matrix();
+  const Teuchos::RCP<Thyra::LinearOpBase<ST>> A =
+      Thyra::createLinearOp(tpetra_A);
   Teuchos::RCP<Thyra::MultiVectorBase<ST>> y =
       Thyra::createMembers(x->range(), x->domain());
 
@@ -877,29 +917,21 @@ ProjectIPtoNodalField<PHAL::AlbanyTraits::Residual, Traits>::postEvaluate(
 
   // Compute A*x - b = y - b.
   Thyra::update(-one, *b, y.ptr());
-  Teuchos::Array<MT> norm_res(mgr_->ip_field->getNumVectors());
+  Teuchos::Array<MT> norm_res(ipf->getNumVectors());
   Thyra::norms_2(*y, norm_res());
   // Print out the final relative residual norms.
   *out << "Final relative residual norms" << std::endl;
-  for (int i = 0; i < mgr_->ip_field->getNumVectors(); ++i) {
+  for (int i = 0; i < ipf->getNumVectors(); ++i) {
     const double rel_res = norm_res[i] == 0 ? 0 : norm_res[i] / norm_b[i];
     *out << "RHS " << i + 1 << " : " << std::setw(16) << std::right << rel_res
          << std::endl;
   }
 #endif
   {  // Store the overlapped vector data back in stk.
-    const Teuchos::RCP<const Tpetra_Map> ovl_map =
-                                             (p_state_mgr_->getStateInfoStruct()
-                                                  ->getNodalDataBase()
-                                                  ->getNodalDataVector()
-                                                  ->getOverlapMap()),
-                                         map =
-                                             node_projected_ip_field->getMap();
     Teuchos::RCP<Tpetra_MultiVector> npif = rcp(new Tpetra_MultiVector(
-        ovl_map, node_projected_ip_field->getNumVectors()));
-    Teuchos::RCP<Tpetra_Import>      im =
-        Teuchos::rcp(new Tpetra_Import(map, ovl_map));
-    npif->doImport(*node_projected_ip_field, *im, Tpetra::ADD);
+        mgr_->importer->getTargetMap(),
+        node_projected_ip_field->getNumVectors()));
+    npif->doImport(*node_projected_ip_field, *mgr_->importer, Tpetra::ADD);
     p_state_mgr_->getStateInfoStruct()
         ->getNodalDataBase()
         ->getNodalDataVector()
@@ -907,4 +939,69 @@ ProjectIPtoNodalField<PHAL::AlbanyTraits::Residual, Traits>::postEvaluate(
   }
 }
 
+template <typename Traits>
+void
+ProjectIPtoNodalField<PHAL::AlbanyTraits::Residual, Traits>::assembleSolver()
+{
+  Teuchos::RCP<Adapt::NodalDataBase> ndb =
+      p_state_mgr_->getStateInfoStruct()->getNodalDataBase();
+
+  mgr_->mass_matrix->matrix()->fillComplete();
+
+  // Right now, ip_field and mass_matrix->matrix() have the same overlapping
+  // (row) map.
+  //   1. If we're not using a preconditioner, then we could fillComplete the
+  // mass matrix with valid 1-1 domain and range maps, export ip_field to b,
+  // where b has the mass matrix's range map, and proceed. The linear algebra
+  // using the matrix would be limited to matrix-vector products, which would
+  // use these valid range and domain maps.
+  //   2. However, we want to use Ifpack2, and Ifpack2 assumes the row map is
+  // nonoverlapping. (This assumption makes sense because of the type of
+  // operations Ifpack2 performs.) Hence I export mass matrix to a new matrix
+  // having nonoverlapping row and col maps. As in case 1, I also have to create
+  // a compatible b, which postEvaluate does with the same exporter.
+  // Get overlapping and nonoverlapping maps.
+  const Teuchos::RCP<const Tpetra_CrsMatrix>& mm_ovl =
+      mgr_->mass_matrix->matrix();
+  if (!mm_ovl->isStaticGraph()) {
+    // If this matrix was constructed without a graph, grab the graph now and
+    // store it for possible reuse later.
+    ndb->updateNodalGraph(mm_ovl->getCrsGraph());
+  }
+  const Teuchos::RCP<const Tpetra_Map> ovl_map = mm_ovl->getRowMap();
+  const Teuchos::RCP<const Tpetra_Map> map = Tpetra::createOneToOne(ovl_map);
+  // Export the mass matrix.
+  mgr_->exporter = Teuchos::rcp(new Tpetra_Export(ovl_map, map));
+  Teuchos::RCP<Tpetra_CrsMatrix> mm =
+      rcp(new Tpetra_CrsMatrix(map, mm_ovl->getGlobalMaxNumRowEntries()));
+  mm->doExport(*mm_ovl, *mgr_->exporter, Tpetra::ADD);
+  mm->fillComplete();
+  // We don't need the assemble form of the mass matrix any longer.
+  mgr_->mass_matrix->matrix() = mm;
+
+  // The projected field goes back to the overlapping map of the nodal data.
+  const Teuchos::RCP<const Tpetra_Map> ndb_ovl_map =
+      ndb->getNodalDataVector()->getOverlapMap();
+  mgr_->importer =
+      Teuchos::rcp(new Tpetra_Import(mm->getDomainMap(), ndb_ovl_map));
+
+  if (mgr_->mass_matrix->isDiagonal()) {
+    mgr_->solver           = Teuchos::null;
+    mgr_->inverse_diagonal = Teuchos::rcp(new Tpetra_Vector(mm->getRowMap()));
+    mm->getLocalDiagCopy(*mgr_->inverse_diagonal);
+    mgr_->inverse_diagonal->reciprocal(*mgr_->inverse_diagonal);
+  } else {
+    // Initializing the solver computes the preconditioner, which is then
+    // reused by every solve until the mesh changes.
+    const Teuchos::RCP<Tpetra_Operator> tpetra_A = mm;
+    const Teuchos::RCP<Thyra::LinearOpBase<ST>> A =
+        Thyra::createLinearOp(tpetra_A);
+    mgr_->inverse_diagonal = Teuchos::null;
+    mgr_->solver           = lowsFactory_->createOp();
+    Thyra::initializeOp<ST>(*lowsFactory_, A, mgr_->solver.ptr());
+  }
+
+  mgr_->setMassMatrixCurrent(ndb_ovl_map, ndb->getNodalGraph());
+}
+
 }  // namespace LCM
@@ -12,6 +12,7 @@
 #include "Phalanx_Evaluator_Derived.hpp"
 #include "Phalanx_MDField.hpp"
 #include "Albany_Layouts.hpp"
+#include "MiniODEIntegrator.h"
 
 namespace LCM {
   /// \brief
@@ -20,7 +21,14 @@ namespace LCM {
   ///   1. He concentration
   ///   2. Total bubble density
   ///   3. Bubble volume fraction
-  /// We employ implicit integration (backward Euler)
+  /// We employ implicit integration (backward Euler) by default. With
+  /// "Integration Method" set to "Bogacki-Shampine" or "Rosenbrock" in the
+  /// Tritium Coefficients, the ODEs are integrated instead by the adaptive
+  /// MiniODEIntegrator, with the source interpolated linearly over the time
+  /// step, to "Integration Relative Tolerance" and
+  /// "Integration Absolute Tolerance" in at most
+  /// "Integration Maximum Steps" sub-steps per point. Points that need more
+  /// sub-steps take a backward Euler step instead.
   ///
   template<typename EvalT, typename Traits>
   class HeliumODEs : public PHX::EvaluatorWithBaseImpl<Traits>,
@@ -49,6 +57,28 @@ namespace LCM {
     typedef typename EvalT::ScalarT ScalarT;
     typedef typename EvalT::MeshScalarT MeshScalarT;
 
+    ///
+    /// Right hand side of the ODEs at a point, for MiniODEIntegrator.
+    /// The time runs from 0 to the time step.
+    ///
+    struct Kinetics
+    {
+      template<typename S>
+      minitensor::Vector<S, 3>
+      rhs(S const & t, minitensor::Vector<S, 3> const & y) const;
+
+      ScalarT d, g_old, g;
+      RealType dt, atomic_omega, he_radius, eta;
+    };
+
+    ///
+    /// Backward Euler step of the ODEs at a point, with a Newton solve;
+    /// n1, nb and sb hold the old values on input and the new ones on output
+    ///
+    void backwardEuler(ScalarT const & dt, ScalarT const & atomic_omega,
+        ScalarT const & d, ScalarT const & g_old, ScalarT const & g,
+        ScalarT & n1, ScalarT & nb, ScalarT & sb) const;
+
     ///
     /// Input: total_concentration - addition of lattice and trapped
     ///        concentration
@@ -86,6 +116,13 @@ namespace LCM {
     ///
     RealType avogadros_num_, omega_, t_decay_constant_, he_radius_, eta_;
 
+    ///
+    /// Local integration, backward Euler if UNDEFINED
+    ///
+    ODEMethod integration_method_;
+    RealType integration_rel_tol_, integration_abs_tol_;
+    int integration_max_steps_;
+
     ///
     /// Scalar names for obtaining state old
     ///
@@ -4,6 +4,8 @@
 //    in the file "license.txt" in the top-level Albany directory  //
 //*****************************************************************//
 #include <cmath>
+#include <utility>
+#include <vector>
 #include <Teuchos_TestForException.hpp>
 #include <Phalanx_DataLayout.hpp>
 #include <MiniTensor.h>
@@ -60,6 +62,23 @@ HeliumODEs(Teuchos::ParameterList& p,
   eta_ = mat_params_2->get<RealType>("Atoms Per Cluster");
   omega_ = mat_params_3->get<RealType>("Value");
 
+  // local integration
+  std::string const integration_method =
+      mat_params_2->get<std::string>("Integration Method", "Backward Euler");
+  integration_method_ = odeMethodFromName(integration_method);
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      integration_method_ == ODEMethod::UNDEFINED &&
+          integration_method != "Backward Euler",
+      std::invalid_argument,
+      "HeliumODEs: unknown Integration Method " << integration_method
+          << ", use Backward Euler, Bogacki-Shampine or Rosenbrock.\n");
+  integration_rel_tol_ =
+      mat_params_2->get<RealType>("Integration Relative Tolerance", 1.0e-4);
+  integration_abs_tol_ =
+      mat_params_2->get<RealType>("Integration Absolute Tolerance", 1.0e-12);
+  integration_max_steps_ =
+      mat_params_2->get<int>("Integration Maximum Steps", 1000);
+
   // add dependent fields
   this->addDependentField(total_concentration_);
   this->addDependentField(diffusion_coefficient_);
@@ -102,6 +121,40 @@ postRegistrationSetup(typename Traits::SetupData d,
 
 }
 
+//------------------------------------------------------------------------------
+template<typename EvalT, typename Traits>
+template<typename S>
+minitensor::Vector<S, 3>
+HeliumODEs<EvalT, Traits>::Kinetics::
+rhs(S const & t, minitensor::Vector<S, 3> const & y) const
+{
+  const double pi = acos(-1.0);
+  const double cub_tfpi = std::cbrt(3.0 / 4.0 / pi);
+
+  S const & n1 = y(0);
+  S const & nb = y(1);
+  S const & sb = y(2);
+  S const nb2 = nb * nb;
+
+  // the coefficients in the type of the states
+  S const d_s(d);
+  S const g_old_s(g_old);
+  S const g_s(g);
+
+  // tritium decay source, linear over the time step
+  S const source = g_old_s + (g_s - g_old_s) * t / dt;
+
+  // two He atoms nucleate a bubble, and bubbles grow by absorbing He
+  S const nucleation = 16.0 * pi * he_radius * d_s * n1 * n1;
+  S const growth =
+      4.0 * pi * cub_tfpi * d_s * n1 * lcm_cbrt(sb) * lcm_cbrt(nb2);
+
+  return minitensor::Vector<S, 3>(
+      source - 2.0 * nucleation - growth,
+      nucleation,
+      atomic_omega / eta * (2.0 * nucleation + growth));
+}
+
 //------------------------------------------------------------------------------
 template<typename EvalT, typename Traits>
 void HeliumODEs<EvalT, Traits>::
@@ -110,18 +163,9 @@ evaluateFields(typename Traits::EvalData workset)
   // Declaring time step & calculated input parameters
   ScalarT dt;
   ScalarT atomic_omega;
-  // Declaring tangent, residual, norms, and increment for N-R
-  minitensor::Tensor<ScalarT> tangent(3);
-  minitensor::Vector<ScalarT> residual(3);
-  ScalarT norm_residual_2, norm_residual_goal_2;
-  minitensor::Vector<ScalarT> increment(3);
 
-  // tolarences and iterations for newton
-  const double tolerance = 1.0e-12, tolerance_2 = tolerance * tolerance;
-  const int maxIterations = 20; //FIXME: Currently a maximum, need relative measures
-  // subincrementation for explicit predictor //FIXME: No guarantee of stability
-  ScalarT dt_explicit;
-  const int explicit_sub_increments = 5;
+  // points with less tritium have no ODEs to solve
+  const double tolerance = 1.0e-12;
 
   // state old
   Albany::MDArray total_concentration_old =
@@ -156,159 +200,100 @@ evaluateFields(typename Traits::EvalData workset)
   // time step
   dt = delta_time_(0);
 
-  // loop over cells and points for implicit time integration
+  // adaptive integration, point by point
+  if (integration_method_ != ODEMethod::UNDEFINED) {
+    RealType const dt_val = Sacado::ScalarValue<ScalarT>::eval(dt);
 
-  // constants for computations
-  const double pi = acos(-1.0);
-  const double onethrd = 1.0 / 3.0;
-  const double twothrd = 2.0 / 3.0;
-  const double cub_tfpi = std::cbrt(3.0 / 4.0 / pi);
+    std::vector<Kinetics> systems;
+    std::vector<minitensor::Vector<ScalarT, 3>> states;
+    std::vector<std::pair<std::size_t, std::size_t>> points;
 
-  // temporary variables
-  ScalarT n1_old, nb_old, sb_old, n1, nb, sb;
-  ScalarT n1_exp, nb_exp, sb_exp;
-  ScalarT d, g_old, g;
+    for (std::size_t cell = 0; cell < workset.numCells; ++cell) {
+      for (std::size_t pt = 0; pt < num_pts_; ++pt) {
+        he_concentration_(cell, pt) = he_concentration_old(cell, pt);
+        total_bubble_density_(cell, pt) = total_bubble_density_old(cell, pt);
+        bubble_volume_fraction_(cell, pt) =
+            bubble_volume_fraction_old(cell, pt);
 
-  const double pi2 = pi * pi;
-  const double cube_root_pi2 = std::cbrt(pi2);
-  const double cube_root_2 = std::cbrt(2.0);
-  const double cube_root_6 = std::cbrt(6.0);
-  const double cube_root_9 = std::cbrt(9.0);
-  const double cube_root_pi2_9 = std::cbrt(pi2 / 9.0);
+        // if no tritium exists, no need to solve the ODEs
+        if (total_concentration_(cell, pt) <= tolerance) continue;
+
+        Kinetics kinetics;
+        kinetics.d = diffusion_coefficient_(cell, pt);
+        kinetics.g_old = avogadros_num_ * t_decay_constant_
+            * total_concentration_old(cell, pt);
+        kinetics.g = avogadros_num_ * t_decay_constant_
+            * total_concentration_(cell, pt);
+        kinetics.dt = dt_val;
+        kinetics.atomic_omega = omega_ / avogadros_num_;
+        kinetics.he_radius = he_radius_;
+        kinetics.eta = eta_;
+
+        systems.push_back(kinetics);
+        states.push_back(minitensor::Vector<ScalarT, 3>(
+            he_concentration_old(cell, pt),
+            total_bubble_density_old(cell, pt),
+            bubble_volume_fraction_old(cell, pt)));
+        points.push_back(std::make_pair(cell, pt));
+      }
+    }
+
+    MiniODEIntegrator<ScalarT, 3> integrator(integration_method_,
+        integration_rel_tol_, integration_abs_tol_, integration_max_steps_);
+
+    int num_failed = 0;
+
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      std::size_t const cell = points[i].first, pt = points[i].second;
+
+      // a point that needs more than the maximum number of steps is
+      // integrated over the whole time step by backward Euler instead
+      if (integrator.integrate(systems[i], 0.0, dt_val, states[i]) == false) {
+        ++num_failed;
+        ScalarT n1 = he_concentration_old(cell, pt);
+        ScalarT nb = total_bubble_density_old(cell, pt);
+        ScalarT sb = bubble_volume_fraction_old(cell, pt);
+        backwardEuler(dt, atomic_omega, systems[i].d, systems[i].g_old,
+            systems[i].g, n1, nb, sb);
+        states[i] = minitensor::Vector<ScalarT, 3>(n1, nb, sb);
+      }
 
+      he_concentration_(cell, pt) = states[i](0);
+      total_bubble_density_(cell, pt) = states[i](1);
+      bubble_volume_fraction_(cell, pt) = states[i](2);
+    }
+
+    if (num_failed > 0) {
+      std::cout << "HeliumODEs: local integration did not reach the end of "
+          << "the time step in " << integration_max_steps_ << " steps at "
+          << num_failed << " points, integrated by backward Euler instead"
+          << std::endl;
+    }
+
+    return;
+  }
+
+  // loop over cells and points for implicit time integration
   for (std::size_t cell = 0; cell < workset.numCells; ++cell) {
 
     for (std::size_t pt = 0; pt < num_pts_; ++pt) {
 
-      // temporary variables
-      n1_old = he_concentration_old(cell, pt);
-      nb_old = total_bubble_density_old(cell, pt);
-      sb_old = bubble_volume_fraction_old(cell, pt);
-      n1 = n1_old;
-      nb = nb_old;
-      sb = sb_old;
-      d = diffusion_coefficient_(cell, pt);
+      ScalarT n1 = he_concentration_old(cell, pt);
+      ScalarT nb = total_bubble_density_old(cell, pt);
+      ScalarT sb = bubble_volume_fraction_old(cell, pt);
 
       // determine if any tritium exists - note that concentration is in mol (not atoms)
       // if no tritium exists, no need to solve the ODEs
       if (total_concentration_(cell, pt) > tolerance) {
 
         // source terms for helium bubble generation
-        g_old = avogadros_num_ * t_decay_constant_
+        ScalarT const g_old = avogadros_num_ * t_decay_constant_
             * total_concentration_old(cell, pt);
-        g = avogadros_num_ * t_decay_constant_ * total_concentration_(cell, pt);
-
-        // check if old bubble density is small
-        // if small, use an explict guess to avoid issues with 1/nb and 1/sb in tangent
-
-        if (nb_old < tolerance) {
-
-          // explicit time integration for predictor
-          // Note that two or more steps are required to obtain a finite nb if the
-          // total_concentration_old is zero.
-          dt_explicit = dt / explicit_sub_increments;
-          n1_exp = n1_old;
-          nb_exp = nb_old;
-          sb_exp = sb_old;
-
-          const ScalarT nb_exp2 = nb_exp * nb_exp;
-          const ScalarT cube_root_nb_exp2 = lcm_cbrt(nb_exp2);
-
-          for (int sub_increment = 0; sub_increment < explicit_sub_increments;
-              sub_increment++) {
-            n1 = n1_exp
-                + dt_explicit
-                    * (g_old - 32.0 * pi * he_radius_ * d * n1_exp * n1_exp
-                        -
-                        4.0 * pi * d * n1_exp * cub_tfpi * lcm_cbrt(sb_exp)
-                            * cube_root_nb_exp2);
-            nb = nb_exp
-                + dt_explicit * (16.0 * pi * he_radius_ * d * n1_exp * n1_exp);
-            sb = sb_exp
-                + atomic_omega / eta_ * dt_explicit
-                    * (32. * pi * he_radius_ * d * n1_exp * n1_exp +
-                        4.0 * pi * d * n1_exp * cub_tfpi * lcm_cbrt(sb_exp) *
-                            cube_root_nb_exp2);
-            n1_exp = n1;
-            nb_exp = nb;
-            sb_exp = sb;
-          }
-        }
-
-        ScalarT nb2 = nb * nb;
-        ScalarT cube_root_nb2 = lcm_cbrt(nb2);
-        ScalarT cube_root_sb = lcm_cbrt(sb);
-
-        // calculate initial residual for a relative tolerance
-        residual(0) = n1 - n1_old
-            - dt * (g - 32.0 * pi * he_radius_ * d * n1 * n1 -
-                4.0 * pi * d * n1 * cub_tfpi * cube_root_sb * cube_root_nb2);
-        residual(1) = nb - nb_old - dt * (16.0 * pi * he_radius_ * d * n1 * n1);
-        residual(2) = sb - sb_old
-            - atomic_omega / eta_ * dt * (32. * pi * he_radius_ * d * n1 * n1 +
-                4.0 * pi * d * n1 * cub_tfpi * cube_root_sb * cube_root_nb2);
-        norm_residual_2 = minitensor::norm_square(residual);
-        norm_residual_goal_2 = tolerance_2 * norm_residual_2;
-        int iter(0);
-
-        // N-R loop for implicit time integration
-        while (norm_residual_2 > norm_residual_goal_2 && iter < maxIterations) {
-
-          // Common factors w/cube_root
-          ScalarT cube_root_nb = lcm_cbrt(nb);
-          nb2 = nb * nb;
-          cube_root_nb2 = lcm_cbrt(nb2);
-          cube_root_sb = lcm_cbrt(sb);
-          ScalarT sb2 = sb * sb;
-          ScalarT cube_root_sb2 = lcm_cbrt(sb2);
-
-          // calculate tangent
-          tangent(0, 0) = 1.0
-              + 2.0 * dt * d * (32.0 * n1 * pi * he_radius_ + cube_root_6 *
-                  cube_root_nb2 * cube_root_pi2 * cube_root_sb);
-          tangent(0, 1) = 4.0 * cube_root_2 * dt * d * n1 * cube_root_pi2 *
-              cube_root_sb / cube_root_9 / cube_root_nb;
-          tangent(0, 2) = 2.0 * cube_root_2 * dt * d * n1 * cube_root_nb2 *
-              cube_root_pi2_9 / cube_root_sb2;
-          tangent(1, 0) = -32.0 * dt * d * n1 * pi * he_radius_;
-          tangent(1, 1) = 1.0;
-          tangent(1, 2) = 0.0;
-          tangent(2, 0) = -2.0 * dt * d * atomic_omega
-              * (32.0 * n1 * pi * he_radius_ + cube_root_6 *
-                  cube_root_nb2 * cube_root_pi2 * cube_root_sb) / eta_;
-          tangent(2, 1) = -4.0 * cube_root_2 * dt * d * n1 * atomic_omega *
-              cube_root_pi2 * cube_root_sb / cube_root_9 / eta_ / cube_root_nb;
-          tangent(2, 2) = 1.0
-              - 2.0 * cube_root_2 * dt * d * n1 * cube_root_nb2 *
-                  atomic_omega * cube_root_pi2_9 / eta_ / cube_root_sb2;
-
-          // find increment
-          increment = -minitensor::inverse(tangent) * residual;
-
-          // update quantities
-          n1 = n1 + increment(0);
-          nb = nb + increment(1);
-          sb = sb + increment(2);
-
-          nb2 = nb * nb;
-          cube_root_nb2 = lcm_cbrt(nb2);
-          cube_root_sb = lcm_cbrt(sb);
-
-          // find new residual and norm
-          residual(0) = n1 - n1_old
-              - dt * (g - 32. * pi * he_radius_ * d * n1 * n1 -
-                  4.0 * pi * d * n1 * cub_tfpi * cube_root_sb * cube_root_nb2);
-          residual(1) = nb - nb_old
-              - dt * (16.0 * pi * he_radius_ * d * n1 * n1);
-          residual(2) = sb - sb_old
-              - atomic_omega / eta_ * dt
-                  * (32. * pi * he_radius_ * d * n1 * n1
-                      +
-                      4.0 * pi * d * n1 * cub_tfpi * cube_root_sb
-                          * cube_root_nb2);
-          norm_residual_2 = minitensor::norm_square(residual);
-          iter++;
-        }
+        ScalarT const g = avogadros_num_ * t_decay_constant_
+            * total_concentration_(cell, pt);
+
+        backwardEuler(dt, atomic_omega, diffusion_coefficient_(cell, pt),
+            g_old, g, n1, nb, sb);
       }
 
       // Update global fields
@@ -320,5 +305,153 @@ evaluateFields(typename Traits::EvalData workset)
     }
   }
 }
+
+//------------------------------------------------------------------------------
+template<typename EvalT, typename Traits>
+void HeliumODEs<EvalT, Traits>::
+backwardEuler(ScalarT const & dt, ScalarT const & atomic_omega,
+    ScalarT const & d, ScalarT const & g_old, ScalarT const & g,
+    ScalarT & n1, ScalarT & nb, ScalarT & sb) const
+{
+  // Declaring tangent, residual, norms, and increment for N-R
+  minitensor::Tensor<ScalarT> tangent(3);
+  minitensor::Vector<ScalarT> residual(3);
+  ScalarT norm_residual_2, norm_residual_goal_2;
+  minitensor::Vector<ScalarT> increment(3);
+
+  // tolarences and iterations for newton
+  const double tolerance = 1.0e-12, tolerance_2 = tolerance * tolerance;
+  const int maxIterations = 20; //FIXME: Currently a maximum, need relative measures
+  // subincrementation for explicit predictor //FIXME: No guarantee of stability
+  ScalarT dt_explicit;
+  const int explicit_sub_increments = 5;
+
+  // constants for computations
+  const double pi = acos(-1.0);
+  const double cub_tfpi = std::cbrt(3.0 / 4.0 / pi);
+
+  // temporary variables
+  ScalarT const n1_old = n1, nb_old = nb, sb_old = sb;
+  ScalarT n1_exp, nb_exp, sb_exp;
+
+  const double pi2 = pi * pi;
+  const double cube_root_pi2 = std::cbrt(pi2);
+  const double cube_root_2 = std::cbrt(2.0);
+  const double cube_root_6 = std::cbrt(6.0);
+  const double cube_root_9 = std::cbrt(9.0);
+  const double cube_root_pi2_9 = std::cbrt(pi2 / 9.0);
+
+  // check if old bubble density is small
+  // if small, use an explict guess to avoid issues with 1/nb and 1/sb in tangent
+
+  if (nb_old < tolerance) {
+
+    // explicit time integration for predictor
+    // Note that two or more steps are required to obtain a finite nb if the
+    // total_concentration_old is zero.
+    dt_explicit = dt / explicit_sub_increments;
+    n1_exp = n1_old;
+    nb_exp = nb_old;
+    sb_exp = sb_old;
+
+    const ScalarT nb_exp2 = nb_exp * nb_exp;
+    const ScalarT cube_root_nb_exp2 = lcm_cbrt(nb_exp2);
+
+    for (int sub_increment = 0; sub_increment < explicit_sub_increments;
+        sub_increment++) {
+      n1 = n1_exp
+          + dt_explicit
+              * (g_old - 32.0 * pi * he_radius_ * d * n1_exp * n1_exp
+                  -
+                  4.0 * pi * d * n1_exp * cub_tfpi * lcm_cbrt(sb_exp)
+                      * cube_root_nb_exp2);
+      nb = nb_exp
+          + dt_explicit * (16.0 * pi * he_radius_ * d * n1_exp * n1_exp);
+      sb = sb_exp
+          + atomic_omega / eta_ * dt_explicit
+              * (32. * pi * he_radius_ * d * n1_exp * n1_exp +
+                  4.0 * pi * d * n1_exp * cub_tfpi * lcm_cbrt(sb_exp) *
+                      cube_root_nb_exp2);
+      n1_exp = n1;
+      nb_exp = nb;
+      sb_exp = sb;
+    }
+  }
+
+  ScalarT nb2 = nb * nb;
+  ScalarT cube_root_nb2 = lcm_cbrt(nb2);
+  ScalarT cube_root_sb = lcm_cbrt(sb);
+
+  // calculate initial residual for a relative tolerance
+  residual(0) = n1 - n1_old
+      - dt * (g - 32.0 * pi * he_radius_ * d * n1 * n1 -
+          4.0 * pi * d * n1 * cub_tfpi * cube_root_sb * cube_root_nb2);
+  residual(1) = nb - nb_old - dt * (16.0 * pi * he_radius_ * d * n1 * n1);
+  residual(2) = sb - sb_old
+      - atomic_omega / eta_ * dt * (32. * pi * he_radius_ * d * n1 * n1 +
+          4.0 * pi * d * n1 * cub_tfpi * cube_root_sb * cube_root_nb2);
+  norm_residual_2 = minitensor::norm_square(residual);
+  norm_residual_goal_2 = tolerance_2 * norm_residual_2;
+  int iter(0);
+
+  // N-R loop for implicit time integration
+  while (norm_residual_2 > norm_residual_goal_2 && iter < maxIterations) {
+
+    // Common factors w/cube_root
+    ScalarT cube_root_nb = lcm_cbrt(nb);
+    nb2 = nb * nb;
+    cube_root_nb2 = lcm_cbrt(nb2);
+    cube_root_sb = lcm_cbrt(sb);
+    ScalarT sb2 = sb * sb;
+    ScalarT cube_root_sb2 = lcm_cbrt(sb2);
+
+    // calculate tangent
+    tangent(0, 0) = 1.0
+        + 2.0 * dt * d * (32.0 * n1 * pi * he_radius_ + cube_root_6 *
+            cube_root_nb2 * cube_root_pi2 * cube_root_sb);
+    tangent(0, 1) = 4.0 * cube_root_2 * dt * d * n1 * cube_root_pi2 *
+        cube_root_sb / cube_root_9 / cube_root_nb;
+    tangent(0, 2) = 2.0 * cube_root_2 * dt * d * n1 * cube_root_nb2 *
+        cube_root_pi2_9 / cube_root_sb2;
+    tangent(1, 0) = -32.0 * dt * d * n1 * pi * he_radius_;
+    tangent(1, 1) = 1.0;
+    tangent(1, 2) = 0.0;
+    tangent(2, 0) = -2.0 * dt * d * atomic_omega
+        * (32.0 * n1 * pi * he_radius_ + cube_root_6 *
+            cube_root_nb2 * cube_root_pi2 * cube_root_sb) / eta_;
+    tangent(2, 1) = -4.0 * cube_root_2 * dt * d * n1 * atomic_omega *
+        cube_root_pi2 * cube_root_sb / cube_root_9 / eta_ / cube_root_nb;
+    tangent(2, 2) = 1.0
+        - 2.0 * cube_root_2 * dt * d * n1 * cube_root_nb2 *
+            atomic_omega * cube_root_pi2_9 / eta_ / cube_root_sb2;
+
+    // find increment
+    increment = -minitensor::inverse(tangent) * residual;
+
+    // update quantities
+    n1 = n1 + increment(0);
+    nb = nb + increment(1);
+    sb = sb + increment(2);
+
+    nb2 = nb * nb;
+    cube_root_nb2 = lcm_cbrt(nb2);
+    cube_root_sb = lcm_cbrt(sb);
+
+    // find new residual and norm
+    residual(0) = n1 - n1_old
+        - dt * (g - 32. * pi * he_radius_ * d * n1 * n1 -
+            4.0 * pi * d * n1 * cub_tfpi * cube_root_sb * cube_root_nb2);
+    residual(1) = nb - nb_old
+        - dt * (16.0 * pi * he_radius_ * d * n1 * n1);
+    residual(2) = sb - sb_old
+        - atomic_omega / eta_ * dt
+            * (32. * pi * he_radius_ * d * n1 * n1
+                +
+                4.0 * pi * d * n1 * cub_tfpi * cube_root_sb
+                    * cube_root_nb2);
+    norm_residual_2 = minitensor::norm_square(residual);
+    iter++;
+  }
+}
 //------------------------------------------------------------------------------
 }
@@ -10,6 +10,10 @@
 #include "Piro_LOCASolver.hpp"
 #include "Piro_TempusSolver.hpp"
 #include "Schwarz_Alternating.hpp"
+#include "Teuchos_CommHelpers.hpp"
+#include "Teuchos_Time.hpp"
+
+#include <algorithm>
 
 //#define DEBUG
 
@@ -50,6 +54,13 @@ SchwarzAlternating(
   increase_factor_ = alt_system_params.get<ST>("Increase Factor", 1.0);
   output_interval_ = alt_system_params.get<int>("Exodus Write Interval", 1);
 
+  std::string const
+  schwarz_method =
+      alt_system_params.get<std::string>("Schwarz Method", "Multiplicative");
+
+  is_additive_ = schwarz_method == "Additive";
+  num_groups_ = alt_system_params.get<int>("Number of Subdomain Groups", 1);
+
   // Firewalls
   ALBANY_ASSERT(min_iters_ >= 1);
   ALBANY_ASSERT(max_iters_ >= 1);
@@ -66,10 +77,21 @@ SchwarzAlternating(
   ALBANY_ASSERT(reduction_factor_ > 0.0);
   ALBANY_ASSERT(increase_factor_ >= 1.0);
   ALBANY_ASSERT(output_interval_ >= 1);
+  ALBANY_ASSERT(
+      schwarz_method == "Multiplicative" || schwarz_method == "Additive",
+      "Unknown Schwarz Method: " + schwarz_method);
 
   //number of models
   num_subdomains_ = model_filenames.size();
 
+  ALBANY_ASSERT(num_groups_ >= 1);
+  ALBANY_ASSERT(num_groups_ <= num_subdomains_,
+      "More subdomain groups than subdomains");
+  ALBANY_ASSERT(num_groups_ == 1 || is_additive_ == true,
+      "Concurrent subdomain groups require 'Schwarz Method: Additive'");
+
+  createSubdomainGroups(comm);
+
   // Create application name-index map used for Schwarz BC.
   Teuchos::RCP<std::map<std::string, int>>
   app_name_index_map = Teuchos::rcp(new std::map<std::string, int>);
@@ -119,7 +141,7 @@ SchwarzAlternating(
   for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
     // Get parameters for each subdomain
     Albany::SolverFactory
-    solver_factory(model_filenames[subdomain], comm);
+    solver_factory(model_filenames[subdomain], group_comm_);
 
     solver_factory.setSchwarz(true); 
 
@@ -135,6 +157,20 @@ SchwarzAlternating(
     // Add application name-index map for later use in Schwarz BC.
     params.set("Application Name Index Map", app_name_index_map);
 
+    // All groups hold a copy of every subdomain. Keep their Exodus files
+    // apart; each subdomain is written only by the group that solves it.
+    Teuchos::ParameterList &
+    disc_params = params.sublist("Discretization");
+
+    if (group_id_ > 0 && disc_params.isType<std::string>(
+        "Exodus Output File Name") == true) {
+      std::string const
+      exo_filename = disc_params.get<std::string>("Exodus Output File Name");
+
+      disc_params.set("Exodus Output File Name",
+          exo_filename + ".group-" + std::to_string(group_id_));
+    }
+
     // Add NOX pre-post-operator for Schwarz loop convergence criterion.
     bool const
     have_piro = params.isSublist("Piro");
@@ -181,7 +217,8 @@ SchwarzAlternating(
     app{Teuchos::null};
     
     Teuchos::RCP<Thyra::ResponseOnlyModelEvaluatorBase<ST>>
-    solver = solver_factory.createAndGetAlbanyAppT(app, comm, comm);
+    solver = solver_factory.createAndGetAlbanyAppT(
+        app, group_comm_, group_comm_);
 
     solvers_[subdomain] = solver;
 
@@ -211,6 +248,18 @@ SchwarzAlternating(
     curr_disp_[subdomain] = Teuchos::null;
   }
 
+  ALBANY_ASSERT(num_groups_ == 1 || is_dynamic_ == false,
+      "Concurrent subdomain groups not supported for dynamics");
+
+  assignSubdomainsToGroups();
+
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    if (isLocalSubdomain(subdomain) == false) {
+      do_outputs_[subdomain] = false;
+      do_outputs_init_[subdomain] = false;
+    }
+  }
+
   //
   // Parameters
   //
@@ -780,10 +829,231 @@ reportFinals(std::ostream & os) const
   os << "Absolute tolerance :" << abs_tol_ << '\n';
   os << "Last relative error:" << rel_error_ << '\n';
   os << "Relative tolerance :" << rel_tol_ << '\n';
+  os << "Schwarz method     :";
+  os << (is_additive_ == true ? "Additive" : "Multiplicative") << '\n';
+  os << "Subdomain groups   :" << num_groups_ << '\n';
+  os << "Wall time          :" << wall_time_ << '\n';
   os << std::endl;
   return;
 }
 
+//
+//
+//
+void
+SchwarzAlternating::
+createSubdomainGroups(Teuchos::RCP<Teuchos::Comm<int> const> const & comm)
+{
+  int const
+  world_size = comm->getSize();
+
+  int const
+  world_rank = comm->getRank();
+
+  ALBANY_ASSERT(world_size % num_groups_ == 0,
+      "Number of ranks must be a multiple of Number of Subdomain Groups");
+
+  int const
+  group_size = world_size / num_groups_;
+
+  group_id_ = world_rank / group_size;
+
+  if (num_groups_ == 1) {
+    group_comm_ = comm;
+    inter_comm_ = Teuchos::null;
+    return;
+  }
+
+  group_comm_ = comm->split(group_id_, world_rank);
+
+  // Rank in the inter-group communicator is the group id.
+  inter_comm_ = comm->split(world_rank % group_size, group_id_);
+
+  return;
+}
+
+//
+// Longest processing time first: largest subdomain to least loaded group.
+//
+void
+SchwarzAlternating::
+assignSubdomainsToGroups()
+{
+  subdomain_group_.assign(num_subdomains_, 0);
+
+  if (num_groups_ == 1) return;
+
+  std::vector<std::pair<Tpetra_GO, int>>
+  dofs_subdomain;
+
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    Tpetra_GO const
+    num_dofs = discs_[subdomain]->getMapT()->getGlobalNumElements();
+
+    dofs_subdomain.emplace_back(num_dofs, subdomain);
+  }
+
+  std::stable_sort(dofs_subdomain.begin(), dofs_subdomain.end(),
+      [](std::pair<Tpetra_GO, int> const & a,
+          std::pair<Tpetra_GO, int> const & b) {
+        return a.first > b.first;
+      });
+
+  std::vector<Tpetra_GO>
+  group_dofs(num_groups_, 0);
+
+  for (auto && ds : dofs_subdomain) {
+    auto const
+    min_it = std::min_element(group_dofs.begin(), group_dofs.end());
+
+    int const
+    group = static_cast<int>(min_it - group_dofs.begin());
+
+    subdomain_group_[ds.second] = group;
+    group_dofs[group] += ds.first;
+  }
+
+  auto &
+  fos = *Teuchos::VerboseObjectBase::getDefaultOStream();
+
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    fos << "INFO: Subdomain " << subdomain << " assigned to group ";
+    fos << subdomain_group_[subdomain] << '\n';
+  }
+
+  return;
+}
+
+//
+//
+//
+bool
+SchwarzAlternating::
+isLocalSubdomain(int const subdomain) const
+{
+  return subdomain_group_[subdomain] == group_id_;
+}
+
+//
+//
+//
+void
+SchwarzAlternating::
+freezeCoupledSolutions(
+    std::vector<Teuchos::RCP<Thyra::VectorBase<ST> const>> const & x) const
+{
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    auto &
+    app = *apps_[subdomain];
+
+    auto const &
+    x_rcp = x[subdomain];
+
+    Teuchos::RCP<Tpetra_Vector const>
+    frozen_x = x_rcp.is_null() == true ?
+        Teuchos::null : ConverterT::getConstTpetraVector(x_rcp);
+
+    app.setFrozenX(frozen_x);
+  }
+  return;
+}
+
+//
+//
+//
+void
+SchwarzAlternating::
+thawCoupledSolutions() const
+{
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    apps_[subdomain]->setFrozenX(Teuchos::null);
+  }
+  return;
+}
+
+//
+//
+//
+void
+SchwarzAlternating::
+synchronizeSubdomainGroups(
+    minitensor::Vector<ST> & norms_init,
+    minitensor::Vector<ST> & norms_final,
+    minitensor::Vector<ST> & norms_diff) const
+{
+  if (num_groups_ == 1) return;
+
+  auto const &
+  inter_comm = *inter_comm_;
+
+  int
+  local_failed = failed_ == true ? 1 : 0;
+
+  int
+  global_failed{0};
+
+  Teuchos::reduceAll(
+      inter_comm, Teuchos::REDUCE_MAX, 1, &local_failed, &global_failed);
+
+  failed_ = global_failed > 0;
+
+  if (failed_ == true) return;
+
+  // Each subdomain norm is computed by one group only.
+  std::vector<ST>
+  local_norms(3 * num_subdomains_, 0.0);
+
+  std::vector<ST>
+  global_norms(3 * num_subdomains_, 0.0);
+
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    if (isLocalSubdomain(subdomain) == false) continue;
+    local_norms[3 * subdomain + 0] = norms_init(subdomain);
+    local_norms[3 * subdomain + 1] = norms_final(subdomain);
+    local_norms[3 * subdomain + 2] = norms_diff(subdomain);
+  }
+
+  Teuchos::reduceAll(inter_comm, Teuchos::REDUCE_SUM,
+      3 * num_subdomains_, local_norms.data(), global_norms.data());
+
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    norms_init(subdomain) = global_norms[3 * subdomain + 0];
+    norms_final(subdomain) = global_norms[3 * subdomain + 1];
+    norms_diff(subdomain) = global_norms[3 * subdomain + 2];
+  }
+
+  // Broadcast solutions from the owner group. The decomposition of each
+  // subdomain is the same in all groups, so local arrays line up.
+  for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+    auto &
+    me = dynamic_cast<Albany::ModelEvaluatorT &>
+    (*model_evaluators_[subdomain]);
+
+    Teuchos::RCP<Thyra::VectorBase<ST>>
+    disp_rcp = Thyra::createMember(me.get_x_space());
+
+    Teuchos::RCP<Tpetra_Vector>
+    disp_tpetra = ConverterT::getTpetraVector(disp_rcp);
+
+    if (isLocalSubdomain(subdomain) == true) {
+      disp_tpetra->assign(*ConverterT::getConstTpetraVector(
+          curr_disp_[subdomain]));
+    }
+
+    Teuchos::ArrayRCP<ST>
+    disp_data = disp_tpetra->getDataNonConst();
+
+    Teuchos::broadcast(inter_comm, subdomain_group_[subdomain],
+        static_cast<int>(disp_data.size()), disp_data.getRawPtr());
+
+    disp_data = Teuchos::null;
+
+    curr_disp_[subdomain] = disp_rcp;
+  }
+
+  return;
+}
+
 //
 // Schwarz Alternating loop, dynamic
 //
@@ -809,8 +1079,15 @@ SchwarzLoopDynamics() const
   fos << delim << std::endl;
   fos << "Schwarz Alternating Method with " << num_subdomains_;
   fos << " subdomains\n";
+  fos << "Schwarz method     :";
+  fos << (is_additive_ == true ? "Additive" : "Multiplicative") << '\n';
   fos << std::scientific << std::setprecision(17);
 
+  Teuchos::Time
+  timer("Schwarz Alternating Dynamics");
+
+  timer.start(true);
+
   ST
   time_step{initial_time_step_};
 
@@ -865,6 +1142,26 @@ SchwarzLoopDynamics() const
       bool const
       is_initial_state = stop == 0 && num_iter_ == 0;
 
+      // Additive: all subdomains see boundary data from the same iterate.
+      if (is_additive_ == true) {
+        std::vector<Teuchos::RCP<Thyra::VectorBase<ST> const>>
+        frozen_disp(num_subdomains_);
+
+        for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+          if (is_initial_state == true) {
+            auto &
+            me = dynamic_cast<Albany::ModelEvaluatorT &>
+            (*model_evaluators_[subdomain]);
+
+            frozen_disp[subdomain] = me.getNominalValues().get_x()->clone_v();
+          } else {
+            frozen_disp[subdomain] = this_disp_[subdomain]->clone_v();
+          }
+        }
+
+        freezeCoupledSolutions(frozen_disp);
+      }
+
       for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
 
         fos << delim << std::endl;
@@ -1207,6 +1504,8 @@ SchwarzLoopDynamics() const
 
     }  while (continueSolve() == true);
 
+    if (is_additive_ == true) thawCoupledSolutions();
+
      // One of the subdomains failed to solve. Reduce step.
     if (failed_ == true) {
       failed_ = false;
@@ -1246,6 +1545,8 @@ SchwarzLoopDynamics() const
       continue;
     }
 
+    wall_time_ = timer.totalElapsedTime(true);
+
     reportFinals(fos);
 
     //Update IC vecs and output solution to exodus file
@@ -1418,8 +1719,16 @@ SchwarzLoopQuasistatics() const
   fos << delim << std::endl;
   fos << "Schwarz Alternating Method with " << num_subdomains_;
   fos << " subdomains\n";
+  fos << "Schwarz method     :";
+  fos << (is_additive_ == true ? "Additive" : "Multiplicative") << '\n';
+  fos << "Subdomain groups   :" << num_groups_ << '\n';
   fos << std::scientific << std::setprecision(17);
 
+  Teuchos::Time
+  timer("Schwarz Alternating Quasistatics");
+
+  timer.start(true);
+
   ST
   time_step{initial_time_step_};
 
@@ -1478,9 +1787,32 @@ SchwarzLoopQuasistatics() const
       bool const
       is_initial_state = stop == 0 && num_iter_ == 0;
 
+      // Additive: all subdomains see boundary data from the same iterate.
+      if (is_additive_ == true) {
+        std::vector<Teuchos::RCP<Thyra::VectorBase<ST> const>>
+        frozen_disp(num_subdomains_);
+
+        for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
+          if (is_initial_state == true) {
+            auto &
+            me = dynamic_cast<Albany::ModelEvaluatorT &>
+            (*model_evaluators_[subdomain]);
+
+            frozen_disp[subdomain] = me.getNominalValues().get_x()->clone_v();
+          } else {
+            frozen_disp[subdomain] = curr_disp_[subdomain];
+          }
+        }
+
+        freezeCoupledSolutions(frozen_disp);
+      }
+
       // Subdomain loop
       for (auto subdomain = 0; subdomain < num_subdomains_; ++subdomain) {
 
+        // Solved by another group of ranks.
+        if (isLocalSubdomain(subdomain) == false) continue;
+
         fos << delim << std::endl;
         fos << "Schwarz iteration  :" << num_iter_ << '\n';
         fos << "Subdomain          :" << subdomain << '\n';
@@ -1608,6 +1940,8 @@ SchwarzLoopQuasistatics() const
 #endif //DEBUG
       } // Subdomain loop
 
+      synchronizeSubdomainGroups(norms_init, norms_final, norms_diff);
+
       if (failed_ == true) {
         fos << "INFO: Unable to continue Schwarz iteration " << num_iter_;
         fos << "\n";
@@ -1664,6 +1998,8 @@ SchwarzLoopQuasistatics() const
 
     }  while (continueSolve() == true); // Schwarz loop
 
+    if (is_additive_ == true) thawCoupledSolutions();
+
     // One of the subdomains failed to solve. Reduce step.
     if (failed_ == true) {
       failed_ = false;
@@ -1698,6 +2034,8 @@ SchwarzLoopQuasistatics() const
       continue;
     }
 
+    wall_time_ = timer.totalElapsedTime(true);
+
     reportFinals(fos);
 
     // Output converged solution if at specified interval
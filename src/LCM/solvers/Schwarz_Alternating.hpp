@@ -13,6 +13,7 @@
 #include "Albany_DataTypes.hpp"
 #include "Albany_MaterialDatabase.hpp"
 #include "Albany_ModelEvaluatorT.hpp"
+#include "MiniTensor.h"
 #include "Piro_NOXSolver.hpp"
 #include "Thyra_DefaultProductVector.hpp"
 #include "Thyra_DefaultProductVectorSpace.hpp"
@@ -159,6 +160,35 @@ private:
   void
   reportFinals(std::ostream & os) const;
 
+  /// Split the world communicator into equal groups of ranks for
+  /// concurrent (additive) subdomain solves.
+  void
+  createSubdomainGroups(Teuchos::RCP<Teuchos::Comm<int> const> const & comm);
+
+  /// Assign subdomains to groups by balancing their DOF counts.
+  void
+  assignSubdomainsToGroups();
+
+  bool
+  isLocalSubdomain(int const subdomain) const;
+
+  /// For additive Schwarz, fix the boundary data seen by all subdomains
+  /// to the given iterate before a sweep.
+  void
+  freezeCoupledSolutions(
+      std::vector<Teuchos::RCP<Thyra::VectorBase<ST> const>> const & x) const;
+
+  void
+  thawCoupledSolutions() const;
+
+  /// Exchange failure flag, norms and solutions between subdomain groups
+  /// after a concurrent sweep.
+  void
+  synchronizeSubdomainGroups(
+      minitensor::Vector<ST> & norms_init,
+      minitensor::Vector<ST> & norms_final,
+      minitensor::Vector<ST> & norms_diff) const;
+
   std::vector<Teuchos::RCP<Thyra::ResponseOnlyModelEvaluatorBase<ST>>>
   solvers_;
 
@@ -216,6 +246,26 @@ private:
   int
   output_interval_{1};
 
+  bool
+  is_additive_{false};
+
+  int
+  num_groups_{1};
+
+  int
+  group_id_{0};
+
+  Teuchos::RCP<Teuchos::Comm<int> const>
+  group_comm_{Teuchos::null};
+
+  // One rank per group, same in-group rank. Used to exchange data between
+  // groups, as all groups share the same decomposition of every subdomain.
+  Teuchos::RCP<Teuchos::Comm<int> const>
+  inter_comm_{Teuchos::null};
+
+  std::vector<int>
+  subdomain_group_;
+
   mutable bool
   failed_{false};
 
@@ -240,6 +290,9 @@ private:
   mutable ST
   norm_diff_{0.0};
 
+  mutable ST
+  wall_time_{0.0};
+
   mutable std::vector<Thyra::ModelEvaluatorBase::InArgs<ST>>
   sub_inargs_;
 
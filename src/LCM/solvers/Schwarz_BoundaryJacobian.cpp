@@ -3,10 +3,15 @@
 //    This Software is released under the BSD license detailed     //
 //    in the file "license.txt" in the top-level Albany directory  //
 //*****************************************************************//
+#include <algorithm>
+#include <map>
+#include <set>
+
 #include "Albany_GenericSTKMeshStruct.hpp"
 #include "Albany_STKDiscretization.hpp"
 #include "Albany_Utils.hpp"
 #include "Schwarz_BoundaryJacobian.hpp"
+#include "SchwarzBC.hpp"
 #include "Teuchos_ParameterListExceptions.hpp"
 #include "Teuchos_TestForException.hpp"
 
@@ -35,6 +40,27 @@ Schwarz_BoundaryJacobian(
   ALBANY_EXPECT(0 <= coupled_app_index && coupled_app_index < ca.size());
   domain_map_ = ca[coupled_app_index]->getMapT();
   range_map_ = ca[this_app_index]->getMapT();
+
+  computeStencil();
+
+  // The graph is that of P and does not change; initialize() refills it.
+  explicit_operator_ = Teuchos::rcp(
+      new Tpetra_CrsMatrix(range_map_, col_map_, 0));
+
+  Teuchos::Array<LO>
+  index(1);
+
+  Teuchos::Array<ST>
+  value(1, Teuchos::ScalarTraits<ST>::zero());
+
+  for (auto k = 0; k < rows_.size(); ++k) {
+    index[0] = cols_[k];
+    explicit_operator_->insertLocalValues(rows_[k], index(), value());
+  }
+
+  explicit_operator_->fillComplete(domain_map_, range_map_);
+
+  initialize();
 }
 
 //
@@ -47,12 +73,137 @@ Schwarz_BoundaryJacobian::
 }
 
 //
-// Initialize the operator with everything needed to apply it
+// Interpolation from the coupled solution to the Schwarz boundary of this
+// application, the same one the Schwarz BC uses.
+//
+void
+Schwarz_BoundaryJacobian::
+computeStencil()
+{
+  Albany::Application const &
+  this_app = getApplication(this_app_index_);
+
+  Teuchos::Array<GO>
+  col_gids;
+
+  std::map<GO, LO>
+  gid_to_col;
+
+  if (this_app.isCoupled(coupled_app_index_) == true) {
+
+    std::string const &
+    nodeset_name = this_app.getNodesetName(coupled_app_index_);
+
+    std::vector<std::vector<int>> const &
+    ns_dof =
+        this_app.getDiscretization()->getNodeSets().find(nodeset_name)->second;
+
+    std::vector<std::vector<GO>>
+    coupled_dofs;
+
+    std::vector<RealType>
+    weights;
+
+    for (auto ns_node = 0; ns_node < ns_dof.size(); ++ns_node) {
+
+      computeSchwarzInterpolation(
+          this_app,
+          coupled_app_index_,
+          ns_node,
+          coupled_dofs,
+          weights);
+
+      for (auto i = 0; i < weights.size(); ++i) {
+        for (auto j = 0; j < coupled_dofs[i].size(); ++j) {
+
+          GO const
+          gid = coupled_dofs[i][j];
+
+          auto
+          it = gid_to_col.find(gid);
+
+          if (it == gid_to_col.end()) {
+            it = gid_to_col.insert(std::make_pair(gid, col_gids.size())).first;
+            col_gids.push_back(gid);
+          }
+
+          rows_.push_back(ns_dof[ns_node][j]);
+          cols_.push_back(it->second);
+          weights_.push_back(weights[i]);
+        }
+      }
+    }
+  }
+
+  values_.resize(weights_.size());
+
+  col_map_ = Teuchos::rcp(
+      new Tpetra_Map(
+          Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid(),
+          col_gids(),
+          0,
+          comm_));
+
+  importer_ = Teuchos::rcp(new Tpetra_Import(domain_map_, col_map_));
+}
+
+//
+// Update the entries after a Jacobian fill of this application
 //
 void
 Schwarz_BoundaryJacobian::
 initialize()
 {
+  Albany::Application const &
+  this_app = getApplication(this_app_index_);
+
+  // Rows the Schwarz BC replaced by j_coeff * (x - P x_coupled). Rows also
+  // fixed by other Dirichlet BCs do not depend on the coupled solution.
+  std::set<LO> const
+  schwarz_dofs = this_app.getSchwarzDOFs(coupled_app_index_);
+
+  Tpetra_Vector
+  diagonal(range_map_);
+
+  jacs_[this_app_index_]->getLocalDiagCopy(diagonal);
+
+  Teuchos::ArrayRCP<ST const>
+  diagonal_view = diagonal.get1dView();
+
+  auto const
+  zero = Teuchos::ScalarTraits<ST>::zero();
+
+  for (auto k = 0; k < rows_.size(); ++k) {
+    LO const
+    row = rows_[k];
+
+    bool const
+    is_schwarz_row = schwarz_dofs.find(row) != schwarz_dofs.end();
+
+    values_[k] =
+        is_schwarz_row == true ? -diagonal_view[row] * weights_[k] : zero;
+  }
+
+  explicit_operator_->resumeFill();
+
+  explicit_operator_->setAllToScalar(zero);
+
+  Teuchos::Array<LO>
+  index(1);
+
+  Teuchos::Array<ST>
+  value(1);
+
+  for (auto k = 0; k < rows_.size(); ++k) {
+    index[0] = cols_[k];
+    value[0] = values_[k];
+    explicit_operator_->sumIntoLocalValues(rows_[k], index(), value());
+  }
+
+  explicit_operator_->fillComplete(domain_map_, range_map_);
+
+  b_initialized_ = true;
+
   return;
 }
 
@@ -63,21 +214,63 @@ Teuchos::RCP<Tpetra_CrsMatrix>
 Schwarz_BoundaryJacobian::
 getExplicitOperator() const
 {
-  auto const
-  max_num_cols = getDomainMap()->getNodeNumElements();
+  return explicit_operator_;
+}
+
+//
+// Largest relative difference between the matrix-free and the explicit
+// operators on random vectors
+//
+ST
+Schwarz_BoundaryJacobian::
+checkExplicitOperator(int const num_vectors) const
+{
+  ST const
+  alpha = -2.0;
 
-  Teuchos::RCP<Tpetra_CrsMatrix>
-  K = Teuchos::rcp(
-      new Tpetra_CrsMatrix(getRangeMap(), getDomainMap(), max_num_cols));
+  ST const
+  beta = 0.5;
 
-  auto const
-  zero = Teuchos::ScalarTraits<ST>::zero();
+  Tpetra_MultiVector
+  X(domain_map_, num_vectors, false);
+
+  X.randomize();
 
-  K->setAllToScalar(zero);
+  Tpetra_MultiVector
+  Y_matrix_free(range_map_, num_vectors, false);
 
-  K->fillComplete();
+  Y_matrix_free.randomize();
 
-  return K;
+  Tpetra_MultiVector
+  Y_explicit(Y_matrix_free, Teuchos::Copy);
+
+  apply(X, Y_matrix_free, Teuchos::NO_TRANS, alpha, beta);
+
+  explicit_operator_->apply(X, Y_explicit, Teuchos::NO_TRANS, alpha, beta);
+
+  Teuchos::Array<ST>
+  norms(num_vectors);
+
+  Y_explicit.normInf(norms());
+
+  Y_matrix_free.update(-1.0, Y_explicit, 1.0);
+
+  Teuchos::Array<ST>
+  differences(num_vectors);
+
+  Y_matrix_free.normInf(differences());
+
+  ST
+  difference = Teuchos::ScalarTraits<ST>::zero();
+
+  for (auto v = 0; v < num_vectors; ++v) {
+    ST const
+    scale = norms[v] > 0.0 ? norms[v] : 1.0;
+
+    difference = std::max(difference, differences[v] / scale);
+  }
+
+  return difference;
 }
 
 //
@@ -93,10 +286,39 @@ apply(
     ST alpha,
     ST beta) const
 {
+  ALBANY_ASSERT(
+      mode == Teuchos::NO_TRANS,
+      "Schwarz_BoundaryJacobian: only NO_TRANS apply is implemented.");
+
   auto const
   zero = Teuchos::ScalarTraits<ST>::zero();
 
-  Y.putScalar(zero);
+  if (beta == zero) {
+    Y.putScalar(zero);
+  } else {
+    Y.scale(beta);
+  }
+
+  // Coupled values the boundary depends on, gathered from their owners
+  auto const
+  num_vectors = X.getNumVectors();
+
+  Tpetra_MultiVector
+  X_col(col_map_, num_vectors, false);
+
+  X_col.doImport(X, *importer_, Tpetra::INSERT);
+
+  for (auto v = 0; v < num_vectors; ++v) {
+    Teuchos::ArrayRCP<ST const>
+    x = X_col.getData(v);
+
+    Teuchos::ArrayRCP<ST>
+    y = Y.getDataNonConst(v);
+
+    for (auto k = 0; k < rows_.size(); ++k) {
+      y[rows_[k]] += alpha * values_[k] * x[cols_[k]];
+    }
+  }
 }
 
 } //namespace LCM
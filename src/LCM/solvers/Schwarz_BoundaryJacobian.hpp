@@ -28,6 +28,16 @@ namespace LCM {
 /// LCM coupled Schwarz Multiscale problem.
 /// Each Jacobian couples one single application to another.
 ///
+/// In the rows of the Schwarz BC of this application coupled to the
+/// other one, the residual is x - P x_coupled, where P interpolates the
+/// coupled solution at the boundary nodes (computeSchwarzInterpolation).
+/// The operator is the derivative of that residual with respect to the
+/// coupled solution, -P scaled by the diagonal of those rows, and zero
+/// elsewhere. P is found once, at construction; initialize() takes the
+/// scaling and the constrained rows from the last Jacobian fill of this
+/// application. The operator is applied matrix-free or as an explicit
+/// sparse matrix with the same entries.
+///
 
 class Schwarz_BoundaryJacobian: public Tpetra_Operator {
 public:
@@ -40,8 +50,7 @@ public:
 
   ~Schwarz_BoundaryJacobian();
 
-  /// Initialize the operator with everything needed to apply it
-  //FIXME: add arguments
+  /// Update the entries after a Jacobian fill of this application
   void
   initialize();
 
@@ -57,9 +66,15 @@ public:
       ST beta = Teuchos::ScalarTraits<ST>::zero()) const;
 
   /// Returns explicit matrix representation of operator if available.
+  /// The matrix is updated in place by initialize().
   Teuchos::RCP<Tpetra_CrsMatrix>
   getExplicitOperator() const;
 
+  /// Largest relative difference, over num_vectors random vectors, between
+  /// apply() and the explicit operator applied with the same alpha and beta
+  ST
+  checkExplicitOperator(int const num_vectors = 4) const;
+
   /// Returns the current UseTranspose setting.
   virtual
   bool
@@ -122,6 +137,10 @@ public:
 
 private:
 
+  /// Find the interpolation from the coupled solution to the boundary
+  void
+  computeStencil();
+
   Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>>
   coupled_apps_;
 
@@ -146,6 +165,31 @@ private:
   Teuchos::RCP<Teuchos_Comm const>
   comm_;
 
+  /// Interpolation entries: local row, local column in col_map_ and
+  /// shape function value. Each row is one component of a boundary node.
+  Teuchos::Array<LO>
+  rows_;
+
+  Teuchos::Array<LO>
+  cols_;
+
+  Teuchos::Array<ST>
+  weights_;
+
+  /// Entries of the operator, set by initialize()
+  Teuchos::Array<ST>
+  values_;
+
+  /// Coupled DOFs the boundary depends on
+  Teuchos::RCP<Tpetra_Map const>
+  col_map_;
+
+  Teuchos::RCP<Tpetra_Import const>
+  importer_;
+
+  Teuchos::RCP<Tpetra_CrsMatrix>
+  explicit_operator_;
+
   bool
   b_use_transpose_;
 
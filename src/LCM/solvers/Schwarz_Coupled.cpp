@@ -105,6 +105,24 @@ SchwarzCoupled(
     ALBANY_ASSERT(false, "Unknown Matrix-Free Preconditioner type.");
   }
 
+  // Off-diagonal blocks of the Jacobian: the sensitivities of the Schwarz
+  // BCs of each model to the solution of the model it is coupled to. With
+  // "None" Newton sees only the block diagonal.
+  std::string const
+  off_diagonal =
+      coupled_system_params.get<std::string>(
+          "Off-Diagonal Jacobian Blocks", "None");
+
+  ALBANY_ASSERT(
+      off_diagonal == "None" || off_diagonal == "Matrix-Free" ||
+      off_diagonal == "Explicit",
+      "Unknown Off-Diagonal Jacobian Blocks type: " << off_diagonal);
+
+  explicit_off_diagonal_ = off_diagonal == "Explicit";
+
+  check_off_diagonal_ = coupled_system_params.get<bool>(
+      "Check Off-Diagonal Jacobian Blocks", false);
+
   // If using matrix-free, get NOX sublist and set "Preconditioner Type" to
   // "None" regardless  of what is specified in the input file.
   // Currently preconditioners for matrix-free  are implemented in this
@@ -515,6 +533,21 @@ SchwarzCoupled(
     solver_outargs_[m] = models_[m]->createOutArgs();
   }
 
+  // The Schwarz BCs know their coupled models now that all applications
+  // are built.
+  if (off_diagonal != "None") {
+    boundary_jacs_.resize(num_models_ * num_models_);
+
+    for (auto i = 0; i < num_models_; ++i) {
+      for (auto j = 0; j < num_models_; ++j) {
+        if (i == j || apps_[i]->isCoupled(j) == false) continue;
+
+        boundary_jacs_[i * num_models_ + j] = Teuchos::rcp(
+            new Schwarz_BoundaryJacobian(comm_, apps_, jacs_, i, j));
+      }
+    }
+  }
+
   //----------------Parameters------------------------
   // Create sacado parameter vectors of appropriate size
   // for use in evalModelImpl
@@ -767,7 +800,8 @@ SchwarzCoupled::create_W_op() const
   Schwarz_CoupledJacobian
   jac(comm_);
 
-  return jac.getThyraCoupledJacobian(jacs_, apps_);
+  return jac.getThyraCoupledJacobian(
+      jacs_, apps_, boundary_jacs_, explicit_off_diagonal_);
 }
 
 Teuchos::RCP<Thyra::PreconditionerBase<ST>>
@@ -1054,6 +1088,18 @@ evalModelImpl(
     app_disc->writeSolutionToMeshDatabaseT(*xTs[m], time);
   }
 
+  // With the off-diagonal blocks, all the models see the current iterate
+  // of the others through the Schwarz BCs, so that the residual is the
+  // monolithic one those blocks are the derivatives of.
+  bool const
+  use_off_diagonal = boundary_jacs_.size() > 0;
+
+  if (use_off_diagonal == true) {
+    for (auto m = 0; m < num_models_; ++m) {
+      apps_[m]->setFrozenX(xTs[m]);
+    }
+  }
+
   // W matrix for each individual model
   if (Teuchos::nonnull(W_op_outT) == true) {
     for (auto m = 0; m < num_models_; ++m) {
@@ -1064,9 +1110,25 @@ evalModelImpl(
           sacado_param_vecs_[m], fTs_out[m].get(), *jacs_[m]);
       fs_already_computed[m] = true;
     }
-    // FIXME: create coupled W matrix from array of model W matrices
-    Schwarz_CoupledJacobian jac(comm_);
-    W_op_outT = jac.getThyraCoupledJacobian(jacs_, apps_);
+
+    // The blocks of W_op are updated in place.
+    for (auto k = 0; k < boundary_jacs_.size(); ++k) {
+      if (boundary_jacs_[k].is_null() == false) boundary_jacs_[k]->initialize();
+    }
+
+    // Both representations of each block must agree
+    for (auto k = 0; check_off_diagonal_ && k < boundary_jacs_.size(); ++k) {
+      if (boundary_jacs_[k].is_null() == true) continue;
+
+      ST const
+      difference = boundary_jacs_[k]->checkExplicitOperator();
+
+      if (comm_->getRank() == 0) {
+        std::cout << "Off-diagonal Jacobian block (" << k / num_models_;
+        std::cout << ", " << k % num_models_ << "): matrix-free and explicit";
+        std::cout << " apply differ by " << difference << '\n';
+      }
+    }
   }
 
   for (auto m = 0; m < num_models_; ++m) {
@@ -1232,6 +1294,12 @@ evalModelImpl(
     }
   }
 
+  if (use_off_diagonal == true) {
+    for (auto m = 0; m < num_models_; ++m) {
+      apps_[m]->setFrozenX(Teuchos::null);
+    }
+  }
+
 #ifdef WRITE_TO_MATRIX_MARKET
   Albany::writeMatrixMarket(xTs, "sol", mm_counter_sol);
   ++mm_counter_sol;
@@ -183,6 +183,20 @@ private:
   Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>>
   precs_;
 
+  /// Off-diagonal coupling blocks, (i, j) at i * num_models_ + j; null for
+  /// models that are not coupled, empty if not used
+  Teuchos::Array<Teuchos::RCP<Schwarz_BoundaryJacobian>>
+  boundary_jacs_;
+
+  /// Off-diagonal blocks given as explicit matrices
+  bool
+  explicit_off_diagonal_{false};
+
+  /// Compare the matrix-free and explicit off-diagonal blocks after each
+  /// Jacobian fill
+  bool
+  check_off_diagonal_{false};
+
   int
   num_models_;
 
@@ -35,16 +35,16 @@ Schwarz_CoupledJacobian::
   return;
 }
 
-//#define USE_OFF_DIAGONAL
-//#define EXPLICIT_OFF_DIAGONAL
-
 // getThyraCoupledJacobian method is similar to getThyraMatrix in panzer
 //(Panzer_BlockedTpetraLinearObjFactory_impl.hpp).
 Teuchos::RCP<Thyra::LinearOpBase<ST>>
 Schwarz_CoupledJacobian::
 getThyraCoupledJacobian(
     Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> jacs,
-    Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca)
+    Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca,
+    Teuchos::Array<Teuchos::RCP<Schwarz_BoundaryJacobian>> const &
+    boundary_jacs,
+    bool const explicit_off_diagonal)
 const
 {
   auto const
@@ -76,34 +76,27 @@ const
         block = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(jacs[i]);
         blocked_op->setNonconstBlock(i, j, block);
       } else { // Off-diagonal blocks
-#if defined(USE_OFF_DIAGONAL)
-#if defined(EXPLICIT_OFF_DIAGONAL)
+        if (boundary_jacs.size() == 0) continue;
 
-        Teuchos::RCP<Schwarz_BoundaryJacobian>
-        jac_boundary =
-            Teuchos::rcp(
-                new Schwarz_BoundaryJacobian(comm_, ca, jacs, i, j));
+        Teuchos::RCP<Schwarz_BoundaryJacobian> const &
+        jac_boundary = boundary_jacs[i * block_dim + j];
 
-        Teuchos::RCP<Tpetra_CrsMatrix>
-        exp_jac = jac_boundary->getExplicitOperator();
+        if (jac_boundary.is_null() == true) continue;
 
         Teuchos::RCP<Thyra::LinearOpBase<ST>>
-        block = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(exp_jac);
-
-#else
+        block;
 
-        Teuchos::RCP<Tpetra_Operator>
-        jac_boundary =
-            Teuchos::rcp(
-                new Schwarz_BoundaryJacobian(comm_, ca, jacs, i, j));
-
-        Teuchos::RCP<Thyra::LinearOpBase<ST>>
-        block = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(jac_boundary);
+        if (explicit_off_diagonal == true) {
+          Teuchos::RCP<Tpetra_CrsMatrix>
+          exp_jac = jac_boundary->getExplicitOperator();
 
-#endif // EXPLICIT_OFF_DIAGONAL
+          block = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(exp_jac);
+        } else {
+          block = Thyra::createLinearOp<ST, LO, Tpetra_GO, KokkosNode>(
+              Teuchos::rcp_implicit_cast<Tpetra_Operator>(jac_boundary));
+        }
 
         blocked_op->setNonconstBlock(i, j, block);
-#endif // USE_OFF_DIAGONAL
       }
     }
   }
@@ -31,10 +31,18 @@ public:
 
   ~Schwarz_CoupledJacobian();
 
+  /// Blocked operator with the Jacobians of the applications on the
+  /// diagonal. Off-diagonal block (i, j) is boundary_jacs[i * n + j], for n
+  /// applications, as an operator or, if explicit_off_diagonal, as its
+  /// explicit matrix. Blocks are zero if boundary_jacs is empty or the entry
+  /// is null.
   Teuchos::RCP<Thyra::LinearOpBase<ST>>
   getThyraCoupledJacobian(
       Teuchos::Array<Teuchos::RCP<Tpetra_CrsMatrix>> jacs,
-      Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca) const;
+      Teuchos::ArrayRCP<Teuchos::RCP<Albany::Application>> const & ca,
+      Teuchos::Array<Teuchos::RCP<Schwarz_BoundaryJacobian>> const &
+      boundary_jacs = Teuchos::Array<Teuchos::RCP<Schwarz_BoundaryJacobian>>(),
+      bool const explicit_off_diagonal = false) const;
 
 private:
 
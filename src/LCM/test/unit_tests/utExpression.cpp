@@ -0,0 +1,151 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include <Teuchos_UnitTestHarness.hpp>
+#include "../../../utility/Expression.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+
+using util::Expression;
+
+double const tol = 1.0e-14;
+
+//
+// Evaluate formula at (x, y, z)
+//
+double
+eval(std::string const & formula, double x, double y, double z)
+{
+  Expression const
+  expr(formula, {"x", "y", "z"});
+
+  double const
+  values[3] = {x, y, z};
+
+  return expr.evaluate(values);
+}
+
+TEUCHOS_UNIT_TEST(Expression, Precedence)
+{
+  TEST_FLOATING_EQUALITY(eval("2+3*4", 0, 0, 0), 14.0, tol);
+  TEST_FLOATING_EQUALITY(eval("(2+3)*4", 0, 0, 0), 20.0, tol);
+  TEST_FLOATING_EQUALITY(eval("10-4-3", 0, 0, 0), 3.0, tol);
+  TEST_FLOATING_EQUALITY(eval("24/4/2", 0, 0, 0), 3.0, tol);
+  TEST_FLOATING_EQUALITY(eval("2*3^2", 0, 0, 0), 18.0, tol);
+  // Power is right associative
+  TEST_FLOATING_EQUALITY(eval("2^3^2", 0, 0, 0), 512.0, tol);
+  TEST_FLOATING_EQUALITY(eval("x+y*z", 1, 2, 3), 7.0, tol);
+  TEST_FLOATING_EQUALITY(eval("(x+y)*z", 1, 2, 3), 9.0, tol);
+}
+
+TEUCHOS_UNIT_TEST(Expression, UnaryMinus)
+{
+  TEST_FLOATING_EQUALITY(eval("-x", 2, 0, 0), -2.0, tol);
+  // Unary minus binds looser than power
+  TEST_FLOATING_EQUALITY(eval("-x^2", 3, 0, 0), -9.0, tol);
+  TEST_FLOATING_EQUALITY(eval("(-x)^2", 3, 0, 0), 9.0, tol);
+  TEST_FLOATING_EQUALITY(eval("2*-3", 0, 0, 0), -6.0, tol);
+  TEST_FLOATING_EQUALITY(eval("x--y", 1, 2, 0), 3.0, tol);
+  TEST_FLOATING_EQUALITY(eval("-(x+y)*z", 1, 2, 3), -9.0, tol);
+  TEST_FLOATING_EQUALITY(eval("+x", 5, 0, 0), 5.0, tol);
+}
+
+TEUCHOS_UNIT_TEST(Expression, Functions)
+{
+  double const x = 0.3, y = 0.7, z = 2.5;
+
+  TEST_FLOATING_EQUALITY(eval("sin(x)", x, y, z), std::sin(x), tol);
+  TEST_FLOATING_EQUALITY(eval("cos(x)*exp(y)", x, y, z),
+                         std::cos(x) * std::exp(y), tol);
+  TEST_FLOATING_EQUALITY(eval("sqrt(z)", x, y, z), std::sqrt(z), tol);
+  TEST_FLOATING_EQUALITY(eval("log(z)+log10(z)", x, y, z),
+                         std::log(z) + std::log10(z), tol);
+  TEST_FLOATING_EQUALITY(eval("abs(x-y)", x, y, z), std::abs(x - y), tol);
+  TEST_FLOATING_EQUALITY(eval("pow(z,x)", x, y, z), std::pow(z, x), tol);
+  TEST_FLOATING_EQUALITY(eval("atan2(y,x)", x, y, z), std::atan2(y, x), tol);
+  TEST_FLOATING_EQUALITY(eval("min(x,y)", x, y, z), x, tol);
+  TEST_FLOATING_EQUALITY(eval("max(x,y)", x, y, z), y, tol);
+  TEST_FLOATING_EQUALITY(eval("sin(pi/2)", x, y, z), 1.0, tol);
+  TEST_FLOATING_EQUALITY(eval("-sin(x)^2", x, y, z),
+                         -std::sin(x) * std::sin(x), tol);
+}
+
+TEUCHOS_UNIT_TEST(Expression, Comparisons)
+{
+  TEST_EQUALITY(eval("x<y", 1, 2, 0), 1.0);
+  TEST_EQUALITY(eval("x>y", 1, 2, 0), 0.0);
+  TEST_EQUALITY(eval("x<=1", 1, 2, 0), 1.0);
+  TEST_EQUALITY(eval("y>=3", 1, 2, 0), 0.0);
+  TEST_EQUALITY(eval("x==1", 1, 2, 0), 1.0);
+  TEST_EQUALITY(eval("x!=1", 1, 2, 0), 0.0);
+  // Comparisons bind looser than arithmetic
+  TEST_EQUALITY(eval("x+1<y*2", 1, 2, 0), 1.0);
+  TEST_FLOATING_EQUALITY(eval("(x<y)*z + (x>=y)*(-z)", 1, 2, 3), 3.0, tol);
+}
+
+TEUCHOS_UNIT_TEST(Expression, AssignmentAndConstants)
+{
+  TEST_FLOATING_EQUALITY(eval("value = x*y;", 2, 3, 0), 6.0, tol);
+
+  Expression const
+  constant("2*pi", {"x", "y", "z"});
+
+  TEST_ASSERT(constant.isConstant());
+
+  Expression const
+  variable("x*2", {"x", "y", "z"});
+
+  TEST_ASSERT(variable.isConstant() == false);
+}
+
+TEUCHOS_UNIT_TEST(Expression, ArrayEvaluate)
+{
+  Expression const
+  expr("x^2 - 3*y + sin(z)", {"x", "y", "z"});
+
+  std::size_t const
+  n = 1000;
+
+  std::vector<double> x(n), y(n), z(n), result(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    x[i] = 0.01 * i;
+    y[i] = 1.0 - 0.002 * i;
+    z[i] = 0.005 * i;
+  }
+
+  double const * const
+  variables[3] = {x.data(), y.data(), z.data()};
+
+  expr.evaluate(n, variables, result.data());
+
+  std::vector<double> registers;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    double const
+    values[3] = {x[i], y[i], z[i]};
+
+    TEST_EQUALITY(result[i], expr.evaluate(values, registers));
+  }
+}
+
+TEUCHOS_UNIT_TEST(Expression, InvalidFormula)
+{
+  std::vector<std::string> const
+  variables = {"x", "y", "z"};
+
+  TEST_THROW(Expression("2+", variables), std::invalid_argument);
+  TEST_THROW(Expression("(x+1", variables), std::invalid_argument);
+  TEST_THROW(Expression("w*2", variables), std::invalid_argument);
+  TEST_THROW(Expression("foo(x)", variables), std::invalid_argument);
+  TEST_THROW(Expression("pow(x)", variables), std::invalid_argument);
+  TEST_THROW(Expression("x y", variables), std::invalid_argument);
+}
+
+} // anonymous namespace
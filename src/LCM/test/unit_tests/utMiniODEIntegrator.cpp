@@ -0,0 +1,191 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "MiniODEIntegrator.h"
+
+int
+main(int ac, char * av[])
+{
+  Kokkos::initialize();
+
+  ::testing::GTEST_FLAG(print_time) = (ac > 1) ? true : false;
+
+  ::testing::InitGoogleTest(&ac, av);
+
+  auto const
+  retval = RUN_ALL_TESTS();
+
+  Kokkos::finalize();
+
+  return retval;
+}
+
+namespace
+{
+
+//
+// y' = -rate y
+//
+struct Decay
+{
+  template<typename S>
+  minitensor::Vector<S, 1>
+  rhs(S const & t, minitensor::Vector<S, 1> const & y) const
+  {
+    minitensor::Vector<S, 1>
+    f;
+
+    f(0) = -rate * y(0);
+
+    return f;
+  }
+
+  double
+  rate{1.0};
+};
+
+//
+// y' = -lambda (y - cos(t)), stiff for large lambda
+//
+struct Relaxation
+{
+  template<typename S>
+  minitensor::Vector<S, 1>
+  rhs(S const & t, minitensor::Vector<S, 1> const & y) const
+  {
+    using std::cos;
+
+    minitensor::Vector<S, 1>
+    f;
+
+    f(0) = -lambda * (y(0) - cos(t));
+
+    return f;
+  }
+
+  double
+  lambda{1000.0};
+};
+
+} // anonymous namespace
+
+//
+// Both methods reach the exact solution to the tolerance.
+//
+TEST(MiniODEIntegrator, Decay)
+{
+  for (auto method : {LCM::ODEMethod::BOGACKI_SHAMPINE,
+      LCM::ODEMethod::ROSENBROCK}) {
+
+    LCM::MiniODEIntegrator<double, 1>
+    integrator(method, 1.0e-6, 1.0e-12, 10000);
+
+    minitensor::Vector<double, 1>
+    y;
+
+    y(0) = 1.0;
+
+    ASSERT_TRUE(integrator.integrate(Decay(), 0.0, 1.0, y));
+    ASSERT_NEAR(y(0), std::exp(-1.0), 1.0e-5);
+  }
+}
+
+//
+// On a stiff system the Rosenbrock method takes far fewer steps.
+//
+TEST(MiniODEIntegrator, Stiff)
+{
+  double const
+  lambda{1000.0};
+
+  double const
+  exact = (lambda * lambda * std::cos(1.0) + lambda * std::sin(1.0) +
+      std::exp(-lambda)) / (lambda * lambda + 1.0);
+
+  LCM::MiniODEIntegrator<double, 1>
+  explicit_integrator(LCM::ODEMethod::BOGACKI_SHAMPINE, 1.0e-4, 1.0e-10, 10000);
+
+  LCM::MiniODEIntegrator<double, 1>
+  stiff_integrator(LCM::ODEMethod::ROSENBROCK, 1.0e-4, 1.0e-10, 10000);
+
+  minitensor::Vector<double, 1>
+  y_explicit;
+
+  minitensor::Vector<double, 1>
+  y_stiff;
+
+  y_explicit(0) = 1.0;
+  y_stiff(0) = 1.0;
+
+  ASSERT_TRUE(explicit_integrator.integrate(Relaxation(), 0.0, 1.0, y_explicit));
+  ASSERT_TRUE(stiff_integrator.integrate(Relaxation(), 0.0, 1.0, y_stiff));
+
+  ASSERT_NEAR(y_explicit(0), exact, 1.0e-3);
+  ASSERT_NEAR(y_stiff(0), exact, 1.0e-3);
+
+  int const
+  explicit_steps = explicit_integrator.getNumAcceptedSteps() +
+      explicit_integrator.getNumRejectedSteps();
+
+  int const
+  stiff_steps = stiff_integrator.getNumAcceptedSteps() +
+      stiff_integrator.getNumRejectedSteps();
+
+  ASSERT_LT(4 * stiff_steps, explicit_steps);
+}
+
+//
+// The derivative of y(1) with respect to y(0) is exp(-1).
+//
+TEST(MiniODEIntegrator, Derivatives)
+{
+  using FAD = Sacado::Fad::SFad<double, 1>;
+
+  for (auto method : {LCM::ODEMethod::BOGACKI_SHAMPINE,
+      LCM::ODEMethod::ROSENBROCK}) {
+
+    LCM::MiniODEIntegrator<FAD, 1>
+    integrator(method, 1.0e-6, 1.0e-12, 10000);
+
+    minitensor::Vector<FAD, 1>
+    y;
+
+    y(0) = FAD(1, 0, 1.0);
+
+    ASSERT_TRUE(integrator.integrate(Decay(), 0.0, 1.0, y));
+    ASSERT_NEAR(y(0).val(), std::exp(-1.0), 1.0e-5);
+    ASSERT_NEAR(y(0).dx(0), std::exp(-1.0), 1.0e-5);
+  }
+}
+
+//
+// Each point of a batch is integrated with its own steps.
+//
+TEST(MiniODEIntegrator, Batch)
+{
+  std::vector<Decay>
+  systems(3);
+
+  std::vector<minitensor::Vector<double, 1>>
+  y(3);
+
+  for (int i = 0; i < 3; ++i) {
+    systems[i].rate = std::pow(10.0, i);
+    y[i](0) = 1.0;
+  }
+
+  LCM::MiniODEIntegrator<double, 1>
+  integrator(LCM::ODEMethod::ROSENBROCK, 1.0e-4, 1.0e-12, 10000);
+
+  ASSERT_EQ(integrator.integrate(systems, 0.0, 1.0, y), 0);
+
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_NEAR(y[i](0), std::exp(-systems[i].rate), 1.0e-3);
+  }
+}
@@ -0,0 +1,212 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include <Teuchos_UnitTestHarness.hpp>
+#include "../../utils/mortar/Moertel_SearchGrid.hpp"
+
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+
+using MoertelT::SearchGrid;
+typedef SearchGrid::Point Point;
+
+// Minimal stand-ins for the Moertel node and segment interface
+struct TestNode
+{
+  std::array<double, 3> x;
+  std::array<double, 3> XCoords() const { return x; }
+};
+
+struct TestSegment
+{
+  TestNode node[4];
+  TestNode* ptr[4];
+  int Nnode() const { return 4; }
+  TestNode** Nodes() { return ptr; }
+};
+
+double const inflation = 2.5;
+
+//
+// Flat n x n interface of unit quadrilaterals at height z, shifted by offset
+//
+std::vector<TestSegment>
+flatInterface(int n, double offset, double z)
+{
+  std::vector<TestSegment> segs(n * n);
+  double const dx[4] = {0.0, 1.0, 1.0, 0.0};
+  double const dy[4] = {0.0, 0.0, 1.0, 1.0};
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      TestSegment& seg = segs[i * n + j];
+      for (int k = 0; k < 4; ++k) {
+        seg.node[k].x = {{i + dx[k] + offset, j + dy[k] + offset, z}};
+        seg.ptr[k] = &seg.node[k];
+      }
+    }
+  }
+  return segs;
+}
+
+void
+boxes(std::vector<TestSegment>& segs, std::vector<Point>& lo, std::vector<Point>& hi)
+{
+  lo.resize(segs.size());
+  hi.resize(segs.size());
+  for (std::size_t i = 0; i < segs.size(); ++i)
+    MoertelT::InflatedBoundingBox(segs[i], inflation, lo[i], hi[i]);
+}
+
+bool
+overlap(Point const& alo, Point const& ahi, Point const& blo, Point const& bhi)
+{
+  for (int d = 0; d < 3; ++d)
+    if (ahi[d] < blo[d] || bhi[d] < alo[d]) return false;
+  return true;
+}
+
+void
+bruteForce(
+    std::vector<Point> const& mlo, std::vector<Point> const& mhi,
+    Point const& lo, Point const& hi, std::vector<int>& ids)
+{
+  ids.clear();
+  for (std::size_t i = 0; i < mlo.size(); ++i)
+    if (overlap(mlo[i], mhi[i], lo, hi) == true) ids.push_back(i);
+}
+
+//
+// The grid must report exactly the boxes found by testing all pairs
+//
+TEUCHOS_UNIT_TEST(MortarSearchGrid, MatchesBruteForce)
+{
+  int const n = 32;
+  std::vector<TestSegment> master = flatInterface(n, 0.0, 0.0);
+  std::vector<TestSegment> slave = flatInterface(n, 0.3, 0.1);
+
+  std::vector<Point> mlo, mhi, slo, shi;
+  boxes(master, mlo, mhi);
+  boxes(slave, slo, shi);
+
+  SearchGrid grid;
+  for (std::size_t i = 0; i < master.size(); ++i) grid.Update(i, mlo[i], mhi[i]);
+  grid.Finalize();
+  TEST_EQUALITY(grid.Size(), master.size());
+
+  std::vector<int> found, expected;
+  for (std::size_t i = 0; i < slave.size(); ++i) {
+    grid.Candidates(slo[i], shi[i], found);
+    bruteForce(mlo, mhi, slo[i], shi[i], expected);
+    TEST_COMPARE_ARRAYS(found, expected);
+  }
+}
+
+//
+// Moving boxes incrementally must give the same answer as a fresh grid
+//
+TEUCHOS_UNIT_TEST(MortarSearchGrid, IncrementalUpdate)
+{
+  int const n = 16;
+  std::vector<TestSegment> master = flatInterface(n, 0.0, 0.0);
+  std::vector<TestSegment> slave = flatInterface(n, 0.5, 0.0);
+
+  std::vector<Point> mlo, mhi, slo, shi;
+  boxes(master, mlo, mhi);
+  boxes(slave, slo, shi);
+
+  SearchGrid grid;
+  for (std::size_t i = 0; i < master.size(); ++i) grid.Update(i, mlo[i], mhi[i]);
+  grid.Finalize();
+
+  // deform the master side: a shear that grows away from the origin
+  for (std::size_t i = 0; i < master.size(); ++i) {
+    for (int k = 0; k < 4; ++k) {
+      std::array<double, 3>& x = master[i].node[k].x;
+      x[0] += 0.2 * x[1];
+      x[2] += 0.05 * x[0];
+    }
+  }
+  boxes(master, mlo, mhi);
+
+  int rebinned = 0;
+  for (std::size_t i = 0; i < master.size(); ++i)
+    if (grid.Update(i, mlo[i], mhi[i]) == true) ++rebinned;
+  grid.Finalize();
+  TEST_COMPARE(rebinned, <, int(master.size()));
+
+  // removed boxes must not be reported any more
+  grid.Remove(0);
+  mlo[0] = mhi[0] = Point{{1.0e10, 1.0e10, 1.0e10}};
+
+  std::vector<int> found, expected;
+  for (std::size_t i = 0; i < slave.size(); ++i) {
+    grid.Candidates(slo[i], shi[i], found);
+    bruteForce(mlo, mhi, slo[i], shi[i], expected);
+    TEST_COMPARE_ARRAYS(found, expected);
+  }
+}
+
+//
+// Pairing on a large flat interface: candidates per slave segment stay
+// bounded and the grid beats the all-pairs loop by a wide margin
+//
+TEUCHOS_UNIT_TEST(MortarSearchGrid, Scaling)
+{
+  typedef std::chrono::steady_clock Clock;
+
+  std::size_t maxCandidates = 0;
+  double gridTime = 0.0;
+  double bruteTime = 0.0;
+
+  for (int n = 32; n <= 128; n *= 2) {
+    std::vector<TestSegment> master = flatInterface(n, 0.0, 0.0);
+    std::vector<TestSegment> slave = flatInterface(n, 0.3, 0.1);
+
+    std::vector<Point> mlo, mhi, slo, shi;
+    boxes(master, mlo, mhi);
+    boxes(slave, slo, shi);
+
+    std::vector<int> ids;
+    std::size_t gridPairs = 0;
+    std::size_t brutePairs = 0;
+    std::size_t candidates = 0;
+
+    Clock::time_point start = Clock::now();
+    SearchGrid grid;
+    for (std::size_t i = 0; i < master.size(); ++i) grid.Update(i, mlo[i], mhi[i]);
+    grid.Finalize();
+    for (std::size_t i = 0; i < slave.size(); ++i) {
+      grid.Candidates(slo[i], shi[i], ids);
+      gridPairs += ids.size();
+      candidates = std::max(candidates, ids.size());
+    }
+    gridTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (std::size_t i = 0; i < slave.size(); ++i) {
+      bruteForce(mlo, mhi, slo[i], shi[i], ids);
+      brutePairs += ids.size();
+    }
+    bruteTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+    out << "n = " << n << " segments = " << master.size()
+        << " pairs = " << gridPairs
+        << " grid = " << gridTime << " s"
+        << " all pairs = " << bruteTime << " s\n";
+
+    TEST_EQUALITY(gridPairs, brutePairs);
+
+    // same local geometry for every size
+    if (maxCandidates == 0) maxCandidates = candidates;
+    TEST_EQUALITY(candidates, maxCandidates);
+  }
+
+  TEST_COMPARE(gridTime, <, bruteTime);
+}
+
+} // anonymous namespace
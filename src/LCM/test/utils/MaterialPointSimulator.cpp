@@ -364,6 +364,12 @@ main(int ac, char* av[])
     double parametrization_interval =
         mpsParams.get<double>("Parametrization Interval", 0.05);
 
+    bool bifurcation_warm_start =
+        mpsParams.get<bool>("Bifurcation Warm Start", false);
+
+    double bifurcation_screening_margin =
+        mpsParams.get<double>("Bifurcation Screening Margin", 0.5);
+
     std::cout << "Bifurcation Check in Material Point Simulator:" << std::endl;
     std::cout << "Parametrization Type: " << parametrization_type << std::endl;
 
@@ -371,6 +377,9 @@ main(int ac, char* av[])
     bcPL.set<Teuchos::ParameterList*>("Material Parameters", &paramList);
     bcPL.set<std::string>("Parametrization Type Name", parametrization_type);
     bcPL.set<double>("Parametrization Interval Name", parametrization_interval);
+    bcPL.set<bool>("Bifurcation Warm Start", bifurcation_warm_start);
+    bcPL.set<double>(
+        "Bifurcation Screening Margin", bifurcation_screening_margin);
     bcPL.set<std::string>("Material Tangent Name", "Material Tangent");
     bcPL.set<std::string>("Ellipticity Flag Name", "Ellipticity_Flag");
     bcPL.set<std::string>("Bifurcation Direction Name", "Direction");
@@ -394,7 +403,7 @@ main(int ac, char* av[])
     fieldManager.registerEvaluator<Residual>(ev);
     stateFieldManager.registerEvaluator<Residual>(ev);
 
-    // register the direction
+    // register the direction, with its old state for the warm start
     p = stateMgr.registerStateVariable(
         "Direction",
         dl->qp_vector,
@@ -402,7 +411,7 @@ main(int ac, char* av[])
         element_block_name,
         "scalar",
         0.0,
-        false,
+        bifurcation_warm_start,
         true);
     ev = Teuchos::rcp(new PHAL::SaveStateField<Residual, Traits>(*p));
     fieldManager.registerEvaluator<Residual>(ev);
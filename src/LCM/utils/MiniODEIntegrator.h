@@ -0,0 +1,173 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#if !defined(LCM_MiniODEIntegrator_h)
+#define LCM_MiniODEIntegrator_h
+
+#include <string>
+#include <vector>
+
+#include "MiniTensor.h"
+#include "Sacado.hpp"
+
+namespace LCM
+{
+
+///
+/// Methods of the mini ODE integrator
+///
+enum class ODEMethod
+{
+  UNDEFINED,
+  BOGACKI_SHAMPINE,
+  ROSENBROCK
+};
+
+///
+/// Method from its name in the input, UNDEFINED if unknown
+///
+ODEMethod
+odeMethodFromName(std::string const & name);
+
+///
+/// Adaptive integration of small systems of ODEs y' = f(t, y), such as
+/// the evolution of the internal variables of an integration point, over
+/// a global time step [t0, t1].
+///
+/// The system is a class with the member template
+///
+///   template<typename S>
+///   minitensor::Vector<S, N>
+///   rhs(S const & t, minitensor::Vector<S, N> const & y) const;
+///
+/// BOGACKI_SHAMPINE is the explicit embedded Runge-Kutta pair of orders
+/// 3 and 2, for non-stiff systems. ROSENBROCK is the two-stage ROS2
+/// method of Verwer et al., L-stable, of order 2 with an embedded order 1
+/// solution, for stiff systems. It solves two linear systems per step with
+/// the Jacobian of f, obtained by automatic differentiation of rhs(), and
+/// takes no Newton iterations.
+///
+/// The first step follows the heuristic of Hairer, Norsett and Wanner.
+/// A step is accepted if the RMS norm of its local error estimate,
+/// weighted by atol + rtol max(|y|, |y_new|), is at most 1. The next step
+/// follows from that error, on accepted and rejected steps alike. The
+/// control uses the values of the states. With T a Fad type the
+/// derivatives of y(t1) follow the accepted steps.
+///
+template<typename T, minitensor::Index N>
+class MiniODEIntegrator
+{
+public:
+  using ValueT = typename Sacado::ScalarType<T>::type;
+
+  static_assert(N != minitensor::DYNAMIC, "ODE systems of static size only");
+
+  MiniODEIntegrator(
+      ODEMethod const method,
+      ValueT const rel_tol,
+      ValueT const abs_tol,
+      int const max_steps);
+
+  ///
+  /// Integrate y from t0 to t1, false if it needs more than the maximum
+  /// number of steps
+  ///
+  template<typename SYS>
+  bool
+  integrate(
+      SYS const & system,
+      ValueT const t0,
+      ValueT const t1,
+      minitensor::Vector<T, N> & y);
+
+  ///
+  /// Integrate a batch of systems, one per point, each with its own steps.
+  /// Returns the number of systems that did not reach t1.
+  ///
+  template<typename SYS>
+  int
+  integrate(
+      std::vector<SYS> const & systems,
+      ValueT const t0,
+      ValueT const t1,
+      std::vector<minitensor::Vector<T, N>> & y);
+
+  int
+  getNumAcceptedSteps() const
+  {
+    return num_accepted_;
+  }
+
+  int
+  getNumRejectedSteps() const
+  {
+    return num_rejected_;
+  }
+
+private:
+  ///
+  /// First step size for integrating from (t0, y)
+  ///
+  template<typename SYS>
+  ValueT
+  initialStep(
+      SYS const & system,
+      ValueT const t0,
+      ValueT const span,
+      ValueT const order,
+      minitensor::Vector<T, N> const & y);
+
+  ///
+  /// One step of size h from (t, y), the weighted norm of its error
+  ///
+  template<typename SYS>
+  ValueT
+  stepBogackiShampine(
+      SYS const & system,
+      ValueT const t,
+      ValueT const h,
+      minitensor::Vector<T, N> const & y,
+      minitensor::Vector<T, N> & y_new);
+
+  template<typename SYS>
+  ValueT
+  stepRosenbrock(
+      SYS const & system,
+      ValueT const t,
+      ValueT const h,
+      minitensor::Vector<T, N> const & y,
+      minitensor::Vector<T, N> & y_new);
+
+  ValueT
+  errorNorm(
+      minitensor::Vector<T, N> const & y,
+      minitensor::Vector<T, N> const & y_new,
+      minitensor::Vector<T, N> const & error) const;
+
+  ODEMethod
+  method_{ODEMethod::UNDEFINED};
+
+  ValueT
+  rel_tol_{0.0};
+
+  ValueT
+  abs_tol_{0.0};
+
+  int
+  max_steps_{0};
+
+  int
+  num_accepted_{0};
+
+  int
+  num_rejected_{0};
+};
+
+} // namespace LCM
+
+#include "MiniODEIntegrator.t.h"
+
+#endif // LCM_MiniODEIntegrator_h
@@ -0,0 +1,338 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace LCM
+{
+
+//
+//
+//
+inline
+ODEMethod
+odeMethodFromName(std::string const & name)
+{
+  if (name == "Bogacki-Shampine") return ODEMethod::BOGACKI_SHAMPINE;
+  if (name == "Rosenbrock") return ODEMethod::ROSENBROCK;
+  return ODEMethod::UNDEFINED;
+}
+
+//
+//
+//
+template<typename T, minitensor::Index N>
+MiniODEIntegrator<T, N>::
+MiniODEIntegrator(
+    ODEMethod const method,
+    ValueT const rel_tol,
+    ValueT const abs_tol,
+    int const max_steps) :
+    method_(method),
+    rel_tol_(rel_tol),
+    abs_tol_(abs_tol),
+    max_steps_(max_steps)
+{
+  return;
+}
+
+//
+//
+//
+template<typename T, minitensor::Index N>
+template<typename SYS>
+bool
+MiniODEIntegrator<T, N>::
+integrate(
+    SYS const & system,
+    ValueT const t0,
+    ValueT const t1,
+    minitensor::Vector<T, N> & y)
+{
+  // Step size controller
+  ValueT const
+  safety{0.9};
+
+  ValueT const
+  min_factor{0.2};
+
+  ValueT const
+  max_factor{5.0};
+
+  // Order of the embedded solution plus one
+  ValueT const
+  order = method_ == ODEMethod::BOGACKI_SHAMPINE ? 3.0 : 2.0;
+
+  ValueT const
+  span = t1 - t0;
+
+  if (span <= 0.0) return true;
+
+  ValueT
+  t{t0};
+
+  ValueT
+  h = initialStep(system, t0, span, order, y);
+
+  minitensor::Vector<T, N>
+  y_new;
+
+  for (int n = 0; n < max_steps_; ++n) {
+
+    bool const
+    last = h >= t1 - t;
+
+    if (last == true) h = t1 - t;
+
+    ValueT const
+    error = method_ == ODEMethod::BOGACKI_SHAMPINE ?
+        stepBogackiShampine(system, t, h, y, y_new) :
+        stepRosenbrock(system, t, h, y, y_new);
+
+    if (error <= 1.0) {
+      ++num_accepted_;
+      y = y_new;
+      if (last == true) return true;
+      t += h;
+    } else {
+      ++num_rejected_;
+    }
+
+    ValueT
+    factor{min_factor};
+
+    if (std::isfinite(error) == true) {
+      factor = error > 0.0 ?
+          safety * std::pow(error, -1.0 / order) : max_factor;
+      factor = std::min(max_factor, std::max(min_factor, factor));
+    }
+
+    h *= factor;
+
+    if (h <= std::numeric_limits<ValueT>::epsilon() * span) return false;
+  }
+
+  return false;
+}
+
+//
+//
+//
+template<typename T, minitensor::Index N>
+template<typename SYS>
+int
+MiniODEIntegrator<T, N>::
+integrate(
+    std::vector<SYS> const & systems,
+    ValueT const t0,
+    ValueT const t1,
+    std::vector<minitensor::Vector<T, N>> & y)
+{
+  int
+  num_failed{0};
+
+  for (std::size_t i = 0; i < systems.size(); ++i) {
+    if (integrate(systems[i], t0, t1, y[i]) == false) ++num_failed;
+  }
+
+  return num_failed;
+}
+
+//
+// Starting step of Hairer, Norsett and Wanner, Solving ODEs I, II.4: the
+// step for which an explicit Euler step would make an error of 0.01, from
+// the sizes of y, f and the change of f.
+//
+template<typename T, minitensor::Index N>
+template<typename SYS>
+typename MiniODEIntegrator<T, N>::ValueT
+MiniODEIntegrator<T, N>::
+initialStep(
+    SYS const & system,
+    ValueT const t0,
+    ValueT const span,
+    ValueT const order,
+    minitensor::Vector<T, N> const & y)
+{
+  minitensor::Vector<T, N> const
+  f0 = system.rhs(T(t0), y);
+
+  ValueT const
+  d0 = errorNorm(y, y, y);
+
+  ValueT const
+  d1 = errorNorm(y, y, f0);
+
+  ValueT
+  h0 = (d0 < 1.0e-5 || d1 < 1.0e-5) ? 1.0e-6 * span : 0.01 * d0 / d1;
+
+  h0 = std::min(h0, span);
+
+  minitensor::Vector<T, N> const
+  f1 = system.rhs(T(t0 + h0), minitensor::Vector<T, N>(y + h0 * f0));
+
+  ValueT const
+  d2 = errorNorm(y, y, minitensor::Vector<T, N>(f1 - f0)) / h0;
+
+  ValueT const
+  d_max = std::max(d1, d2);
+
+  ValueT const
+  h1 = d_max <= 1.0e-15 ?
+      std::max(1.0e-6 * span, 1.0e-3 * h0) :
+      std::pow(0.01 / d_max, 1.0 / order);
+
+  return std::min(std::min(100.0 * h0, h1), span);
+}
+
+//
+// Bogacki-Shampine 3(2). The last stage is f at the new solution.
+//
+template<typename T, minitensor::Index N>
+template<typename SYS>
+typename MiniODEIntegrator<T, N>::ValueT
+MiniODEIntegrator<T, N>::
+stepBogackiShampine(
+    SYS const & system,
+    ValueT const t,
+    ValueT const h,
+    minitensor::Vector<T, N> const & y,
+    minitensor::Vector<T, N> & y_new)
+{
+  minitensor::Vector<T, N> const
+  k1 = system.rhs(T(t), y);
+
+  minitensor::Vector<T, N> const
+  k2 = system.rhs(
+      T(t + 0.5 * h), minitensor::Vector<T, N>(y + 0.5 * h * k1));
+
+  minitensor::Vector<T, N> const
+  k3 = system.rhs(
+      T(t + 0.75 * h), minitensor::Vector<T, N>(y + 0.75 * h * k2));
+
+  y_new = y + h * (2.0 / 9.0 * k1 + 1.0 / 3.0 * k2 + 4.0 / 9.0 * k3);
+
+  minitensor::Vector<T, N> const
+  k4 = system.rhs(T(t + h), y_new);
+
+  minitensor::Vector<T, N> const
+  error = h * (-5.0 / 72.0 * k1 + 1.0 / 12.0 * k2 + 1.0 / 9.0 * k3 -
+      1.0 / 8.0 * k4);
+
+  return errorNorm(y, y_new, error);
+}
+
+//
+// ROS2: with gamma = 1 + 1 / sqrt(2) and M = I - gamma h J,
+//
+//   M k1 = h f(t, y) + gamma h^2 f_t
+//   M k2 = h f(t + h, y + k1) - 2 k1 - gamma h^2 f_t
+//
+// y_new = y + 3/2 k1 + 1/2 k2, and the embedded y + k1.
+//
+template<typename T, minitensor::Index N>
+template<typename SYS>
+typename MiniODEIntegrator<T, N>::ValueT
+MiniODEIntegrator<T, N>::
+stepRosenbrock(
+    SYS const & system,
+    ValueT const t,
+    ValueT const h,
+    minitensor::Vector<T, N> const & y,
+    minitensor::Vector<T, N> & y_new)
+{
+  using AD = Sacado::Fad::SLFad<T, N + 1>;
+
+  ValueT const
+  gamma = 1.0 + 1.0 / std::sqrt(2.0);
+
+  // f, df/dy and df/dt at (t, y); t is the last independent variable.
+  minitensor::Vector<AD, N>
+  y_ad;
+
+  for (minitensor::Index i = 0; i < N; ++i) {
+    y_ad(i) = AD(N + 1, i, y(i));
+  }
+
+  AD const
+  t_ad(N + 1, N, T(t));
+
+  minitensor::Vector<AD, N> const
+  f_ad = system.rhs(t_ad, y_ad);
+
+  minitensor::Vector<T, N>
+  f;
+
+  minitensor::Vector<T, N>
+  f_t;
+
+  minitensor::Tensor<T, N>
+  M;
+
+  for (minitensor::Index i = 0; i < N; ++i) {
+    f(i) = f_ad(i).val();
+    f_t(i) = f_ad(i).dx(N);
+    for (minitensor::Index j = 0; j < N; ++j) {
+      M(i, j) = -gamma * h * f_ad(i).dx(j);
+    }
+    M(i, i) += 1.0;
+  }
+
+  minitensor::Vector<T, N> const
+  k1 = minitensor::solve(
+      M, minitensor::Vector<T, N>(h * f + gamma * h * h * f_t));
+
+  minitensor::Vector<T, N> const
+  f2 = system.rhs(T(t + h), minitensor::Vector<T, N>(y + k1));
+
+  minitensor::Vector<T, N> const
+  k2 = minitensor::solve(
+      M, minitensor::Vector<T, N>(h * f2 - 2.0 * k1 - gamma * h * h * f_t));
+
+  y_new = y + 1.5 * k1 + 0.5 * k2;
+
+  minitensor::Vector<T, N> const
+  error = 0.5 * (k1 + k2);
+
+  return errorNorm(y, y_new, error);
+}
+
+//
+//
+//
+template<typename T, minitensor::Index N>
+typename MiniODEIntegrator<T, N>::ValueT
+MiniODEIntegrator<T, N>::
+errorNorm(
+    minitensor::Vector<T, N> const & y,
+    minitensor::Vector<T, N> const & y_new,
+    minitensor::Vector<T, N> const & error) const
+{
+  ValueT
+  sum{0.0};
+
+  for (minitensor::Index i = 0; i < N; ++i) {
+    ValueT const
+    y_i = std::abs(Sacado::ScalarValue<T>::eval(y(i)));
+
+    ValueT const
+    y_new_i = std::abs(Sacado::ScalarValue<T>::eval(y_new(i)));
+
+    ValueT const
+    scale = abs_tol_ + rel_tol_ * std::max(y_i, y_new_i);
+
+    ValueT const
+    e_i = Sacado::ScalarValue<T>::eval(error(i)) / scale;
+
+    sum += e_i * e_i;
+  }
+
+  return std::sqrt(sum / N);
+}
+
+} // namespace LCM
@@ -18,6 +18,7 @@
 #include <Teuchos_LAPACK.hpp>
 #include <Teuchos_SerialDenseMatrix.hpp>
 #include <Epetra_Export.h>
+#include <Epetra_Import.h>
 #include "Phalanx_KokkosViewFactory.hpp"
 #include "Phalanx_MDField.hpp"
 
@@ -497,15 +498,21 @@ void LCM::PeridigmManager::initialize(const Teuchos::RCP<Teuchos::ParameterList>
   }
 }
 
-void LCM::PeridigmManager::obcOverlappingElementSearch()
+bool LCM::PeridigmManager::obcOverlappingElementSearchIsValid() const
 {
-  static bool searchComplete = false;
-  if(searchComplete){
-    std::cout << "DJL DEBUGGING PeridigmManager::obcOverlappingElementSearch() is being called more than once!" << std::endl;
-  }
-  searchComplete = true;
+  return !obcDataPoints.is_null() && obcSearchOverlapMap.get() == stkDisc->getOverlapMapT().get();
+}
 
+void LCM::PeridigmManager::obcOverlappingElementSearch()
+{
   obcDataPoints = Teuchos::rcp(new std::vector<OBCDataPoint>());
+  obcSearchOverlapMap = stkDisc->getOverlapMapT();
+
+  // Communication patterns built for the previous search results
+  obcCurrentCoordsImporter = Teuchos::null;
+  obcPeridynamicNodeDofMap = Teuchos::null;
+  obcOverlapExporter = Teuchos::null;
+  obcPeridynamicNodeImporter = Teuchos::null;
 
   stk::mesh::Field<double,stk::mesh::Cartesian3d>* coordinatesField =
     metaData->get_field< stk::mesh::Field<double,stk::mesh::Cartesian3d>>(stk::topology::NODE_RANK, "coordinates");
@@ -769,6 +776,18 @@ void LCM::PeridigmManager::obcOverlappingElementSearch()
 	    dataPoint.peridigmGlobalId = neighborSphereNodeId;
 	    dataPoint.albanyElement = elements[iElem];
 	    dataPoint.cellTopologyData = cellTopologyData;
+
+	    // The basis functions at the peridynamic node do not change as long as the search results are valid
+	    Teuchos::RCP<Intrepid2::Basis<PHX::Device, RealType, RealType>> refBasis = Albany::getIntrepid2Basis(cellTopologyData);
+	    Kokkos::DynRankView<RealType, PHX::Device> refPoint("PPP", 1, numDim);
+	    for(int dof=0 ; dof<3 ; dof++)
+	      refPoint(0, dof) = point(dof);
+	    Kokkos::DynRankView<RealType, PHX::Device> basisOnRefPoint("PPP", numNodesInElement, 1);
+	    refBasis->getValues(basisOnRefPoint, refPoint, Intrepid2::OPERATOR_VALUE);
+	    dataPoint.basisValues.resize(numNodesInElement);
+	    for(int i=0 ; i<numNodesInElement ; i++)
+	      dataPoint.basisValues[i] = basisOnRefPoint(i, 0);
+
 	    obcDataPoints->push_back(dataPoint);
 	  }
 	}
@@ -810,14 +829,21 @@ double LCM::PeridigmManager::obcEvaluateFunctional(Epetra_Vector* obcFunctionalD
     return 0.0;
   }
 
+  // Repeat the search if the Albany discretization has changed since it was done
+  if(!obcOverlappingElementSearchIsValid()){
+    obcOverlappingElementSearch();
+  }
+
   // Set up access to the current displacements of the nodes in the solid elements
   Teuchos::ArrayRCP<const ST> albanyCurrentDisplacement = albanyOverlapSolutionVector->getData();
   const Teuchos::RCP<const Tpetra_Map> albanyMap = albanyOverlapSolutionVector->getMap();
 
   // Load the current displacements into the obcDataPoints data structures
   Epetra_Vector& peridigmCurrentPositions = *(peridigm->getY());
-  Epetra_Import overlapCurrentCoordsImporter(obcPeridynamicNodeCurrentCoords->Map(), peridigmCurrentPositions.Map());
-  int err = obcPeridynamicNodeCurrentCoords->Import(peridigmCurrentPositions, overlapCurrentCoordsImporter, Insert);
+  if(obcCurrentCoordsImporter.is_null() || obcCurrentCoordsImporter->SourceMap().DataPtr() != peridigmCurrentPositions.Map().DataPtr()){
+    obcCurrentCoordsImporter = Teuchos::rcp(new Epetra_Import(obcPeridynamicNodeCurrentCoords->Map(), peridigmCurrentPositions.Map()));
+  }
+  int err = obcPeridynamicNodeCurrentCoords->Import(peridigmCurrentPositions, *obcCurrentCoordsImporter, Insert);
   TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "\n\n**** Error in PeridigmManager::obcEvaluateFunctional(), import operation failed!\n\n");
   for(unsigned int iEvalPt=0 ; iEvalPt<obcDataPoints->size() ; iEvalPt++){
     int localId = obcPeridynamicNodeCurrentCoords->Map().LID((*obcDataPoints)[iEvalPt].peridigmGlobalId);
@@ -828,27 +854,32 @@ double LCM::PeridigmManager::obcEvaluateFunctional(Epetra_Vector* obcFunctionalD
 
   // Creating Overlapped obcFunctionalDerivWrtDisplacement
   Teuchos::RCP<Epetra_Vector> obcFunctionalDerivWrtDisplacementOverlap;
-  Teuchos::RCP<Epetra_Export> overlapSolutionExporter;
   if(obcFunctionalDerivWrtDisplacement != NULL){
     obcFunctionalDerivWrtDisplacementOverlap = Teuchos::rcp<Epetra_Vector>(new Epetra_Vector(*stkDisc->getOverlapMap()));
-    overlapSolutionExporter = Teuchos::rcp<Epetra_Export>(new Epetra_Export(*stkDisc->getOverlapMap(), obcFunctionalDerivWrtDisplacement->Map()));
+    if(obcOverlapExporter.is_null() ||
+       obcOverlapExporter->SourceMap().DataPtr() != obcFunctionalDerivWrtDisplacementOverlap->Map().DataPtr() ||
+       obcOverlapExporter->TargetMap().DataPtr() != obcFunctionalDerivWrtDisplacement->Map().DataPtr()){
+      obcOverlapExporter = Teuchos::rcp<Epetra_Export>(new Epetra_Export(*stkDisc->getOverlapMap(), obcFunctionalDerivWrtDisplacement->Map()));
+    }
   }
 
   Teuchos::RCP<Epetra_Vector> obcFunctionalDerivWrtDisplacementPeridynamicNodes;
   if(obcFunctionalDerivWrtDisplacement != NULL){
-    std::vector<int> tempGlobalIds(3*obcDataPoints->size());
-    for(unsigned int i=0 ; i<obcDataPoints->size() ; i++){
-      tempGlobalIds[3*i]   = 3*(*obcDataPoints)[i].peridigmGlobalId;
-      tempGlobalIds[3*i+1] = 3*(*obcDataPoints)[i].peridigmGlobalId + 1;
-      tempGlobalIds[3*i+2] = 3*(*obcDataPoints)[i].peridigmGlobalId + 2;
+    if(obcPeridynamicNodeDofMap.is_null()){
+      std::vector<int> tempGlobalIds(3*obcDataPoints->size());
+      for(unsigned int i=0 ; i<obcDataPoints->size() ; i++){
+        tempGlobalIds[3*i]   = 3*(*obcDataPoints)[i].peridigmGlobalId;
+        tempGlobalIds[3*i+1] = 3*(*obcDataPoints)[i].peridigmGlobalId + 1;
+        tempGlobalIds[3*i+2] = 3*(*obcDataPoints)[i].peridigmGlobalId + 2;
+      }
+      obcPeridynamicNodeDofMap = Teuchos::rcp(new Epetra_BlockMap(-1,
+                                                                  static_cast<int>( tempGlobalIds.size() ),
+                                                                  tempGlobalIds.size() > 0 ? &tempGlobalIds[0] : 0,
+                                                                  1,
+                                                                  0,
+                                                                  obcFunctionalDerivWrtDisplacement->Map().Comm()));
     }
-    Epetra_BlockMap epetraTempMap(-1,
-				  static_cast<int>( tempGlobalIds.size() ),
-				  &tempGlobalIds[0],
-				  1,
-				  0,
-				  obcFunctionalDerivWrtDisplacement->Map().Comm());
-    obcFunctionalDerivWrtDisplacementPeridynamicNodes = Teuchos::rcp<Epetra_Vector>(new Epetra_Vector(epetraTempMap));
+    obcFunctionalDerivWrtDisplacementPeridynamicNodes = Teuchos::rcp<Epetra_Vector>(new Epetra_Vector(*obcPeridynamicNodeDofMap));
   }
 
   // We're interested in a single point in a single element in a three-dimensional simulation
@@ -894,13 +925,7 @@ double LCM::PeridigmManager::obcEvaluateFunctional(Epetra_Vector* obcFunctionalD
       displacementDiffScaled[3*iEvalPt+dof] = obcScaleFactor*displacementDiff[3*iEvalPt+dof]*(*obcDataPoints)[iEvalPt].sphereElementVolume;
     }
     if(obcFunctionalDerivWrtDisplacement != NULL) {
-      Kokkos::DynRankView<RealType, PHX::Device> refPoint("PPP", numPoints, numDim);
-      for(int dof=0 ; dof<3 ; dof++)
-        refPoint(0, dof) = refPoints(0, 0, dof);
-
-      Teuchos::RCP<Intrepid2::Basis<PHX::Device, RealType, RealType>> refBasis = Albany::getIntrepid2Basis((*obcDataPoints)[iEvalPt].cellTopologyData);
-      Kokkos::DynRankView<RealType, PHX::Device> basisOnRefPoint("PPP", numNodes, 1);
-      refBasis->getValues(basisOnRefPoint, refPoint, Intrepid2::OPERATOR_VALUE);
+      const std::vector<double>& basisOnRefPoint = (*obcDataPoints)[iEvalPt].basisValues;
 
       // Derivatives corresponding to nodal dof in Albany element
       double deriv[3];
@@ -909,7 +934,7 @@ double LCM::PeridigmManager::obcEvaluateFunctional(Epetra_Vector* obcFunctionalD
         int globalAlbanyNodeId = bulkData->identifier(nodes[i]) - 1;
 
         for(int dim=0; dim<3; ++dim) {
-          deriv[dim] = 2*displacementDiffScaled[3*iEvalPt+dim]*basisOnRefPoint(i,0);
+          deriv[dim] = 2*displacementDiffScaled[3*iEvalPt+dim]*basisOnRefPoint[i];
           globalNodeIds[dim] = 3*globalAlbanyNodeId + dim;
         }
         int err = obcFunctionalDerivWrtDisplacementOverlap->SumIntoGlobalValues(3, deriv, globalNodeIds);
@@ -931,12 +956,14 @@ double LCM::PeridigmManager::obcEvaluateFunctional(Epetra_Vector* obcFunctionalD
 
   // Assemble the derivative of the functional
   if(obcFunctionalDerivWrtDisplacement != NULL) {
-    obcFunctionalDerivWrtDisplacement->Export(*obcFunctionalDerivWrtDisplacementOverlap, *overlapSolutionExporter, Add);
+    obcFunctionalDerivWrtDisplacement->Export(*obcFunctionalDerivWrtDisplacementOverlap, *obcOverlapExporter, Add);
 
     // Add in the contribution from the peridynamic nodes, which may be owned by a different processor
     Epetra_Vector temp(obcFunctionalDerivWrtDisplacement->Map());
-    Epetra_Import tempImporter(temp.Map(), obcFunctionalDerivWrtDisplacementPeridynamicNodes->Map());
-    int err = temp.Import(*obcFunctionalDerivWrtDisplacementPeridynamicNodes, tempImporter, Add);
+    if(obcPeridynamicNodeImporter.is_null() || obcPeridynamicNodeImporter->TargetMap().DataPtr() != temp.Map().DataPtr()){
+      obcPeridynamicNodeImporter = Teuchos::rcp(new Epetra_Import(temp.Map(), *obcPeridynamicNodeDofMap));
+    }
+    int err = temp.Import(*obcFunctionalDerivWrtDisplacementPeridynamicNodes, *obcPeridynamicNodeImporter, Add);
     TEUCHOS_TEST_FOR_EXCEPT_MSG(err != 0, "\n\n**** Error in PeridigmManager::obcEvaluateFunctional(), import operation failed for obcFunctionalDerivWrtDisplacementPeridynamicNodes!\n\n");
     obcFunctionalDerivWrtDisplacement->Update(1.0, temp, 1.0);
   }
@@ -1099,49 +1126,74 @@ void LCM::PeridigmManager::writePeridigmSubModel(RealType currentTime)
     peridigm->writePeridigmSubModel(currentTime);
 }
 
-bool LCM::PeridigmManager::copyPeridigmTangentStiffnessMatrixIntoAlbanyJacobian(Teuchos::RCP<Tpetra_CrsMatrix> jacT)
+void LCM::PeridigmManager::buildTangentLocalIndices(const Teuchos::RCP<const Epetra_FECrsMatrix>& peridigmTangent, const Tpetra_CrsMatrix& jacT)
 {
-  if(!peridigm->hasTangentStiffnessMatrix())
-    return false;
-
-  jacT->globalAssemble();
-  evaluateTangentStiffnessMatrix();
-  Teuchos::RCP<const Epetra_FECrsMatrix> peridigmTangent = peridigm->getTangentStiffnessMatrix();
-  //   char name[100];
-  //   sprintf(name, "peridigmJac%i.mm", countJac);
-  //   EpetraExt::RowMatrixToMatrixMarketFile(name, *peridigmTangent);
+  tangentAlbanyLocalRows.resize(peridigmTangent->NumMyRows());
+  tangentAlbanyLocalCols.clear();
+  tangentAlbanyLocalCols.reserve(peridigmTangent->NumMyNonzeros());
 
   for(int peridigmLocalRow=0 ; peridigmLocalRow<peridigmTangent->NumMyRows() ; peridigmLocalRow++){
 
     int globalRow = peridigmTangent->RowMatrixRowMap().GID(peridigmLocalRow);
+    LO albanyLocalRow = jacT.getRowMap()->getLocalElement(globalRow);
+    TEUCHOS_TEST_FOR_EXCEPTION(albanyLocalRow == Teuchos::OrdinalTraits<LO>::invalid(), std::logic_error,
+                               "Error copying Peridigm Jacobian values into Albany Jacobian, row " << globalRow << " is not in the Albany Jacobian.\n");
+    tangentAlbanyLocalRows[peridigmLocalRow] = albanyLocalRow;
 
     int peridigmNumEntries;
     double* peridigmValues;
     int* peridigmLocalColIndices;
     peridigmTangent->ExtractMyRowView(peridigmLocalRow, peridigmNumEntries, peridigmValues, peridigmLocalColIndices);
 
-    std::vector<int> globalColIndices(peridigmNumEntries);
     for(int i=0 ; i<peridigmNumEntries ; i++){
-      globalColIndices[i] = peridigmTangent->ColMap().GID(peridigmLocalColIndices[i]);
+      int globalCol = peridigmTangent->ColMap().GID(peridigmLocalColIndices[i]);
+      tangentAlbanyLocalCols.push_back(jacT.getColMap()->getLocalElement( static_cast<GO>(globalCol) ));
     }
+  }
 
-    LO albanyLocalRow = jacT->getRowMap()->getLocalElement(globalRow);
+  // Holding on to the matrix and the graph keeps their addresses from being reused by a new matrix or graph
+  tangentIndexPeridigmTangent = peridigmTangent;
+  tangentIndexAlbanyGraph = jacT.getCrsGraph();
+}
 
-    std::vector<LO> albanyLocalColIndices(peridigmNumEntries);
-    for(int i=0 ; i<peridigmNumEntries ; i++){
-      albanyLocalColIndices[i] = jacT->getColMap()->getLocalElement( static_cast<GO>(globalColIndices[i]) );
-    }
-    Teuchos::ArrayView<LO> albanyLocalColIndicesView(&albanyLocalColIndices[0], peridigmNumEntries);
+bool LCM::PeridigmManager::copyPeridigmTangentStiffnessMatrixIntoAlbanyJacobian(Teuchos::RCP<Tpetra_CrsMatrix> jacT)
+{
+  if(!peridigm->hasTangentStiffnessMatrix())
+    return false;
 
-    std::vector<RealType> albanyValues(peridigmNumEntries);
-    for(int i=0 ; i<peridigmNumEntries ; i++){
-      albanyValues[i] = -1.0 * static_cast<RealType>(peridigmValues[i]);
-    }
-    Teuchos::ArrayView<RealType> albanyValuesView(&albanyValues[0], peridigmNumEntries);
+  jacT->globalAssemble();
+  evaluateTangentStiffnessMatrix();
+  Teuchos::RCP<const Epetra_FECrsMatrix> peridigmTangent = peridigm->getTangentStiffnessMatrix();
+  //   char name[100];
+  //   sprintf(name, "peridigmJac%i.mm", countJac);
+  //   EpetraExt::RowMatrixToMatrixMarketFile(name, *peridigmTangent);
 
-    LO numReplaced = jacT->replaceLocalValues(albanyLocalRow, albanyLocalColIndicesView, albanyValuesView);
+  // The Albany local indices of the Peridigm tangent entries depend only on the two matrix structures
+  if(tangentIndexPeridigmTangent.get() != peridigmTangent.get() ||
+     tangentIndexAlbanyGraph.get() != jacT->getCrsGraph().get() ||
+     tangentAlbanyLocalCols.size() != static_cast<std::size_t>(peridigmTangent->NumMyNonzeros())){
+    buildTangentLocalIndices(peridigmTangent, *jacT);
+  }
 
-    TEUCHOS_TEST_FOR_EXCEPTION(numReplaced != peridigmNumEntries, std::logic_error, "Error copying Peridigm Jacobian values into Albany Jacobian.\n");
+  // The tangent overwrites the Albany entries of the peridynamic nodes, so the values are replaced rather than summed.
+  // Going through the matrix interface keeps the host and device values of the Jacobian in sync.
+  std::vector<RealType> rowValues;
+  std::size_t entry = 0;
+  for(int peridigmLocalRow=0 ; peridigmLocalRow<peridigmTangent->NumMyRows() ; peridigmLocalRow++){
+    int peridigmNumEntries;
+    double* peridigmValues;
+    peridigmTangent->ExtractMyRowView(peridigmLocalRow, peridigmNumEntries, peridigmValues);
+    if(peridigmNumEntries > 0){
+      rowValues.resize(peridigmNumEntries);
+      for(int i=0 ; i<peridigmNumEntries ; i++){
+        rowValues[i] = -1.0 * static_cast<RealType>(peridigmValues[i]);
+      }
+      Teuchos::ArrayView<const LO> albanyLocalColIndicesView(&tangentAlbanyLocalCols[entry], peridigmNumEntries);
+      Teuchos::ArrayView<const RealType> albanyValuesView(&rowValues[0], peridigmNumEntries);
+      LO numReplaced = jacT->replaceLocalValues(tangentAlbanyLocalRows[peridigmLocalRow], albanyLocalColIndicesView, albanyValuesView);
+      TEUCHOS_TEST_FOR_EXCEPTION(numReplaced != peridigmNumEntries, std::logic_error, "Error copying Peridigm Jacobian values into Albany Jacobian.\n");
+    }
+    entry += peridigmNumEntries;
   }
   jacT->globalAssemble();
 
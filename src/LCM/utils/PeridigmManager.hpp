@@ -59,6 +59,7 @@ public:
     stk::mesh::Entity albanyElement;
     CellTopologyData cellTopologyData;
     double naturalCoords[3];
+    std::vector<double> basisValues;
   };
 
   //! Singleton.
@@ -75,6 +76,9 @@ public:
   //! Identify the overlapping solid element for each peridynamic sphere element (applies only to overlapping discretizations).
   void obcOverlappingElementSearch();
 
+  //! Whether the results of obcOverlappingElementSearch() still apply to the current Albany discretization.
+  bool obcOverlappingElementSearchIsValid() const;
+
   //! Evaluate the functional for optimization-based coupling
   double obcEvaluateFunctional(Epetra_Vector* obcFunctionalDerivWrtDisplacement = NULL);
 
@@ -185,6 +189,26 @@ private:
 
   Teuchos::RCP<Epetra_Vector> obcPeridynamicNodeCurrentCoords;
 
+  // Albany overlap map for which the overlap search was done; the search is repeated if the discretization changes
+  Teuchos::RCP<const Tpetra_Map> obcSearchOverlapMap;
+
+  // Communication patterns of the functional evaluation, kept as long as the search results and target maps are valid
+  Teuchos::RCP<Epetra_Import> obcCurrentCoordsImporter;
+  Teuchos::RCP<Epetra_BlockMap> obcPeridynamicNodeDofMap;
+  Teuchos::RCP<Epetra_Export> obcOverlapExporter;
+  Teuchos::RCP<Epetra_Import> obcPeridynamicNodeImporter;
+
+  // Albany local row of each Peridigm local row and Albany local column of each Peridigm tangent entry
+  std::vector<LO> tangentAlbanyLocalRows;
+  std::vector<LO> tangentAlbanyLocalCols;
+
+  // Peridigm tangent and Albany Jacobian graph for which the local indices were built
+  Teuchos::RCP<const Epetra_FECrsMatrix> tangentIndexPeridigmTangent;
+  Teuchos::RCP<const Tpetra_CrsGraph> tangentIndexAlbanyGraph;
+
+  //! Build the Albany local indices of the current Peridigm tangent entries.
+  void buildTangentLocalIndices(const Teuchos::RCP<const Epetra_FECrsMatrix>& peridigmTangent, const Tpetra_CrsMatrix& jacT);
+
   int cubatureDegree;
 
   Teuchos::RCP<Tpetra_Vector> albanyOverlapSolutionVector;
@@ -21,6 +21,7 @@
 #include "Moertel_SegmentT.hpp"
 #include "Moertel_NodeT.hpp"
 #include "Moertel_ProjectorT.hpp"
+#include "Moertel_SearchGrid.hpp"
 
 /*!
 \brief MoertelT: namespace of the Moertel package
@@ -854,6 +855,7 @@ private:
   std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > > seg_[2];    // local segments of interface (both sides)
   std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > > rseg_[2];   // global segments of interface (both sides)
   std::map<int,int>                            segPID_;    // maps all global seg ids to process holding segment
+  SearchGrid                                   msearch_;   // bucket grid over mortar side segment boxes
   
   std::map<int,Teuchos::RCP<MoertelT::MOERTEL_TEMPLATE_CLASS(NodeT) > >    node_[2];   // local nodes of interface (both sides)
   std::map<int,Teuchos::RCP<MoertelT::MOERTEL_TEMPLATE_CLASS(NodeT) > >    rnode_[2];  // global nodes of interface (both sides)
@@ -14,6 +14,8 @@
 #include "Moertel_IntegratorT.hpp"
 #include "Moertel_ProjectorT.hpp"
 #include "Moertel_OverlapT.hpp"
+#include "Moertel_SearchGrid.hpp"
+#include "Moertel_Tolerances.hpp"
 
 const double CONSTRAINT_MATRIX_ZERO = 1.0e-11;
 
@@ -136,6 +138,27 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_3D() {
   int mside = MortarSide();
   int sside = OtherSide(mside);
 
+  // bin the master segments so that each slave segment only visits the
+  // master segments that can pass the rough search in the overlap test.
+  // The grid persists between calls and is updated incrementally.
+  const bool usegrid = intparams_->get("segment search grid",true);
+  SearchGrid::Point lo, hi;
+  std::vector<int> candidates;
+
+  if (usegrid) {
+    // if the set of master segments changed, start over
+    typename std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >::iterator mcurr;
+    bool sameset = msearch_.Size() == rseg_[mside].size();
+    for(mcurr = rseg_[mside].begin(); sameset && mcurr != rseg_[mside].end(); ++mcurr)
+      sameset = msearch_.Contains(mcurr->first);
+    if (!sameset) msearch_.Clear();
+
+    for(mcurr = rseg_[mside].begin(); mcurr != rseg_[mside].end(); ++mcurr) {
+      InflatedBoundingBox(*(mcurr->second),MOERTEL::Rough_Search_Radius,lo,hi);
+      msearch_.Update(mcurr->first,lo,hi);
+    }
+    msearch_.Finalize();
+  }
 
   // loop over all segments of slave side
   std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >::iterator scurr;
@@ -166,6 +189,16 @@ bool MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::Integrate_3D() {
     //Teuchos::Time time(*lComm());
     //time.ResetStartTime();
 
+    // loop over the candidate segments on the master side, in ascending id
+    // order as in the loop over all master segments
+    if (usegrid) {
+      InflatedBoundingBox(*actsseg,MOERTEL::Rough_Search_Radius,lo,hi);
+      msearch_.Candidates(lo,hi,candidates);
+      for (size_t i=0; i<candidates.size(); ++i)
+        Integrate_3D_Section(*actsseg,*(rseg_[mside][candidates[i]]));
+      continue;
+    }
+
     // loop over all segments on the master side
     std::map<int,Teuchos::RCP<MoertelT::SEGMENT_TEMPLATE_CLASS(SegmentT) > >::iterator mcurr;
 
@@ -112,6 +112,9 @@ MoertelT::MOERTEL_TEMPLATE_CLASS(InterfaceT)::~InterfaceT()
   // delete PID maps
   segPID_.clear();
   nodePID_.clear();
+
+  // delete search grid
+  msearch_.Clear();
 }
 
 /*----------------------------------------------------------------------*
@@ -0,0 +1,311 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef MOERTEL_SEARCHGRID_H
+#define MOERTEL_SEARCHGRID_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace MoertelT
+{
+
+/*!
+\class SearchGrid
+
+\brief <b> Uniform bucket grid over axis aligned bounding boxes of segments </b>
+
+Used to find the candidate master segments of a slave segment without
+testing every pair.  Each box is binned into all cells it touches; a query
+visits the cells touched by the query box and tests the boxes found there.
+With a cell size comparable to the segment size, the number of candidates
+per query is bounded and pairing is linear in the interface size.
+
+Boxes can be updated individually when the interface deforms.  A box is
+only re-binned if the range of cells it touches changes, and the grid is
+rebuilt if the mean box size drifts too far from the cell size.
+
+*/
+class SearchGrid
+{
+public:
+
+  typedef std::array<double, 3> Point;
+
+  SearchGrid() : cellSize_(0.0), sizeAtBuild_(0.0) {}
+
+  //! Number of boxes stored
+  std::size_t Size() const { return slot_.size(); }
+
+  //! Whether a box with id is stored
+  bool Contains(int id) const { return slot_.find(id) != slot_.end(); }
+
+  //! Remove all boxes
+  void Clear()
+  {
+    slot_.clear();
+    store_.clear();
+    free_.clear();
+    cells_.clear();
+    cellSize_ = 0.0;
+    sizeAtBuild_ = 0.0;
+  }
+
+  /*!
+  \brief Insert box with id or move it to a new position
+
+  Returns true if the box had to be re-binned.
+  */
+  bool Update(int id, Point const& lo, Point const& hi)
+  {
+    auto it = slot_.find(id);
+    if (it == slot_.end()) {
+      int slot = store_.size();
+      if (free_.empty() == false) {
+        slot = free_.back();
+        free_.pop_back();
+      } else {
+        store_.push_back(Box());
+      }
+      slot_[id] = slot;
+      Box& box = store_[slot];
+      box.id = id;
+      box.lo = lo;
+      box.hi = hi;
+      if (cellSize_ > 0.0) {
+        CellRange(lo, hi, box.cmin, box.cmax);
+        Bin(slot);
+      }
+      return true;
+    }
+
+    int const slot = it->second;
+    Box& box = store_[slot];
+    box.lo = lo;
+    box.hi = hi;
+    if (cellSize_ <= 0.0) return true;
+
+    Cell cmin, cmax;
+    CellRange(lo, hi, cmin, cmax);
+    if (cmin == box.cmin && cmax == box.cmax) return false;
+
+    Unbin(slot);
+    box.cmin = cmin;
+    box.cmax = cmax;
+    Bin(slot);
+    return true;
+  }
+
+  //! Remove box with id, if present
+  void Remove(int id)
+  {
+    auto it = slot_.find(id);
+    if (it == slot_.end()) return;
+    if (cellSize_ > 0.0) Unbin(it->second);
+    free_.push_back(it->second);
+    slot_.erase(it);
+  }
+
+  /*!
+  \brief Rebin all boxes if the cell size no longer matches the boxes
+
+  Must be called after a batch of Update() calls and before querying.
+  */
+  void Finalize()
+  {
+    double const size = MeanBoxSize();
+    bool const stale = cellSize_ <= 0.0 ||
+      size > 2.0 * sizeAtBuild_ || size < 0.5 * sizeAtBuild_;
+    if (stale == true) Rebuild(size);
+  }
+
+  /*!
+  \brief Ids of all boxes that overlap the box [lo, hi], in ascending order
+  */
+  void Candidates(Point const& lo, Point const& hi, std::vector<int>& ids) const
+  {
+    ids.clear();
+    if (slot_.empty() == true) return;
+
+    Cell cmin, cmax;
+    CellRange(lo, hi, cmin, cmax);
+
+    double ncells = 1.0;
+    for (int d = 0; d < 3; ++d) ncells *= double(cmax[d] - cmin[d] + 1);
+
+    // a query larger than the whole interface is cheaper done directly
+    if (cellSize_ <= 0.0 || ncells > double(slot_.size())) {
+      for (auto const& entry : slot_)
+        if (Overlap(store_[entry.second], lo, hi) == true) ids.push_back(entry.first);
+      return;
+    }
+
+    Cell c;
+    for (c[0] = cmin[0]; c[0] <= cmax[0]; ++c[0])
+      for (c[1] = cmin[1]; c[1] <= cmax[1]; ++c[1])
+        for (c[2] = cmin[2]; c[2] <= cmax[2]; ++c[2]) {
+          auto const cell = cells_.find(c);
+          if (cell == cells_.end()) continue;
+          for (int const slot : cell->second) {
+            Box const& box = store_[slot];
+            // a box spanning several visited cells is only tested in the
+            // first of them
+            if (FirstSharedCell(box, cmin, c) == false) continue;
+            if (Overlap(box, lo, hi) == true) ids.push_back(box.id);
+          }
+        }
+
+    std::sort(ids.begin(), ids.end());
+  }
+
+private:
+
+  typedef std::array<long, 3> Cell;
+
+  struct Box
+  {
+    int id;
+    Point lo;
+    Point hi;
+    Cell cmin;
+    Cell cmax;
+  };
+
+  struct CellHash
+  {
+    std::size_t operator()(Cell const& c) const
+    {
+      std::size_t h = std::hash<long>()(c[0]);
+      h = h * 73856093u ^ std::hash<long>()(c[1]);
+      h = h * 19349663u ^ std::hash<long>()(c[2]);
+      return h;
+    }
+  };
+
+  static bool Overlap(Box const& box, Point const& lo, Point const& hi)
+  {
+    for (int d = 0; d < 3; ++d)
+      if (box.hi[d] < lo[d] || hi[d] < box.lo[d]) return false;
+    return true;
+  }
+
+  static bool FirstSharedCell(Box const& box, Cell const& qmin, Cell const& c)
+  {
+    for (int d = 0; d < 3; ++d)
+      if (c[d] != std::max(box.cmin[d], qmin[d])) return false;
+    return true;
+  }
+
+  double MeanBoxSize() const
+  {
+    if (slot_.empty() == true) return 0.0;
+    double sum = 0.0;
+    for (auto const& entry : slot_) {
+      Box const& box = store_[entry.second];
+      double extent = 0.0;
+      for (int d = 0; d < 3; ++d)
+        extent = std::max(extent, box.hi[d] - box.lo[d]);
+      sum += extent;
+    }
+    return sum / double(slot_.size());
+  }
+
+  void CellRange(Point const& lo, Point const& hi, Cell& cmin, Cell& cmax) const
+  {
+    for (int d = 0; d < 3; ++d) {
+      cmin[d] = static_cast<long>(std::floor(lo[d] / cellSize_));
+      cmax[d] = static_cast<long>(std::floor(hi[d] / cellSize_));
+    }
+  }
+
+  void Bin(int slot)
+  {
+    Box const& box = store_[slot];
+    Cell c;
+    for (c[0] = box.cmin[0]; c[0] <= box.cmax[0]; ++c[0])
+      for (c[1] = box.cmin[1]; c[1] <= box.cmax[1]; ++c[1])
+        for (c[2] = box.cmin[2]; c[2] <= box.cmax[2]; ++c[2])
+          cells_[c].push_back(slot);
+  }
+
+  void Unbin(int slot)
+  {
+    Box const& box = store_[slot];
+    Cell c;
+    for (c[0] = box.cmin[0]; c[0] <= box.cmax[0]; ++c[0])
+      for (c[1] = box.cmin[1]; c[1] <= box.cmax[1]; ++c[1])
+        for (c[2] = box.cmin[2]; c[2] <= box.cmax[2]; ++c[2]) {
+          auto const cell = cells_.find(c);
+          if (cell == cells_.end()) continue;
+          std::vector<int>& slots = cell->second;
+          slots.erase(std::remove(slots.begin(), slots.end(), slot), slots.end());
+          if (slots.empty() == true) cells_.erase(cell);
+        }
+  }
+
+  void Rebuild(double size)
+  {
+    cells_.clear();
+    sizeAtBuild_ = size;
+    cellSize_ = size > 0.0 ? size : 1.0;
+    for (auto const& entry : slot_) {
+      Box& box = store_[entry.second];
+      CellRange(box.lo, box.hi, box.cmin, box.cmax);
+      Bin(entry.second);
+    }
+  }
+
+  std::map<int, int> slot_;      // box id -> position in store_
+  std::vector<Box> store_;       // boxes, contiguous for the queries
+  std::vector<int> free_;        // unused positions in store_
+  std::unordered_map<Cell, std::vector<int>, CellHash> cells_;
+  double cellSize_;
+  double sizeAtBuild_;
+};
+
+/*!
+\brief Bounding box of a segment, grown by inflation times its diameter
+
+Segments whose inflated boxes do not intersect cannot pass the rough
+distance test of the overlap computation when the inflation is at least
+Rough_Search_Radius.
+*/
+template <class Segment>
+void
+InflatedBoundingBox(Segment& seg, double inflation, SearchGrid::Point& lo, SearchGrid::Point& hi)
+{
+  double const big = std::numeric_limits<double>::max();
+  lo.fill(big);
+  hi.fill(-big);
+
+  const int nnode = seg.Nnode();
+  auto** nodes = seg.Nodes();
+  for (int i = 0; i < nnode; ++i) {
+    auto const x = nodes[i]->XCoords();
+    for (int d = 0; d < 3; ++d) {
+      lo[d] = std::min(lo[d], double(x[d]));
+      hi[d] = std::max(hi[d], double(x[d]));
+    }
+  }
+
+  double diam2 = 0.0;
+  for (int d = 0; d < 3; ++d) diam2 += (hi[d] - lo[d]) * (hi[d] - lo[d]);
+  double const pad = inflation * std::sqrt(diam2);
+  for (int d = 0; d < 3; ++d) {
+    lo[d] -= pad;
+    hi[d] += pad;
+  }
+}
+
+} // namespace MoertelT
+
+#endif // MOERTEL_SEARCHGRID_H
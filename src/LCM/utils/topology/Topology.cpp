@@ -3,6 +3,8 @@
 //    This Software is released under the BSD license detailed     //
 //    in the file "license.txt" in the top-level Albany directory  //
 //*****************************************************************//
+#include <algorithm>
+
 #include <boost/foreach.hpp>
 
 #include "stk_mesh/base/FEMHelpers.hpp"
@@ -998,6 +1000,10 @@ Topology::splitOpenFaces()
 
   stk::mesh::get_selected_entities(local_bulk, point_buckets, points);
 
+  modified_cells_.clear();
+
+  new_points_.clear();
+
   // Collect open points
   for (stk::mesh::EntityVector::iterator i = points.begin(); i != points.end();
       ++i) {
@@ -1269,6 +1275,15 @@ Topology::splitOpenFaces()
       new_point = j->second;
 
       bulk_data.copy_entity_fields(point, new_point);
+
+      new_points_.push_back(new_point);
+
+      stk::mesh::Entity
+      entity = j->first;
+
+      if (bulk_data.entity_rank(entity) == stk::topology::ELEMENT_RANK) {
+        modified_cells_.push_back(entity);
+      }
     }
 
   }
@@ -1276,6 +1291,18 @@ Topology::splitOpenFaces()
   Albany::fix_node_sharing(bulk_data);
   bulk_data.modification_end();
 
+  std::sort(modified_cells_.begin(), modified_cells_.end());
+
+  modified_cells_.erase(
+      std::unique(modified_cells_.begin(), modified_cells_.end()),
+      modified_cells_.end());
+
+  std::sort(new_points_.begin(), new_points_.end());
+
+  new_points_.erase(
+      std::unique(new_points_.begin(), new_points_.end()),
+      new_points_.end());
+
 #if defined(DEBUG_LCM_TOPOLOGY)
   {
     std::string const
@@ -212,6 +212,26 @@ public:
   void
   insertSurfaceElements(std::set<EntityPair> const & fractured_faces);
 
+  ///
+  /// \brief Cells whose node connectivity was changed by the last
+  ///        call to splitOpenFaces(). Used for incremental updates
+  ///        of the discretization.
+  ///
+  stk::mesh::EntityVector const &
+  get_modified_cells() const
+  {
+    return modified_cells_;
+  }
+
+  ///
+  /// \brief Points created by the last call to splitOpenFaces().
+  ///
+  stk::mesh::EntityVector const &
+  get_new_points() const
+  {
+    return new_points_;
+  }
+
   ///
   /// \brief Adds a new entity of rank 3 to the mesh
   ///
@@ -895,6 +915,12 @@ private:
   std::set<EntityPair>
   fractured_faces_;
 
+  stk::mesh::EntityVector
+  modified_cells_;
+
+  stk::mesh::EntityVector
+  new_points_;
+
   std::vector<stk::topology>
   topologies_;
 
@@ -27,6 +27,9 @@ MORFacadeImpl::MORFacadeImpl(
   // Albany-specific reduced basis source
   const Teuchos::RCP<MOR::EpetraMVSource> stkMVSource(new StkEpetraMVSource(disc));
   basisFactory_->extend("Stk", Teuchos::rcp(new MOR::DefaultTruncatedReducedBasisSource(stkMVSource)));
+  const Teuchos::RCP<MOR::EpetraMVSource> stkResidualMVSource(
+      new StkEpetraMVSource(disc, StkEpetraMVSource::RESIDUAL));
+  basisFactory_->extend("Stk Residual", Teuchos::rcp(new MOR::DefaultTruncatedReducedBasisSource(stkResidualMVSource)));
 
   // Albany-specific sampling source
   samplingFactory_->extend("Stk", Teuchos::rcp(new DiscretizationSampleDofListProvider(disc)));
@@ -8,8 +8,10 @@
 
 namespace Albany {
 
-StkEpetraMVSource::StkEpetraMVSource(const Teuchos::RCP<STKDiscretization> &disc) :
-  disc_(disc)
+StkEpetraMVSource::StkEpetraMVSource(const Teuchos::RCP<STKDiscretization> &disc,
+                                     HistoryField field) :
+  disc_(disc),
+  field_(field)
 {}
 
 int
@@ -27,25 +29,38 @@ StkEpetraMVSource::vectorMap() const
 Teuchos::RCP<Epetra_MultiVector>
 StkEpetraMVSource::multiVectorNew()
 {
+  if (field_ == RESIDUAL) {
+    return disc_->getResidualFieldHistory(0, this->vectorCount());
+  }
   return disc_->getSolutionFieldHistory();
 }
 
 Teuchos::RCP<Epetra_MultiVector>
 StkEpetraMVSource::truncatedMultiVectorNew(int vectorCountMax)
 {
+  if (field_ == RESIDUAL) {
+    return disc_->getResidualFieldHistory(0, vectorCountMax);
+  }
   return disc_->getSolutionFieldHistory(vectorCountMax);
 }
 
 Teuchos::RCP<Epetra_MultiVector>
 StkEpetraMVSource::truncatedMultiVectorNew(int vectorCountMin, int vectorCountMax)
 {
+  if (field_ == RESIDUAL) {
+    return disc_->getResidualFieldHistory(vectorCountMin, vectorCountMax);
+  }
   return disc_->getSolutionFieldHistory(vectorCountMin, vectorCountMax);
 }
 
 const Epetra_MultiVector &
 StkEpetraMVSource::filledMultiVector(Epetra_MultiVector &result)
 {
-  disc_->getSolutionFieldHistory(result);
+  if (field_ == RESIDUAL) {
+    disc_->getResidualFieldHistory(result);
+  } else {
+    disc_->getSolutionFieldHistory(result);
+  }
   return result;
 }
 
@@ -14,7 +14,11 @@ namespace Albany {
 
 class StkEpetraMVSource : public MOR::EpetraMVSource {
 public:
-  explicit StkEpetraMVSource(const Teuchos::RCP<STKDiscretization> &disc);
+  // Which nodal field history of the input mesh provides the vectors
+  enum HistoryField { SOLUTION, RESIDUAL };
+
+  explicit StkEpetraMVSource(const Teuchos::RCP<STKDiscretization> &disc,
+                             HistoryField field = SOLUTION);
 
   virtual int vectorCount() const;
   virtual Epetra_Map vectorMap() const;
@@ -26,6 +30,7 @@ public:
 
 private:
   Teuchos::RCP<STKDiscretization> disc_;
+  HistoryField field_;
 };
 
 } // end namespace Albany
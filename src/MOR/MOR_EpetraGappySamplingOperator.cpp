@@ -0,0 +1,182 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include "MOR_EpetraGappySamplingOperator.hpp"
+
+#include "Epetra_MultiVector.h"
+#include "Epetra_Comm.h"
+
+#include "Teuchos_Assert.hpp"
+#include "Teuchos_TestForException.hpp"
+#include "Teuchos_TypeNameTraits.hpp"
+#include "Teuchos_SerialDenseSolver.hpp"
+
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+namespace MOR {
+
+using ::Teuchos::Array;
+using ::Teuchos::ArrayView;
+
+EpetraGappySamplingOperator::EpetraGappySamplingOperator(
+    const Epetra_Map &map,
+    const ArrayView<const int> &sampleLIDs,
+    const Epetra_MultiVector &residualBasis) :
+  map_(map),
+  sampleLIDs_(sampleLIDs),
+  basisSize_(residualBasis.NumVectors()),
+  weights_(residualBasis.NumVectors(), residualBasis.NumVectors()),
+  useTranspose_(false)
+{
+  TEUCHOS_ASSERT(map_.PointSameAs(residualBasis.Map()));
+  std::sort(sampleLIDs_.begin(), sampleLIDs_.end());
+
+  const int mySampleCount = sampleLIDs_.size();
+  sampledBasis_.resize(mySampleCount * basisSize_);
+  for (int iSample = 0; iSample < mySampleCount; ++iSample) {
+    for (int iVec = 0; iVec < basisSize_; ++iVec) {
+      sampledBasis_[iSample * basisSize_ + iVec] = residualBasis[iVec][sampleLIDs_[iSample]];
+    }
+  }
+
+  // Gram matrix of the sampled basis U_s^T * U_s
+  Array<double> myGram(basisSize_ * basisSize_, 0.0);
+  for (int iSample = 0; iSample < mySampleCount; ++iSample) {
+    const double *row = &sampledBasis_[iSample * basisSize_];
+    for (int i = 0; i < basisSize_; ++i) {
+      for (int j = 0; j < basisSize_; ++j) {
+        myGram[i * basisSize_ + j] += row[i] * row[j];
+      }
+    }
+  }
+  Array<double> gram(basisSize_ * basisSize_);
+  map_.Comm().SumAll(myGram.getRawPtr(), gram.getRawPtr(), gram.size());
+
+  long myTotalSamples = mySampleCount; // Nonconst because of Epetra_Comm::SumAll
+  long totalSamples;
+  map_.Comm().SumAll(&myTotalSamples, &totalSamples, 1);
+  TEUCHOS_TEST_FOR_EXCEPTION(totalSamples < basisSize_,
+      std::invalid_argument,
+      "Gappy POD requires at least as many samples (" << totalSamples <<
+      ") as residual basis vectors (" << basisSize_ << ")");
+
+  Teuchos::SerialDenseMatrix<int, double> gramInverse(basisSize_, basisSize_);
+  for (int i = 0; i < basisSize_; ++i) {
+    for (int j = 0; j < basisSize_; ++j) {
+      gramInverse(i, j) = gram[i * basisSize_ + j];
+    }
+  }
+  Teuchos::SerialDenseSolver<int, double> solver;
+  solver.setMatrix(Teuchos::rcpFromRef(gramInverse));
+  const int err = solver.invert();
+  TEUCHOS_TEST_FOR_EXCEPTION(err != 0,
+      std::runtime_error,
+      "Sampled residual basis is rank deficient, cannot build Gappy POD weights");
+
+  weights_.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0, gramInverse, gramInverse, 0.0);
+}
+
+const char *EpetraGappySamplingOperator::Label() const
+{
+  static const std::string label = Teuchos::TypeNameTraits<EpetraGappySamplingOperator>::name();
+  return label.c_str();
+}
+
+const Epetra_Map &EpetraGappySamplingOperator::OperatorDomainMap() const
+{
+  return map_;
+}
+
+const Epetra_Map &EpetraGappySamplingOperator::OperatorRangeMap() const
+{
+  return map_;
+}
+
+const Epetra_Comm &EpetraGappySamplingOperator::Comm() const
+{
+  return map_.Comm();
+}
+
+int EpetraGappySamplingOperator::SetUseTranspose(bool UseTranspose)
+{
+  // Symmetric operator
+  useTranspose_ = UseTranspose;
+  return 0;
+}
+
+bool EpetraGappySamplingOperator::UseTranspose() const
+{
+  return useTranspose_;
+}
+
+int EpetraGappySamplingOperator::Apply(const Epetra_MultiVector &X, Epetra_MultiVector &Y) const
+{
+  TEUCHOS_ASSERT(map_.PointSameAs(X.Map()) && map_.PointSameAs(Y.Map()));
+  TEUCHOS_ASSERT(X.NumVectors() == Y.NumVectors());
+
+  const int vecCount = X.NumVectors();
+  const int mySampleCount = sampleLIDs_.size();
+
+  // Only the sampled entries are read: c <- U_s^T * P^T * X
+  Array<double> myComponents(basisSize_ * vecCount, 0.0);
+  for (int iVec = 0; iVec < vecCount; ++iVec) {
+    const ArrayView<const double> sourceVec(X[iVec], X.MyLength());
+    for (int iSample = 0; iSample < mySampleCount; ++iSample) {
+      const double value = sourceVec[sampleLIDs_[iSample]];
+      const double *row = &sampledBasis_[iSample * basisSize_];
+      for (int i = 0; i < basisSize_; ++i) {
+        myComponents[iVec * basisSize_ + i] += row[i] * value;
+      }
+    }
+  }
+  Array<double> components(basisSize_ * vecCount);
+  map_.Comm().SumAll(myComponents.getRawPtr(), components.getRawPtr(), components.size());
+
+  // d <- (U_s^T * U_s)^{-2} * c
+  Array<double> weighted(basisSize_ * vecCount, 0.0);
+  for (int iVec = 0; iVec < vecCount; ++iVec) {
+    for (int i = 0; i < basisSize_; ++i) {
+      for (int j = 0; j < basisSize_; ++j) {
+        weighted[iVec * basisSize_ + i] += weights_(i, j) * components[iVec * basisSize_ + j];
+      }
+    }
+  }
+
+  // Y <- P * U_s * d
+  Y.PutScalar(0.0);
+  for (int iVec = 0; iVec < vecCount; ++iVec) {
+    const ArrayView<double> targetVec(Y[iVec], Y.MyLength());
+    for (int iSample = 0; iSample < mySampleCount; ++iSample) {
+      const double *row = &sampledBasis_[iSample * basisSize_];
+      double value = 0.0;
+      for (int i = 0; i < basisSize_; ++i) {
+        value += row[i] * weighted[iVec * basisSize_ + i];
+      }
+      targetVec[sampleLIDs_[iSample]] = value;
+    }
+  }
+
+  return 0;
+}
+
+int EpetraGappySamplingOperator::ApplyInverse(const Epetra_MultiVector &X, Epetra_MultiVector &Y) const
+{
+  // Not supported (rank-deficient operator)
+  return -1;
+}
+
+bool EpetraGappySamplingOperator::HasNormInf() const
+{
+  return false;
+}
+
+double EpetraGappySamplingOperator::NormInf() const
+{
+  return 0.0;
+}
+
+} // namespace MOR
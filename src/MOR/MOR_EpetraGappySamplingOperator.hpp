@@ -0,0 +1,65 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#ifndef MOR_EPETRAGAPPYSAMPLINGOPERATOR_HPP
+#define MOR_EPETRAGAPPYSAMPLINGOPERATOR_HPP
+
+#include "Epetra_Operator.h"
+#include "Epetra_Map.h"
+
+#include "Teuchos_Array.hpp"
+#include "Teuchos_ArrayView.hpp"
+#include "Teuchos_SerialDenseMatrix.hpp"
+
+class Epetra_MultiVector;
+
+namespace MOR {
+
+// Gappy POD weighting of sampled entries:
+//   M = P * U_s * (U_s^T * U_s)^{-2} * U_s^T * P^T, with U_s = P^T * U
+// where P selects the sample entries and U is a basis of the residual.
+// M^{1/2} maps a sampled residual to the least-squares coefficients of its
+// reconstruction in span(U), so using M as metric minimizes the norm of the
+// reconstructed residual while only reading sampled entries.
+class EpetraGappySamplingOperator : public Epetra_Operator {
+public:
+  EpetraGappySamplingOperator(
+      const Epetra_Map &map,
+      const Teuchos::ArrayView<const int> &sampleLIDs,
+      const Epetra_MultiVector &residualBasis);
+
+  // Overriden from Epetra_Operator
+  virtual const char *Label() const;
+
+  virtual const Epetra_Map &OperatorDomainMap() const;
+  virtual const Epetra_Map &OperatorRangeMap() const;
+  virtual const Epetra_Comm &Comm() const;
+
+  virtual bool UseTranspose() const;
+  virtual int SetUseTranspose(bool UseTranspose);
+
+  virtual int Apply(const Epetra_MultiVector &X, Epetra_MultiVector &Y) const;
+  virtual int ApplyInverse(const Epetra_MultiVector &X, Epetra_MultiVector &Y) const;
+
+  virtual bool HasNormInf() const;
+  virtual double NormInf() const;
+
+private:
+  Epetra_Map map_;
+  Teuchos::Array<int> sampleLIDs_;
+
+  // Locally owned sampled rows of the residual basis, row-major
+  Teuchos::Array<double> sampledBasis_;
+  int basisSize_;
+
+  // (U_s^T * U_s)^{-2}, replicated
+  Teuchos::SerialDenseMatrix<int, double> weights_;
+
+  bool useTranspose_;
+};
+
+} // namespace MOR
+
+#endif /* MOR_EPETRAGAPPYSAMPLINGOPERATOR_HPP */
@@ -9,6 +9,7 @@
 
 #include "MOR_SampleDofListFactory.hpp"
 #include "MOR_EpetraSamplingOperator.hpp"
+#include "MOR_EpetraGappySamplingOperator.hpp"
 #include "MOR_ContainerUtils.hpp"
 #include "MOR_EpetraUtils.hpp"
 #include "MOR_BasisOps.hpp"
@@ -92,15 +93,20 @@ ReducedSpaceFactory::getSamplingOperator(
     const Teuchos::RCP<Teuchos::ParameterList> hyperreductionParams = Teuchos::sublist(params, "Hyper Reduction");
     const bool useHyperreduction = hyperreductionParams->get("Activate", false);
     if (useHyperreduction) {
-      const Teuchos::Tuple<std::string, 1> allowedHyperreductionTypes = Teuchos::tuple<std::string>("Collocation");
+      const Teuchos::Tuple<std::string, 2> allowedHyperreductionTypes = Teuchos::tuple<std::string>("Collocation", "Gappy POD");
       const std::string hyperreductionType = hyperreductionParams->get("Type", allowedHyperreductionTypes[0]);
       TEUCHOS_TEST_FOR_EXCEPTION(!contains(allowedHyperreductionTypes, hyperreductionType),
           std::out_of_range,
           hyperreductionType + " not in " + allowedHyperreductionTypes.toString());
+      const Teuchos::RCP<Teuchos::ParameterList> collocationParams = Teuchos::sublist(hyperreductionParams, "Collocation Data");
+      const Teuchos::Array<int> sampleLocalEntries = samplingFactory_->create(collocationParams);
       if (hyperreductionType == allowedHyperreductionTypes[0]) {
-        const Teuchos::RCP<Teuchos::ParameterList> collocationParams = Teuchos::sublist(hyperreductionParams, "Collocation Data");
-        const Teuchos::Array<int> sampleLocalEntries = samplingFactory_->create(collocationParams);
         result = Teuchos::rcp(new EpetraSamplingOperator(stateMap, sampleLocalEntries));
+      } else if (hyperreductionType == allowedHyperreductionTypes[1]) {
+        // The residual basis uses the same sources as the solution basis
+        const Teuchos::RCP<Teuchos::ParameterList> residualBasisParams = Teuchos::sublist(hyperreductionParams, "Residual Basis");
+        const Teuchos::RCP<const Epetra_MultiVector> residualBasis = basisRepository_.getBasis(residualBasisParams);
+        result = Teuchos::rcp(new EpetraGappySamplingOperator(stateMap, sampleLocalEntries, *residualBasis));
       } else {
         TEUCHOS_TEST_FOR_EXCEPT_MSG(true, "Should not happen");
       }
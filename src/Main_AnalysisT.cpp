@@ -7,6 +7,7 @@
 
 #include "Albany_Utils.hpp"
 #include "Albany_SolverFactory.hpp"
+#include "Albany_TruncatedGaussNewtonT.hpp"
 #include "Piro_PerformAnalysis.hpp"
 #include "Thyra_VectorBase.hpp"
 #include "Teuchos_GlobalMPISession.hpp"
@@ -50,20 +51,32 @@ int main(int argc, char *argv[]) {
     Teuchos::RCP<Albany::SolverFactory> slvrfctry =
       Teuchos::rcp(new Albany::SolverFactory(cmd.xml_filename, comm));
 
-    Teuchos::RCP<Thyra::ResponseOnlyModelEvaluatorBase<ST> > appThyra = slvrfctry->createT(comm, comm);
+    Teuchos::RCP<Albany::Application> app;
+    Teuchos::RCP<Thyra::ResponseOnlyModelEvaluatorBase<ST> > appThyra =
+      slvrfctry->createAndGetAlbanyAppT(app, comm, comm);
 
 
     Teuchos::RCP< Thyra::VectorBase<double> > p;
+    int analysisStatus = 0;
 
     // If no analysis section set in input file, default to simple "Solve"
     std::string analysisPackage = slvrfctry->getAnalysisParameters().get("Analysis Package","Solve");
-    status = Piro::PerformAnalysis(*appThyra, slvrfctry->getAnalysisParameters(), p); 
+    if (analysisPackage == "Truncated Gauss-Newton") {
+      // Albany's own inversion driver: it needs the Application and the
+      // linear solver behind the Piro solver, not only the response model
+      Albany::TruncatedGaussNewtonT truncatedGaussNewton(
+          Teuchos::sublist(Teuchos::rcpFromRef(slvrfctry->getAnalysisParameters()), "Truncated Gauss-Newton"),
+          appThyra, app, slvrfctry->returnLinearSolveFactoryT());
+      analysisStatus = truncatedGaussNewton.run(p);
+    }
+    else
+      status = Piro::PerformAnalysis(*appThyra, slvrfctry->getAnalysisParameters(), p); 
 
 //    Dakota::RealVector finalValues = dakota.getFinalSolution().continuous_variables();
 //    std::cout << "\nAlbany_Dakota: Final Values from Dakota = "
 //         << setprecision(8) << finalValues << std::endl;
 
-    status =  slvrfctry->checkAnalysisTestResults(0, p);
+    status =  slvrfctry->checkAnalysisTestResults(0, p) + analysisStatus;
 
     // Regression comparisons for Dakota runs only valid on Proc 0.
     if (mpiSession.getRank()>0)  status=0;
@@ -193,6 +193,8 @@ int main(int argc, char *argv[]) {
       Piro::PerformSolveBase(*solver, solveParams, thyraResponses, thyraSensitivities, app->getAdaptSolMgr()->getSolObserver());
     else
       Piro::PerformSolveBase(*solver, solveParams, thyraResponses, thyraSensitivities);
+    if(Teuchos::nonnull(app))
+      app->reportDagProfile();
 
     Teuchos::Array<Teuchos::RCP<const Epetra_Vector> > responses;
     Teuchos::Array<Teuchos::Array<Teuchos::RCP<const Epetra_MultiVector> > > sensitivities;
@@ -330,6 +330,7 @@ main(int argc, char *argv[]) {
         thyraSensitivities;
     Piro::PerformSolve(
         *solver, solveParams, thyraResponses, thyraSensitivities);
+    app->reportDagProfile();
 
     Teuchos::Array<Teuchos::RCP<const Tpetra_Vector>> responses;
     Teuchos::Array<Teuchos::Array<Teuchos::RCP<const Tpetra_MultiVector>>>
@@ -9,6 +9,7 @@
 
 
 #include "Albany_Utils.hpp"
+#include "Albany_Checkpoint.hpp"
 #include "Albany_SolverFactory.hpp"
 #include "Albany_Memory.hpp"
 
@@ -221,6 +222,89 @@ void tpetraFromThyra(
   }
 }
 
+// Record the solution history of the integrator for a checkpoint. The states
+// are named by their time index, so the incremental writes of the checkpoint
+// only write the states that are new since the previous one.
+void saveTempusHistory(
+  Albany::Checkpoint &checkpoint,
+  Tempus::SolutionHistory<double> &history)
+{
+  checkpoint.unset("Tempus ");
+  const int num_states = history.getNumStates();
+  checkpoint.setScalar("Tempus States", num_states);
+  for (int k = 0; k < num_states; ++k) {
+    const Teuchos::RCP<Tempus::SolutionState<double> > state = history[k];
+    const std::string name = "Tempus " + std::to_string(state->getIndex()) + " ";
+    checkpoint.setScalar("Tempus State " + std::to_string(k), state->getIndex());
+    checkpoint.setScalar(name + "Time", state->getTime());
+    checkpoint.setScalar(name + "Time Step", state->getTimeStep());
+    checkpoint.setScalar(name + "Order", state->getOrder());
+    checkpoint.setScalar(name + "Error Abs", state->getErrorAbs());
+    checkpoint.setScalar(name + "Error Rel", state->getErrorRel());
+    // Failures of the nonlinear solver, counted against the limits of the
+    // time step control
+    checkpoint.setScalar(name + "Failures", state->getNFailures());
+    checkpoint.setScalar(name + "Running Failures", state->getNRunningFailures());
+    checkpoint.setScalar(name + "Consecutive Failures", state->getNConsecutiveFailures());
+    checkpoint.setScalar(name + "Status", state->getSolutionStatus());
+    checkpoint.setVector(name + "x", ConverterT::getConstTpetraVector(state->getX()));
+    if (Teuchos::nonnull(state->getXDot()))
+      checkpoint.setVector(name + "xdot", ConverterT::getConstTpetraVector(state->getXDot()));
+    if (Teuchos::nonnull(state->getXDotDot()))
+      checkpoint.setVector(name + "xdotdot", ConverterT::getConstTpetraVector(state->getXDotDot()));
+  }
+}
+
+// Replace the solution history of the integrator, which starts from the
+// initial condition, by the one of the checkpoint. Multistep steppers and
+// variable step controls continue from the same states and step sizes as
+// the run that wrote the checkpoint.
+void restoreTempusHistory(
+  const Albany::Checkpoint &checkpoint,
+  const Thyra::ModelEvaluator<double> &model,
+  Tempus::Stepper<double> &stepper,
+  Tempus::SolutionHistory<double> &history)
+{
+  double num_states = 0.0;
+  if (!checkpoint.getScalar("Tempus States", num_states)) return;
+
+  history.clear();
+  for (int k = 0; k < static_cast<int>(num_states); ++k) {
+    double index = 0.0;
+    checkpoint.getScalar("Tempus State " + std::to_string(k), index);
+    const std::string name = "Tempus " + std::to_string(static_cast<int>(index)) + " ";
+    const auto scalar = [&checkpoint, &name](const std::string &s) {
+      double value = 0.0;
+      checkpoint.getScalar(name + s, value);
+      return value;
+    };
+
+    const Teuchos::RCP<Tempus::SolutionStateMetaData<double> > md =
+      Teuchos::rcp(new Tempus::SolutionStateMetaData<double>());
+    md->setTime(scalar("Time"));
+    md->setIStep(static_cast<int>(index));
+    md->setDt(scalar("Time Step"));
+    md->setOrder(static_cast<int>(scalar("Order")));
+    md->setErrorAbs(scalar("Error Abs"));
+    md->setErrorRel(scalar("Error Rel"));
+    md->setNFailures(static_cast<int>(scalar("Failures")));
+    md->setNRunningFailures(static_cast<int>(scalar("Running Failures")));
+    md->setNConsecutiveFailures(static_cast<int>(scalar("Consecutive Failures")));
+    md->setSolutionStatus(static_cast<Tempus::Status>(static_cast<int>(scalar("Status"))));
+    md->setIsSynced(true);
+
+    const auto vector = [&checkpoint, &model, &name](const std::string &s) {
+      Teuchos::RCP<Thyra::VectorBase<double> > v = Thyra::createMember(model.get_x_space());
+      if (!checkpoint.getVector(name + s, *ConverterT::getTpetraVector(v)))
+        v = Teuchos::null;
+      return v;
+    };
+    history.addState(Teuchos::rcp(new Tempus::SolutionState<double>(
+      md, vector("x"), vector("xdot"), vector("xdotdot"),
+      stepper.getDefaultStepperState())));
+  }
+}
+
 int main(int argc, char *argv[]) {
 
   // Global variable that denotes this is the Tpetra executable
@@ -312,11 +396,32 @@ int main(int argc, char *argv[]) {
         tempus_observer = Teuchos::rcp(new Piro::ObserverToTempusIntegrationObserverAdapter<double>(solutionHistory, 
                                            timeStepControl, piro_observer));
       }
+      bool reinitialize = false;
+      const RCP<Albany::Checkpoint> checkpoint = app->getCheckpoint();
+      if (Teuchos::nonnull(checkpoint)) {
+        if (checkpoint->restarting()) {
+          restoreTempusHistory(*checkpoint, *model, *integrator->getStepper(),
+                               *integrator->getSolutionHistory());
+          reinitialize = true;
+        }
+        // The integrator holds the model, which holds the application and
+        // its checkpoint
+        const auto weak_integrator = integrator.create_weak();
+        checkpoint->addSaver([weak_integrator](Albany::Checkpoint &c) {
+          if (weak_integrator.is_valid_ptr())
+            saveTempusHistory(c, *weak_integrator->getSolutionHistory());
+        });
+      }
       if (Teuchos::nonnull(tempus_observer)) {
         integrator->setObserver(tempus_observer); 
-        integrator->initialize(); 
+        reinitialize = true;
       }
+      if (reinitialize)
+        integrator->initialize(); 
       bool integratorStatus = integrator->advanceTime(); 
+      if (Teuchos::nonnull(checkpoint))
+        checkpoint->wait();
+      app->reportDagProfile();
       double time = integrator->getTime();
       *out << "\n Final time = " << time << "\n"; 
       Teuchos::RCP<Thyra::VectorBase<double> > x = integrator->getX();
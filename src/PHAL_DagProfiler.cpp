@@ -0,0 +1,112 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#include "PHAL_DagProfiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace PHAL {
+
+namespace {
+
+std::string quote (const std::string& s) {
+  std::string q = "\"";
+  for (const char c : s) {
+    if (c == '"' || c == '\\') q += '\\';
+    q += c;
+  }
+  return q + "\"";
+}
+
+void writeList (std::ostream& os, const std::vector<std::string>& v) {
+  os << "[";
+  for (std::size_t i = 0; i < v.size(); ++i)
+    os << (i ? ", " : "") << quote(v[i]);
+  os << "]";
+}
+
+} // namespace
+
+void DagProfiler::enable (const std::string& file_name) {
+  enabled_ = true;
+  file_name_ = file_name;
+}
+
+void DagProfiler::report (std::ostream& os) const {
+  struct Row {
+    const Dag* dag;
+    const Node* node;
+  };
+  std::vector<Row> rows;
+  for (const auto& dag : dags_)
+    for (const auto& node : dag.nodes) rows.push_back(Row{&dag, &node});
+  std::stable_sort(rows.begin(), rows.end(), [] (const Row& a, const Row& b) {
+    return a.node->seconds > b.node->seconds;
+  });
+
+  os << "Phalanx DAG profile (this process):\n";
+  for (const auto& dag : dags_)
+    os << "  " << dag.fm_name << " " << dag.eval_type << ": "
+       << dag.nodes.size() << " evaluators, " << dag.calls.count
+       << " calls, " << dag.calls.seconds << " s\n";
+  os << std::setw(12) << "time [s]" << std::setw(10) << "calls"
+     << std::setw(14) << "field bytes" << "  evaluator\n";
+  for (const auto& r : rows)
+    os << std::setw(12) << r.node->seconds << std::setw(10)
+       << r.dag->calls.count << std::setw(14) << r.node->bytes << "  "
+       << r.node->name << " (" << r.dag->fm_name << " " << r.dag->eval_type
+       << ")\n";
+  os << std::flush;
+}
+
+void DagProfiler::write (const int rank, const int num_ranks) const {
+  std::ostringstream name;
+  name << file_name_;
+  if (num_ranks > 1) name << "." << rank;
+  std::ofstream os(name.str().c_str());
+
+  os << "{\n  \"dags\": [";
+  for (std::size_t d = 0; d < dags_.size(); ++d) {
+    const Dag& dag = dags_[d];
+    os << (d ? "," : "") << "\n    {\n"
+       << "      \"field manager\": " << quote(dag.fm_name) << ",\n"
+       << "      \"evaluation type\": " << quote(dag.eval_type) << ",\n"
+       << "      \"calls\": " << dag.calls.count << ",\n"
+       << "      \"seconds\": " << dag.calls.seconds << ",\n"
+       << "      \"nodes\": [";
+    std::map<std::string, std::size_t> provider;
+    for (std::size_t i = 0; i < dag.nodes.size(); ++i) {
+      const Node& n = dag.nodes[i];
+      for (const auto& f : n.evaluated) provider[f] = i;
+      os << (i ? "," : "") << "\n        {\"id\": " << i
+         << ", \"name\": " << quote(n.name)
+         << ", \"seconds\": " << n.seconds
+         << ", \"calls\": " << dag.calls.count
+         << ", \"field bytes\": " << n.bytes << ",\n         \"evaluates\": ";
+      writeList(os, n.evaluated);
+      os << ",\n         \"depends on\": ";
+      writeList(os, n.dependent);
+      os << "}";
+    }
+    os << "\n      ],\n      \"edges\": [";
+    bool first = true;
+    for (std::size_t i = 0; i < dag.nodes.size(); ++i)
+      for (const auto& f : dag.nodes[i].dependent) {
+        const auto p = provider.find(f);
+        if (p == provider.end()) continue;
+        os << (first ? "" : ",") << "\n        {\"from\": " << p->second
+           << ", \"to\": " << i << ", \"field\": " << quote(f) << "}";
+        first = false;
+      }
+    os << "\n      ]\n    }";
+  }
+  os << "\n  ]\n}\n";
+}
+
+} // namespace PHAL
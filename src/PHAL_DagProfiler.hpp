@@ -0,0 +1,194 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef PHAL_DAG_PROFILER_HPP
+#define PHAL_DAG_PROFILER_HPP
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "Phalanx_FieldManager.hpp"
+#include "Sacado_Traits.hpp"
+
+#include "PHAL_AlbanyTraits.hpp"
+#include "PHAL_Workset.hpp"
+
+namespace PHAL {
+
+/*! \brief Per evaluator cost of the Phalanx DAGs driven by Albany::Application.
+ *
+ *  Enable it in the debug block:
+ *
+ *      <ParameterList name="Debug Output">
+ *        <Parameter name="Profile Phalanx DAG" type="bool" value="true"/>
+ *        <Parameter name="Phalanx DAG Profile File Name" type="string"
+ *                   value="phalanx_dag_profile.json"/>
+ *      </ParameterList>
+ *
+ *  Application routes its FieldManager::evaluateFields calls through
+ *  evaluateFields() below, which counts them and times them as a whole when
+ *  profiling is on, and is a plain forwarding call otherwise. At the end of
+ *  the solve collect() reads, for each evaluator of the DAG, the execution time
+ *  accumulated by the Phalanx DagManager and the memory of the fields it
+ *  evaluates. Since the DAG runs every evaluator once per call, the call count
+ *  of an evaluator is the call count of its field manager. The drivers call
+ *  Application::reportDagProfile() at the end of the solve.
+ *
+ *  report() prints the evaluators by decreasing time; write() stores the
+ *  DAGs, with these costs on the nodes and the fields on the edges, as JSON.
+ *  The numbers are local to the process; with several processes every rank
+ *  writes its own file, suffixed with the rank.
+ */
+class DagProfiler {
+public:
+  DagProfiler () : enabled_(false) {}
+
+  void enable (const std::string& file_name);
+  bool enabled () const { return enabled_; }
+  const std::string& fileName () const { return file_name_; }
+
+  //! Run fm.evaluateFields<EvalT>(workset), recording the call if enabled.
+  template<typename EvalT>
+  void evaluateFields (PHX::FieldManager<AlbanyTraits>& fm, Workset& workset);
+
+  //! Whether the DAG of EvalT in fm was run while profiling.
+  template<typename EvalT>
+  bool wasEvaluated (const PHX::FieldManager<AlbanyTraits>& fm) const;
+
+  /*! Gather the per evaluator costs of the DAG of EvalT in fm.
+   *  \param fm_name Label of fm in the output, e.g. "fm 0" or "dfm".
+   *  \param derivative_dimension Derivative dimension of the AD fields.
+   */
+  template<typename EvalT>
+  void collect (const PHX::FieldManager<AlbanyTraits>& fm,
+                const std::string& fm_name, const int derivative_dimension);
+
+  //! Drop the DAGs gathered by earlier collect() calls; call counts are kept.
+  void clearCollected () { dags_.clear(); }
+
+  //! Table of the collected evaluators, most expensive first.
+  void report (std::ostream& os) const;
+
+  //! Write the collected DAGs as JSON to fileName(), suffixed with rank if
+  //! num_ranks > 1.
+  void write (const int rank, const int num_ranks) const;
+
+private:
+  struct Calls {
+    Calls () : count(0), seconds(0) {}
+    std::size_t count;
+    double seconds;
+  };
+
+  struct Node {
+    std::string name;
+    double seconds;
+    std::size_t bytes;
+    std::vector<std::string> evaluated, dependent;
+  };
+
+  struct Dag {
+    std::string fm_name, eval_type;
+    Calls calls;
+    std::vector<Node> nodes;
+  };
+
+  typedef std::pair<const void*, std::string> Key;
+
+  template<typename EvalT>
+  static Key key (const PHX::FieldManager<AlbanyTraits>& fm) {
+    return Key(&fm, PHX::typeAsString<EvalT>());
+  }
+
+  template<typename EvalT>
+  static std::size_t scalarBytes (const std::type_info& type,
+                                  const int derivative_dimension);
+
+  bool enabled_;
+  std::string file_name_;
+  std::map<Key, Calls> calls_;
+  std::vector<Dag> dags_;
+};
+
+template<typename EvalT>
+void DagProfiler::
+evaluateFields (PHX::FieldManager<AlbanyTraits>& fm, Workset& workset) {
+  if ( ! enabled_) {
+    fm.template evaluateFields<EvalT>(workset);
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  fm.template evaluateFields<EvalT>(workset);
+  const std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  Calls& c = calls_[key<EvalT>(fm)];
+  ++c.count;
+  c.seconds += elapsed.count();
+}
+
+template<typename EvalT>
+bool DagProfiler::wasEvaluated (const PHX::FieldManager<AlbanyTraits>& fm) const {
+  return calls_.find(key<EvalT>(fm)) != calls_.end();
+}
+
+template<typename EvalT>
+std::size_t DagProfiler::
+scalarBytes (const std::type_info& type, const int derivative_dimension) {
+  typedef typename EvalT::ScalarT ScalarT;
+  typedef typename EvalT::MeshScalarT MeshScalarT;
+  typedef typename EvalT::ParamScalarT ParamScalarT;
+  // Dynamic AD types keep their derivatives outside of the object.
+  const std::size_t ad = (derivative_dimension + 1) * sizeof(RealType);
+  if (type == typeid(ScalarT))
+    return Sacado::IsADType<ScalarT>::value ? ad : sizeof(ScalarT);
+  if (type == typeid(MeshScalarT))
+    return Sacado::IsADType<MeshScalarT>::value ? ad : sizeof(MeshScalarT);
+  if (type == typeid(ParamScalarT))
+    return Sacado::IsADType<ParamScalarT>::value ? ad : sizeof(ParamScalarT);
+  if (type == typeid(int)) return sizeof(int);
+  return sizeof(RealType);
+}
+
+template<typename EvalT>
+void DagProfiler::collect (const PHX::FieldManager<AlbanyTraits>& fm,
+                           const std::string& fm_name,
+                           const int derivative_dimension) {
+  const auto c = calls_.find(key<EvalT>(fm));
+  if (c == calls_.end()) return;
+
+  Dag dag;
+  dag.fm_name = fm_name;
+  dag.eval_type = PHX::typeAsString<EvalT>();
+  dag.calls = c->second;
+
+  const PHX::DagManager<AlbanyTraits>& dm = fm.template getDagManager<EvalT>();
+  const auto& dag_nodes = dm.getDagNodes();
+  for (const int i : dm.getEvaluatorInternalOrdering()) {
+    const auto& e = dag_nodes[i].get();
+    Node n;
+    n.name = e->getName();
+    n.seconds = dag_nodes[i].executionTime().count();
+    n.bytes = 0;
+    for (const auto& tag : e->evaluatedFields()) {
+      n.evaluated.push_back(tag->identifier());
+      n.bytes += tag->dataLayout().size() *
+        scalarBytes<EvalT>(tag->dataTypeInfo(), derivative_dimension);
+    }
+    for (const auto& tag : e->dependentFields())
+      n.dependent.push_back(tag->identifier());
+    dag.nodes.push_back(n);
+  }
+  dags_.push_back(dag);
+}
+
+} // namespace PHAL
+
+#endif // PHAL_DAG_PROFILER_HPP
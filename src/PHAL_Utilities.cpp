@@ -36,6 +36,12 @@ template<> int getDerivativeDimensions<PHAL::AlbanyTraits::DistParamDeriv> (
   const Albany::Application* app, const Albany::MeshSpecsStruct* ms)
 {
   //Mauro: currently distributed derivatives work only with scalar parameters, to be updated.
+#ifdef ALBANY_TAN_SLFAD_SIZE
+  TEUCHOS_TEST_FOR_EXCEPTION(
+    ms->ctd.node_count > ALBANY_TAN_SLFAD_SIZE, std::logic_error,
+    "Error in getDerivativeDimensions: elements with " << ms->ctd.node_count
+    << " nodes need TAN_SLFAD_SIZE >= " << ms->ctd.node_count << ".\n");
+#endif
   return ms->ctd.node_count;
 }
 
@@ -119,7 +119,9 @@ struct Workset {
 
   // Current Time as defined by Rythmos
   double current_time;
-  //amb Nowhere set. We should either set it or remove it.
+  // Time of the last solution accepted by the time integrator, i.e. the
+  // start of the current time step, as seen by the observer; -infinity
+  // before the first one or without an observer
   double previous_time;
 
   // flag indicating whether to sum tangent derivatives, i.e.,
@@ -393,6 +393,8 @@ QCAD::ResponseSaddleValue<EvalT,Traits>::getValidResponseParameters() const
   validPL->set<double>("GF-CBR Method Vds Final Value", 0., "Final Vds value [V]");
   validPL->set<int>("GF-CBR Method Vds Steps", 10, "Number of Vds steps going from initial to final values");
   validPL->set<std::string>("GF-CBR Method Eigensolver", "", "Eigensolver used by the GF-CBR method");
+  validPL->set<double>("GF-CBR Method Energy Points per kT", 10.0, "Number of uniform energy points per kbT in the GF-CBR current integral");
+  validPL->set<double>("GF-CBR Method Energy Refinement Tolerance", 0.0, "Relative tolerance of the adaptive Simpson refinement of the GF-CBR energy grid near resonances; 0 uses the uniform grid only");
   
   validPL->set<int>("Debug Mode", 0, "Print verbose debug messages to stdout");
   validPL->set< Teuchos::RCP<QCAD::SaddleValueResponseFunction> >("Response Function", Teuchos::null, "Saddle value response function");
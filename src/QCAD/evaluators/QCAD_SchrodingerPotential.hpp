@@ -13,6 +13,7 @@
 #include "Phalanx_MDField.hpp"
 
 #include "Albany_Layouts.hpp"
+#include "QCAD_StringFormulaEvaluator.hpp"
 
 #include "Teuchos_ParameterList.hpp"
 #include "Sacado_ParameterAccessor.hpp"
@@ -78,6 +79,8 @@ namespace QCAD {
 
     //!! specific parameters for string formula
     std::string stringFormula;
+    Teuchos::RCP<QCAD::StringFormulaEvaluator> stringFormulaEval;
+    std::vector<MeshScalarT> formulaRegisters;
     
     //! specific parameters for Finite Wall 
     double barrEffMass; // in [m0]
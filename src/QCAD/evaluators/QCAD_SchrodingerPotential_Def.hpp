@@ -8,7 +8,6 @@
 #include "Teuchos_TestForException.hpp"
 #include "Phalanx_DataLayout.hpp"
 #include "Sacado_ParameterRegistration.hpp"
-#include "QCAD_StringFormulaEvaluator.hpp"
 
 template<typename EvalT, typename Traits>
 QCAD::SchrodingerPotential<EvalT, Traits>::
@@ -39,6 +38,8 @@ SchrodingerPotential(Teuchos::ParameterList& p,
   
   // Parameters for String Formula
   stringFormula = psList->get("Formula", "0");
+  if (potentialType == "String Formula")
+    stringFormulaEval = Teuchos::rcp(new QCAD::StringFormulaEvaluator(stringFormula));  //Parse once, throws on error
 
   // Parameters for Finite Wall 
   barrEffMass = psList->get<double>("Barrier Effective Mass", 0.0);
@@ -333,8 +334,8 @@ QCAD::SchrodingerPotential<EvalT,Traits>::stringFormulaPotential(
     }    
   }  // end of switch (numDim)
   
-  result = Evaluate(stringFormula,x,y,z); //Parse and evaluate formula string 
-  val = result;                                // (could speed this up in future by saving intermediate parse info)
+  result = stringFormulaEval->evaluate(x, y, z, formulaRegisters); //Run formula compiled in constructor
+  val = result;
   return scalingFactor * val;
 }
 
@@ -7,13 +7,64 @@
 #ifndef QCAD_STRINGFORMULAEVALUATOR_HPP
 #define QCAD_STRINGFORMULAEVALUATOR_HPP
 
-//Prototypes
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "utility/Expression.hpp"
+
+class EvaluateException: public std::exception
+{
+public:
+  EvaluateException(std::string message) {
+    msg = message;
+  }
+  ~EvaluateException() throw () {}
+
+  virtual const char* what() const throw() {
+    return msg.c_str();
+  }
+
+private:
+  std::string msg;
+};
+
+namespace QCAD {
+
+//String expression which may contain x,y,z symbols.  The expression is parsed
+// once, in the constructor, which throws EvaluateException on error.
+class StringFormulaEvaluator
+{
+public:
+  StringFormulaEvaluator(const std::string& strExpression);
+
+  const std::string& formula() const { return expr.formula(); }
+
+  template<typename coordType>
+  coordType evaluate(coordType x, coordType y, coordType z) const
+  {
+    const coordType values[3] = {x, y, z};
+    return expr.evaluate(values);
+  }
+
+  //Same as above, reusing the register file across calls
+  template<typename coordType>
+  coordType evaluate(coordType x, coordType y, coordType z,
+                     std::vector<coordType>& registers) const
+  {
+    const coordType values[3] = {x, y, z};
+    return expr.evaluate(values, registers);
+  }
+
+private:
+  util::Expression expr;
+};
+
+}
 
 //Evaluate a string expression which may contain x,y,z symbols.  Throws EvaluateException on error.
+// Parses the expression on every call; use QCAD::StringFormulaEvaluator to evaluate a formula repeatedly.
 template<typename coordType>
 coordType Evaluate(std::string strExpression, coordType x, coordType y, coordType z);
 
-class EvaluateException;
-
-
 #endif
@@ -8,6 +8,7 @@
 #include "AnasaziBasicEigenproblem.hpp"
 #include "AnasaziBlockDavidsonSolMgr.hpp"
 #include "Epetra_CrsMatrix.h"
+#include "Kokkos_Core.hpp"
 
 #include "Teuchos_TestForException.hpp"
 #include "Teuchos_CommHelpers.hpp"
@@ -15,6 +16,32 @@
 #include "QCAD_GreensFunctionTunneling.hpp"
 #include <fstream>
 
+namespace {
+
+typedef Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace> HostRange;
+
+// Bisections of an energy interval, each halving it, in the adaptive grid
+const int maxRefineDepth = 16;
+
+// Adaptive Simpson's rule for the integral of g on [a,b], given g at a, at
+// the midpoint and at b and the Simpson estimate on [a,b]
+template<typename Integrand>
+double adaptiveSimpson(const Integrand& g, double a, double b, double fa, double fm,
+                       double fb, double whole, double tol, int depth)
+{
+  const double m = 0.5*(a+b), lm = 0.5*(a+m), rm = 0.5*(m+b);
+  const double flm = g(lm), frm = g(rm);
+  const double left = (m-a)/6. * (fa + 4.*flm + fm);
+  const double right = (b-m)/6. * (fm + 4.*frm + fb);
+  const double delta = left + right - whole;
+  if(depth <= 0 || std::abs(delta) <= 15.*tol)
+    return left + right + delta/15.;
+  return adaptiveSimpson(g, a, m, fa, flm, fm, left, tol/2., depth-1)
+       + adaptiveSimpson(g, m, b, fm, frm, fb, right, tol/2., depth-1);
+}
+
+} // namespace
+
 // Assume EcValues are in units of eV
 // Assume effMass is in units of m_0 (electron rest mass)
 // Assume ptSpacing is in units of microns (um)
@@ -31,6 +58,8 @@ GreensFunctionTunnelingSolver(const Teuchos::RCP<std::vector<double> >& EcValues
   nGFPts = nGFPts_; 
   effMass = effMass_;
   bNeumannBC = bNeumannBC_;
+  energyPtsPerKbT = 10.;
+  energyRefineTol = 0.;
 
   // Retrieve Ec and pathLen for spline interpolation
   std::vector<double>  oldEcValues = (*EcValues_);
@@ -103,6 +132,14 @@ QCAD::GreensFunctionTunnelingSolver::
 
 double QCAD::GreensFunctionTunnelingSolver::
 computeCurrent(double Vds, double kbT, double Ecutoff_offset_from_Emax, bool bUseAnasazi)
+{
+  return computeCurrent(Vds, kbT, Ecutoff_offset_from_Emax, bUseAnasazi, true);
+}
+
+
+double QCAD::GreensFunctionTunnelingSolver::
+computeCurrent(double Vds, double kbT, double Ecutoff_offset_from_Emax, bool bUseAnasazi,
+               bool bSplitEnergyOverProcs)
 {
   const double hbar_1 = 6.582119e-16; // eV * s
   const double hbar_2 = 1.054572e-34; // J * s = kg * m^2 / s
@@ -135,7 +172,7 @@ computeCurrent(double Vds, double kbT, double Ecutoff_offset_from_Emax, bool bUs
   }
 
   // set up uniform energy spacing
-  double dE = kbT / 10;
+  double dE = kbT / energyPtsPerKbT;
   int nEPts = int((Emax - Emin) / dE) + 1;
   dE = (Emax - Emin)/(nEPts-1);  // recalculate dE for given nEPts
   double a0 = ptSpacing;
@@ -147,7 +184,6 @@ computeCurrent(double Vds, double kbT, double Ecutoff_offset_from_Emax, bool bUs
   Teuchos::RCP<std::vector<double> > pEc = Teuchos::null;
   Teuchos::RCP<std::vector<double> > pLastEc = Teuchos::null;
 
-  Map = Teuchos::rcp(new Epetra_Map(nPts, 0, *Comm));
   t0  = hbar_1 * hbar_2 /(2*effMass*m_0* pow(a0*um,2) ); // gives t0 in units of eV 
   std::cout << "Emin=" << Emin << ", Emax=" << Emax << ", Ecutoff=" << Ecutoff <<", t0=" << t0 << std::endl;    
 
@@ -156,6 +192,10 @@ computeCurrent(double Vds, double kbT, double Ecutoff_offset_from_Emax, bool bUs
   if(bUseAnasazi) {
     Teuchos::RCP<Epetra_MultiVector> evecs;
 
+    // Creating the map is collective, so only the Anasazi path, which every
+    // processor takes together, may do it: with tql2 the processors may be
+    // computing different bias points, or different numbers of them.
+    Map = Teuchos::rcp(new Epetra_Map(nPts, 0, *Comm));
     ret = doMatrixDiag_Anasazi(Vds, *EcValues, Ecutoff, evals, evecs);
     pEc = EcValues;
     std::cout << "  Diag w/ a0 = " << a0 << ", nPts = " << nPts << " give "
@@ -265,24 +305,11 @@ computeCurrent(double Vds, double kbT, double Ecutoff_offset_from_Emax, bool bUs
 
   std::cout << nEPts << " Energy Pts: " << Emin << " to " << Emax << " eV in steps of " << dE << std::endl;
 
-  // Spread energy points evenly across processors
-  Epetra_Map EnergyMap(nEPts, 0, *Comm);
-  
-  // Number of energy points on current processor. 
-  int NumMyEnergyPts = EnergyMap.NumMyElements();
-
-  // Put list of global elements on this processor into the user-provided array. 
-  std::vector<int> MyGlobalEnergyPts(NumMyEnergyPts);
-  EnergyMap.MyGlobalElements(&MyGlobalEnergyPts[0]);
-
-  double I, Iloc = 0., x, y;
-  double E, Gamma11, GammaNN, G011, G01N, G0NN, Tm;
-  std::complex<double> Sigma11, SigmaNN, GR1N, p11, pNN;
-  
-  // add up contributions to energy integral from current processor
-  // eigenvectors are assumed to be real
-  for (int i = 0; i < NumMyEnergyPts; i++) {
-    E = Emin + MyGlobalEnergyPts[i]*dE;
+  // Integrand of the current at energy E: transmission times the difference
+  // of the lead occupations. Eigenvectors are assumed to be real.
+  auto integrand = [&](const double E) -> double {
+    double x, y;
+    std::complex<double> Sigma11, SigmaNN;
 
     x = (E-VL)*(t0-(E-VL)/4.);
     y = bNeumannBC ? 0. : t0;
@@ -297,29 +324,77 @@ computeCurrent(double Vds, double kbT, double Ecutoff_offset_from_Emax, bool bUs
     else
       SigmaNN = std::complex<double>( (E-VR)/2. - y + sqrt(-x ), 0.);
 
-    Gamma11 = -2.*Sigma11.imag();
-    GammaNN = -2.*SigmaNN.imag();
+    double Gamma11 = -2.*Sigma11.imag();
+    double GammaNN = -2.*SigmaNN.imag();
 
-    G011 = G01N = G0NN = 0.;
+    double G011 = 0., G01N = 0., G0NN = 0.;
     for(int j = 0; j < nEvecs; j++) {
       G011 += evecBeginEls[j] * evecBeginEls[j] / (E - evals[j]);
       G01N += evecBeginEls[j] * evecEndEls[j] / (E - evals[j]);
       G0NN += evecEndEls[j] * evecEndEls[j] / (E - evals[j]);
     }
 
-    p11 = Sigma11*G011; pNN = SigmaNN*G0NN; 
-    GR1N = G01N / ((p11-1.0)*(pNN-1.0) - Sigma11*SigmaNN*G01N*G01N);
-    Tm = Gamma11 * GammaNN * std::norm(GR1N);
-    //std::cout << "DEBUG: brkdown = " << Gamma11 << " , " << GammaNN << " , " << 
-    // std::norm(GR1N) << " , " << E << " , " << VL << " , " << VR << " , " << t0 << " , " << x << std::endl;
-
-    Iloc += Tm * ( f0((E - muL)/kbT) - f0((E - muR)/kbT) ) * dE;
+    std::complex<double> p11 = Sigma11*G011, pNN = SigmaNN*G0NN;
+    std::complex<double> GR1N = G01N / ((p11-1.0)*(pNN-1.0) - Sigma11*SigmaNN*G01N*G01N);
+    double Tm = Gamma11 * GammaNN * std::norm(GR1N);
+
+    return Tm * ( f0((E - muL)/kbT) - f0((E - muR)/kbT) );
+  };
+
+  // Energy points (uniform grid) or intervals (refined grid) of the current
+  // processor: a contiguous block of them, or all of them
+  const bool bRefine = (energyRefineTol > 0.) && (nEPts > 1);
+  const int nSamples = bRefine ? nEPts-1 : nEPts;
+  int myBegin = 0, myEnd = nSamples;
+  if(bSplitEnergyOverProcs) {
+    Epetra_Map EnergyMap(nSamples, 0, *Comm);
+    myBegin = EnergyMap.MinMyGID();
+    myEnd = myBegin + EnergyMap.NumMyElements();
+  }
+  const int nMySamples = myEnd - myBegin;
+
+  // add up contributions to energy integral from current processor, over
+  // the host threads
+  double I, Iloc = 0.;
+  if(!bRefine) {
+    Kokkos::parallel_reduce(HostRange(myBegin, myEnd),
+      [&](const int i, double& sum) {
+        sum += integrand(Emin + i*dE) * dE;
+      }, Iloc);
+  }
+  else {
+    // Simpson's rule on each interval, refined by bisection where it differs
+    // from its halves by more than the tolerance, relative to the integral
+    // of |integrand|. The resonances of the transmission, much narrower than
+    // kbT, only get the extra points.
+    std::vector<double> gPts(nMySamples+1), gMid(nMySamples);
+    Kokkos::parallel_for(HostRange(0, nMySamples+1),
+      [&](const int i) {
+        gPts[i] = integrand(Emin + (myBegin+i)*dE);
+        if(i < nMySamples) gMid[i] = integrand(Emin + (myBegin+i+0.5)*dE);
+      });
+
+    double absLoc = 0., absI = 0.;
+    for(int i = 0; i < nMySamples; i++)
+      absLoc += dE/6. * (std::abs(gPts[i]) + 4.*std::abs(gMid[i]) + std::abs(gPts[i+1]));
+    if(bSplitEnergyOverProcs) Comm->SumAll(&absLoc, &absI, 1);
+    else absI = absLoc;
+    const double tol = energyRefineTol * absI / nSamples;
+
+    Kokkos::parallel_reduce(HostRange(0, nMySamples),
+      [&](const int i, double& sum) {
+        const double a = Emin + (myBegin+i)*dE;
+        const double whole = dE/6. * (gPts[i] + 4.*gMid[i] + gPts[i+1]);
+        sum += adaptiveSimpson(integrand, a, a+dE, gPts[i], gMid[i], gPts[i+1],
+                               whole, tol, maxRefineDepth);
+      }, Iloc);
   }
 
-  std::cout << "Energy Integral contrib from proc " << Comm->MyPID() << " = " << Iloc << " (" << NumMyEnergyPts << " energy pts)"<< std::endl;
+  std::cout << "Energy Integral contrib from proc " << Comm->MyPID() << " = " << Iloc << " (" << nMySamples << " energy " << (bRefine ? "intervals" : "pts") << ")"<< std::endl;
 
   // add contributions from all processors
-  Comm->SumAll(&Iloc, &I, 1);
+  if(bSplitEnergyOverProcs) Comm->SumAll(&Iloc, &I, 1);
+  else I = Iloc;
 
   std::cout << "Total Energy Integral = " << I << " eV" << std::endl;
   
@@ -666,9 +741,37 @@ void QCAD::GreensFunctionTunnelingSolver::
 computeCurrentRange(const std::vector<double> Vds, double kbT, 
 	double Ecutoff_offset_from_Emax, std::vector<double>& resultingCurrent, bool bUseAnasazi)
 {
-  for(std::size_t i = 0; i < Vds.size(); i++) {
-    resultingCurrent[i] = computeCurrent(Vds[i], kbT, Ecutoff_offset_from_Emax, bUseAnasazi);
+  const int nProcs = Comm->NumProc();
+  const int nVds = Vds.size();
+
+  // Anasazi diagonalizes on all processors together, and with fewer bias
+  // points than processors some would sit idle: spread the energy points of
+  // each bias point over the processors instead.
+  if(bUseAnasazi || nProcs == 1 || nVds < nProcs) {
+    for(int i = 0; i < nVds; i++) {
+      resultingCurrent[i] = computeCurrent(Vds[i], kbT, Ecutoff_offset_from_Emax, bUseAnasazi);
+    }
+    return;
   }
+
+  // tql2 diagonalizes on each processor, so give each processor whole bias
+  // points, round robin since the energy range grows with |Vds|.
+  std::vector<double> myCurrent(nVds, 0.0);
+  for(int i = Comm->MyPID(); i < nVds; i += nProcs) {
+    myCurrent[i] = computeCurrent(Vds[i], kbT, Ecutoff_offset_from_Emax, false, false);
+  }
+  resultingCurrent.resize(nVds);
+  Comm->SumAll(&myCurrent[0], &resultingCurrent[0], nVds);
+}
+
+
+void QCAD::GreensFunctionTunnelingSolver::
+setEnergyGrid(double ptsPerKbT, double refineTol)
+{
+  TEUCHOS_TEST_FOR_EXCEPTION( ptsPerKbT <= 0., Teuchos::Exceptions::InvalidParameter,
+      "Error!  The number of energy points per kbT must be positive !" );
+  energyPtsPerKbT = ptsPerKbT;
+  energyRefineTol = refineTol;
 }
 
 
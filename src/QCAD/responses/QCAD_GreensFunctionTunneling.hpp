@@ -31,10 +31,20 @@ namespace QCAD {
     // returns current in units of Amps at a given Vds (in Volts)
     double computeCurrent(double Vds, double kbT, double Ecutoff_offset_from_Emax, bool bUseAnasazi);
     
+    // with tql2 and at least as many Vds values as processors, each processor
+    // computes whole Vds values; otherwise the energy points are split
     void computeCurrentRange(const std::vector<double> Vds, double kbT, double Ecutoff_offset_from_Emax,
 			     std::vector<double>& resultingCurrent, bool bUseAnasazi);
 
+    // energy grid of the current integral: ptsPerKbT uniform points per kbT
+    // (default 10), and if refineTol > 0, adaptive Simpson refinement of each
+    // grid interval to this tolerance relative to the integral (default 0)
+    void setEnergyGrid(double ptsPerKbT, double refineTol);
+
   private:
+    double computeCurrent(double Vds, double kbT, double Ecutoff_offset_from_Emax, bool bUseAnasazi,
+                          bool bSplitEnergyOverProcs);
+
     double f0(double x) const;
 
     bool doMatrixDiag_Anasazi(double Vds, std::vector<double>& Ec, double Ecutoff,
@@ -64,6 +74,8 @@ namespace QCAD {
     double ptSpacing, effMass, t0;
     bool bNeumannBC;
     int nGFPts; 
+
+    double energyPtsPerKbT, energyRefineTol;
     
     std::vector<double> matlabEvals; 
   };
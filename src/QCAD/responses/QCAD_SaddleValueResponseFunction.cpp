@@ -103,6 +103,10 @@ SaddleValueResponseFunction(
   // set default value to 0.5 eV (always want a positive value)
   current_Ecutoff_offset_from_Emax = params.get<double>("GF-CBR Method Energy Cutoff Offset", 0.5);
 
+  // energy grid of the current integral
+  gfEnergyPtsPerKbT = params.get<double>("GF-CBR Method Energy Points per kT", 10.0);
+  gfEnergyRefineTol = params.get<double>("GF-CBR Method Energy Refinement Tolerance", 0.0);
+
   if(backtraceAfterIters < 0) backtraceAfterIters = 10000000;
   else if(backtraceAfterIters <= 1) backtraceAfterIters = 2; // can't backtrace until the second iteration
 
@@ -1937,6 +1941,7 @@ double QCAD::SaddleValueResponseFunction::getCurrent
 
   // instantiate the GF-CBR solver to compute current
   QCAD::GreensFunctionTunnelingSolver solver(Ec, pathLen, nGFPts, ptSpacing, effMass, comm, outputFilename); //Teuchos::rcp(comm.Clone())
+  solver.setEnergyGrid(gfEnergyPtsPerKbT, gfEnergyRefineTol);
   
   // set the eigensolver to be used
   bool bUseAnasazi = false; 
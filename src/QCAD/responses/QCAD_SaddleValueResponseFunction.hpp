@@ -357,6 +357,8 @@ namespace QCAD {
 
     bool bGetCurrent;
     double current_Ecutoff_offset_from_Emax;
+    double gfEnergyPtsPerKbT;  // uniform energy points per kbT in the GF-CBR current integral
+    double gfEnergyRefineTol;  // relative tolerance of the adaptive energy refinement, 0 = none
 
     //! accumulation vectors for evaluator to fill
     mathVector imagePtValues;
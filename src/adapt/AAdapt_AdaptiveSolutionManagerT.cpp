@@ -409,6 +409,16 @@ AAdapt::AdaptiveSolutionManagerT::scatterXT(
 
 }
 
+void
+AAdapt::AdaptiveSolutionManagerT::setInitialSolution(
+    const Tpetra_MultiVector& soln) /* not overlapped */
+{
+  TEUCHOS_TEST_FOR_EXCEPTION(soln.getNumVectors() != current_soln->getNumVectors(), std::logic_error,
+      "AdaptiveSolutionManager error: the initial solution has " << soln.getNumVectors()
+      << " vectors, " << current_soln->getNumVectors() << " expected");
+  current_soln->assign(soln);
+  scatterXT(*current_soln);
+}
 
 Teuchos::RCP<Thyra::MultiVectorBase<double> >
 AAdapt::AdaptiveSolutionManagerT::
@@ -44,6 +44,13 @@ public:
 
    Teuchos::RCP<const Tpetra_MultiVector> getInitialSolution() const { return current_soln; }
 
+   //! Replace the initial solution, e.g. by one restored from a checkpoint
+   void setInitialSolution(const Tpetra_MultiVector& soln);
+
+   //! Number of mesh adaptations performed
+   int getAdaptationStep() const { return iter_; }
+   void setAdaptationStep(const int step) { iter_ = step; }
+
    Teuchos::RCP<Tpetra_MultiVector> getOverlappedSolution() { return overlapped_soln; }
 
    Teuchos::RCP<const Tpetra_MultiVector> getOverlappedSolution() const { return overlapped_soln; }
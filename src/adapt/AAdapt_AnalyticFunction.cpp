@@ -2822,6 +2822,13 @@ AAdapt::ExpressionParser::ExpressionParser(int neq_, int spatialDim_, std::strin
     msg += "**** " + rtcFunctionZ.getErrors() + "\n";
     TEUCHOS_TEST_FOR_EXCEPT_MSG(!success, msg);
   }
+#else
+  // Without the run time compiler, "value = <formula>;" bodies are compiled
+  // by util::Expression
+  const std::vector<std::string> variables = {"x", "y", "z"};
+  functionX.compile(expressionX, variables);
+  functionY.compile(expressionY, variables);
+  functionZ.compile(expressionZ, variables);
 #endif
 }
 
@@ -2860,6 +2867,10 @@ void AAdapt::ExpressionParser::compute(double* solution, const double* X) {
   success = rtcFunctionZ.execute();
   TEUCHOS_TEST_FOR_EXCEPT_MSG(!success, "Error inAAdapt::ExpressionParser::compute(), rtcFunctionZ.execute(), " + rtcFunctionZ.getErrors());
   solution[2] = rtcFunctionZ.getValueOfVar("value");
+#else
+  solution[0] = functionX.evaluate(X);
+  solution[1] = functionY.evaluate(X);
+  solution[2] = functionZ.evaluate(X);
 #endif
 
 //   std::cout << "DEBUG CHECK ExpressionParser " << expressionX << " evaluated at " << X[0] << ", " << X[1] << ", " << X[2] << " yields " << solution[0] << std::endl;
@@ -2868,3 +2879,38 @@ void AAdapt::ExpressionParser::compute(double* solution, const double* X) {
 
   return;
 }
+
+//*****************************************************************************
+AAdapt::ExpressionFunction::ExpressionFunction(int neq_, int spatialDim_, const Teuchos::Array<std::string>& expressions_)
+  : spatialDim(spatialDim_), neq(neq_) {
+
+  TEUCHOS_TEST_FOR_EXCEPTION((expressions_.size() != neq) || (spatialDim > 3),
+                             std::logic_error,
+                             "Error! Invalid specification of initial condition: \"Function Expressions\" must hold "
+                             << neq << " formulas of x, y and z, found " << expressions_.size() << ".");
+
+  const std::vector<std::string> variables = {"x", "y", "z"};
+  for(int i = 0; i < neq; i++) {
+    try {
+      expressions.push_back(util::Expression(expressions_[i], variables));
+    }
+    catch(std::invalid_argument& e) {
+      TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter,
+                                 "Error! Invalid formula for equation " << i << ": " << e.what());
+    }
+  }
+}
+void AAdapt::ExpressionFunction::compute(double* x, const double* X) {
+  double coords[3] = {0.0, 0.0, 0.0};
+  for(int d = 0; d < spatialDim; d++) coords[d] = X[d];
+
+  for(int i = 0; i < neq; i++)
+    x[i] = expressions[i].evaluate(coords);
+}
+void AAdapt::ExpressionFunction::computeAll(std::size_t n, const double* const* coords, double* x) {
+  values.resize(n);
+  for(int i = 0; i < neq; i++) {
+    expressions[i].evaluate(n, coords, values.data());
+    for(std::size_t k = 0; k < n; k++) x[k * neq + i] = values[k];
+  }
+}
@@ -19,6 +19,7 @@
 #ifdef ALBANY_PAMGEN
 #include "RTC_FunctionRTC.hh"
 #endif
+#include "utility/Expression.hpp"
 
 namespace AAdapt {
 
@@ -622,9 +623,30 @@ class ExpressionParser : public AnalyticFunction {
     PG_RuntimeCompiler::Function rtcFunctionX;
     PG_RuntimeCompiler::Function rtcFunctionY;
     PG_RuntimeCompiler::Function rtcFunctionZ;
+#else
+    util::Expression functionX;
+    util::Expression functionY;
+    util::Expression functionZ;
 #endif
 };
 
+//----------------------------------------------------------------------------
+
+// One formula of the coordinates x, y, z per equation, compiled once
+class ExpressionFunction : public AnalyticFunction {
+  public:
+    ExpressionFunction(int neq_, int spatialDim_, const Teuchos::Array<std::string>& expressions_);
+    void compute(double* x, const double* X);
+    // Evaluate at n points at once: coords[d][k] is coordinate d of point k
+    // (three coordinates, zero beyond spatialDim), x[k*neq+i] equation i at point k
+    void computeAll(std::size_t n, const double* const* coords, double* x);
+  private:
+    int spatialDim; // size of coordinate vector X
+    int neq;    // size of solution vector x
+    std::vector<util::Expression> expressions;
+    std::vector<double> values;
+};
+
 }
 
 #endif
@@ -29,6 +29,8 @@ getValidInitialConditionParameters(const Teuchos::ArrayRCP<std::string>& wsEBNam
   validPL->set<std::string >("Function Expression for DOF X", "None", "");
   validPL->set<std::string >("Function Expression for DOF Y", "None", "");
   validPL->set<std::string >("Function Expression for DOF Z", "None", "");
+  validPL->set<Teuchos::Array<std::string> >("Function Expressions", Teuchos::Array<std::string>(),
+      "One formula of x, y and z per equation");
 
   // Validate element block constant data
 
@@ -43,6 +45,25 @@ getValidInitialConditionParameters(const Teuchos::ArrayRCP<std::string>& wsEBNam
   return validPL;
 }
 
+// Evaluate the "Expression" initial condition at all nodes of one workset;
+// node ln of element el is row el*numNodes+ln of x
+void worksetExpressionValues(AAdapt::ExpressionFunction& initFunc,
+                             const Teuchos::ArrayRCP<Teuchos::ArrayRCP<double*> >& wsCoords,
+                             const int numDim, const int numCells, const int numNodes,
+                             const int neq, std::vector<double>& x) {
+
+  const std::size_t n = numCells * numNodes;
+  std::vector<double> X(3 * n, 0.0);
+  for(int el = 0; el < numCells; el++)
+    for(int ln = 0; ln < numNodes; ln++)
+      for(int d = 0; d < numDim; d++)
+        X[d * n + el * numNodes + ln] = wsCoords[el][ln][d];
+
+  const double* columns[3] = {X.data(), X.data() + n, X.data() + 2 * n};
+  x.resize(n * neq);
+  initFunc.computeAll(n, columns, x.data());
+}
+
 #if defined(ALBANY_EPETRA)
 void InitialConditions(const Teuchos::RCP<Epetra_Vector>& soln,
                        const Albany::AbstractDiscretization::Conn& wsElNodeEqID,
@@ -234,6 +255,28 @@ wsElNodeEqID[ws](el,ln,5) = DOF[1],eq[2] (z eqn)
 
   }
 
+  else if(name == "Expression") {
+
+    Teuchos::Array<std::string> expressions =
+      icParams.get("Function Expressions", Teuchos::Array<std::string>());
+    AAdapt::ExpressionFunction initFunc(neq, numDim, expressions);
+
+    // Evaluate each formula over all nodes of a workset at once
+    std::vector<double> x;
+
+    for(int ws = 0; ws < wsElNodeEqID.size(); ws++) {
+      const int numCells = wsElNodeEqID[ws].dimension(0);
+      const int numNodes = wsElNodeEqID[ws].dimension(1);
+      worksetExpressionValues(initFunc, coords[ws], numDim, numCells, numNodes, neq, x);
+
+      for(int el = 0; el < numCells; el++)
+        for(int ln = 0; ln < numNodes; ln++)
+          for(int i = 0; i < neq; i++)
+            (*soln)[wsElNodeEqID[ws](el,ln,i)] = x[(el * numNodes + ln) * neq + i];
+    }
+
+  }
+
   else {
 
     Teuchos::Array<double> defaultData(neq);
@@ -433,6 +476,26 @@ void InitialConditionsT(const Teuchos::RCP<Tpetra_Vector>& solnT,
 
   }
 
+  else if(name == "Expression") {
+
+    Teuchos::Array<std::string> expressions =
+      icParams.get("Function Expressions", Teuchos::Array<std::string>());
+    AAdapt::ExpressionFunction initFunc(neq, numDim, expressions);
+
+    // Evaluate each formula over all nodes of a workset at once
+    std::vector<double> x;
+    for (int ws=0; ws < wsElNodeEqID.size(); ws++) {
+      const int numCells = wsElNodeEqID[ws].dimension(0);
+      const int numNodes = wsElNodeEqID[ws].dimension(1);
+      worksetExpressionValues(initFunc, coords[ws], numDim, numCells, numNodes, neq, x);
+      for (int el=0; el < numCells; el++)
+        for (int ln=0; ln < numNodes; ln++)
+          for (int i=0; i<neq; i++)
+            solnT_nonconstView[wsElNodeEqID[ws](el,ln,i)] = x[(el * numNodes + ln) * neq + i];
+    }
+
+  }
+
   else {
 
     Teuchos::Array<double> defaultData(neq);
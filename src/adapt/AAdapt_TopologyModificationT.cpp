@@ -54,6 +54,11 @@ AAdapt::TopologyModT::TopologyModT(
   double const
   beta = params->get<double>("beta");
 
+  incremental_update_ = params->get<bool>("Incremental Update", false);
+
+  incremental_update_threshold_ =
+      params->get<double>("Incremental Update Threshold", 0.1);
+
   topology_ =
     Teuchos::rcp(new LCM::Topology(
         discretization_,
@@ -126,9 +131,22 @@ AAdapt::TopologyModT::adaptMesh() {
 
   topology_->splitOpenFaces();
 
-  // Throw away all the Albany data structures and re-build them from the mesh
+  // Either patch the Albany data structures for the cells that were
+  // re-attached to new nodes, or throw them away and re-build them from
+  // the mesh
+
+  {
+    TEUCHOS_FUNC_TIME_MONITOR("AAdapt::TopologyMod: discretization update");
 
-  stk_discretization_->updateMesh();
+    if (incremental_update_ == true) {
+      stk_discretization_->updateMeshIncremental(
+          topology_->get_modified_cells(),
+          topology_->get_new_points(),
+          incremental_update_threshold_);
+    } else {
+      stk_discretization_->updateMesh();
+    }
+  }
 
   return true;
 }
@@ -163,6 +181,16 @@ AAdapt::TopologyModT::getValidAdapterParameters() const {
     1.0,
     "Weight factor t_eff = sqrt[(t_s/beta)^2 + t_n^2]");
 
+  valid_pl_->set<bool>(
+    "Incremental Update",
+    false,
+    "Patch the discretization only for the cells affected by fracture");
+
+  valid_pl_->set<double>(
+    "Incremental Update Threshold",
+    0.1,
+    "Fraction of modified cells above which the discretization is rebuilt");
+
   return valid_pl_;
 }
 
@@ -125,6 +125,14 @@ private:
   int
   remesh_file_index_;
 
+  //! Patch the discretization instead of rebuilding it after fracture
+  bool
+  incremental_update_;
+
+  //! Fraction of modified cells above which the full rebuild is used
+  double
+  incremental_update_threshold_;
+
   std::string
   base_exo_filename_;
 };
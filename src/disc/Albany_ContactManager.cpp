@@ -9,13 +9,93 @@
 
 #include "Moertel_InterfaceT.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
 const int printLevel = 4;
 
+namespace {
+
+typedef std::array<double, 2> Vec2;
+
+// Two point Gauss rule, exact for the products of linear functions in D and M
+const int numGaussPoints = 2;
+const double gaussPoints[] = { -0.577350269189625765, 0.577350269189625765 };
+const double gaussWeights[] = { 1.0, 1.0 };
+
+// Slave nodes with less overlap than this fraction of their own length are left out of contact,
+// as their pressure p = -n.r / D is ill determined
+const double minOverlapFraction = 1.0e-2;
+
+// Mortar data of a slave node: nodal normal, half the length of its segments, and the
+// rows of D and M
+struct MortarNode {
+  Vec2 n = {{0.0, 0.0}};
+  double length = 0.0;
+  double D = 0.0;
+  std::map<GO, double> M;
+};
+
+double dot(const Vec2& a, const Vec2& b) { return a[0] * b[0] + a[1] * b[1]; }
+
+// Distance from the point p to the segment (a, b)
+double pointSegmentDistance(const double* p, const double* a, const double* b) {
+  const Vec2 t = {{b[0] - a[0], b[1] - a[1]}};
+  const Vec2 d = {{p[0] - a[0], p[1] - a[1]}};
+  const double length2 = dot(t, t);
+  const double s = length2 > 0.0 ? std::max(0.0, std::min(1.0, dot(d, t) / length2)) : 0.0;
+  return std::hypot(d[0] - s * t[0], d[1] - s * t[1]);
+}
+
+// Which side of the line through a and b is p on?
+double orientation(const double* a, const double* b, const double* p) {
+  return (b[0] - a[0]) * (p[1] - a[1]) - (b[1] - a[1]) * (p[0] - a[0]);
+}
+
+// Sparse row of a matrix by global column
+typedef std::map<Tpetra_GO, ST> SparseRow;
+
+void getRow(const Tpetra_CrsMatrix& A, const Tpetra_GO row, const double scale, SparseRow& result) {
+  const size_t numEntries = A.getNumEntriesInGlobalRow(row);
+  Teuchos::Array<Tpetra_GO> cols(numEntries);
+  Teuchos::Array<ST> vals(numEntries);
+  size_t n = 0;
+  A.getGlobalRowCopy(row, cols(), vals(), n);
+  for (size_t i = 0; i < n; ++i)
+    result[cols[i]] += scale * vals[i];
+}
+
+void sumIntoRow(Tpetra_CrsMatrix& A, const Tpetra_GO row, const double scale, const SparseRow& values) {
+  Teuchos::Array<Tpetra_GO> cols;
+  Teuchos::Array<ST> vals;
+  for (SparseRow::const_iterator it = values.begin(); it != values.end(); ++it) {
+    cols.push_back(it->first);
+    vals.push_back(scale * it->second);
+  }
+  A.sumIntoGlobalValues(row, cols(), vals());
+}
+
+void zeroRow(Tpetra_CrsMatrix& A, const Tpetra_GO row) {
+  const size_t numEntries = A.getNumEntriesInGlobalRow(row);
+  Teuchos::Array<Tpetra_GO> cols(numEntries);
+  Teuchos::Array<ST> vals(numEntries);
+  size_t n = 0;
+  A.getGlobalRowCopy(row, cols(), vals(), n);
+  std::fill(vals.begin(), vals.end(), 0.0);
+  A.replaceGlobalValues(row, cols(0, n), vals(0, n));
+}
+
+}
+
 Albany::ContactManager::ContactManager(const Teuchos::RCP<Teuchos::ParameterList>& params_,
     const Albany::AbstractDiscretization& disc_,
 	const Teuchos::ArrayRCP<Teuchos::RCP<Albany::MeshSpecsStruct> >& meshSpecs_) :
 
-	params(params_), disc(disc_), coordArray(disc_.getCoordinates()), meshSpecs(meshSpecs_)
+	params(params_), disc(disc_), coordArray(disc_.getCoordinates()), meshSpecs(meshSpecs_),
+	out(Teuchos::VerboseObjectBase::getDefaultOStream())
 
 {
 
@@ -26,6 +106,8 @@ Albany::ContactManager::ContactManager(const Teuchos::RCP<Teuchos::ParameterList
 
   probDim = meshSpecs[0]->numDim;
 
+  ALBANY_ASSERT(probDim == 2, "Mortar contact is implemented in 2D only");
+
   moertelManager = Teuchos::rcp( new MoertelT::ManagerT<ST, LO, Tpetra_GO, KokkosNode>(disc.getMapT()->getComm(), printLevel) );
 
   if(probDim == 2){
@@ -49,6 +131,11 @@ Albany::ContactManager::ContactManager(const Teuchos::RCP<Teuchos::ParameterList
         paramList.get<Teuchos::Array<std::string>>("Contact Side Set Pair");
   constrainedFields =
         paramList.get<Teuchos::Array<std::string>>("Constrained Field Names");
+  complementarityParam = paramList.get<double>("Complementarity Parameter", 1.0);
+
+  ALBANY_ASSERT(complementarityParam > 0.0, "Contact Complementarity Parameter must be positive");
+
+  printState = paramList.get<bool>("Print Contact State", false);
 
   // Print names of field variables to be constrainted
   std::cout << "Number of constrained fields: " << constrainedFields.size() << std::endl;
@@ -100,11 +187,14 @@ Albany::ContactManager::ContactManager(const Teuchos::RCP<Teuchos::ParameterList
 
   int interface_ctr = 0;
 
+  slaveSegments.resize(number_of_mortar_pairs);
+  masterSegments.resize(number_of_mortar_pairs);
+
   // Loop over all the master interfaces
   for(int pair = 0; pair < number_of_mortar_pairs; pair++){
 
       processSS(interface_ctr, slaveSideNames[pair], 0 /* Slave side */, mortarside, 
-           slaveNodeGIDs, sfile);
+           slaveNodeGIDs, slaveSegments[pair], sfile);
 
       interface_ctr++;
 
@@ -114,12 +204,42 @@ Albany::ContactManager::ContactManager(const Teuchos::RCP<Teuchos::ParameterList
   for(int pair = 0; pair < number_of_mortar_pairs; pair++){
 
       processSS(interface_ctr, masterSideNames[pair], 1 /* mortar side */, nonmortarside, 
-           masterNodeGIDs, mfile);
+           masterNodeGIDs, masterSegments[pair], mfile);
 
       interface_ctr++;
 
   }
 
+  // Default search distance: the longest contact segment
+  double longestSegment = 0.0;
+  for(int pair = 0; pair < number_of_mortar_pairs; pair++){
+    for(const Segments* segments : {&slaveSegments[pair], &masterSegments[pair]}){
+      for(std::size_t seg = 0; seg < segments->size(); seg++){
+        const InterfaceNode& a = interfaceNodes.at((*segments)[seg].first);
+        const InterfaceNode& b = interfaceNodes.at((*segments)[seg].second);
+        longestSegment = std::max(longestSegment, std::hypot(b.X[0] - a.X[0], b.X[1] - a.X[1]));
+      }
+    }
+  }
+  searchDistance = paramList.get<double>("Search Distance", longestSegment);
+
+  // The master segments each slave segment can come into contact with. The STK graph reserves the same pairs.
+  masterCandidates.resize(number_of_mortar_pairs);
+  for(int pair = 0; pair < number_of_mortar_pairs; pair++){
+    masterCandidates[pair].resize(slaveSegments[pair].size());
+    for(std::size_t sseg = 0; sseg < slaveSegments[pair].size(); sseg++){
+      const InterfaceNode& a = interfaceNodes.at(slaveSegments[pair][sseg].first);
+      const InterfaceNode& b = interfaceNodes.at(slaveSegments[pair][sseg].second);
+      for(std::size_t mseg = 0; mseg < masterSegments[pair].size(); mseg++){
+        const InterfaceNode& c = interfaceNodes.at(masterSegments[pair][mseg].first);
+        const InterfaceNode& d = interfaceNodes.at(masterSegments[pair][mseg].second);
+        if(withinSearchDistance(a.X, b.X, c.X, d.X, searchDistance))
+          masterCandidates[pair][sseg].push_back(mseg);
+      }
+    }
+  }
+  activeSetTime = 0.0;
+
   // ============================================================= //
   // choose integration parameters
   // ============================================================= //
@@ -152,7 +272,7 @@ Albany::ContactManager::ContactManager(const Teuchos::RCP<Teuchos::ParameterList
 // Process all the contact surfaces and insert the data into a Moertel Interface
 void
 Albany::ContactManager::processSS(const int ctr, const std::string& sideSetName, int s_or_mortar, 
-         int mortarside, WorksetContactNodes& nodeGIDs, std::ofstream& stream ){
+         int mortarside, WorksetContactNodes& nodeGIDs, Segments& segments, std::ofstream& stream ){
 
   // one interface per side set name
   Teuchos::RCP<MoertelT::InterfaceT<ST, LO, Tpetra_GO, KokkosNode> > moertelInterface
@@ -219,8 +339,9 @@ Albany::ContactManager::processSS(const int ctr, const std::string& sideSetName,
 
         for (int i = 0; i < numSideNodes; ++i) {
           std::size_t node = subcell_side.node[i];
-          LO lnodeId = disc.getMapT()->getLocalElement(elNodeID[node]);
-          GO gnodeId = disc.getMapT()->getGlobalElement(elNodeID[node]);
+          // coordinates are stored by overlap node, the equation IDs are overlap DOF LIDs
+          GO gnodeId = elNodeID[node];
+          LO lnodeId = disc.getOverlapNodeMapT()->getLocalElement(gnodeId);
           nodev[i] = gnodeId;
           double *coords = &coordArray[3 * lnodeId]; // location of the first coordinate
 //          const double coords[] = { coordArray[3 * lnodeId],
@@ -243,11 +364,17 @@ Albany::ContactManager::processSS(const int ctr, const std::string& sideSetName,
 
             for (std::size_t eq = 0; eq < numFields; eq++) {
 
-              int global_eq_id = elNodeEqID(elem_LID, node, eq);
+              int global_eq_id = disc.getOverlapMapT()->getGlobalElement(elNodeEqID(elem_LID, node, eq));
               list_of_dofgid.push_back(global_eq_id);
 
             }
 
+            InterfaceNode& inode = interfaceNodes[gnodeId];
+            for (int dim = 0; dim < 3; dim++) {
+              inode.X[dim] = coords[dim];
+              inode.dofs[dim] = dim < probDim ? list_of_dofgid[dim] : -1;
+            }
+
             MOERTEL::Node moertel_node(gnodeId,
                                        coords, 
                                        list_of_dofgid.size(),
@@ -264,6 +391,7 @@ Albany::ContactManager::processSS(const int ctr, const std::string& sideSetName,
 
   // 2D
         MOERTEL::Segment_Linear1D segment( side_GID, nodev, printLevel );
+        segments.push_back(std::make_pair(GO(nodev[0]), GO(nodev[1])));
 //  	  MOERTEL::Segment_BiLinearQuad segment( side_GID, nnodes, nodeid, printLevel ); // 3D
   	  moertelInterface->AddSegment(segment, s_or_mortar);
 
@@ -281,10 +409,283 @@ Albany::ContactManager::processSS(const int ctr, const std::string& sideSetName,
 
 // Fill in residual from M&D
 void
-Albany::ContactManager::fillInMortarResidual(const int ws,  Teuchos::ArrayRCP<ST>& resid){
+Albany::ContactManager::fillInMortarResidual(const int ws,  Teuchos::ArrayRCP<ST>& resid) const {
 
 //  Teuchos::Array<GO> masterNodeGIDs& = contactManager->masterNodeGIDs[ws];
 //  Teuchos::Array<GO> slaveNodeGIDs& = contactManager->slaveNodeGIDs[ws];
 
 }
 
+bool
+Albany::ContactManager::withinSearchDistance(const double* a, const double* b, const double* c, const double* d,
+    const double distance) {
+
+  // Crossing segments touch
+  if(orientation(a, b, c) * orientation(a, b, d) < 0.0 && orientation(c, d, a) * orientation(c, d, b) < 0.0)
+    return true;
+
+  return std::min(std::min(pointSegmentDistance(a, c, d), pointSegmentDistance(b, c, d)),
+                  std::min(pointSegmentDistance(c, a, b), pointSegmentDistance(d, a, b))) <= distance;
+}
+
+bool
+Albany::ContactManager::haveActiveSet(const Tpetra_Vector& xT, const double time) const {
+
+  if(Teuchos::is_null(activeSetX) || time != activeSetTime || !xT.getMap()->isSameAs(*activeSetX->getMap()))
+    return false;
+
+  Teuchos::ArrayRCP<const ST> x = xT.get1dView();
+  Teuchos::ArrayRCP<const ST> x_last = activeSetX->get1dView();
+  return std::equal(x.begin(), x.end(), x_last.begin());
+}
+
+// Semi-smooth Newton step on the contact conditions, see the class documentation
+void
+Albany::ContactManager::applyContactConstraints(const Tpetra_Vector& xT, const double time, Tpetra_Vector& fT,
+    const Teuchos::RCP<Tpetra_CrsMatrix>& jacT, const double beta) const {
+
+  if(!have_contact) return;
+
+  computeActiveSet(xT, fT);
+
+  if(Teuchos::is_null(activeSetX) || !activeSetX->getMap()->isSameAs(*xT.getMap()))
+    activeSetX = Teuchos::rcp(new Tpetra_Vector(xT.getMap()));
+  activeSetX->assign(xT);
+  activeSetTime = time;
+
+  const Teuchos::RCP<const Tpetra_Map> mapT = fT.getMap();
+  Teuchos::ArrayRCP<ST> f = fT.get1dViewNonConst();
+
+  // Residual: transfer the pressure of the active nodes to the master nodes, and replace the normal
+  // equation of an active node by its gap
+  for(std::size_t j = 0; j < activeSet.size(); j++){
+    const ActiveNode& an = activeSet[j];
+    const double nr = an.n[0] * an.r[0] + an.n[1] * an.r[1];
+    for(auto m = an.M.begin(); m != an.M.end(); ++m){
+      const InterfaceNode& master = interfaceNodes.at(m->first);
+      for(int dim = 0; dim < 2; dim++)
+        f[mapT->getLocalElement(master.dofs[dim])] += m->second / an.D * nr * an.n[dim];
+    }
+  }
+  for(std::size_t j = 0; j < activeSet.size(); j++){
+    const ActiveNode& an = activeSet[j];
+    const InterfaceNode& slave = interfaceNodes.at(an.gid);
+    f[mapT->getLocalElement(slave.dofs[0])] = an.n[1] * an.r[0] - an.n[0] * an.r[1];
+    f[mapT->getLocalElement(slave.dofs[1])] = complementarityParam * an.gap;
+  }
+
+  if(Teuchos::nonnull(jacT))
+    applyContactJacobian(jacT, beta);
+
+}
+
+// Mortar operators, weighted gaps and pressures at xT from the assembled residual fT, and the active set
+void
+Albany::ContactManager::computeActiveSet(const Tpetra_Vector& xT, const Tpetra_Vector& fT) const {
+
+  ALBANY_ASSERT(xT.getMap()->getComm()->getSize() == 1, "Mortar contact is implemented in serial only");
+
+  const Teuchos::RCP<const Tpetra_Map> mapT = xT.getMap();
+  Teuchos::ArrayRCP<const ST> x = xT.get1dView();
+  Teuchos::ArrayRCP<const ST> f = fT.get1dView();
+
+  // Current positions of the interface nodes
+  std::map<GO, Vec2> pos;
+  for(auto it = interfaceNodes.begin(); it != interfaceNodes.end(); ++it){
+    Vec2& xn = pos[it->first];
+    for(int dim = 0; dim < 2; dim++)
+      xn[dim] = it->second.X[dim] + x[mapT->getLocalElement(it->second.dofs[dim])];
+  }
+
+  activeSet.clear();
+
+  double minGap = 0.0, minPressure = 0.0, maxPressure = 0.0;
+  bool haveOverlap = false;
+
+  for(int pair = 0; pair < slaveSegments.size(); pair++){
+
+    std::map<GO, MortarNode> mortar;
+
+    // Nodal normals, averaged over the segments weighted by their length. The sides of a 2D element
+    // run counterclockwise, so (t_y, -t_x) points out of the body.
+    for(std::size_t seg = 0; seg < slaveSegments[pair].size(); seg++){
+      const GO a = slaveSegments[pair][seg].first;
+      const GO b = slaveSegments[pair][seg].second;
+      const Vec2 t = {{pos[b][0] - pos[a][0], pos[b][1] - pos[a][1]}};
+      const double length = std::sqrt(dot(t, t));
+      for(const GO node : {a, b}){
+        mortar[node].n[0] += t[1];
+        mortar[node].n[1] -= t[0];
+        mortar[node].length += 0.5 * length;
+      }
+    }
+    for(auto it = mortar.begin(); it != mortar.end(); ++it){
+      const double norm = std::sqrt(dot(it->second.n, it->second.n));
+      if(norm > 0.0){
+        it->second.n[0] /= norm;
+        it->second.n[1] /= norm;
+      }
+    }
+
+    // D and M: integrals of the dual shape functions of the slave segment times the shape functions of the
+    // master segments projected onto it
+    for(std::size_t sseg = 0; sseg < slaveSegments[pair].size(); sseg++){
+      const GO a = slaveSegments[pair][sseg].first;
+      const GO b = slaveSegments[pair][sseg].second;
+      const Vec2& xa = pos[a];
+      const Vec2& xb = pos[b];
+      const Vec2 t = {{xb[0] - xa[0], xb[1] - xa[1]}};
+      const Vec2 mid = {{0.5 * (xa[0] + xb[0]), 0.5 * (xa[1] + xb[1])}};
+      const double length2 = dot(t, t);
+      if(length2 <= 0.0) continue;
+      const double length = std::sqrt(length2);
+      const Vec2 ns = {{t[1] / length, -t[0] / length}};
+
+      const Teuchos::Array<int>& candidates = masterCandidates[pair][sseg];
+      for(int cand = 0; cand < candidates.size(); cand++){
+        const GO c = masterSegments[pair][candidates[cand]].first;
+        const GO d = masterSegments[pair][candidates[cand]].second;
+        const Vec2& xc = pos[c];
+        const Vec2& xd = pos[d];
+
+        // Only surfaces that face each other
+        const Vec2 tm = {{xd[0] - xc[0], xd[1] - xc[1]}};
+        if(ns[0] * tm[1] - ns[1] * tm[0] >= 0.0) continue;
+
+        // Parametric coordinates on the slave segment of the projections of the master nodes
+        const double xi_c = 2.0 * ((xc[0] - mid[0]) * t[0] + (xc[1] - mid[1]) * t[1]) / length2;
+        const double xi_d = 2.0 * ((xd[0] - mid[0]) * t[0] + (xd[1] - mid[1]) * t[1]) / length2;
+        if(std::abs(xi_d - xi_c) < 1.0e-12) continue;
+        const double xi_lo = std::max(-1.0, std::min(xi_c, xi_d));
+        const double xi_hi = std::min(1.0, std::max(xi_c, xi_d));
+        if(xi_hi - xi_lo < 1.0e-12) continue;
+
+        auto master_eta = [&](const double xi) { return -1.0 + 2.0 * (xi - xi_c) / (xi_d - xi_c); };
+        auto normal_distance = [&](const double xi) {
+          const double eta = master_eta(xi);
+          const Vec2 xs = {{mid[0] + 0.5 * xi * t[0], mid[1] + 0.5 * xi * t[1]}};
+          const Vec2 xm = {{0.5 * (1.0 - eta) * xc[0] + 0.5 * (1.0 + eta) * xd[0] - xs[0],
+                            0.5 * (1.0 - eta) * xc[1] + 0.5 * (1.0 + eta) * xd[1] - xs[1]}};
+          return std::abs(dot(ns, xm));
+        };
+        if(std::min(normal_distance(xi_lo), normal_distance(xi_hi)) > searchDistance) continue;
+
+        MortarNode& node_a = mortar[a];
+        MortarNode& node_b = mortar[b];
+        for(int gp = 0; gp < numGaussPoints; gp++){
+          const double xi = 0.5 * (xi_lo + xi_hi) + 0.5 * (xi_hi - xi_lo) * gaussPoints[gp];
+          const double w = gaussWeights[gp] * 0.5 * (xi_hi - xi_lo) * 0.5 * length;
+          const double eta = master_eta(xi);
+          const double phi_a = 0.5 * (1.0 - 3.0 * xi);
+          const double phi_b = 0.5 * (1.0 + 3.0 * xi);
+          const double N_c = 0.5 * (1.0 - eta);
+          const double N_d = 0.5 * (1.0 + eta);
+          node_a.M[c] += phi_a * N_c * w;
+          node_a.M[d] += phi_a * N_d * w;
+          node_b.M[c] += phi_b * N_c * w;
+          node_b.M[d] += phi_b * N_d * w;
+        }
+      }
+    }
+
+    // Weighted gaps, pressures and the active set. The master shape functions sum to one, so
+    // D_jj = sum_k M_jk is the integral of the dual function over the overlap.
+    for(auto it = mortar.begin(); it != mortar.end(); ++it){
+      MortarNode& node = it->second;
+      for(auto m = node.M.begin(); m != node.M.end(); ++m)
+        node.D += m->second;
+      if(node.D <= minOverlapFraction * node.length) continue;
+
+      const InterfaceNode& inode = interfaceNodes.at(it->first);
+      const Vec2& xj = pos[it->first];
+      Vec2 gap_vector = {{-node.D * xj[0], -node.D * xj[1]}};
+      for(auto m = node.M.begin(); m != node.M.end(); ++m){
+        gap_vector[0] += m->second * pos[m->first][0];
+        gap_vector[1] += m->second * pos[m->first][1];
+      }
+      const double gap = dot(node.n, gap_vector);
+      const Vec2 r = {{f[mapT->getLocalElement(inode.dofs[0])], f[mapT->getLocalElement(inode.dofs[1])]}};
+      const double pressure = -dot(node.n, r) / node.D;
+
+      minGap = haveOverlap ? std::min(minGap, gap / node.D) : gap / node.D;
+      haveOverlap = true;
+
+      if(pressure - complementarityParam * gap > 0.0){
+        ActiveNode an;
+        an.gid = it->first;
+        an.n[0] = node.n[0];
+        an.n[1] = node.n[1];
+        an.D = node.D;
+        an.gap = gap;
+        an.M = node.M;
+        an.r[0] = r[0];
+        an.r[1] = r[1];
+        minPressure = activeSet.empty() ? pressure : std::min(minPressure, pressure);
+        maxPressure = activeSet.empty() ? pressure : std::max(maxPressure, pressure);
+        activeSet.push_back(an);
+      }
+    }
+  }
+
+  // Contact state, one line per residual, on request
+  if(printState){
+    std::ostringstream state;
+    state.precision(12);
+    state << "Contact: " << activeSet.size() << " active slave nodes";
+    if(!activeSet.empty())
+      state << ", pressure " << minPressure << " to " << maxPressure;
+    if(haveOverlap)
+      state << ", smallest normal gap " << minGap;
+    *out << state.str() << std::endl;
+  }
+
+}
+
+// Jacobian, the same row operations as on the residual. The normal and the mortar operators are held fixed.
+void
+Albany::ContactManager::applyContactJacobian(const Teuchos::RCP<Tpetra_CrsMatrix>& jacT, const double beta) const {
+
+  if(!have_contact) return;
+
+  const std::vector<ActiveNode>& active = activeSet;
+
+  std::vector<SparseRow> normalRows(active.size());
+  std::vector<SparseRow> tangentRows(active.size());
+  for(std::size_t j = 0; j < active.size(); j++){
+    const ActiveNode& an = active[j];
+    const InterfaceNode& slave = interfaceNodes.at(an.gid);
+    for(int dim = 0; dim < 2; dim++)
+      getRow(*jacT, slave.dofs[dim], an.n[dim], normalRows[j]);
+    getRow(*jacT, slave.dofs[0], an.n[1], tangentRows[j]);
+    getRow(*jacT, slave.dofs[1], -an.n[0], tangentRows[j]);
+  }
+
+  for(std::size_t j = 0; j < active.size(); j++){
+    const ActiveNode& an = active[j];
+    for(auto m = an.M.begin(); m != an.M.end(); ++m){
+      const InterfaceNode& master = interfaceNodes.at(m->first);
+      for(int dim = 0; dim < 2; dim++)
+        sumIntoRow(*jacT, master.dofs[dim], m->second / an.D * an.n[dim], normalRows[j]);
+    }
+  }
+
+  for(std::size_t j = 0; j < active.size(); j++){
+    const ActiveNode& an = active[j];
+    const InterfaceNode& slave = interfaceNodes.at(an.gid);
+
+    zeroRow(*jacT, slave.dofs[0]);
+    sumIntoRow(*jacT, slave.dofs[0], 1.0, tangentRows[j]);
+
+    SparseRow gapRow;
+    for(int dim = 0; dim < 2; dim++){
+      gapRow[slave.dofs[dim]] -= an.D * an.n[dim];
+      for(auto m = an.M.begin(); m != an.M.end(); ++m)
+        gapRow[interfaceNodes.at(m->first).dofs[dim]] += m->second * an.n[dim];
+    }
+    zeroRow(*jacT, slave.dofs[1]);
+    sumIntoRow(*jacT, slave.dofs[1], beta * complementarityParam, gapRow);
+  }
+
+}
+
+
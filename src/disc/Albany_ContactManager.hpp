@@ -8,6 +8,7 @@
 #define ALBANY_CONTACT_MANAGER_HPP
 
 #include "Teuchos_RCP.hpp"
+#include "Teuchos_VerboseObject.hpp"
 #include "Albany_DataTypes.hpp"
 #include "Albany_AbstractDiscretization.hpp"
 #include "Phalanx_DataLayout.hpp"
@@ -17,6 +18,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <utility>
+#include <vector>
 
 
 /** \brief This class implements the Mortar contact algorithm. Here is the overall sketch of how things work:
@@ -46,7 +50,43 @@
 
     4. Go back to 2 until convergence of the nonlinear inequality constrained problem is achieved.
 
+   What is implemented: frictionless contact in 2D, serial, with a primal-dual active set (semi-smooth Newton)
+   treatment of the gap inequality. Moertel holds the interface definition. The mortar operators D and M are
+   recomputed in the current configuration every time the application assembles the residual or the Jacobian, with
+   dual Lagrange multiplier shape functions on the slave side, so that D is diagonal and the contact pressure of each
+   slave node follows from its own equations:
 
+      p_j = - n_j . r_j / D_jj
+
+   The contact conditions p_j >= 0, g_j >= 0, p_j g_j = 0 on the weighted gap
+
+      g_j = n_j . ( sum_k M_jk x_k - D_jj x_j )
+
+   are written as the complementarity function C_j = p_j - max(0, p_j - c g_j). Each Newton iteration a slave node
+   is active if p_j - c g_j > 0. The equations of the assembled system are then condensed: the pressure of the active
+   nodes is transferred to the master nodes through M / D, and the normal equation of an active slave node is
+   replaced by c g_j = 0. The active set settles in a few iterations, after which the iteration is a Newton method on
+   the constrained problem. The dependence of n, D and M on the displacement is not linearized.
+
+   The active set, n, D and M are kept from the last residual. A Jacobian assembled without its residual at the same
+   solution and time reuses them (see haveActiveSet), so the residual is not assembled again for the Jacobian.
+
+   Each slave segment is only paired with the master segments within the search distance of it in the reference
+   configuration. The STK discretization reserves the matrix graph of the same pairs (see withinSearchDistance), so
+   the search distance also bounds how far the surfaces can slide along each other.
+
+   Parameters, in the "Contact" sublist of the discretization:
+
+      "Complementarity Parameter"  c above, which also scales the gap equations. Of the order of the elastic
+                                   modulus. Default 1.0.
+      "Search Distance"            master segments farther than this from a slave segment are not paired with it,
+                                   in the reference configuration and in the current one. Default the length of
+                                   the longest contact segment in the reference configuration.
+      "Print Contact State"        print the number of active slave nodes, their pressure range and the smallest
+                                   normal gap after each residual, on the output stream of the application.
+                                   Default false.
+
+   The displacement is taken to be the first numDim equations of each node.
 */
 
 
@@ -67,7 +107,29 @@ class ContactManager {
     //! Destructor
     virtual ~ContactManager() {}
 
-    void fillInMortarResidual(const int, Teuchos::ArrayRCP<ST>&);
+    //! Is contact specified in the discretization parameters?
+    bool haveContact() const { return have_contact; }
+
+    //! Workset contribution to the residual. The contact conditions are imposed on the assembled system by
+    //! applyContactConstraints, so there is nothing to add per workset.
+    void fillInMortarResidual(const int, Teuchos::ArrayRCP<ST>&) const;
+
+    //! Impose the contact conditions on the assembled residual fT at xT and time and, if not null, on its Jacobian
+    //! jacT, whose fill must be active and whose derivatives with respect to xT are scaled by beta.
+    void applyContactConstraints(const Tpetra_Vector& xT, const double time, Tpetra_Vector& fT,
+         const Teuchos::RCP<Tpetra_CrsMatrix>& jacT, const double beta) const;
+
+    //! Was the last residual assembled at xT and time? Its active set then serves a Jacobian at the same point.
+    bool haveActiveSet(const Tpetra_Vector& xT, const double time) const;
+
+    //! Impose the contact conditions on the Jacobian jacT alone, with the active set of the last residual, which
+    //! must have been assembled at the same point (see haveActiveSet).
+    void applyContactJacobian(const Teuchos::RCP<Tpetra_CrsMatrix>& jacT, const double beta) const;
+
+    //! Can the 2D segments (a, b) and (c, d) come into contact, that is, are they within distance of each other?
+    //! Pairs the segments in the reference configuration here and in the graph of the STK discretization.
+    static bool withinSearchDistance(const double* a, const double* b, const double* c, const double* d,
+         const double distance);
 
   private:
 
@@ -78,8 +140,42 @@ class ContactManager {
     WorksetContactNodes masterNodeGIDs;
     WorksetContactNodes slaveNodeGIDs;
 
+    //! Reference coordinates and displacement DOF GIDs of a node on a contact surface
+    struct InterfaceNode {
+      double X[3];
+      Tpetra_GO dofs[3];
+    };
+
+    //! Segments of a contact surface as pairs of node GIDs, in the order of the element boundary
+    typedef Teuchos::Array<std::pair<GO, GO> > Segments;
+
+    std::map<GO, InterfaceNode> interfaceNodes;
+    Teuchos::Array<Segments> masterSegments; // one per contact pair
+    Teuchos::Array<Segments> slaveSegments;
+
+    //! Per contact pair and slave segment, the master segments within the search distance in the reference
+    //! configuration
+    Teuchos::Array<Teuchos::Array<Teuchos::Array<int> > > masterCandidates;
+
+    //! Active slave node: normal, mortar operators, weighted gap and the unmodified residual at its DOFs
+    struct ActiveNode {
+      GO gid;
+      double n[2];
+      double D;
+      double gap;
+      std::map<GO, double> M;
+      double r[2];
+    };
+
+    //! Active set of the last residual, and the solution and time it was assembled at
+    mutable std::vector<ActiveNode> activeSet;
+    mutable Teuchos::RCP<Tpetra_Vector> activeSetX;
+    mutable double activeSetTime;
+
+    void computeActiveSet(const Tpetra_Vector& xT, const Tpetra_Vector& fT) const;
+
     void processSS(const int ctr, const std::string& sideSetName, int s_or_mortar,
-         int mortarside, WorksetContactNodes&, std::ofstream& stream );
+         int mortarside, WorksetContactNodes&, Segments&, std::ofstream& stream );
 
     Teuchos::RCP<Teuchos::ParameterList> params;
 
@@ -97,6 +193,13 @@ class ContactManager {
 
     int probDim;
 
+    double complementarityParam;
+    double searchDistance;
+
+    //! Print the contact state after each residual, on the default output stream of the application
+    bool printState;
+    Teuchos::RCP<Teuchos::FancyOStream> out;
+
 
     // Moertel-specific library data
     Teuchos::RCP<MoertelT::ManagerT<ST, LO, Tpetra_GO, KokkosNode> > moertelManager;
@@ -51,7 +51,8 @@ Albany::DiscretizationFactory::DiscretizationFactory(
         const Teuchos::RCP<const Teuchos_Comm>& commT_,
         const bool explicit_scheme_) :
 commT(commT_),
-explicit_scheme(explicit_scheme_) {
+explicit_scheme(explicit_scheme_),
+residual_only_scheme(false) {
 
     discParams = Teuchos::sublist(topLevelParams, "Discretization", true);
 
@@ -63,6 +64,11 @@ explicit_scheme(explicit_scheme_) {
 
         Teuchos::RCP<Teuchos::ParameterList> problemParams = Teuchos::sublist(topLevelParams, "Problem", true);
 
+        // Albany's central difference solver never forms a Jacobian
+        if (problemParams->isType<std::string>("Solution Method"))
+
+            residual_only_scheme = problemParams->get<std::string>("Solution Method") == "Transient Explicit";
+
         if (problemParams->isSublist("Adaptation"))
 
             adaptParams = Teuchos::sublist(problemParams, "Adaptation", true);
@@ -474,7 +480,7 @@ Albany::DiscretizationFactory::createDiscretizationFromInternalMeshStruct(
                     return Teuchos::rcp(new Albany::STKDiscretizationStokesH(discParams, ms, commT, rigidBodyModes));
                 else
 #endif
-                    return Teuchos::rcp(new Albany::STKDiscretization(discParams, ms, commT, rigidBodyModes, sideSetEquations));
+                    return Teuchos::rcp(new Albany::STKDiscretization(discParams, ms, commT, rigidBodyModes, sideSetEquations, residual_only_scheme));
             }
                 break;
 #endif
@@ -132,6 +132,10 @@ class DiscretizationFactory {
     //Flag for explicit time-integration scheme, used in Aeras
     bool explicit_scheme;
 
+    //Flag for schemes that only evaluate residuals ("Transient Explicit"), for
+    //which the STK graphs only reserve the diagonal
+    bool residual_only_scheme;
+
     Teuchos::RCP<Albany::AbstractMeshStruct> meshStruct;
 
 };
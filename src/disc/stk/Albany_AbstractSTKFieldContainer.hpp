@@ -132,6 +132,7 @@ class AbstractSTKFieldContainer : public AbstractFieldContainer {
                             const Teuchos::RCP<const Epetra_Map>& field_node_map, const NodalDOFManager& nodalDofManager) = 0;
     virtual void saveSolnVector(const Epetra_Vector& soln, stk::mesh::Selector& sel, const Teuchos::RCP<const Epetra_Map>& node_map) = 0;
     virtual void saveResVector(const Epetra_Vector& res, stk::mesh::Selector& sel, const Teuchos::RCP<const Epetra_Map>& node_map) = 0;
+    virtual void fillResVector(Epetra_Vector& res, stk::mesh::Selector& sel, const Teuchos::RCP<const Epetra_Map>& node_map) = 0;
 #endif
     //Tpetra version of above
     virtual void fillVectorT(Tpetra_Vector& field_vector, const std::string&  field_name, stk::mesh::Selector& field_selection,
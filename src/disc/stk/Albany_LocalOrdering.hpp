@@ -0,0 +1,144 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+#ifndef ALBANY_LOCALORDERING_HPP
+#define ALBANY_LOCALORDERING_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace Albany {
+
+/*!
+ * \brief Locality improving orderings of mesh entities on one process
+ *
+ * Graphs are given in compressed row form: the neighbors of vertex i are
+ * adj[offsets[i]] ... adj[offsets[i+1]-1].
+ */
+
+//! Largest |i - j| over the edges of the graph, with vertex i at position
+//! rank[i] (identity if rank is empty)
+inline int
+graphBandwidth(
+    const std::vector<int>& offsets,
+    const std::vector<int>& adj,
+    const std::vector<int>& rank = std::vector<int>())
+{
+  int       bw = 0;
+  const int n  = offsets.size() - 1;
+  for (int i = 0; i < n; ++i) {
+    const int ri = rank.empty() ? i : rank[i];
+    for (int k = offsets[i]; k < offsets[i + 1]; ++k) {
+      const int rj = rank.empty() ? adj[k] : rank[adj[k]];
+      bw = std::max(bw, std::abs(ri - rj));
+    }
+  }
+  return bw;
+}
+
+/*!
+ * \brief Reverse Cuthill-McKee ordering
+ *
+ * Returns the vertices in their new order. Each connected component is
+ * started from a pseudo-peripheral vertex found by repeated breadth first
+ * searches, and neighbors are visited by increasing degree.
+ */
+inline std::vector<int>
+reverseCuthillMcKee(const std::vector<int>& offsets, const std::vector<int>& adj)
+{
+  const int n = offsets.size() - 1;
+  std::vector<int>  order;
+  std::vector<int>  level(n, -1);
+  std::vector<char> visited(n, 0);
+  std::vector<int>  next;
+  order.reserve(n);
+
+  auto degree = [&](int i) { return offsets[i + 1] - offsets[i]; };
+
+  // Last vertex, of smallest degree, of a breadth first search from root.
+  // level is used as scratch and reset afterwards.
+  auto farthest = [&](int root, int& depth) {
+    std::vector<int> queue(1, root);
+    level[root] = 0;
+    for (std::size_t q = 0; q < queue.size(); ++q) {
+      const int v = queue[q];
+      for (int k = offsets[v]; k < offsets[v + 1]; ++k) {
+        const int w = adj[k];
+        if (level[w] >= 0) continue;
+        level[w] = level[v] + 1;
+        queue.push_back(w);
+      }
+    }
+    depth = level[queue.back()];
+    int best = queue.back();
+    for (const int v : queue)
+      if (level[v] == depth && degree(v) < degree(best)) best = v;
+    for (const int v : queue) level[v] = -1;
+    return best;
+  };
+
+  for (int start = 0; start < n; ++start) {
+    if (visited[start]) continue;
+
+    // Pseudo-peripheral root of this component
+    int root = start, depth = -1, new_depth = 0;
+    for (int it = 0; it < 8; ++it) {
+      const int candidate = farthest(root, new_depth);
+      if (new_depth <= depth) break;
+      depth = new_depth;
+      root  = candidate;
+    }
+
+    const std::size_t first = order.size();
+    order.push_back(root);
+    visited[root] = 1;
+    for (std::size_t q = first; q < order.size(); ++q) {
+      const int v = order[q];
+      next.clear();
+      for (int k = offsets[v]; k < offsets[v + 1]; ++k)
+        if (!visited[adj[k]]) {
+          visited[adj[k]] = 1;
+          next.push_back(adj[k]);
+        }
+      std::sort(next.begin(), next.end(), [&](int a, int b) {
+        return degree(a) < degree(b) || (degree(a) == degree(b) && a < b);
+      });
+      order.insert(order.end(), next.begin(), next.end());
+    }
+  }
+
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+/*!
+ * \brief Position of a point along a Morton (Z order) space filling curve
+ *
+ * x is scaled into the box [lo, hi] and quantized to 21 bits per
+ * coordinate. Points close on the curve are close in space.
+ */
+inline std::uint64_t
+mortonKey(const double* x, const double* lo, const double* hi, const int numDim)
+{
+  const std::uint64_t cells = (std::uint64_t(1) << 21) - 1;
+  std::uint64_t       key   = 0;
+  std::uint64_t       q[3]  = {0, 0, 0};
+  for (int d = 0; d < numDim && d < 3; ++d) {
+    const double extent = hi[d] - lo[d];
+    double       s      = extent > 0.0 ? (x[d] - lo[d]) / extent : 0.0;
+    s    = std::min(std::max(s, 0.0), 1.0);
+    q[d] = static_cast<std::uint64_t>(s * cells);
+  }
+  for (int bit = 20; bit >= 0; --bit)
+    for (int d = 0; d < 3; ++d) key = (key << 1) | ((q[d] >> bit) & 1);
+  return key;
+}
+
+}  // namespace Albany
+
+#endif  // ALBANY_LOCALORDERING_HPP
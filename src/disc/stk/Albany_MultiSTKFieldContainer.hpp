@@ -58,6 +58,7 @@ class MultiSTKFieldContainer : public GenericSTKFieldContainer<Interleaved> {
 
 #if defined(ALBANY_EPETRA)
     void saveResVector(const Epetra_Vector& res, stk::mesh::Selector& sel, const Teuchos::RCP<const Epetra_Map>& node_map);
+    void fillResVector(Epetra_Vector& res, stk::mesh::Selector& sel, const Teuchos::RCP<const Epetra_Map>& node_map);
 #endif
     void saveResVectorT(const Tpetra_Vector& res, stk::mesh::Selector& sel, const Teuchos::RCP<const Tpetra_Map>& node_map);
 
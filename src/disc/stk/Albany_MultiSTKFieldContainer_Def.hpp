@@ -799,6 +799,48 @@ void Albany::MultiSTKFieldContainer<Interleaved>::saveResVector(const Epetra_Vec
   }
 }
 
+template<bool Interleaved>
+void Albany::MultiSTKFieldContainer<Interleaved>::fillResVector(Epetra_Vector& res,
+    stk::mesh::Selector& sel, const Teuchos::RCP<const Epetra_Map>& node_map) {
+
+  typedef typename AbstractSTKFieldContainer::VectorFieldType VFT;
+  typedef typename AbstractSTKFieldContainer::ScalarFieldType SFT;
+
+  // Iterate over the on-processor nodes by getting node buckets and iterating over each bucket.
+  stk::mesh::BucketVector const& all_elements = this->bulkData->get_buckets(stk::topology::NODE_RANK, sel);
+  this->numNodes = node_map->NumMyElements(); // Needed for the getDOF function to work correctly
+  // This is either numOwnedNodes or numOverlapNodes, depending on
+  // which map is passed in
+
+  for(stk::mesh::BucketVector::const_iterator it = all_elements.begin() ; it != all_elements.end() ; ++it) {
+
+    const stk::mesh::Bucket& bucket = **it;
+
+    int offset = 0;
+
+    for(int k = 0; k < res_index.size(); k++) {
+
+      if(res_index[k] == 1) { // Scalar
+
+        SFT* field = this->metaData->template get_field<SFT>(stk::topology::NODE_RANK, res_vector_name[k]);
+        this->fillVectorHelper(res, field, node_map, bucket, offset);
+
+      }
+
+      else {
+
+        VFT* field = this->metaData->template get_field<VFT>(stk::topology::NODE_RANK, res_vector_name[k]);
+        this->fillVectorHelper(res, field, node_map, bucket, offset);
+
+      }
+
+      offset += res_index[k];
+
+    }
+
+  }
+}
+
 #endif
 
 template<bool Interleaved>
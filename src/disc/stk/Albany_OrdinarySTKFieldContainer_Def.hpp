@@ -500,6 +500,29 @@ void Albany::OrdinarySTKFieldContainer<Interleaved>::saveResVector(const Epetra_
   }
 
 }
+
+template<bool Interleaved>
+void Albany::OrdinarySTKFieldContainer<Interleaved>::fillResVector(Epetra_Vector& res,
+    stk::mesh::Selector& sel, const Teuchos::RCP<const Epetra_Map>& node_map) {
+
+  typedef typename AbstractSTKFieldContainer::VectorFieldType VFT;
+
+  // Iterate over the on-processor nodes by getting node buckets and iterating over each bucket.
+  stk::mesh::BucketVector const& all_elements = this->bulkData->get_buckets(stk::topology::NODE_RANK, sel);
+  this->numNodes = node_map->NumMyElements(); // Needed for the getDOF function to work correctly
+  // This is either numOwnedNodes or numOverlapNodes, depending on
+  // which map is passed in
+
+  for(stk::mesh::BucketVector::const_iterator it = all_elements.begin() ; it != all_elements.end() ; ++it) {
+
+    const stk::mesh::Bucket& bucket = **it;
+
+    this->fillVectorHelper(res, residual_field, node_map, bucket, 0);
+
+  }
+
+}
+
 #endif
 
 template<bool Interleaved>
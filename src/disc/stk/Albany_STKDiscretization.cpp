@@ -6,7 +6,10 @@
 
 #include <limits>
 
+#include <Teuchos_TimeMonitor.hpp>
+
 #include "Albany_BucketArray.hpp"
+#include "Albany_LocalOrdering.hpp"
 #include "Albany_NodalGraphUtils.hpp"
 #include "Albany_STKDiscretization.hpp"
 #include "Albany_STKNodeFieldContainer.hpp"
@@ -29,6 +32,8 @@
 #include <stk_util/parallel/Parallel.hpp>
 
 #include <stk_mesh/base/Entity.hpp>
+#include <stk_mesh/base/EntityLess.hpp>
+#include <stk_mesh/base/EntitySorterBase.hpp>
 #include <stk_mesh/base/GetBuckets.hpp>
 #include <stk_mesh/base/GetEntities.hpp>
 #include <stk_mesh/base/Selector.hpp>
@@ -49,6 +54,7 @@ extern "C" {
 #endif
 
 #include <algorithm>
+#include <cmath>
 #if defined(ALBANY_EPETRA)
 #include "EpetraExt_MultiVectorOut.h"
 #include "Epetra_Export.h"
@@ -69,12 +75,82 @@ const Tpetra::global_size_t INVALID =
 // Uncomment the following line if you want debug output to be printed to screen
 // #define OUTPUT_TO_SCREEN
 
+namespace {
+
+// Orders the elements of each bucket by the position of their centroid
+// along a Morton curve through the bounding box of the bucket, so that
+// consecutive elements of a workset share nodes. Other entity ranks keep
+// the default order by identifier.
+class SpaceFillingCurveSorter : public stk::mesh::EntitySorterBase
+{
+ public:
+  SpaceFillingCurveSorter(
+      Albany::AbstractSTKFieldContainer::VectorFieldType const& coordinates,
+      int const                                                 numDim)
+      : coordinates_(coordinates), numDim_(numDim)
+  {
+  }
+
+  virtual void
+  sort(stk::mesh::BulkData& bulk, stk::mesh::EntityVector& entities) const
+  {
+    if (entities.empty() ||
+        bulk.entity_rank(entities[0]) != stk::topology::ELEMENT_RANK) {
+      std::sort(entities.begin(), entities.end(), stk::mesh::EntityLess(bulk));
+      return;
+    }
+
+    double const big = std::numeric_limits<double>::max();
+    std::size_t const n = entities.size();
+    std::vector<double> centroids(3 * n, 0.0);
+    double lo[3] = {big, big, big};
+    double hi[3] = {-big, -big, -big};
+
+    for (std::size_t i = 0; i < n; ++i) {
+      stk::mesh::Entity const* nodes = bulk.begin_nodes(entities[i]);
+      int const num_nodes = bulk.num_nodes(entities[i]);
+      double* c = &centroids[3 * i];
+      for (int k = 0; k < num_nodes; ++k) {
+        double const* x = stk::mesh::field_data(coordinates_, nodes[k]);
+        for (int d = 0; d < numDim_; ++d) c[d] += x[d] / num_nodes;
+      }
+      for (int d = 0; d < numDim_; ++d) {
+        lo[d] = std::min(lo[d], c[d]);
+        hi[d] = std::max(hi[d], c[d]);
+      }
+    }
+
+    std::vector<std::pair<std::uint64_t, stk::mesh::EntityId>> keys(n);
+    std::vector<std::size_t> order(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      keys[i] = std::make_pair(
+          Albany::mortonKey(&centroids[3 * i], lo, hi, numDim_),
+          bulk.identifier(entities[i]));
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+      return keys[a] < keys[b];
+    });
+
+    stk::mesh::EntityVector sorted(n);
+    for (std::size_t i = 0; i < n; ++i) sorted[i] = entities[order[i]];
+    entities.swap(sorted);
+  }
+
+ private:
+  Albany::AbstractSTKFieldContainer::VectorFieldType const& coordinates_;
+  int const                                                 numDim_;
+};
+
+}  // namespace
+
 Albany::STKDiscretization::STKDiscretization(
     const Teuchos::RCP<Teuchos::ParameterList>&  discParams_,
     Teuchos::RCP<Albany::AbstractSTKMeshStruct>& stkMeshStruct_,
     const Teuchos::RCP<const Teuchos_Comm>&      commT_,
     const Teuchos::RCP<Albany::RigidBodyModes>&  rigidBodyModes_,
-    const std::map<int, std::vector<std::string>>& sideSetEquations_)
+    const std::map<int, std::vector<std::string>>& sideSetEquations_,
+    const bool                                     residual_only_scheme_)
     :
 
       out(Teuchos::VerboseObjectBase::getDefaultOStream()),
@@ -87,11 +163,27 @@ Albany::STKDiscretization::STKDiscretization(
       neq(stkMeshStruct_->neq),
       stkMeshStruct(stkMeshStruct_),
       sideSetEquations(sideSetEquations_),
-      interleavedOrdering(stkMeshStruct_->interleavedOrdering)
+      interleavedOrdering(stkMeshStruct_->interleavedOrdering),
+      elementOrdering(
+          discParams_->get<std::string>("Element Ordering", "Native")),
+      localDOFOrdering(
+          discParams_->get<std::string>("Local DOF Ordering", "Native")),
+      residual_only_scheme(residual_only_scheme_)
 {
 #if defined(ALBANY_EPETRA)
   comm = Albany::createEpetraCommFromTeuchosComm(commT_);
 #endif
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      elementOrdering != "Native" && elementOrdering != "Space Filling Curve",
+      std::logic_error,
+      "STKDiscretization: unknown Element Ordering " << elementOrdering
+                                                      << std::endl);
+  TEUCHOS_TEST_FOR_EXCEPTION(
+      localDOFOrdering != "Native" &&
+          localDOFOrdering != "Reverse Cuthill-McKee",
+      std::logic_error,
+      "STKDiscretization: unknown Local DOF Ordering " << localDOFOrdering
+                                                        << std::endl);
   Albany::STKDiscretization::updateMesh();
 }
 
@@ -700,6 +792,13 @@ Albany::STKDiscretization::setupMLCoords()
       coordMV->replaceLocalValue(node_lid, j, X[j]);
   }
 
+  // Extruded meshes also export their columns, for MueLu line detection
+  const Teuchos::RCP<LayeredMeshNumbering<LO>> layeredMeshNumbering =
+      stkMeshStruct->layered_mesh_numbering;
+  if (!layeredMeshNumbering.is_null()) {
+    rigidBodyModes->setVerticalLines(layeredMeshNumbering->numLevels);
+  }
+
   rigidBodyModes->setCoordinatesAndNullspace(coordMV, mapT);
 
   // Some optional matrix-market output was tagged on here; keep that
@@ -910,6 +1009,9 @@ Albany::STKDiscretization::writeSolutionToFileT(
 {
 #ifdef ALBANY_SEACAS
 
+  // Defined again after an incremental mesh update
+  if (stkMeshStruct->exoOutput && mesh_data.is_null()) setupExodusOutput();
+
   if (stkMeshStruct->exoOutput && stkMeshStruct->transferSolutionToCoords) {
     Teuchos::RCP<AbstractSTKFieldContainer> container =
         stkMeshStruct->getFieldContainer();
@@ -986,6 +1088,9 @@ Albany::STKDiscretization::writeSolutionMVToFile(
 {
 #ifdef ALBANY_SEACAS
 
+  // Defined again after an incremental mesh update
+  if (stkMeshStruct->exoOutput && mesh_data.is_null()) setupExodusOutput();
+
   if (stkMeshStruct->exoOutput && stkMeshStruct->transferSolutionToCoords) {
     Teuchos::RCP<AbstractSTKFieldContainer> container =
         stkMeshStruct->getFieldContainer();
@@ -1236,6 +1341,35 @@ Albany::STKDiscretization::getSolutionFieldHistoryImpl(
   }
 }
 
+Teuchos::RCP<Epetra_MultiVector>
+Albany::STKDiscretization::getResidualFieldHistory(int minStep, int maxStep) const
+{
+  const int stepMax = std::min(this->getSolutionFieldHistoryDepth(), maxStep);
+  const int stepCount = stepMax - minStep;
+  const Teuchos::RCP<Epetra_MultiVector> result =
+      Teuchos::rcp(new Epetra_MultiVector(*map, std::max(stepCount, 1)));
+  for (int i = minStep; i < stepMax; ++i) {
+    stkMeshStruct->loadSolutionFieldHistory(i);
+    Epetra_Vector v(View, *result, i-minStep);
+    this->getResidualField(v);
+  }
+  return result;
+}
+
+void
+Albany::STKDiscretization::getResidualFieldHistory(
+    Epetra_MultiVector& result) const
+{
+  TEUCHOS_TEST_FOR_EXCEPT(!map->SameAs(result.Map()));
+  const int stepCount =
+      std::min(this->getSolutionFieldHistoryDepth(), result.NumVectors());
+  for (int i = 0; i < stepCount; ++i) {
+    stkMeshStruct->loadSolutionFieldHistory(i);
+    Epetra_Vector v(View, result, i);
+    this->getResidualField(v);
+  }
+}
+
 #endif
 
 #if defined(ALBANY_EPETRA)
@@ -1255,6 +1389,20 @@ Albany::STKDiscretization::getSolutionField(
 
   container->fillSolnVector(result, locally_owned, node_map);
 }
+
+void
+Albany::STKDiscretization::getResidualField(Epetra_Vector& result) const
+{
+  Teuchos::RCP<AbstractSTKFieldContainer> container =
+      stkMeshStruct->getFieldContainer();
+
+  TEUCHOS_TEST_FOR_EXCEPTION(!container->hasResidualField(), std::logic_error,
+      "Error: the mesh has no residual field, set 'Residual Vector Components'" << std::endl);
+
+  stk::mesh::Selector locally_owned = metaData.locally_owned_part();
+
+  container->fillResVector(result, locally_owned, node_map);
+}
 #endif
 
 void
@@ -1586,6 +1734,10 @@ Albany::STKDiscretization::computeNodalMaps(bool overlapped)
 
   GO maxID(0), maxGID(0);
   for (int i = 0; i < nodes.size(); i++) maxID = std::max(maxID, gid(nodes[i]));
+
+  // The same node order is used for every DOF struct, so that node and
+  // unknown maps of different parts remain compatible
+  const std::unordered_map<GO, int> nodeOrdering = computeNodeOrdering(nodes);
   Teuchos::reduceAll(*commT, Teuchos::REDUCE_MAX, 1, &maxID, &maxGID);
   numGlobalNodes =
       maxGID + 1;  // maxGID is the same for overlapped and unique maps
@@ -1613,6 +1765,15 @@ Albany::STKDiscretization::computeNodalMaps(bool overlapped)
 
     numNodes = nodes.size();
 
+    if (!nodeOrdering.empty()) {
+      std::sort(
+          nodes.begin(),
+          nodes.end(),
+          [&](stk::mesh::Entity const a, stk::mesh::Entity const b) {
+            return nodeOrdering.at(gid(a)) < nodeOrdering.at(gid(b));
+          });
+    }
+
     Teuchos::Array<Tpetra_GO> indicesT(numNodes * nComp);
     NodalDOFManager*   dofManager =
         (overlapped) ? &it->second.overlap_dofManager : &it->second.dofManager;
@@ -1641,6 +1802,61 @@ Albany::STKDiscretization::computeNodalMaps(bool overlapped)
   }
 }
 
+std::unordered_map<GO, int>
+Albany::STKDiscretization::computeNodeOrdering(
+    const std::vector<stk::mesh::Entity>& nodes) const
+{
+  std::unordered_map<GO, int> position;
+  if (localDOFOrdering != "Reverse Cuthill-McKee") return position;
+
+  const int numNodes = nodes.size();
+  for (int i = 0; i < numNodes; i++) position[gid(nodes[i])] = i;
+
+  // Node graph through the elements, restricted to the given nodes
+  std::vector<int> offsets(1, 0), adj, row;
+  for (int i = 0; i < numNodes; i++) {
+    row.clear();
+    const stk::mesh::Entity* elems    = bulkData.begin_elements(nodes[i]);
+    const int                numElems = bulkData.num_elements(nodes[i]);
+    for (int e = 0; e < numElems; e++) {
+      const stk::mesh::Entity* elemNodes = bulkData.begin_nodes(elems[e]);
+      const int                numElemNodes = bulkData.num_nodes(elems[e]);
+      for (int k = 0; k < numElemNodes; k++) {
+        auto it = position.find(gid(elemNodes[k]));
+        if (it != position.end() && it->second != i) row.push_back(it->second);
+      }
+    }
+    std::sort(row.begin(), row.end());
+    row.erase(std::unique(row.begin(), row.end()), row.end());
+    adj.insert(adj.end(), row.begin(), row.end());
+    offsets.push_back(adj.size());
+  }
+
+  const std::vector<int> order = Albany::reverseCuthillMcKee(offsets, adj);
+  std::vector<int>       rank(numNodes);
+  for (int i = 0; i < numNodes; i++) rank[order[i]] = i;
+
+  *out << "STKDiscretization: local node graph bandwidth "
+       << Albany::graphBandwidth(offsets, adj) << " -> "
+       << Albany::graphBandwidth(offsets, adj, rank)
+       << " with Reverse Cuthill-McKee ordering" << std::endl;
+
+  for (int i = 0; i < numNodes; i++) position[gid(nodes[i])] = rank[i];
+  return position;
+}
+
+void
+Albany::STKDiscretization::sortElements()
+{
+  if (elementOrdering != "Space Filling Curve") return;
+
+  // Field data moves with the entities, so element states and the worksets
+  // built afterwards see the new order
+  SpaceFillingCurveSorter sorter(
+      *stkMeshStruct->getCoordinatesField(), stkMeshStruct->numDim);
+  bulkData.sort_entities(sorter);
+}
+
 void
 Albany::STKDiscretization::computeOwnedNodesAndUnknowns()
 {
@@ -1709,10 +1925,42 @@ Albany::STKDiscretization::computeOverlapNodesAndUnknowns()
 void
 Albany::STKDiscretization::computeGraphs()
 {
+  if (residual_only_scheme) {
+    computeGraphsResidualOnly();
+    return;
+  }
   computeGraphsUpToFillComplete();
   fillCompleteGraphs();
 }
 
+void
+Albany::STKDiscretization::computeGraphsResidualOnly()
+{
+  stk::mesh::Selector select_owned_in_part =
+      stk::mesh::Selector(metaData.universal_part()) &
+      stk::mesh::Selector(metaData.locally_owned_part());
+
+  stk::mesh::get_selected_entities(
+      select_owned_in_part,
+      bulkData.buckets(stk::topology::ELEMENT_RANK),
+      cells);
+
+  if (commT->getRank() == 0)
+    *out << "STKDisc: " << cells.size() << " elements on Proc 0 " << std::endl;
+
+  overlap_graphT = Teuchos::null;  // delete existing graph happens here on remesh
+
+  // Graph for a diagonal (lumped) matrix
+  overlap_graphT = Teuchos::rcp(new Tpetra_CrsGraph(overlap_mapT, 1));
+
+  for (LO lrow = 0; lrow < overlap_mapT->getNodeNumElements(); ++lrow) {
+    Tpetra_GO row = overlap_mapT->getGlobalElement(lrow);
+    overlap_graphT->insertGlobalIndices(row, Teuchos::arrayView(&row, 1));
+  }
+
+  fillCompleteGraphs();
+}
+
 void
 Albany::STKDiscretization::computeGraphsUpToFillComplete()
 {
@@ -1844,6 +2092,116 @@ Albany::STKDiscretization::computeGraphsUpToFillComplete()
       }
     }
   }
+
+#ifdef ALBANY_CONTACT
+  // The contact conditions couple the equations of a slave node and of the
+  // master nodes it can come into contact with, and those master equations
+  // with the unknowns of the elements around the slave node. Reserve these
+  // couplings for the pairs of slave and master sides within the search
+  // distance of each other, as Albany::ContactManager pairs them.
+  if (discParams->isSublist("Contact")) {
+    Teuchos::ParameterList& contactParams = discParams->sublist("Contact");
+
+    const Teuchos::Array<std::string>& masterNames =
+        contactParams.get<Teuchos::Array<std::string>>("Master Side Sets");
+    const Teuchos::Array<std::string>& slaveNames =
+        contactParams.get<Teuchos::Array<std::string>>("Slave Side Sets");
+
+    AbstractSTKFieldContainer::VectorFieldType* coordinates_field =
+        stkMeshStruct->getCoordinatesField();
+
+    // The sides of a contact side set, each as its two end nodes
+    typedef std::pair<stk::mesh::Entity, stk::mesh::Entity> Segment;
+    auto getSegments =
+        [&](const std::string& ssName) -> std::vector<Segment> {
+      auto ssPart = stkMeshStruct->ssPartVec.find(ssName);
+      TEUCHOS_TEST_FOR_EXCEPTION(
+          ssPart == stkMeshStruct->ssPartVec.end(),
+          std::logic_error,
+          "Error! Contact side set " << ssName << " is not in the mesh.\n");
+
+      std::vector<stk::mesh::Entity> sides;
+      stk::mesh::get_selected_entities(
+          stk::mesh::Selector(*ssPart->second),
+          bulkData.buckets(metaData.side_rank()),
+          sides);
+
+      std::vector<Segment> segments;
+      for (std::size_t i = 0; i < sides.size(); ++i) {
+        stk::mesh::Entity const* side_nodes = bulkData.begin_nodes(sides[i]);
+        segments.push_back(std::make_pair(side_nodes[0], side_nodes[1]));
+      }
+      return segments;
+    };
+    auto coords = [&](const stk::mesh::Entity node) -> double* {
+      return stk::mesh::field_data(*coordinates_field, node);
+    };
+
+    std::vector<std::vector<Segment>> masterSegments, slaveSegments;
+    double longestSegment = 0.0;
+    for (int pair = 0; pair < masterNames.size(); ++pair) {
+      masterSegments.push_back(getSegments(masterNames[pair]));
+      slaveSegments.push_back(getSegments(slaveNames[pair]));
+      for (auto segments : {&masterSegments.back(), &slaveSegments.back()}) {
+        for (const Segment& seg : *segments) {
+          const double* a = coords(seg.first);
+          const double* b = coords(seg.second);
+          longestSegment =
+              std::max(longestSegment, std::hypot(b[0] - a[0], b[1] - a[1]));
+        }
+      }
+    }
+    const double searchDistance =
+        contactParams.isParameter("Search Distance") ?
+            contactParams.get<double>("Search Distance") :
+            longestSegment;
+
+    // The master nodes each slave node can come into contact with
+    std::map<GO, std::set<GO>> pairedNodes;
+    for (std::size_t pair = 0; pair < slaveSegments.size(); ++pair) {
+      for (const Segment& slave : slaveSegments[pair]) {
+        for (const Segment& master : masterSegments[pair]) {
+          if (!Albany::ContactManager::withinSearchDistance(
+                  coords(slave.first), coords(slave.second),
+                  coords(master.first), coords(master.second),
+                  searchDistance))
+            continue;
+          for (auto slaveNode : {slave.first, slave.second}) {
+            pairedNodes[gid(slaveNode)].insert(gid(master.first));
+            pairedNodes[gid(slaveNode)].insert(gid(master.second));
+          }
+        }
+      }
+    }
+
+    // Rows: the slave node and its master nodes. Columns: the nodes of the
+    // elements around the slave node, and the master nodes.
+    for (auto it = pairedNodes.begin(); it != pairedNodes.end(); ++it) {
+      stk::mesh::Entity const slaveNode =
+          bulkData.get_entity(stk::topology::NODE_RANK, it->first + 1);
+
+      std::set<GO> colNodes(it->second);
+      stk::mesh::Entity const* elems = bulkData.begin_elements(slaveNode);
+      for (std::size_t e = 0; e < bulkData.num_elements(slaveNode); ++e) {
+        stk::mesh::Entity const* elem_nodes = bulkData.begin_nodes(elems[e]);
+        for (std::size_t l = 0; l < bulkData.num_nodes(elems[e]); ++l)
+          colNodes.insert(gid(elem_nodes[l]));
+      }
+
+      Teuchos::Array<Tpetra_GO> cols;
+      for (auto colNode : colNodes)
+        for (std::size_t m = 0; m < neq; m++)
+          cols.push_back(getGlobalDOF(colNode, m));
+
+      std::set<GO> rowNodes(it->second);
+      rowNodes.insert(it->first);
+      for (auto rowNode : rowNodes)
+        for (std::size_t k = 0; k < neq; k++)
+          overlap_graphT->insertGlobalIndices(
+              getGlobalDOF(rowNode, k), cols());
+    }
+  }
+#endif
 }
 
 void
@@ -3312,7 +3670,7 @@ void
 Albany::STKDiscretization::reNameExodusOutput(std::string& filename)
 {
 #ifdef ALBANY_SEACAS
-  if (stkMeshStruct->exoOutput && !mesh_data.is_null()) {
+  if (stkMeshStruct->exoOutput) {
     // Delete the mesh data object and recreate it
     mesh_data = Teuchos::null;
 
@@ -3614,6 +3972,8 @@ Albany::STKDiscretization::updateMesh()
         param_state.name, param_state.meshPart, numComps);
   }
 
+  sortElements();
+
   computeNodalMaps(false);
 
   computeOwnedNodesAndUnknowns();
@@ -3655,6 +4015,9 @@ Albany::STKDiscretization::updateMesh()
 // meshToGraph();
 // printVertexConnectivity();
 
+  // Reference for the coordinate views of updateMeshIncremental()
+  recordNodeBuckets();
+
 #ifdef OUTPUT_TO_SCREEN
   printCoords();
 #endif
@@ -3677,3 +4040,625 @@ Albany::STKDiscretization::updateMesh()
     buildSideSetProjectors();
   }
 }
+
+namespace {
+
+// Append the DOFs of new_node_gids to the element list of an existing map.
+// The local ids of the DOFs already in the map are preserved. Interleaved
+// ordering only.
+Teuchos::RCP<const Tpetra_Map>
+appendNodesToMap(
+    const Tpetra_Map&                       map,
+    const std::vector<GO>&                  new_node_gids,
+    const int                               nComp,
+    const Teuchos::RCP<const Teuchos_Comm>& commT)
+{
+  Teuchos::ArrayView<const Tpetra_GO> old_indices = map.getNodeElementList();
+  Teuchos::Array<Tpetra_GO>           indicesT(
+      old_indices.size() + new_node_gids.size() * nComp);
+  std::copy(old_indices.begin(), old_indices.end(), indicesT.begin());
+  std::size_t k = old_indices.size();
+  for (std::size_t i = 0; i < new_node_gids.size(); ++i)
+    for (int j = 0; j < nComp; ++j) indicesT[k++] = new_node_gids[i] * nComp + j;
+  return Tpetra::createNonContigMapWithNode<LO, Tpetra_GO, KokkosNode>(
+      indicesT(), commT);
+}
+
+// Copy of a fill-completed graph with the given local rows extended by
+// new_rows. The row map of graph must be a prefix of row_map. Untouched rows
+// are copied in blocks from the packed local storage of graph, keeping their
+// local column ids, since the columns of new_rows that are not in the column
+// map of graph are appended to it. Entries are only added, never removed: a
+// column that lost its coupling keeps a structural zero.
+Teuchos::RCP<Tpetra_CrsGraph>
+extendGraph(
+    const Tpetra_CrsGraph&                            graph,
+    const Teuchos::RCP<const Tpetra_Map>&             row_map,
+    const std::map<Tpetra_LO, std::vector<Tpetra_GO>>& new_rows,
+    const Teuchos::RCP<const Tpetra_Map>&             domain_map,
+    const Teuchos::RCP<const Tpetra_Map>&             range_map)
+{
+  Teuchos::RCP<const Tpetra_Map> const old_col_map = graph.getColMap();
+  Teuchos::ArrayView<const Tpetra_GO>  old_cols =
+      old_col_map->getNodeElementList();
+
+  std::vector<Tpetra_GO> added_cols;
+  for (auto it = new_rows.begin(); it != new_rows.end(); ++it)
+    for (std::size_t k = 0; k < it->second.size(); ++k)
+      if (!old_col_map->isNodeGlobalElement(it->second[k]))
+        added_cols.push_back(it->second[k]);
+  std::sort(added_cols.begin(), added_cols.end());
+  added_cols.erase(
+      std::unique(added_cols.begin(), added_cols.end()), added_cols.end());
+
+  Teuchos::Array<Tpetra_GO> cols(old_cols.size() + added_cols.size());
+  std::copy(old_cols.begin(), old_cols.end(), cols.begin());
+  std::copy(added_cols.begin(), added_cols.end(), cols.begin() + old_cols.size());
+  Teuchos::RCP<const Tpetra_Map> const col_map =
+      Tpetra::createNonContigMapWithNode<LO, Tpetra_GO, KokkosNode>(
+          cols(), row_map->getComm());
+
+  Teuchos::ArrayRCP<const size_t>    old_ptrs = graph.getNodeRowPtrs();
+  Teuchos::ArrayRCP<const Tpetra_LO> old_inds = graph.getNodePackedIndices();
+  Tpetra_LO const num_old_rows = graph.getNodeNumRows();
+  Tpetra_LO const num_rows     = row_map->getNodeNumElements();
+
+  // Sorted local entries of the extended rows
+  std::map<Tpetra_LO, std::vector<Tpetra_LO>> rows;
+  for (auto it = new_rows.begin(); it != new_rows.end(); ++it) {
+    std::vector<Tpetra_LO>& row = rows[it->first];
+    if (it->first < num_old_rows)
+      row.assign(
+          old_inds.begin() + old_ptrs[it->first],
+          old_inds.begin() + old_ptrs[it->first + 1]);
+    for (std::size_t k = 0; k < it->second.size(); ++k)
+      row.push_back(col_map->getLocalElement(it->second[k]));
+    std::sort(row.begin(), row.end());
+    row.erase(std::unique(row.begin(), row.end()), row.end());
+  }
+
+  // Old row lengths up to num_old_rows, extended rows, empty rows after
+  auto old_length = [&](Tpetra_LO const r) -> size_t {
+    return r < num_old_rows ? old_ptrs[r + 1] - old_ptrs[r] : 0;
+  };
+  Teuchos::ArrayRCP<size_t> ptrs(num_rows + 1);
+  ptrs[0]     = 0;
+  Tpetra_LO r = 0;
+  for (auto it = rows.begin(); it != rows.end(); ++it, ++r) {
+    for (; r < it->first; ++r) ptrs[r + 1] = ptrs[r] + old_length(r);
+    ptrs[r + 1] = ptrs[r] + it->second.size();
+  }
+  for (; r < num_rows; ++r) ptrs[r + 1] = ptrs[r] + old_length(r);
+
+  Teuchos::ArrayRCP<Tpetra_LO> inds(ptrs[num_rows]);
+  Tpetra_LO                    first = 0;
+  for (auto it = rows.begin(); it != rows.end(); ++it) {
+    Tpetra_LO const last = std::min(it->first, num_old_rows);
+    if (first < last)
+      std::copy(
+          old_inds.begin() + old_ptrs[first],
+          old_inds.begin() + old_ptrs[last],
+          inds.begin() + ptrs[first]);
+    std::copy(
+        it->second.begin(), it->second.end(), inds.begin() + ptrs[it->first]);
+    first = it->first + 1;
+  }
+  if (first < num_old_rows)
+    std::copy(
+        old_inds.begin() + old_ptrs[first],
+        old_inds.begin() + old_ptrs[num_old_rows],
+        inds.begin() + ptrs[first]);
+
+  Teuchos::RCP<Tpetra_CrsGraph> const extended =
+      Teuchos::rcp(new Tpetra_CrsGraph(row_map, col_map, ptrs, inds));
+  extended->expertStaticFillComplete(domain_map, range_map);
+  return extended;
+}
+
+}  // namespace
+
+bool
+Albany::STKDiscretization::canUpdateIncrementally(
+    stk::mesh::EntityVector const& modified_cells,
+    double const                   max_modified_fraction) const
+{
+  // Global DOF ids depend on the number of global nodes otherwise
+  if (!interleavedOrdering) return false;
+  if (sideSetEquations.size() > 0) return false;
+  if (stkMeshStruct->sideSetMeshStructs.size() > 0) return false;
+  // patchGraphs() adds full element couplings
+  if (residual_only_scheme) return false;
+  for (int d = 0; d < stkMeshStruct->numDim; d++)
+    if (stkMeshStruct->PBCStruct.periodic[d]) return false;
+  if (Teuchos::nonnull(stkMeshStruct->nodal_data_base) &&
+      stkMeshStruct->nodal_data_base->isNodeDataPresent())
+    return false;
+
+  // Only whole-mesh DOF structures can be patched
+  for (auto it = nodalDOFsStructContainer.mapOfDOFsStructs.begin();
+       it != nodalDOFsStructContainer.mapOfDOFsStructs.end();
+       ++it)
+    if (it->first.first.size() > 0) return false;
+
+  // The element buckets (and hence the worksets) must be unchanged, i.e. no
+  // cells were added or removed (e.g. by surface element insertion).
+  stk::mesh::Selector select_owned_in_part =
+      stk::mesh::Selector(metaData.universal_part()) &
+      stk::mesh::Selector(metaData.locally_owned_part());
+  stk::mesh::BucketVector const& buckets =
+      bulkData.get_buckets(stk::topology::ELEMENT_RANK, select_owned_in_part);
+  if (buckets.size() != wsElNodeID.size()) return false;
+  for (std::size_t b = 0; b < buckets.size(); ++b)
+    if (buckets[b]->size() != wsElNodeID[b].size()) return false;
+
+  double const num_cells = static_cast<double>(cells.size());
+  if (modified_cells.size() > max_modified_fraction * num_cells) return false;
+
+  return true;
+}
+
+void
+Albany::STKDiscretization::patchGraphs(std::set<GO> const& touched_nodes)
+{
+  // New entries of the overlap rows of the touched nodes, from all owned
+  // cells around them
+  std::map<Tpetra_LO, std::vector<Tpetra_GO>> overlap_rows;
+  Teuchos::Array<Tpetra_GO>                   patch_gids;
+  for (auto it = touched_nodes.begin(); it != touched_nodes.end(); ++it) {
+    stk::mesh::Entity rowNode =
+        bulkData.get_entity(stk::topology::NODE_RANK, *it + 1);
+    if (!bulkData.is_valid(rowNode)) continue;
+
+    std::vector<Tpetra_GO>   cols;
+    stk::mesh::Entity const* elem_rels = bulkData.begin_elements(rowNode);
+    const size_t             num_elems = bulkData.num_elements(rowNode);
+    for (std::size_t e = 0; e < num_elems; ++e) {
+      stk::mesh::Entity elem = elem_rels[e];
+      if (!bulkData.bucket(elem).owned()) continue;
+
+      stk::mesh::Entity const* node_rels = bulkData.begin_nodes(elem);
+      const size_t             num_nodes = bulkData.num_nodes(elem);
+      for (std::size_t l = 0; l < num_nodes; l++)
+        for (std::size_t m = 0; m < neq; m++)
+          cols.push_back(getGlobalDOF(gid(node_rels[l]), m));
+    }
+    if (cols.empty()) continue;
+
+    for (std::size_t k = 0; k < neq; ++k) {
+      Tpetra_GO const row = getGlobalDOF(*it, k);
+      overlap_rows[overlap_mapT->getLocalElement(row)] = cols;
+      patch_gids.push_back(row);
+    }
+  }
+
+  overlap_graphT = extendGraph(
+      *overlap_graphT, overlap_mapT, overlap_rows, overlap_mapT, overlap_mapT);
+
+  // The owned rows that change are the ones the new entries are exported to,
+  // from this or any other rank
+  Teuchos::RCP<const Tpetra_Map> const patch_mapT =
+      Tpetra::createNonContigMapWithNode<LO, Tpetra_GO, KokkosNode>(
+          patch_gids(), commT);
+  Tpetra_CrsGraph patch_graphT(patch_mapT, neq);
+  for (auto it = overlap_rows.begin(); it != overlap_rows.end(); ++it)
+    patch_graphT.insertGlobalIndices(
+        overlap_mapT->getGlobalElement(it->first),
+        Teuchos::arrayViewFromVector(it->second));
+  patch_graphT.fillComplete(mapT, mapT);
+
+  Tpetra_Export const exporterT(patch_mapT, mapT);
+  Tpetra_CrsGraph     owned_patch_graphT(mapT, 0);
+  owned_patch_graphT.doExport(patch_graphT, exporterT, Tpetra::INSERT);
+
+  std::set<Tpetra_LO> owned_lids;
+  for (std::size_t i = 0; i < exporterT.getNumSameIDs(); ++i)
+    owned_lids.insert(i);
+  Teuchos::ArrayView<const Tpetra_LO> permute_lids =
+      exporterT.getPermuteToLIDs();
+  owned_lids.insert(permute_lids.begin(), permute_lids.end());
+  Teuchos::ArrayView<const Tpetra_LO> remote_lids = exporterT.getRemoteLIDs();
+  owned_lids.insert(remote_lids.begin(), remote_lids.end());
+
+  std::map<Tpetra_LO, std::vector<Tpetra_GO>> owned_rows;
+  Teuchos::Array<Tpetra_GO>                   row_indices;
+  for (auto it = owned_lids.begin(); it != owned_lids.end(); ++it) {
+    Tpetra_GO const   row = mapT->getGlobalElement(*it);
+    std::size_t const num_entries =
+        owned_patch_graphT.getNumEntriesInGlobalRow(row);
+    if (num_entries == 0) continue;
+    row_indices.resize(num_entries);
+    std::size_t num_copied;
+    owned_patch_graphT.getGlobalRowCopy(row, row_indices(), num_copied);
+    owned_rows[*it].assign(
+        row_indices.begin(), row_indices.begin() + num_copied);
+  }
+
+  graphT = extendGraph(*graphT, mapT, owned_rows, mapT, mapT);
+}
+
+void
+Albany::STKDiscretization::patchWorksetInfo(
+    stk::mesh::EntityVector const& cells_to_patch)
+{
+  typedef AbstractSTKFieldContainer::ScalarFieldType ScalarFieldType;
+  typedef AbstractSTKFieldContainer::VectorFieldType VectorFieldType;
+  typedef AbstractSTKFieldContainer::TensorFieldType TensorFieldType;
+
+  VectorFieldType* coordinates_field = stkMeshStruct->getCoordinatesField();
+
+  const Albany::StateInfoStruct& nodal_states =
+      stkMeshStruct->getFieldContainer()->getNodalSIS();
+
+  NodalDOFsStructContainer::MapOfDOFsStructs& mapOfDOFsStructs =
+      nodalDOFsStructContainer.mapOfDOFsStructs;
+
+  for (std::size_t c = 0; c < cells_to_patch.size(); ++c) {
+    stk::mesh::Entity element = cells_to_patch[c];
+    const wsLid&      ws_lid  = elemGIDws[gid(element)];
+    const int         b       = ws_lid.ws;
+    const int         i       = ws_lid.LID;
+
+    stk::mesh::Entity const* node_rels = bulkData.begin_nodes(element);
+    const int                nodes_per_element = bulkData.num_nodes(element);
+
+    for (auto it = mapOfDOFsStructs.begin(); it != mapOfDOFsStructs.end();
+         ++it) {
+      IDArray&  wsElNodeEqID_array = it->second.wsElNodeEqID[b];
+      GIDArray& wsElNodeID_array   = it->second.wsElNodeID[b];
+      int       nComp              = it->first.second;
+      for (int j = 0; j < nodes_per_element; j++) {
+        stk::mesh::Entity node      = node_rels[j];
+        wsElNodeID_array(i, j)      = gid(node);
+        for (int k = 0; k < nComp; k++) {
+          const GO node_gid = it->second.overlap_dofManager.getGlobalDOF(
+              bulkData.identifier(node) - 1, k);
+          wsElNodeEqID_array(i, j, k) =
+              it->second.overlap_map->getLocalElement(node_gid);
+        }
+      }
+    }
+
+    DOFsStruct& dofs_struct = mapOfDOFsStructs[make_pair(std::string(""), neq)];
+    GIDArray&   node_array    = dofs_struct.wsElNodeID[b];
+    IDArray&    node_eq_array = dofs_struct.wsElNodeEqID[b];
+    for (int j = 0; j < nodes_per_element; j++) {
+      const stk::mesh::Entity rowNode = node_rels[j];
+      coords[b][i][j] = stk::mesh::field_data(*coordinates_field, rowNode);
+      wsElNodeID[b][i][j] = node_array(i, j);
+      for (int eq = 0; eq < neq; eq++)
+        wsElNodeEqID[b](i, j, eq) = node_eq_array(i, j, eq);
+    }
+
+    // Nodal states gathered to the element nodes
+    for (int is = 0; is < nodal_states.size(); ++is) {
+      const std::string&                    name = nodal_states[is]->name;
+      const Albany::StateStruct::FieldDims& dim  = nodal_states[is]->dim;
+      MDArray& array = stateArrays.elemStateArrays[b][name];
+      switch (dim.size()) {
+        case 2: {
+          const ScalarFieldType& field = *metaData.get_field<ScalarFieldType>(
+              stk::topology::NODE_RANK, name);
+          for (int j = 0; j < dim[1]; j++)
+            array(i, j) = *stk::mesh::field_data(field, node_rels[j]);
+          break;
+        }
+        case 3: {
+          const VectorFieldType& field = *metaData.get_field<VectorFieldType>(
+              stk::topology::NODE_RANK, name);
+          for (int j = 0; j < dim[1]; j++) {
+            double* entry = stk::mesh::field_data(field, node_rels[j]);
+            for (int k = 0; k < dim[2]; k++) array(i, j, k) = entry[k];
+          }
+          break;
+        }
+        case 4: {
+          const TensorFieldType& field = *metaData.get_field<TensorFieldType>(
+              stk::topology::NODE_RANK, name);
+          for (int j = 0; j < dim[1]; j++) {
+            double* entry = stk::mesh::field_data(field, node_rels[j]);
+            for (int k = 0; k < dim[2]; k++)
+              for (int l = 0; l < dim[3]; l++)
+                array(i, j, k, l) = entry[k * dim[3] + l];
+          }
+          break;
+        }
+      }
+    }
+  }
+}
+
+Albany::STKDiscretization::NodeBucketSignature
+Albany::STKDiscretization::nodeBucketSignature(
+    stk::mesh::Bucket const& bucket) const
+{
+  NodeBucketSignature signature;
+  signature.size   = bucket.size();
+  signature.coords = stk::mesh::field_data(
+      *stkMeshStruct->getCoordinatesField(), bucket);
+  if (bucket.size() > 0) {
+    signature.first = bucket[0];
+    signature.last  = bucket[bucket.size() - 1];
+  }
+  return signature;
+}
+
+void
+Albany::STKDiscretization::recordNodeBuckets()
+{
+  nodeBucketSignatures.clear();
+  stk::mesh::BucketVector const& buckets =
+      bulkData.buckets(stk::topology::NODE_RANK);
+  for (std::size_t b = 0; b < buckets.size(); ++b)
+    nodeBucketSignatures[buckets[b]] = nodeBucketSignature(*buckets[b]);
+}
+
+void
+Albany::STKDiscretization::refreshCoordinateViews()
+{
+  AbstractSTKFieldContainer::VectorFieldType* coordinates_field =
+      stkMeshStruct->getCoordinatesField();
+
+  // STK only moves the field data of the nodes in buckets whose contents
+  // changed; the other buckets still match their signatures.
+  std::vector<stk::mesh::Entity> moved_nodes;
+  stk::mesh::BucketVector const& buckets =
+      bulkData.buckets(stk::topology::NODE_RANK);
+  for (std::size_t b = 0; b < buckets.size(); ++b) {
+    auto const it = nodeBucketSignatures.find(buckets[b]);
+    if (it != nodeBucketSignatures.end() &&
+        it->second == nodeBucketSignature(*buckets[b]))
+      continue;
+    moved_nodes.insert(moved_nodes.end(), buckets[b]->begin(), buckets[b]->end());
+  }
+
+  std::set<GO> cells_to_refresh;
+  for (std::size_t i = 0; i < moved_nodes.size(); ++i) {
+    stk::mesh::Entity        node      = moved_nodes[i];
+    stk::mesh::Entity const* elem_rels = bulkData.begin_elements(node);
+    const size_t             num_elems = bulkData.num_elements(node);
+    for (std::size_t e = 0; e < num_elems; ++e) {
+      GO const cell_gid = gid(elem_rels[e]);
+      if (elemGIDws.find(cell_gid) != elemGIDws.end())
+        cells_to_refresh.insert(cell_gid);
+    }
+
+    if (!bulkData.bucket(node).owned()) continue;
+    for (auto ns = stkMeshStruct->nsPartVec.begin();
+         ns != stkMeshStruct->nsPartVec.end();
+         ++ns) {
+      if (!bulkData.bucket(node).member(*ns->second)) continue;
+      std::vector<GO> const& gids = nodeSetGIDs[ns->first];
+      auto const pos = std::find(gids.begin(), gids.end(), gid(node));
+      if (pos != gids.end())
+        nodeSetCoords[ns->first][pos - gids.begin()] =
+            stk::mesh::field_data(*coordinates_field, node);
+    }
+  }
+
+  for (auto it = cells_to_refresh.begin(); it != cells_to_refresh.end(); ++it) {
+    stk::mesh::Entity element =
+        bulkData.get_entity(stk::topology::ELEMENT_RANK, *it + 1);
+    const wsLid&                ws_lid    = elemGIDws[*it];
+    stk::mesh::Entity const*    node_rels = bulkData.begin_nodes(element);
+    Teuchos::ArrayRCP<double*>& elem_coords = coords[ws_lid.ws][ws_lid.LID];
+    for (int j = 0; j < elem_coords.size(); ++j)
+      elem_coords[j] = stk::mesh::field_data(*coordinates_field, node_rels[j]);
+  }
+
+  recordNodeBuckets();
+}
+
+void
+Albany::STKDiscretization::patchMLCoords(
+    std::vector<stk::mesh::Entity> const& new_owned_nodes)
+{
+  if (rigidBodyModes.is_null()) return;
+  if (!rigidBodyModes->isMLUsed() && !rigidBodyModes->isMueLuUsed()) return;
+
+  const int                                   numDim = stkMeshStruct->numDim;
+  AbstractSTKFieldContainer::VectorFieldType* coordinates_field =
+      stkMeshStruct->getCoordinatesField();
+  Teuchos::RCP<const Tpetra_MultiVector> old_coordMV = coordMV;
+  coordMV = Teuchos::rcp(new Tpetra_MultiVector(node_mapT, numDim, false));
+
+  // The existing nodes kept their local ids
+  for (int j = 0; j < numDim; j++) {
+    Teuchos::ArrayRCP<const ST> old_values = old_coordMV->getData(j);
+    Teuchos::ArrayRCP<ST>       values     = coordMV->getDataNonConst(j);
+    std::copy(old_values.begin(), old_values.end(), values.begin());
+  }
+
+  for (std::size_t i = 0; i < new_owned_nodes.size(); i++) {
+    int const node_lid = node_mapT->getLocalElement(gid(new_owned_nodes[i]));
+    double*   X = stk::mesh::field_data(*coordinates_field, new_owned_nodes[i]);
+    for (int j = 0; j < numDim; j++)
+      coordMV->replaceLocalValue(node_lid, j, X[j]);
+  }
+
+  rigidBodyModes->setCoordinatesAndNullspace(coordMV, mapT);
+
+  writeCoordsToMatrixMarket();
+}
+
+void
+Albany::STKDiscretization::patchNodeSets(
+    std::vector<stk::mesh::Entity> const& new_owned_nodes)
+{
+  AbstractSTKFieldContainer::VectorFieldType* coordinates_field =
+      stkMeshStruct->getCoordinatesField();
+
+  for (auto ns = stkMeshStruct->nsPartVec.begin();
+       ns != stkMeshStruct->nsPartVec.end();
+       ++ns) {
+    for (std::size_t i = 0; i < new_owned_nodes.size(); i++) {
+      stk::mesh::Entity node = new_owned_nodes[i];
+      if (!bulkData.bucket(node).member(*ns->second)) continue;
+      GO const         node_gid = gid(node);
+      int const        node_lid = node_mapT->getLocalElement(node_gid);
+      std::vector<int> dofs(neq);
+      for (std::size_t eq = 0; eq < neq; eq++)
+        dofs[eq] = getOwnedDOF(node_lid, eq);
+      nodeSets[ns->first].push_back(dofs);
+      nodeSetGIDs[ns->first].push_back(node_gid);
+      nodeSetCoords[ns->first].push_back(
+          stk::mesh::field_data(*coordinates_field, node));
+    }
+  }
+}
+
+bool
+Albany::STKDiscretization::updateMeshIncremental(
+    stk::mesh::EntityVector const& modified_cells,
+    stk::mesh::EntityVector const& new_nodes,
+    double const                   max_modified_fraction)
+{
+  TEUCHOS_FUNC_TIME_MONITOR("STKDiscretization::updateMeshIncremental");
+
+  // Only owned cells are stored in the worksets
+  stk::mesh::EntityVector owned_cells;
+  for (std::size_t c = 0; c < modified_cells.size(); ++c) {
+    stk::mesh::Entity cell = modified_cells[c];
+    if (bulkData.is_valid(cell) && bulkData.bucket(cell).owned() &&
+        elemGIDws.find(gid(cell)) != elemGIDws.end())
+      owned_cells.push_back(cell);
+  }
+  std::sort(owned_cells.begin(), owned_cells.end());
+  owned_cells.erase(
+      std::unique(owned_cells.begin(), owned_cells.end()), owned_cells.end());
+
+  // All ranks must take the same path
+  int local_ok = canUpdateIncrementally(owned_cells, max_modified_fraction);
+  int global_ok = 0;
+  Teuchos::reduceAll(*commT, Teuchos::REDUCE_MIN, 1, &local_ok, &global_ok);
+  if (global_ok == 0) {
+    *out << "STKDisc: topology change is not local, rebuilding discretization"
+         << std::endl;
+    updateMesh();
+    return false;
+  }
+
+  // Nodes whose graph rows change: the nodes the modified cells were attached
+  // to before the change (still in wsElNodeID) and the ones they are attached
+  // to now.
+  std::set<GO> touched_nodes;
+  bool         touches_side_set = false;
+  for (std::size_t c = 0; c < owned_cells.size(); ++c) {
+    stk::mesh::Entity cell   = owned_cells[c];
+    const wsLid&      ws_lid = elemGIDws[gid(cell)];
+    const Teuchos::ArrayRCP<GO>& old_nodes = wsElNodeID[ws_lid.ws][ws_lid.LID];
+    for (int j = 0; j < old_nodes.size(); ++j) touched_nodes.insert(old_nodes[j]);
+
+    stk::mesh::Entity const* node_rels = bulkData.begin_nodes(cell);
+    const size_t             num_nodes = bulkData.num_nodes(cell);
+    for (std::size_t j = 0; j < num_nodes; ++j)
+      touched_nodes.insert(gid(node_rels[j]));
+
+    stk::mesh::Entity const* side_rels =
+        bulkData.begin(cell, metaData.side_rank());
+    const size_t num_sides = bulkData.num_connectivity(cell, metaData.side_rank());
+    for (std::size_t j = 0; j < num_sides; ++j)
+      for (auto ss = stkMeshStruct->ssPartVec.begin();
+           ss != stkMeshStruct->ssPartVec.end();
+           ++ss)
+        if (bulkData.bucket(side_rels[j]).member(*ss->second))
+          touches_side_set = true;
+  }
+
+  // The new owned and shared nodes are the ones the topology change created
+  // on this rank: STK requires a shared node to be declared on every rank
+  // that shares it.
+  std::vector<stk::mesh::Entity> new_owned_nodes, new_overlap_nodes;
+  std::vector<GO>                new_owned_gids, new_overlap_gids;
+  for (std::size_t i = 0; i < new_nodes.size(); ++i) {
+    stk::mesh::Entity node = new_nodes[i];
+    if (!bulkData.is_valid(node)) continue;
+    stk::mesh::Bucket const& bucket = bulkData.bucket(node);
+    if (!bucket.owned() && !bucket.shared()) continue;
+    GO const node_gid = gid(node);
+    if (overlap_node_mapT->isNodeGlobalElement(node_gid)) continue;
+    new_overlap_nodes.push_back(node);
+    new_overlap_gids.push_back(node_gid);
+    touched_nodes.insert(node_gid);
+    if (!bucket.owned()) continue;
+    new_owned_nodes.push_back(node);
+    new_owned_gids.push_back(node_gid);
+  }
+
+  GO maxID(0), maxGID(0);
+  for (std::size_t i = 0; i < new_overlap_gids.size(); ++i)
+    maxID = std::max(maxID, new_overlap_gids[i]);
+  Teuchos::reduceAll(*commT, Teuchos::REDUCE_MAX, 1, &maxID, &maxGID);
+  numGlobalNodes = std::max(numGlobalNodes, maxGID + 1);
+
+  ownednodes.insert(
+      ownednodes.end(), new_owned_nodes.begin(), new_owned_nodes.end());
+  overlapnodes.insert(
+      overlapnodes.end(), new_overlap_nodes.begin(), new_overlap_nodes.end());
+  numOwnedNodes   = ownednodes.size();
+  numOverlapNodes = overlapnodes.size();
+
+  // Extend the maps, keeping the local ids of existing DOFs
+  NodalDOFsStructContainer::MapOfDOFsStructs& mapOfDOFsStructs =
+      nodalDOFsStructContainer.mapOfDOFsStructs;
+  for (auto it = mapOfDOFsStructs.begin(); it != mapOfDOFsStructs.end(); ++it) {
+    int const nComp = it->first.second;
+    it->second.map =
+        appendNodesToMap(*it->second.map, new_owned_gids, nComp, commT);
+    it->second.overlap_map =
+        appendNodesToMap(*it->second.overlap_map, new_overlap_gids, nComp, commT);
+    it->second.dofManager.setup(
+        nComp, numOwnedNodes, numGlobalNodes, interleavedOrdering);
+    it->second.overlap_dofManager.setup(
+        nComp, numOverlapNodes, numGlobalNodes, interleavedOrdering);
+  }
+  for (auto it = mapOfDOFsStructs.begin(); it != mapOfDOFsStructs.end(); ++it) {
+    auto it2 = mapOfDOFsStructs.find(make_pair(it->first.first, 1));
+    it->second.node_map         = it2->second.map;
+    it->second.overlap_node_map = it2->second.overlap_map;
+  }
+
+  node_mapT = nodalDOFsStructContainer.getDOFsStruct("mesh_nodes").map;
+  mapT      = nodalDOFsStructContainer.getDOFsStruct("ordinary_solution").map;
+  overlap_node_mapT =
+      nodalDOFsStructContainer.getDOFsStruct("mesh_nodes").overlap_map;
+  overlap_mapT =
+      nodalDOFsStructContainer.getDOFsStruct("ordinary_solution").overlap_map;
+
+#ifdef ALBANY_EPETRA
+  map              = Petra::TpetraMap_To_EpetraMap(mapT, comm);
+  node_map         = Petra::TpetraMap_To_EpetraMap(node_mapT, comm);
+  overlap_map      = Petra::TpetraMap_To_EpetraMap(overlap_mapT, comm);
+  overlap_node_map = Petra::TpetraMap_To_EpetraMap(overlap_node_mapT, comm);
+#endif
+
+  coordinates.resize(3 * numOverlapNodes);
+
+  patchMLCoords(new_owned_nodes);
+
+  patchGraphs(touched_nodes);
+
+  patchWorksetInfo(owned_cells);
+
+  refreshCoordinateViews();
+
+  patchNodeSets(new_owned_nodes);
+
+  // The cells keep their workset slots and side ordinals, so the side sets
+  // only change if a modified cell has a side in one
+  if (touches_side_set) computeSideSets();
+
+  // The output mesh is defined again at the next write, if there is one
+#ifdef ALBANY_SEACAS
+  if (stkMeshStruct->exoOutput) {
+    mesh_data      = Teuchos::null;
+    outputInterval = 0;
+  }
+#endif
+
+  if (commT->getRank() == 0)
+    *out << "STKDisc: incremental update of " << owned_cells.size()
+         << " cells and " << new_overlap_nodes.size() << " new nodes on Proc 0"
+         << std::endl;
+
+  return true;
+}
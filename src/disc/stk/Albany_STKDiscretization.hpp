@@ -7,6 +7,9 @@
 #ifndef ALBANY_STKDISCRETIZATION_HPP
 #define ALBANY_STKDISCRETIZATION_HPP
 
+#include <map>
+#include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -108,7 +111,8 @@ class STKDiscretization : public Albany::AbstractDiscretization {
       const Teuchos::RCP<Albany::RigidBodyModes>&  rigidBodyModes =
           Teuchos::null,
       const std::map<int, std::vector<std::string>>& sideSetEquations =
-          std::map<int, std::vector<std::string>>());
+          std::map<int, std::vector<std::string>>(),
+      const bool residual_only_scheme = false);
 
   //! Destructor
   ~STKDiscretization();
@@ -429,6 +433,12 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   getSolutionFieldHistoryImpl(Epetra_MultiVector& result) const;
   void
   getSolutionFieldHistoryImpl(Epetra_MultiVector& result, int stepMin, int stepMax) const;
+
+  //! Residual snapshots stored in the input mesh, same step range as above
+  Teuchos::RCP<Epetra_MultiVector>
+  getResidualFieldHistory(int minStep, int maxStep) const;
+  void
+  getResidualFieldHistory(Epetra_MultiVector& result) const;
 #endif
 
   // Tpetra analog
@@ -491,6 +501,23 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   void
   updateMesh();
 
+  //! After a local topology change (e.g. LCM fracture) that only re-attaches
+  //! existing cells to new nodes, patch the maps, graphs and workset
+  //! connectivity for the modified cells instead of rebuilding everything.
+  //! new_nodes are the nodes the change created on this rank. They are
+  //! appended to the owned/overlap maps so that the local ids of all existing
+  //! nodes are preserved, and only the graph rows, workset cells, coordinate
+  //! views and node set entries of the affected nodes are touched. Falls back
+  //! to updateMesh() when the change is not local (more than
+  //! max_modified_fraction of the owned cells on any rank) or the
+  //! discretization uses features the patch path does not handle. Returns
+  //! true if the incremental path was taken.
+  bool
+  updateMeshIncremental(
+      stk::mesh::EntityVector const& modified_cells,
+      stk::mesh::EntityVector const& new_nodes,
+      double const                   max_modified_fraction = 0.1);
+
   //! Function that transforms an STK mesh of a unit cube (for FELIX problems)
   void
   transformMesh();
@@ -569,6 +596,10 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   // Copy values from STK Mesh field to given Epetra_Vector
   void
   getSolutionField(Epetra_Vector& result, bool overlapped = false) const;
+
+  // Copy values from STK Mesh residual field to given Epetra_Vector
+  void
+  getResidualField(Epetra_Vector& result) const;
 #endif
   // Copy values from STK Mesh field to given Tpetra_Vector
   void
@@ -623,9 +654,21 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   void
   computeNodalMaps(bool overlapped);
 
+  //! Sort the elements of each bucket along a space filling curve
+  void
+  sortElements();
+
+  //! Local position of each of the given nodes under the "Local DOF
+  //! Ordering", keyed by global id. Empty for the native ordering.
+  std::unordered_map<GO, int>
+  computeNodeOrdering(const std::vector<stk::mesh::Entity>& nodes) const;
+
   //! Process STK mesh for CRS Graphs
   virtual void
   computeGraphs();
+  //! Diagonal graphs for residual-only schemes, which never form a Jacobian
+  void
+  computeGraphsResidualOnly();
   //! Process STK mesh for Owned nodal quantitites
   void
   computeOwnedNodesAndUnknowns();
@@ -818,6 +861,14 @@ class STKDiscretization : public Albany::AbstractDiscretization {
 #endif
   bool interleavedOrdering;
 
+  //! "Element Ordering" and "Local DOF Ordering" discretization parameters
+  std::string elementOrdering;
+  std::string localDOFOrdering;
+
+  //! Only a diagonal is reserved in the graphs of residual-only schemes
+  //! ("Transient Explicit"), which never assemble a Jacobian
+  bool residual_only_scheme;
+
  private:
   Teuchos::RCP<Tpetra_CrsGraph> nodalGraph;
 
@@ -864,6 +915,58 @@ class STKDiscretization : public Albany::AbstractDiscretization {
   computeGraphsUpToFillComplete();
   void
   fillCompleteGraphs();
+
+  //! Check whether updateMeshIncremental can patch the current structures
+  bool
+  canUpdateIncrementally(
+      stk::mesh::EntityVector const& modified_cells,
+      double const                   max_modified_fraction) const;
+
+  //! Rebuild the overlap graph rows of the given nodes, copying all others
+  void
+  patchGraphs(std::set<GO> const& touched_nodes);
+
+  //! Refill the workset connectivity of the given (owned) cells
+  void
+  patchWorksetInfo(stk::mesh::EntityVector const& cells_to_patch);
+
+  //! Extend the ML/MueLu coordinates with the new owned nodes
+  void
+  patchMLCoords(std::vector<stk::mesh::Entity> const& new_owned_nodes);
+
+  //! Add the new owned nodes to the node sets they belong to
+  void
+  patchNodeSets(std::vector<stk::mesh::Entity> const& new_owned_nodes);
+
+  //! Reset the coordinate pointers of the cells and node set entries whose
+  //! nodes are in node buckets STK rearranged
+  void
+  refreshCoordinateViews();
+
+  //! Record the signatures of all node buckets
+  void
+  recordNodeBuckets();
+
+  //! What identifies the layout of a node bucket: STK moves field data only
+  //! when it adds, removes or reorders the entities of a bucket
+  struct NodeBucketSignature
+  {
+    std::size_t       size{0};
+    double const*     coords{nullptr};
+    stk::mesh::Entity first, last;
+
+    bool
+    operator==(NodeBucketSignature const& other) const
+    {
+      return size == other.size && coords == other.coords &&
+             first == other.first && last == other.last;
+    }
+  };
+
+  NodeBucketSignature
+  nodeBucketSignature(stk::mesh::Bucket const& bucket) const;
+
+  std::map<stk::mesh::Bucket const*, NodeBucketSignature> nodeBucketSignatures;
 };
 }
 
@@ -19,6 +19,7 @@
 #endif
 #include "Teuchos_Array.hpp"
 #include "Teuchos_TestForException.hpp"
+#include "utility/Expression.hpp"
 
 namespace PHAL {
 
@@ -391,6 +392,142 @@ evaluateFields(typename Traits::EvalData workset){
 ////////////////////////////////////////////////////////////////////////////////
 
 
+template<typename EvalT, typename Traits>
+class Expression :
+    public Source_Base<EvalT,Traits>,
+    public Sacado::ParameterAccessor<EvalT, SPL_Traits> {
+public :
+  typedef typename EvalT::ScalarT ScalarT;
+  typedef typename EvalT::MeshScalarT MeshScalarT;
+  static bool check_for_existance(Teuchos::ParameterList* source_list);
+  Expression(Teuchos::ParameterList& p);
+  virtual ~Expression(){}
+  virtual void EvaluatedFields(Source<EvalT,Traits> &source,
+			       Teuchos::ParameterList& p);
+  virtual void DependentFields(Source<EvalT,Traits> &source,
+			       Teuchos::ParameterList& p);
+  virtual void FieldData(PHX::EvaluatorUtilities<EvalT,Traits> &utils,
+			 PHX::FieldManager<Traits>& fm);
+  virtual void evaluateFields (typename Traits::EvalData workset);
+  virtual ScalarT & getValue(const std::string &n) { return m_scale;};
+private :
+  ScalarT     m_scale;
+  std::size_t m_num_qp;
+  std::size_t m_num_dim;
+  util::Expression m_formula;
+  std::vector<MeshScalarT> m_registers;
+  std::vector<RealType>    m_coords;
+  std::vector<RealType>    m_values;
+  Teuchos::ParameterList* m_source_list;
+  PHX::MDField<ScalarT,Cell,Point> m_source;
+  PHX::MDField<const MeshScalarT,Cell,Point,Dim> coordVec;
+};
+
+template<typename EvalT,typename Traits>
+bool
+Expression<EvalT,Traits>::
+check_for_existance(Teuchos::ParameterList* source_list)
+{
+  const bool exists = source_list->getEntryPtr("Expression");
+  return exists;
+}
+
+template<typename EvalT,typename Traits>
+Expression<EvalT,Traits>::
+Expression(Teuchos::ParameterList& p) {
+  m_source_list = p.get<Teuchos::ParameterList*>("Parameter List", NULL);
+  Teuchos::ParameterList& paramList = m_source_list->sublist("Expression");
+  m_scale = paramList.get("Scale", 1.0);
+  // Compile the formula of x, y, z once, it is only run per workset
+  const std::string formula = paramList.get<std::string>("Formula", "0");
+  try {
+    m_formula.compile(formula, {"x", "y", "z"});
+  }
+  catch (std::invalid_argument& e) {
+    TEUCHOS_TEST_FOR_EXCEPTION(true, Teuchos::Exceptions::InvalidParameter,
+                               "Error! Expression source: " << e.what());
+  }
+  // Add the scale as a Sacado-ized parameter
+  Teuchos::RCP<ParamLib> paramLib =
+    p.get< Teuchos::RCP<ParamLib> > ("Parameter Library", Teuchos::null);
+  this->registerSacadoParameter("Expression Source Scale", paramLib);
+}
+
+template<typename EvalT,typename Traits>
+void Expression<EvalT,Traits>::
+EvaluatedFields(Source<EvalT,Traits> &source, Teuchos::ParameterList& p) {
+  Teuchos::RCP<PHX::DataLayout> dl =
+    p.get< Teuchos::RCP<PHX::DataLayout> >("QP Scalar Data Layout");
+  PHX::MDField<ScalarT,Cell,Point> f(p.get<std::string>("Source Name"), dl);
+  m_source = f ;
+  source.addEvaluatedField(m_source);
+}
+
+template<typename EvalT,typename Traits>
+void
+Expression<EvalT,Traits>::
+DependentFields(Source<EvalT,Traits> &source, Teuchos::ParameterList& p)
+{
+  Teuchos::RCP<PHX::DataLayout> vector_qp = p.get< Teuchos::RCP<PHX::DataLayout> >("QP Vector Data Layout");
+
+  coordVec = decltype(coordVec)(
+      p.get<std::string>("QP Coordinate Vector Name"),  vector_qp);
+  source.addDependentField(coordVec);
+}
+
+template<typename EvalT,typename Traits>
+void
+Expression<EvalT,Traits>::
+FieldData(PHX::EvaluatorUtilities<EvalT,Traits> &utils,
+	  PHX::FieldManager<Traits>& fm){
+  utils.setFieldData(m_source, fm);
+  utils.setFieldData(coordVec,fm);
+  typename std::vector< typename PHX::template MDField<ScalarT,Cell,Node>::size_type > dims;
+  coordVec.dimensions(dims);
+  m_num_qp = dims[1];
+  m_num_dim = dims[2];
+  TEUCHOS_TEST_FOR_EXCEPTION(m_num_dim > 3, std::logic_error,
+                             "Error! Expression source supports at most 3 dimensions.");
+}
+
+template<typename EvalT,typename Traits>
+void
+Expression<EvalT,Traits>::
+evaluateFields(typename Traits::EvalData workset){
+
+  const std::size_t n = workset.numCells * m_num_qp;
+  if (n == 0) return;
+
+  if (std::is_same<MeshScalarT, RealType>::value) {
+    // Plain coordinates: run the formula over all points of the workset at once
+    m_coords.assign(3 * n, 0.0);
+    for (std::size_t cell = 0; cell < workset.numCells; ++cell)
+      for (std::size_t iqp=0; iqp<m_num_qp; iqp++)
+        for (std::size_t i=0; i<m_num_dim; i++)
+          m_coords[i * n + cell * m_num_qp + iqp] =
+            Sacado::ScalarValue<MeshScalarT>::eval(coordVec(cell,iqp,i));
+    const RealType* columns[3] = {m_coords.data(), m_coords.data() + n, m_coords.data() + 2 * n};
+    m_values.resize(n);
+    m_formula.evaluate(n, columns, m_values.data());
+    for (std::size_t cell = 0; cell < workset.numCells; ++cell)
+      for (std::size_t iqp=0; iqp<m_num_qp; iqp++)
+        m_source(cell, iqp) = m_scale * m_values[cell * m_num_qp + iqp];
+  }
+  else {
+    // Coordinates carry derivatives: evaluate point by point to keep them
+    for (std::size_t cell = 0; cell < workset.numCells; ++cell) {
+      for (std::size_t iqp=0; iqp<m_num_qp; iqp++) {
+        MeshScalarT X[3] = {0.0, 0.0, 0.0};
+        for (std::size_t i=0; i<m_num_dim; i++) X[i] = coordVec(cell,iqp,i);
+        m_source(cell, iqp) = m_scale * m_formula.evaluate(X, m_registers);
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+
 template<typename EvalT, typename Traits>
 class Quadratic : 
     public Source_Base<EvalT,Traits>, 
@@ -1129,6 +1266,12 @@ Source<EvalT, Traits>::Source(Teuchos::ParameterList& p)
     m_sources.push_back(sb);
     this->setName("TrigonometricSource" );
   }
+  if (Expression<EvalT,Traits>::check_for_existance(source_list)) {
+    Expression<EvalT,Traits>    *q = new Expression<EvalT,Traits>(p);
+    Source_Base<EvalT,Traits> *sb = q;
+    m_sources.push_back(sb);
+    this->setName("ExpressionSource" );
+  }
 #ifdef ALBANY_STOKHOS
   if (TruncatedKL<EvalT,Traits>::check_for_existance(source_list)) {
     TruncatedKL<EvalT,Traits>    *q = new TruncatedKL<EvalT,Traits>(p);
@@ -52,6 +52,12 @@ Albany::AbstractProblem::AbstractProblem(
     number_of_time_deriv = 1;
     SolutionMethodName = Transient;
   }
+  else if(solutionMethod == "Transient Explicit")
+  {
+    // Central differences need accelerations
+    number_of_time_deriv = 2;
+    SolutionMethodName = Transient;
+  }
   else if(solutionMethod == "Transient Tempus" || solutionMethod == "Transient Tempus No Piro")
   {
     number_of_time_deriv = 1;
@@ -69,7 +75,7 @@ Albany::AbstractProblem::AbstractProblem(
   }
   else
     TEUCHOS_TEST_FOR_EXCEPTION(true,
-            std::logic_error, "Solution Method must be Steady, Transient, Transient Tempus, "
+            std::logic_error, "Solution Method must be Steady, Transient, Transient Explicit, Transient Tempus, "
             << "Continuation, Eigensolve, or Aeras Hyperviscosity, not : " << solutionMethod);
 
    // Set the number in the Problem PL
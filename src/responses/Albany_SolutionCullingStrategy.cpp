@@ -8,6 +8,7 @@
 
 #if defined(ALBANY_EPETRA)
 #include "Epetra_BlockMap.h"
+#include "Epetra_Comm.h"
 #include "Epetra_GatherAllV.hpp"
 #endif
 #include "Tpetra_GatherAllV.hpp" 
@@ -36,6 +37,69 @@ private:
 
 } // namespace Albany
 
+namespace {
+
+// The GIDs of ranks i * stride, stride = 1 + (n - 1) / numValues, in the
+// sorted list of the n GIDs of a one-to-one map, without gathering that
+// list. If the GIDs are min, ..., max they follow directly. Otherwise each
+// is the smallest g with at least rank + 1 GIDs <= g, found by bisecting
+// all of them at once: one sum of numValues counts per step, at most
+// log2(max - min) + 1 steps. The memory per process is that of its own
+// GIDs and the selection.
+template <typename GO, typename SumAll>
+Teuchos::Array<GO>
+uniformSelection(
+    const Teuchos::ArrayView<const GO> &myGIDs,
+    const GO minAllGID, const GO maxAllGID, const GO numGlobal,
+    const int numValues, const SumAll &sumAll)
+{
+  Teuchos::Array<GO> ranks;
+  if (numGlobal > 0) {
+    const GO stride = 1 + (numGlobal - 1) / numValues;
+    for (GO i = 0; i < numValues && i * stride < numGlobal; ++i) {
+      ranks.push_back(i * stride);
+    }
+  }
+  const int numSelected = ranks.size();
+
+  Teuchos::Array<GO> lo(numSelected, minAllGID);
+  if (maxAllGID - minAllGID + 1 == numGlobal) {
+    for (int i = 0; i < numSelected; ++i) lo[i] += ranks[i];
+    return lo;
+  }
+
+  Teuchos::Array<GO> sortedGIDs(myGIDs.begin(), myGIDs.end());
+  std::sort(sortedGIDs.begin(), sortedGIDs.end());
+
+  Teuchos::Array<GO> hi(numSelected, maxAllGID);
+  Teuchos::Array<GO> mid(numSelected);
+  Teuchos::Array<GO> myCounts(numSelected);
+  Teuchos::Array<GO> counts(numSelected);
+  for (;;) {
+    bool done = true;
+    for (int i = 0; i < numSelected; ++i) {
+      done = done && lo[i] == hi[i];
+      mid[i] = lo[i] + (hi[i] - lo[i]) / 2;
+      myCounts[i] =
+          std::upper_bound(sortedGIDs.begin(), sortedGIDs.end(), mid[i]) -
+          sortedGIDs.begin();
+    }
+    // Same on all processes: the bounds only change through the sums
+    if (done) break;
+    sumAll(myCounts, counts);
+    for (int i = 0; i < numSelected; ++i) {
+      if (counts[i] >= ranks[i] + 1) {
+        hi[i] = mid[i];
+      } else {
+        lo[i] = mid[i] + 1;
+      }
+    }
+  }
+  return lo;
+}
+
+} // namespace
+
 Albany::UniformSolutionCullingStrategy::
 UniformSolutionCullingStrategy(int numValues) :
   numValues_(numValues)
@@ -47,22 +111,17 @@ Teuchos::Array<Tpetra_GO>
 Albany::UniformSolutionCullingStrategy::
 selectedGIDsT(Teuchos::RCP<const Tpetra_Map> sourceMapT) const
 {
-  Teuchos::Array<Tpetra_GO> allGIDs(sourceMapT->getGlobalNumElements());
-  {
-    const int ierr = Tpetra::GatherAllV(
-        sourceMapT->getComm(),
-        sourceMapT->getNodeElementList().getRawPtr(), sourceMapT->getNodeNumElements(),
-        allGIDs.getRawPtr(), allGIDs.size());
-    TEUCHOS_ASSERT(ierr == 0);
-  }
-  std::sort(allGIDs.begin(), allGIDs.end());
-
-  Teuchos::Array<Tpetra_GO> result(numValues_);
-  const int stride = 1 + (allGIDs.size() - 1) / numValues_;
-  for (int i = 0; i < numValues_; ++i) {
-    result[i] = allGIDs[i * stride];
-  }
-  return result;
+  Teuchos::RCP<const Teuchos::Comm<int> > commT = sourceMapT->getComm();
+  const auto sumAll = [&commT](
+      const Teuchos::Array<Tpetra_GO> &in, Teuchos::Array<Tpetra_GO> &out) {
+    Teuchos::reduceAll<int, Tpetra_GO>(
+        *commT, Teuchos::REDUCE_SUM, in.size(), in.getRawPtr(), out.getRawPtr());
+  };
+  return uniformSelection<Tpetra_GO>(
+      sourceMapT->getNodeElementList(),
+      sourceMapT->getMinAllGlobalIndex(), sourceMapT->getMaxAllGlobalIndex(),
+      static_cast<Tpetra_GO>(sourceMapT->getGlobalNumElements()),
+      numValues_, sumAll);
 }
 
 #if defined(ALBANY_EPETRA)
@@ -70,22 +129,17 @@ Teuchos::Array<int>
 Albany::UniformSolutionCullingStrategy::
 selectedGIDs(const Epetra_BlockMap &sourceMap) const
 {
-  Teuchos::Array<int> allGIDs(sourceMap.NumGlobalElements());
-  {
-    const int ierr = Epetra::GatherAllV(
-        sourceMap.Comm(),
-        sourceMap.MyGlobalElements(), sourceMap.NumMyElements(),
-        allGIDs.getRawPtr(), allGIDs.size());
+  const Epetra_Comm &comm = sourceMap.Comm();
+  const auto sumAll = [&comm](
+      const Teuchos::Array<int> &in, Teuchos::Array<int> &out) {
+    Teuchos::Array<int> inCopy(in);
+    const int ierr = comm.SumAll(inCopy.getRawPtr(), out.getRawPtr(), in.size());
     TEUCHOS_ASSERT(ierr == 0);
-  }
-  std::sort(allGIDs.begin(), allGIDs.end());
-
-  Teuchos::Array<int> result(numValues_);
-  const int stride = 1 + (allGIDs.size() - 1) / numValues_;
-  for (int i = 0; i < numValues_; ++i) {
-    result[i] = allGIDs[i * stride];
-  }
-  return result;
+  };
+  return uniformSelection<int>(
+      Teuchos::arrayView(sourceMap.MyGlobalElements(), sourceMap.NumMyElements()),
+      sourceMap.MinAllGID(), sourceMap.MaxAllGID(),
+      sourceMap.NumGlobalElements(), numValues_, sumAll);
 }
 #endif
 
@@ -177,7 +177,7 @@ evaluateResponse(const double /*current_time*/,
   this->updateSolutionImporter();
   this->ImportWithAlternateMap(*solutionImporter_, x, g, Insert);
   if (Teuchos::nonnull(sol_printer_))
-    sol_printer_->print(g, cullingStrategy_->selectedGIDs(*app_->getMap()));
+    sol_printer_->print(g, selectedGIDs_);
 }
 #endif
 
@@ -193,7 +193,7 @@ evaluateResponseT(const double /*current_time*/,
   this->updateSolutionImporterT();
   this->ImportWithAlternateMapT(solutionImporterT_, xT, gT, Tpetra::INSERT);
   if (Teuchos::nonnull(sol_printer_))
-    sol_printer_->print(gT, cullingStrategy_->selectedGIDsT(app_->getMapT()));
+    sol_printer_->print(gT, selectedGIDsT_);
 }
 
 #if defined(ALBANY_EPETRA)
@@ -222,7 +222,7 @@ evaluateTangent(const double /*alpha*/,
   if (g) {
     this->ImportWithAlternateMap(*solutionImporter_, x, *g, Insert);
     if (Teuchos::nonnull(sol_printer_))
-      sol_printer_->print(*g, cullingStrategy_->selectedGIDs(*app_->getMap()));
+      sol_printer_->print(*g, selectedGIDs_);
   }
 
   if (gx) {
@@ -265,7 +265,7 @@ evaluateTangentT(const double /*alpha*/,
   if (gT) {
     this->ImportWithAlternateMapT(solutionImporterT_, xT, *gT, Tpetra::INSERT);
     if (Teuchos::nonnull(sol_printer_))
-      sol_printer_->print(*gT, cullingStrategy_->selectedGIDsT(app_->getMapT()));
+      sol_printer_->print(*gT, selectedGIDsT_);
   }
 
   if (gxT) {
@@ -302,7 +302,7 @@ evaluateGradient(const double /*current_time*/,
   if (g) {
     this->ImportWithAlternateMap(*solutionImporter_, x, *g, Insert);
     if (Teuchos::nonnull(sol_printer_))
-      sol_printer_->print(*g, cullingStrategy_->selectedGIDs(*app_->getMap()));
+      sol_printer_->print(*g, selectedGIDs_);
   }
 
   if (dg_dx) {
@@ -368,7 +368,7 @@ evaluateGradientT(const double /*current_time*/,
   if (gT) {
     this->ImportWithAlternateMapT(solutionImporterT_, xT, *gT, Tpetra::INSERT);
     if (Teuchos::nonnull(sol_printer_))
-      sol_printer_->print(*gT, cullingStrategy_->selectedGIDsT(app_->getMapT()));
+      sol_printer_->print(*gT, selectedGIDsT_);
   }
 
   if (dg_dxT) {
@@ -405,8 +405,8 @@ updateSolutionImporter()
 {
   const Teuchos::RCP<const Epetra_BlockMap> solutionMap = app_->getMap();
   if (Teuchos::is_null(solutionImporter_) || !solutionMap->SameAs(solutionImporter_->SourceMap())) {
-    const Teuchos::Array<int> selectedGIDs = cullingStrategy_->selectedGIDs(*solutionMap);
-    const Epetra_Map targetMap(-1, selectedGIDs.size(), selectedGIDs.getRawPtr(), 0, solutionMap->Comm());
+    selectedGIDs_ = cullingStrategy_->selectedGIDs(*solutionMap);
+    const Epetra_Map targetMap(-1, selectedGIDs_.size(), selectedGIDs_.getRawPtr(), 0, solutionMap->Comm());
     solutionImporter_ = Teuchos::rcp(new Epetra_Import(targetMap, *solutionMap));
   }
 }
@@ -418,8 +418,8 @@ updateSolutionImporterT()
 {
   const Teuchos::RCP<const Tpetra_Map> solutionMapT = app_->getMapT();
   if (Teuchos::is_null(solutionImporterT_) || !solutionMapT->isSameAs(*solutionImporterT_->getSourceMap())) {
-    const Teuchos::Array<Tpetra_GO> selectedGIDsT = cullingStrategy_->selectedGIDsT(solutionMapT);
-    Teuchos::RCP<const Tpetra_Map> targetMapT = Tpetra::createNonContigMapWithNode<LO, Tpetra_GO, KokkosNode> (selectedGIDsT, solutionMapT->getComm(), solutionMapT->getNode());
+    selectedGIDsT_ = cullingStrategy_->selectedGIDsT(solutionMapT);
+    Teuchos::RCP<const Tpetra_Map> targetMapT = Tpetra::createNonContigMapWithNode<LO, Tpetra_GO, KokkosNode> (selectedGIDsT_, solutionMapT->getComm(), solutionMapT->getNode());
     //const Epetra_Map targetMap(-1, selectedGIDs.size(), selectedGIDs.getRawPtr(), 0, solutionMap->Comm());
     solutionImporterT_ = Teuchos::rcp(new Tpetra_Import(solutionMapT, targetMapT));
   }
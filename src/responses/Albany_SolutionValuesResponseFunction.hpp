@@ -160,6 +160,12 @@ namespace Albany {
 #endif
     Teuchos::RCP<Tpetra_Import> solutionImporterT_;
 
+    //! GIDs of the sampled values, selected once per solution map
+#if defined(ALBANY_EPETRA)
+    Teuchos::Array<int> selectedGIDs_;
+#endif
+    Teuchos::Array<Tpetra_GO> selectedGIDsT_;
+
     class SolutionPrinter;
     Teuchos::RCP<SolutionPrinter> sol_printer_;
 
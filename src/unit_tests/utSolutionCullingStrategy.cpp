@@ -0,0 +1,144 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include <Teuchos_UnitTestHarness.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include "Albany_SolutionCullingStrategy.hpp"
+#include "Tpetra_GatherAllV.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+int const n = 103;
+
+//
+// One-to-one map with the GIDs gid(0), ..., gid(n - 1) dealt to the
+// processes in turn, in decreasing order on each: neither the global nor
+// the local GIDs are contiguous, and the local ones are not sorted
+//
+Teuchos::RCP<Tpetra_Map const>
+dealtMap(Tpetra_GO (*gid)(Tpetra_GO))
+{
+  Teuchos::RCP<Teuchos::Comm<int> const> const
+  comm = Teuchos::DefaultComm<int>::getComm();
+
+  Teuchos::Array<Tpetra_GO>
+  my_gids;
+
+  for (int k = n - 1; k >= 0; --k) {
+    if (k % comm->getSize() == comm->getRank()) my_gids.push_back(gid(k));
+  }
+
+  return Teuchos::rcp(new Tpetra_Map(
+      Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid(), my_gids(), 0,
+      comm));
+}
+
+Tpetra_GO
+gappedGID(Tpetra_GO const k)
+{
+  return 7 + 3 * k + k % 2;
+}
+
+Tpetra_GO
+contiguousGID(Tpetra_GO const k)
+{
+  return k;
+}
+
+//
+// The selection as it was made before: gather and sort all the GIDs, and
+// take those of ranks i * stride that are in the list
+//
+Teuchos::Array<Tpetra_GO>
+gatherAndSort(Tpetra_Map const & map, int const num_values)
+{
+  Teuchos::Array<Tpetra_GO>
+  all_gids(map.getGlobalNumElements());
+
+  int const
+  ierr = Tpetra::GatherAllV(
+      map.getComm(),
+      map.getNodeElementList().getRawPtr(), map.getNodeNumElements(),
+      all_gids.getRawPtr(), all_gids.size());
+  TEUCHOS_ASSERT(ierr == 0);
+
+  std::sort(all_gids.begin(), all_gids.end());
+
+  Teuchos::Array<Tpetra_GO>
+  result;
+
+  int const
+  stride = 1 + (all_gids.size() - 1) / num_values;
+
+  for (int i = 0; i < num_values && i * stride < all_gids.size(); ++i) {
+    result.push_back(all_gids[i * stride]);
+  }
+  return result;
+}
+
+Teuchos::Array<Tpetra_GO>
+uniformSelection(Teuchos::RCP<Tpetra_Map const> const & map,
+    int const num_values)
+{
+  Teuchos::ParameterList
+  params;
+
+  params.set("Culling Strategy", "Uniform");
+  params.set("Num Values", num_values);
+
+  Teuchos::RCP<Albany::SolutionCullingStrategyBase> const
+  strategy = Albany::createSolutionCullingStrategy(Teuchos::null, params);
+
+  strategy->setupT();
+  return strategy->selectedGIDsT(map);
+}
+
+TEUCHOS_UNIT_TEST(UniformSolutionCulling, NonContiguousMap)
+{
+  Teuchos::RCP<Tpetra_Map const> const
+  map = dealtMap(gappedGID);
+
+  TEST_ASSERT(map->getMaxAllGlobalIndex() - map->getMinAllGlobalIndex() + 1 >
+      static_cast<Tpetra_GO>(map->getGlobalNumElements()));
+
+  for (int num_values = 1; num_values <= n; num_values += 6) {
+    Teuchos::Array<Tpetra_GO> const
+    expected = gatherAndSort(*map, num_values);
+
+    TEST_COMPARE_ARRAYS(uniformSelection(map, num_values), expected);
+  }
+}
+
+TEUCHOS_UNIT_TEST(UniformSolutionCulling, ContiguousMap)
+{
+  Teuchos::RCP<Tpetra_Map const> const
+  map = dealtMap(contiguousGID);
+
+  for (int num_values = 1; num_values <= n; num_values += 6) {
+    Teuchos::Array<Tpetra_GO> const
+    expected = gatherAndSort(*map, num_values);
+
+    TEST_COMPARE_ARRAYS(uniformSelection(map, num_values), expected);
+  }
+}
+
+TEUCHOS_UNIT_TEST(UniformSolutionCulling, MoreValuesThanGIDs)
+{
+  // Every GID once, and no read past the end of the list
+  Teuchos::RCP<Tpetra_Map const> const
+  map = dealtMap(gappedGID);
+
+  Teuchos::Array<Tpetra_GO>
+  expected(n);
+
+  for (int k = 0; k < n; ++k) expected[k] = gappedGID(k);
+
+  TEST_COMPARE_ARRAYS(uniformSelection(map, 2 * n), expected);
+}
+
+} // anonymous namespace
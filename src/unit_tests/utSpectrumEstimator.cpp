@@ -0,0 +1,110 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+#include <Teuchos_UnitTestHarness.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include "Albany_SpectrumEstimatorT.hpp"
+
+namespace
+{
+
+int const n = 50;
+
+//
+// Singular value i of the test matrices: 1, ..., n, with alternating signs
+// on the matrix entries
+//
+ST
+entry(Tpetra_GO const i)
+{
+  return (i % 2 == 0 ? 1.0 : -1.0) * (i + 1);
+}
+
+//
+// J = P D, with D = diag(entry(i)) and P the cyclic shift of the columns:
+// nonsymmetric, with singular values 1, ..., n
+//
+Teuchos::RCP<Tpetra_CrsMatrix>
+shiftedDiagonal()
+{
+  Teuchos::RCP<Tpetra_Map const> const
+  map = Teuchos::rcp(new Tpetra_Map(n, 0, Teuchos::DefaultComm<int>::getComm()));
+
+  Teuchos::RCP<Tpetra_CrsMatrix> const
+  J = Teuchos::rcp(new Tpetra_CrsMatrix(map, 1));
+
+  for (Tpetra_LO k = 0; k < static_cast<Tpetra_LO>(map->getNodeNumElements());
+       ++k) {
+    Tpetra_GO const
+    row = map->getGlobalElement(k);
+
+    Tpetra_GO const
+    col = (row + 1) % n;
+
+    ST const
+    value = entry(col);
+
+    J->insertGlobalValues(row, Teuchos::tuple(col), Teuchos::tuple(value));
+  }
+  J->fillComplete();
+  return J;
+}
+
+TEUCHOS_UNIT_TEST(SpectrumEstimator, KnownSingularValues)
+{
+  // n iterations span the whole space: the Ritz values are exact
+  Albany::SpectrumEstimatorT const
+  estimator(n, 1.0e-12);
+
+  Albany::SpectrumEstimateT const
+  result = estimator.estimate(*shiftedDiagonal());
+
+  TEST_ASSERT(result.valid);
+  TEST_FLOATING_EQUALITY(result.sigma_max, ST(n), 1.0e-8);
+  TEST_FLOATING_EQUALITY(result.sigma_min, 1.0, 1.0e-8);
+  TEST_FLOATING_EQUALITY(result.condition_number, ST(n), 1.0e-8);
+  TEST_ASSERT(result.num_iterations <= n);
+  TEST_EQUALITY(result.num_matvecs, 2 * result.num_iterations);
+}
+
+TEUCHOS_UNIT_TEST(SpectrumEstimator, BoundsFromInside)
+{
+  // A few iterations: the Ritz values lie inside the spectrum
+  Albany::SpectrumEstimatorT const
+  estimator(8, 1.0e-12);
+
+  Albany::SpectrumEstimateT const
+  result = estimator.estimate(*shiftedDiagonal());
+
+  TEST_EQUALITY(result.num_iterations, 8);
+  TEST_ASSERT(result.sigma_max <= n * (1.0 + 1.0e-12));
+  TEST_ASSERT(result.sigma_min >= 1.0 - 1.0e-12);
+  TEST_ASSERT(result.condition_number <= n * (1.0 + 1.0e-12));
+  // The largest singular value converges first
+  TEST_FLOATING_EQUALITY(result.sigma_max, ST(n), 5.0e-2);
+}
+
+TEUCHOS_UNIT_TEST(SpectrumEstimator, Deterministic)
+{
+  Albany::SpectrumEstimatorT const
+  estimator(10, 1.0e-2);
+
+  Teuchos::RCP<Tpetra_CrsMatrix> const
+  J = shiftedDiagonal();
+
+  Albany::SpectrumEstimateT const
+  first = estimator.estimate(*J);
+
+  Albany::SpectrumEstimateT const
+  second = estimator.estimate(*J);
+
+  TEST_EQUALITY(first.num_iterations, second.num_iterations);
+  TEST_EQUALITY(first.sigma_max, second.sigma_max);
+  TEST_EQUALITY(first.sigma_min, second.sigma_min);
+  TEST_EQUALITY(first.residual_max, second.residual_max);
+  TEST_EQUALITY(first.residual_min, second.residual_min);
+}
+
+} // anonymous namespace
@@ -0,0 +1,370 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+// @HEADER
+
+#include "Expression.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+namespace util {
+
+namespace {
+
+const double pi = 3.141592653589793;
+
+// Points processed per instruction in the array evaluation
+const std::size_t block_size = 256;
+
+// Expression tree built by the parser, constant subtrees already folded
+struct Node {
+  enum Kind { CONSTANT, VARIABLE, OPERATION };
+  Kind kind;
+  double value;
+  int variable;
+  Expression::OpCode op;
+  int left;
+  int right;
+};
+
+class Parser {
+public:
+  Parser (const std::string& text, const std::vector<std::string>& variables)
+      : text_(text), variables_(variables), pos_(0) {
+  }
+
+  std::vector<Node>& nodes () { return nodes_; }
+
+  int parse () {
+    skipAssignment();
+    const int root = comparison();
+    skipSpace();
+    while (pos_ < text_.size() && text_[pos_] == ';') {
+      ++pos_;
+      skipSpace();
+    }
+    if (pos_ != text_.size()) fail("unexpected character");
+    return root;
+  }
+
+private:
+
+  void fail (const std::string& what) const {
+    std::ostringstream msg;
+    msg << "Error parsing expression \"" << text_ << "\" at position "
+        << pos_ << ": " << what << ".";
+    throw std::invalid_argument(msg.str());
+  }
+
+  void skipSpace () {
+    while (pos_ < text_.size() && std::isspace(text_[pos_])) ++pos_;
+  }
+
+  bool accept (const char* token) {
+    skipSpace();
+    const std::size_t n = std::char_traits<char>::length(token);
+    if (text_.compare(pos_, n, token) != 0) return false;
+    pos_ += n;
+    return true;
+  }
+
+  void expect (const char* token) {
+    if (accept(token) == false) fail(std::string("expected '") + token + "'");
+  }
+
+  bool peekName () {
+    skipSpace();
+    return pos_ < text_.size() &&
+        (std::isalpha(text_[pos_]) || text_[pos_] == '_');
+  }
+
+  std::string name () {
+    skipSpace();
+    const std::size_t start = pos_;
+    while (pos_ < text_.size() &&
+           (std::isalnum(text_[pos_]) || text_[pos_] == '_'))
+      ++pos_;
+    return text_.substr(start, pos_ - start);
+  }
+
+  // Drop "name =" in front of the formula, but not "name == ..."
+  void skipAssignment () {
+    const std::size_t start = pos_;
+    if (peekName() == true) {
+      const std::string lhs = name();
+      skipSpace();
+      if (std::find(variables_.begin(), variables_.end(), lhs) == variables_.end() &&
+          pos_ < text_.size() && text_[pos_] == '=' &&
+          text_.compare(pos_, 2, "==") != 0) {
+        ++pos_;
+        return;
+      }
+    }
+    pos_ = start;
+  }
+
+  int constant (double value) {
+    Node n;
+    n.kind = Node::CONSTANT;
+    n.value = value;
+    n.variable = -1;
+    n.op = Expression::ADD;
+    n.left = n.right = -1;
+    nodes_.push_back(n);
+    return nodes_.size() - 1;
+  }
+
+  int variable (int index) {
+    const int id = constant(0.0);
+    nodes_[id].kind = Node::VARIABLE;
+    nodes_[id].variable = index;
+    return id;
+  }
+
+  int operation (Expression::OpCode op, int left, int right = -1) {
+    const bool unary = right < 0;
+    const Node& l = nodes_[left];
+    if (l.kind == Node::CONSTANT &&
+        (unary == true || nodes_[right].kind == Node::CONSTANT)) {
+      const double b = unary == true ? l.value : nodes_[right].value;
+      return constant(Expression::apply(op, l.value, b));
+    }
+    // x^2 and x^0.5 are common enough to avoid pow for
+    if (op == Expression::POW && nodes_[right].kind == Node::CONSTANT) {
+      if (nodes_[right].value == 1.0) return left;
+      if (nodes_[right].value == 2.0) return operation(Expression::MUL, left, left);
+      if (nodes_[right].value == 0.5) return operation(Expression::SQRT, left);
+    }
+    const int id = constant(0.0);
+    nodes_[id].kind = Node::OPERATION;
+    nodes_[id].op = op;
+    nodes_[id].left = left;
+    nodes_[id].right = unary == true ? left : right;
+    return id;
+  }
+
+  int comparison () {
+    int left = additive();
+    while (true) {
+      if (accept("<=")) left = operation(Expression::LE, left, additive());
+      else if (accept(">=")) left = operation(Expression::GE, left, additive());
+      else if (accept("==")) left = operation(Expression::EQ, left, additive());
+      else if (accept("!=")) left = operation(Expression::NE, left, additive());
+      else if (accept("<")) left = operation(Expression::LT, left, additive());
+      else if (accept(">")) left = operation(Expression::GT, left, additive());
+      else return left;
+    }
+  }
+
+  int additive () {
+    int left = term();
+    while (true) {
+      if (accept("+")) left = operation(Expression::ADD, left, term());
+      else if (accept("-")) left = operation(Expression::SUB, left, term());
+      else return left;
+    }
+  }
+
+  int term () {
+    int left = unary();
+    while (true) {
+      if (accept("*")) left = operation(Expression::MUL, left, unary());
+      else if (accept("/")) left = operation(Expression::DIV, left, unary());
+      else return left;
+    }
+  }
+
+  // Unary minus binds looser than ^, so -x^2 is -(x^2)
+  int unary () {
+    if (accept("-")) return operation(Expression::NEG, unary());
+    if (accept("+")) return unary();
+    return power();
+  }
+
+  int power () {
+    const int base = primary();
+    if (accept("^")) return operation(Expression::POW, base, unary());
+    return base;
+  }
+
+  int primary () {
+    skipSpace();
+    if (pos_ >= text_.size()) fail("unexpected end of expression");
+
+    if (accept("(")) {
+      const int inner = comparison();
+      expect(")");
+      return inner;
+    }
+
+    const char c = text_[pos_];
+    if (std::isdigit(c) || c == '.') {
+      const char* begin = text_.c_str() + pos_;
+      char* end = nullptr;
+      const double value = std::strtod(begin, &end);
+      if (end == begin) fail("invalid number");
+      pos_ += end - begin;
+      return constant(value);
+    }
+
+    if (peekName() == false) fail("unexpected character");
+    const std::string id = name();
+
+    const auto var = std::find(variables_.begin(), variables_.end(), id);
+    if (var != variables_.end()) return variable(var - variables_.begin());
+    if (id == "pi") return constant(pi);
+
+    static const struct { const char* name; Expression::OpCode op; } unary_fns[] = {
+      {"sin", Expression::SIN}, {"cos", Expression::COS}, {"tan", Expression::TAN},
+      {"asin", Expression::ASIN}, {"acos", Expression::ACOS}, {"atan", Expression::ATAN},
+      {"sinh", Expression::SINH}, {"cosh", Expression::COSH}, {"tanh", Expression::TANH},
+      {"exp", Expression::EXP}, {"log", Expression::LOG}, {"log10", Expression::LOG10},
+      {"sqrt", Expression::SQRT}, {"abs", Expression::ABS}, {"fabs", Expression::ABS}
+    };
+    static const struct { const char* name; Expression::OpCode op; } binary_fns[] = {
+      {"pow", Expression::POW}, {"atan2", Expression::ATAN2},
+      {"min", Expression::MIN}, {"max", Expression::MAX}
+    };
+
+    for (const auto& fn : unary_fns) {
+      if (id != fn.name) continue;
+      expect("(");
+      const int arg = comparison();
+      expect(")");
+      return operation(fn.op, arg);
+    }
+    for (const auto& fn : binary_fns) {
+      if (id != fn.name) continue;
+      expect("(");
+      const int a = comparison();
+      expect(",");
+      const int b = comparison();
+      expect(")");
+      return operation(fn.op, a, b);
+    }
+
+    fail("unknown name '" + id + "'");
+    return -1;
+  }
+
+  const std::string& text_;
+  const std::vector<std::string>& variables_;
+  std::size_t pos_;
+  std::vector<Node> nodes_;
+};
+
+// Apply op elementwise to m points.  d may alias a or b.
+void run (Expression::OpCode op, std::size_t m,
+          const double* a, const double* b, double* d) {
+  switch (op) {
+  case Expression::ADD: for (std::size_t i = 0; i < m; ++i) d[i] = a[i] + b[i]; break;
+  case Expression::SUB: for (std::size_t i = 0; i < m; ++i) d[i] = a[i] - b[i]; break;
+  case Expression::MUL: for (std::size_t i = 0; i < m; ++i) d[i] = a[i] * b[i]; break;
+  case Expression::DIV: for (std::size_t i = 0; i < m; ++i) d[i] = a[i] / b[i]; break;
+  case Expression::NEG: for (std::size_t i = 0; i < m; ++i) d[i] = -a[i]; break;
+  case Expression::SQRT: for (std::size_t i = 0; i < m; ++i) d[i] = std::sqrt(a[i]); break;
+  case Expression::EXP: for (std::size_t i = 0; i < m; ++i) d[i] = std::exp(a[i]); break;
+  default:
+    for (std::size_t i = 0; i < m; ++i) d[i] = Expression::apply(op, a[i], b[i]);
+    break;
+  }
+}
+
+}
+
+Expression::Expression ()
+    : num_variables_(0), num_registers_(1), result_(0) {
+  constants_.push_back(0.0);
+}
+
+Expression::Expression (const std::string& formula,
+                        const std::vector<std::string>& variables) {
+  compile(formula, variables);
+}
+
+void Expression::compile (const std::string& formula,
+                          const std::vector<std::string>& variables) {
+  Parser parser(formula, variables);
+  const int root = parser.parse();
+  const std::vector<Node>& nodes = parser.nodes();
+
+  formula_ = formula;
+  code_.clear();
+  constants_.clear();
+  num_variables_ = variables.size();
+
+  // Constants first, so that temporaries can be numbered after them
+  std::vector<int> const_reg(nodes.size(), -1);
+  for (std::size_t i = 0; i < nodes.size(); ++i) {
+    if (nodes[i].kind != Node::CONSTANT) continue;
+    const auto it = std::find(constants_.begin(), constants_.end(), nodes[i].value);
+    const_reg[i] = num_variables_ + (it - constants_.begin());
+    if (it == constants_.end()) constants_.push_back(nodes[i].value);
+  }
+  const int first_temp = num_variables_ + constants_.size();
+  num_registers_ = first_temp;
+
+  // Post order code generation.  The result of a subtree evaluated at depth
+  // k goes into temporary k; the right operand uses k + 1 and up, so the
+  // left operand is never overwritten before it is used.
+  struct Emitter {
+    const std::vector<Node>& nodes;
+    const std::vector<int>& const_reg;
+    std::vector<Instruction>& code;
+    int first_temp;
+    int& num_registers;
+
+    int emit (int id, int depth) {
+      const Node& n = nodes[id];
+      if (n.kind == Node::CONSTANT) return const_reg[id];
+      if (n.kind == Node::VARIABLE) return n.variable;
+      const int a = emit(n.left, depth);
+      const int b = n.right == n.left ? a : emit(n.right, depth + 1);
+      Instruction ins;
+      ins.op = n.op;
+      ins.dst = first_temp + depth;
+      ins.a = a;
+      ins.b = b;
+      code.push_back(ins);
+      num_registers = std::max(num_registers, ins.dst + 1);
+      return ins.dst;
+    }
+  } emitter = {nodes, const_reg, code_, first_temp, num_registers_};
+
+  result_ = emitter.emit(root, 0);
+}
+
+void Expression::evaluate (std::size_t n, const double* const* variables,
+                           double* result) const {
+  // Constants and temporaries live in one block sized buffer per register;
+  // variable registers point straight into the caller's arrays.
+  const int num_local = num_registers_ - num_variables_;
+  std::vector<double> buffer(num_local * block_size);
+  std::vector<const double*> in(num_registers_);
+  std::vector<double*> out(num_registers_, nullptr);
+  for (int r = num_variables_; r < num_registers_; ++r) {
+    out[r] = &buffer[(r - num_variables_) * block_size];
+    in[r] = out[r];
+  }
+  for (std::size_t c = 0; c < constants_.size(); ++c)
+    std::fill(out[num_variables_ + c], out[num_variables_ + c] + block_size,
+              constants_[c]);
+
+  for (std::size_t start = 0; start < n; start += block_size) {
+    const std::size_t m = std::min(block_size, n - start);
+    for (int v = 0; v < num_variables_; ++v)
+      in[v] = variables[v] + start;
+    for (const Instruction& ins : code_)
+      run(ins.op, m, in[ins.a], in[ins.b], out[ins.dst]);
+    std::copy(in[result_], in[result_] + m, result + start);
+  }
+}
+
+}
@@ -0,0 +1,189 @@
+//*****************************************************************//
+//    Albany 3.0:  Copyright 2016 Sandia Corporation               //
+//    This Software is released under the BSD license detailed     //
+//    in the file "license.txt" in the top-level Albany directory  //
+//*****************************************************************//
+
+// @HEADER
+
+#ifndef UTIL_EXPRESSION_HPP
+#define UTIL_EXPRESSION_HPP
+
+/**
+ *  \file Expression.hpp
+ *
+ *  \brief Analytic expressions compiled once to register bytecode
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace util {
+
+/**
+ *  \brief Formula of named variables compiled to a register bytecode
+ *
+ *  The formula is parsed once, constant subexpressions are folded, and the
+ *  result is a flat list of three address instructions over a register file
+ *  laid out as [variables | constants | temporaries].  Evaluation is a single
+ *  pass over the instructions, either for one point with any scalar type
+ *  (double or a Sacado type) or for whole arrays of points with doubles, in
+ *  which case every instruction is applied to a block of points at a time.
+ *
+ *  Supported syntax:
+ *  - numbers, the variables given at compile time and the constant pi
+ *  - + - * / ^ (right associative), unary + and -, parentheses
+ *  - comparisons < > <= >= == != that evaluate to 1 or 0
+ *  - sin cos tan asin acos atan sinh cosh tanh exp log log10 sqrt abs
+ *  - pow(a,b) atan2(a,b) min(a,b) max(a,b)
+ *
+ *  For compatibility with run time compiler input, an optional leading
+ *  assignment to a name (as in "value = x*y;") and trailing semicolons are
+ *  accepted and ignored.
+ */
+class Expression {
+public:
+
+  /**
+   *  \brief Instruction codes of the bytecode
+   */
+  enum OpCode {
+    ADD, SUB, MUL, DIV, POW, MIN, MAX, ATAN2,
+    LT, GT, LE, GE, EQ, NE,
+    NEG, SIN, COS, TAN, ASIN, ACOS, ATAN, SINH, COSH, TANH,
+    EXP, LOG, LOG10, SQRT, ABS
+  };
+
+  Expression ();
+
+  /**
+   *  \brief Compile a formula
+   *
+   *  \param formula [in]   Text of the formula.
+   *  \param variables [in] Names of the variables, in the order in which
+   *                        their values are passed to evaluate().
+   *
+   *  Throws std::invalid_argument if the formula cannot be parsed.
+   */
+  Expression (const std::string& formula,
+              const std::vector<std::string>& variables);
+
+  //! Replace the compiled formula
+  void compile (const std::string& formula,
+                const std::vector<std::string>& variables);
+
+  const std::string& formula () const { return formula_; }
+  int numVariables () const { return num_variables_; }
+  int numRegisters () const { return num_registers_; }
+  std::size_t numInstructions () const { return code_.size(); }
+
+  //! True if the value does not depend on any variable
+  bool isConstant () const { return result_ >= num_variables_ && code_.empty(); }
+
+  /**
+   *  \brief Evaluate at one point
+   *
+   *  \param variables [in]   Values of the variables.
+   *  \param registers [work] Register file, resized as needed.  Reusing it
+   *                          across calls avoids allocations.
+   */
+  template<typename T>
+  T evaluate (const T* variables, std::vector<T>& registers) const;
+
+  //! Evaluate at one point, allocating the register file
+  template<typename T>
+  T evaluate (const T* variables) const {
+    std::vector<T> registers;
+    return evaluate(variables, registers);
+  }
+
+  /**
+   *  \brief Evaluate at n points
+   *
+   *  \param n [in]         Number of points.
+   *  \param variables [in] For each variable, an array of its n values.
+   *  \param result [out]   Array of the n values of the formula.
+   */
+  void evaluate (std::size_t n, const double* const* variables,
+                 double* result) const;
+
+  //! Apply a single instruction to scalar operands
+  template<typename T>
+  static T apply (OpCode op, const T& a, const T& b);
+
+private:
+
+  struct Instruction {
+    OpCode op;
+    int dst;
+    int a;
+    int b;
+  };
+
+  std::string formula_;
+  std::vector<Instruction> code_;
+  std::vector<double> constants_;
+  int num_variables_;
+  int num_registers_;
+  int result_;
+};
+
+template<typename T>
+T Expression::apply (OpCode op, const T& a, const T& b) {
+  using std::pow; using std::atan2;
+  using std::sin; using std::cos; using std::tan;
+  using std::asin; using std::acos; using std::atan;
+  using std::sinh; using std::cosh; using std::tanh;
+  using std::exp; using std::log; using std::log10;
+  using std::sqrt; using std::abs;
+  switch (op) {
+  case ADD:   return a + b;
+  case SUB:   return a - b;
+  case MUL:   return a * b;
+  case DIV:   return a / b;
+  case POW:   return pow(a, b);
+  case MIN:   return b < a ? b : a;
+  case MAX:   return a < b ? b : a;
+  case ATAN2: return atan2(a, b);
+  case LT:    return T(a < b ? 1.0 : 0.0);
+  case GT:    return T(a > b ? 1.0 : 0.0);
+  case LE:    return T(a <= b ? 1.0 : 0.0);
+  case GE:    return T(a >= b ? 1.0 : 0.0);
+  case EQ:    return T(a == b ? 1.0 : 0.0);
+  case NE:    return T(a != b ? 1.0 : 0.0);
+  case NEG:   return -a;
+  case SIN:   return sin(a);
+  case COS:   return cos(a);
+  case TAN:   return tan(a);
+  case ASIN:  return asin(a);
+  case ACOS:  return acos(a);
+  case ATAN:  return atan(a);
+  case SINH:  return sinh(a);
+  case COSH:  return cosh(a);
+  case TANH:  return tanh(a);
+  case EXP:   return exp(a);
+  case LOG:   return log(a);
+  case LOG10: return log10(a);
+  case SQRT:  return sqrt(a);
+  case ABS:   return abs(a);
+  }
+  return a;
+}
+
+template<typename T>
+T Expression::evaluate (const T* variables, std::vector<T>& registers) const {
+  registers.resize(num_registers_);
+  for (int i = 0; i < num_variables_; ++i)
+    registers[i] = variables[i];
+  for (std::size_t i = 0; i < constants_.size(); ++i)
+    registers[num_variables_ + i] = constants_[i];
+  for (const Instruction& ins : code_)
+    registers[ins.dst] = apply(ins.op, registers[ins.a], registers[ins.b]);
+  return registers[result_];
+}
+
+}
+
+#endif  // UTIL_EXPRESSION_HPP
@@ -0,0 +1,270 @@
+#! /usr/bin/env python
+
+# Runs the Kessler cloud physics with a 4 stage and a 2 stage explicit
+# Runge-Kutta method, with the same time step.
+#
+# 1. The physics runs once per time step and workset, whatever the number of
+#    stages, so the call counts of the "Aeras: Moist Physics" timer have to
+#    be the same, and at least the number of time steps.
+# 2. The initial state is horizontally uniform, so the dynamics leave it
+#    alone and each column only sees the physics. Each physics step starts
+#    at an accepted solution and its tendencies are constant over the time
+#    step, which both methods integrate exactly: after n steps the column is
+#    the Kessler scheme applied n times to the initial column. The final
+#    temperature and mixing ratios of both runs are compared to that.
+#
+# Usage: runtest_cloud_physics.py <AlbanyT command>
+
+import sys
+import re
+from math import exp, sqrt
+from subprocess import Popen
+
+albany = sys.argv[1:]
+num_steps = 10
+dt = 0.1
+
+# Column of the decks: Function Data of the initial condition, and the
+# XZHydrostatic Problem constants
+num_levels = 30
+tracers = ["Vapor", "Rain", "Cloud"]
+P0 = 101325.0
+Ptop = 101.325
+Ps = P0
+T0 = 300.0
+q0 = {"Vapor": 0.03, "Rain": 0.0, "Cloud": 0.0}
+
+gravity = 9.80616
+R = 287.0
+Rv = 461.5
+rtol = 1.0e-4
+
+# Call count of the moist physics timer in the timer summary of the log
+def physics_count(log_file_name):
+    with open(log_file_name, 'r') as log_file:
+        for line in log_file:
+            if line.startswith("Aeras: Moist Physics"):
+                return int(re.search(r"\((\d+)\)", line).group(1))
+    return 0
+
+# Values printed after "xfinal:" by "Write Solution to Standard Output"
+def final_solution(log_file_name):
+    values = []
+    with open(log_file_name, 'r') as log_file:
+        found = False
+        for line in log_file:
+            if line.startswith("xfinal:"):
+                found = True
+            elif found:
+                try:
+                    values.append(float(line))
+                except ValueError:
+                    if values:
+                        break
+    return values
+
+# Vertical coordinate, as Aeras::Eta, Aeras::XZHydrostatic_Pressure and the
+# Aeras XZ Hydrostatic initial condition compute it
+Etatop = Ptop/P0
+delta = (1.0 - Etatop)/num_levels
+
+def eta_half(i):
+    return Etatop + (1.0 - Etatop)*i/num_levels
+
+a = [eta_half(i)*(1.0 - (eta_half(i) - Etatop)/(1.0 - Etatop))
+     for i in range(num_levels + 1)]
+b = [eta_half(i)*(eta_half(i) - Etatop)/(1.0 - Etatop)
+     for i in range(num_levels + 1)]
+pressure = [0.5*(a[l] + a[l+1])*P0 + 0.5*(b[l] + b[l+1])*Ps
+            for l in range(num_levels)]
+pi = []
+for l in range(num_levels):
+    pp = 0.5*(pressure[l] + pressure[l+1]) if l < num_levels - 1 else Ps
+    pm = 0.5*(pressure[l] + pressure[l-1]) if l else Ptop
+    pi.append((pp - pm)/delta)
+
+def nint(x):
+    # The NINT macro of Aeras_Atmosphere_Moisture_Def.hpp, expanded the way
+    # the preprocessor does for an argument 0.5 + c
+    c = x - 0.5
+    if abs(x) - abs(int(x)) > 0.5:
+        return (0.5 + c/abs(x))*int(abs(x) + 1)
+    return int(x)
+
+# One step of the Kessler scheme of Aeras::Atmosphere_Moisture, on a single
+# column with k = 0 at the bottom
+def kessler(t, qv, qc, qr, rho, p, exner, z, dt):
+    Km = len(t)
+    xlv = 2.501e+6
+    cp = 1005.7
+    eps = 0.622
+    K_temp_C = 273.15
+    mbar_per_bar = 1000.
+    mks_to_cgs = 0.001
+    max_cr_sedimentation = 0.75
+    f5 = 17.67*243.5*xlv/cp
+
+    t, qv, qc, qr = list(t), list(qv), list(qc), list(qr)
+    dz8w = z
+    qrk = list(qr)
+    rhok = list(rho)
+    rcgsk = [mks_to_cgs*r for r in rho]
+    qrcond = [1.0]*Km
+
+    vtden = [0.0]*Km
+    vt = [0.0]*Km
+    rdzw = [0.0]*Km
+    crmax = 0.0
+    for k in range(Km):
+        qrr = max(0.0, qrk[k]*rcgsk[k])
+        vtden[k] = sqrt(rcgsk[1]/rcgsk[k])
+        vt[k] = 36.34*qrr**0.1364*vtden[k]
+        rdzw[k] = 1.0/dz8w[k]
+        crmax = max(vt[k]*dt*rdzw[k], crmax)
+
+    rdzk = [0.0]*Km
+    for k in range(Km - 1):
+        rdzk[k] = 1.0/(z[k+1] - z[k])
+    rdzk[Km-1] = 1.0/(z[Km-1] - z[Km-2])
+
+    nfall = max(1, int(0.5 + crmax/max_cr_sedimentation))
+    dtfall = dt/float(nfall)
+    time_sediment = dt
+
+    while nfall > 0:
+        time_sediment = time_sediment - dtfall
+        factor = [dtfall*rdzk[k]/rhok[k] for k in range(Km)]
+        factor[Km-1] = dtfall*rdzk[Km-1]
+
+        for k in range(Km - 1):
+            qrk[k] = qrk[k] - factor[k]*(rhok[k]*qrk[k]*vt[k]
+                                         - rhok[k+1]*qrk[k+1]*vt[k+1])
+        qrk[Km-1] = qrk[Km-1] - factor[Km-1]*qrk[Km-1]*vt[Km-1]
+
+        if nfall > 1:
+            crmax = 0.0
+            for k in range(Km):
+                qrr = max(0.0, qrk[k]*rcgsk[k])
+                vt[k] = 36.34*qrr**0.1364*vtden[k]
+                crmax = max(vt[k]*time_sediment*rdzw[k], crmax)
+            nfall = nfall - 1
+            nfall_new = max(1, int(nint(0.5 + crmax/max_cr_sedimentation)))
+            if nfall_new != nfall:
+                nfall = nfall_new
+                dtfall = time_sediment/nfall
+        else:
+            qrcond = list(qrk)
+            nfall = 0
+
+    for k in range(Km):
+        factorn = 1.0/(1.0 + 2.2*dt*max(0.0, qr[k]**0.875))
+        qrprod = qc[k]*(1.0 - factorn) + factorn*0.001*dt*max(qc[k] - 0.001, 0.0)
+
+        qc[k] = max(qc[k] - qrprod, 0.0)
+        qr[k] = qr[k] + qrcond[k] - qr[k]
+        qr[k] = max(qr[k] + qrprod, 0.0)
+
+        temp = exner[k]*t[k] - K_temp_C
+        es = mbar_per_bar*6.112*exp(17.67*temp/(temp + 243.5))
+        qvs = eps*es/(p[k] - es)
+
+        qrcond[k] = (qv[k] - qvs)/(1.0 + p[k]/(p[k] - es)*qvs*f5/(temp + 243.5)**2)
+
+        qrvent = 1.6 + 124.9*(rcgsk[k]*qr[k])**0.2046
+
+        dim = qvs - qv[k] if qvs - qv[k] > 0.0 else 0.0
+        arg1 = dt*((qrvent*(rcgsk[k]*qr[k])**0.525)/(2.55E+08/(p[k]*qvs) + 5.4E+05))*(dim/(rcgsk[k]*qvs))
+        arg2 = max(-qrcond[k] - qc[k], 0.0)
+        qrevap = min(min(arg1, arg2), qr[k])
+
+        prodct = max(qrcond[k], -qc[k])
+        gam = xlv/(cp*exner[k])
+        t[k] = t[k] + gam*(prodct - qrevap)
+        qv[k] = max(qv[k] - prodct + qrevap, 0.0)
+        qc[k] = qc[k] + prodct
+        qr[k] = qr[k] - qrevap
+
+    return t, qv, qc, qr
+
+# Column evolution under the physics alone, by level (level 0 at the top)
+def reference_column():
+    T = [T0]*num_levels
+    q = dict((name, [q0[name]]*num_levels) for name in tracers)
+    for step in range(num_steps):
+        virt_t = [T[l]*(1.0 + (Rv/R - 1.0)*q["Vapor"][l])
+                  for l in range(num_levels)]
+        rho = [pressure[l]/(R*virt_t[l]) for l in range(num_levels)]
+        phi = []
+        for l in range(num_levels):
+            phi.append(0.5*pi[l]*delta/rho[l] +
+                       sum(pi[j]*delta/rho[j] for j in range(l+1, num_levels)))
+        # Kessler columns run bottom up
+        col = lambda f: [f[num_levels-1-k] for k in range(num_levels)]
+        z = [phi_k/gravity for phi_k in col(phi)]
+        p = col(pressure)
+        exner = [(p_k/100000.0)**0.286 for p_k in p]
+        t, qv, qc, qr = kessler(col(T), col(q["Vapor"]), col(q["Cloud"]),
+                                col(q["Rain"]), col(rho), p, exner, z, dt)
+        T = col(t)
+        q["Vapor"], q["Cloud"], q["Rain"] = col(qv), col(qc), col(qr)
+    return T, q
+
+# Temperature and mixing ratios of the first node of the solution: surface
+# pressure, then velocity and temperature by level, then pi*q by level and
+# tracer
+def solution_column(x):
+    T = [x[1 + 2*l + 1] for l in range(num_levels)]
+    q = {}
+    for n, name in enumerate(tracers):
+        q[name] = [x[1 + 2*num_levels + len(tracers)*l + n]/pi[l]
+                   for l in range(num_levels)]
+    return T, q
+
+def compare(field, computed, expected):
+    scale = max(abs(v) for v in expected)
+    failed = 0
+    for l in range(num_levels):
+        if not abs(computed[l] - expected[l]) <= rtol*scale:
+            print "  " + field + " at level " + str(l) + ": " + \
+                  str(computed[l]) + ", expected " + str(expected[l])
+            failed += 1
+    return failed
+
+T_ref, q_ref = reference_column()
+if max(q_ref["Cloud"] + q_ref["Rain"]) <= 0.0:
+    print "FAILED: the reference column has neither cloud nor rain"
+    sys.exit(1)
+
+counts = []
+failed = 0
+for name in ["input_cloud_physics_RK4_T", "input_cloud_physics_trapezoidal_T"]:
+    print "test - " + name
+    log_file_name = name + ".log"
+    with open(log_file_name, 'w') as logfile:
+        p = Popen(albany + [name + ".xml"], stdout=logfile, stderr=logfile)
+        return_code = p.wait()
+    if return_code != 0:
+        with open(log_file_name, 'r') as log_file:
+            print log_file.read()
+        sys.exit(return_code)
+    counts.append(physics_count(log_file_name))
+    print "  moist physics calls: " + str(counts[-1])
+
+    x = final_solution(log_file_name)
+    if len(x) < 1 + (2 + len(tracers))*num_levels:
+        print "FAILED: no final solution in " + log_file_name
+        sys.exit(1)
+    T, q = solution_column(x)
+    failed += compare("Temperature", T, T_ref)
+    for tracer in tracers:
+        failed += compare(tracer, q[tracer], q_ref[tracer])
+
+if counts[0] != counts[1] or counts[0] < num_steps:
+    print "FAILED: expected the same number of calls, at least " + str(num_steps)
+    sys.exit(1)
+
+if failed:
+    print "FAILED: " + str(failed) + " values differ from the column reference"
+    sys.exit(1)
+
+sys.exit(0)
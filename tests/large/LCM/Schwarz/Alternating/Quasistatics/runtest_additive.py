@@ -0,0 +1,95 @@
+#! /usr/bin/env python
+import sys
+import os
+import re
+import shutil
+
+from subprocess import Popen
+
+name = "cuboid_additive"
+result = 0
+
+# usage: runtest_additive.py <mpiexec> <mpi num procs flag> <exodiff>
+mpiexec = sys.argv[1]
+mpinpf = sys.argv[2]
+exodiff = sys.argv[3]
+
+subdomains = ["cuboid_00", "cuboid_01"]
+
+print "test 1 - Schwarz Alternating Additive vs Multiplicative"
+
+def run(command, log_file_name):
+    if os.path.exists(log_file_name):
+        os.remove(log_file_name)
+    logfile = open(log_file_name, 'w')
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    logfile.close()
+    num_converged = 0
+    num_not_converged = 0
+    iterations = 0
+    wall_time = 0.0
+    groups = {}
+    for line in open(log_file_name):
+        if "Schwarz Alternating Method converged: YES" in line:
+            num_converged = num_converged + 1
+        if "Schwarz Alternating Method converged: NO" in line:
+            num_not_converged = num_not_converged + 1
+        match = re.match(r"Total iterations   :(\d+)", line)
+        if match:
+            iterations = iterations + int(match.group(1))
+        match = re.match(r"Wall time          :(\S+)", line)
+        if match:
+            wall_time = float(match.group(1))
+        match = re.match(r"INFO: Subdomain (\d+) assigned to group (\d+)", line)
+        if match:
+            groups[int(match.group(1))] = int(match.group(2))
+    converged = num_converged > 0 and num_not_converged == 0
+    return return_code, converged, iterations, wall_time, groups
+
+# run Albany, multiplicative on one rank, and keep its output
+mult = run(["./AlbanyT", "cuboids.yaml"], name + "_multiplicative.log")
+
+for subdomain in subdomains:
+    if os.path.exists(subdomain + ".e"):
+        shutil.move(subdomain + ".e", subdomain + "_multiplicative.e")
+
+# run Albany, additive with one subdomain per rank
+add = run([mpiexec, mpinpf, "2", "./AlbanyT", "cuboids_additive.yaml"],
+          name + ".log")
+
+for return_code, converged, iterations, wall_time, groups in [mult, add]:
+    if return_code != 0:
+        result = result + return_code
+    if converged == False:
+        print "Schwarz did not converge in every step"
+        result = result + 1
+
+# Both methods converge to the same solution in every step. Each subdomain
+# is written by the group that solved it.
+groups = add[4]
+for index, subdomain in enumerate(subdomains):
+    group = groups.get(index, 0)
+    additive_output = subdomain + ".e"
+    if group > 0:
+        additive_output = additive_output + ".group-%d" % group
+    command = [exodiff, "-i", "-t", "1.e-6", "-F", "1.e-10",
+               subdomain + "_multiplicative.e", additive_output]
+    p = Popen(command)
+    return_code = p.wait()
+    if return_code != 0:
+        print "%s differs from the multiplicative solution" % additive_output
+        result = result + 1
+
+print "Multiplicative: iterations %d, wall time %s" % (mult[2], mult[3])
+print "Additive      : iterations %d, wall time %s" % (add[2], add[3])
+
+if result != 0:
+    print "result is %s" % result
+    print "%s test has failed" % name
+
+with open(name + ".log", 'r') as log_file:
+    print log_file.read()
+
+
+sys.exit(result)
@@ -0,0 +1,85 @@
+#! /usr/bin/env python
+
+import sys
+import os
+import re
+from subprocess import Popen
+
+result = 0
+
+# Block Gauss-Seidel preconditioner without, with explicit and with
+# matrix-free off-diagonal Schwarz blocks: all converge to the solution of
+# the Cubes DBC test. With the off-diagonal blocks Newton sees the
+# monolithic Jacobian, so it takes fewer iterations than without them, and
+# the matrix-free blocks must apply like their explicit matrices.
+tests = [("Cubes_Teko_GS", "cubes-teko-gauss-seidel.yaml"),
+         ("Cubes_Teko_GS_Explicit", "cubes-teko-gauss-seidel-explicit.yaml"),
+         ("Cubes_Teko_GS_Matrix_Free", "cubes-teko-gauss-seidel-matrix-free.yaml")]
+
+#specify tolerance to determine test failure / passing
+tolerance = 1.0e-9;
+meanvalue = 0.000809523809524;
+block_tolerance = 1.0e-12
+
+newton_iterations = []
+
+for i, (name, input_file) in enumerate(tests):
+    print "test %d - %s" % (i + 1, name)
+    log_file_name = name + ".log"
+    if os.path.exists(log_file_name):
+        os.remove(log_file_name)
+    logfile = open(log_file_name, 'w')
+
+    # run AlbanyT
+    command = ["./AlbanyT", input_file]
+    p = Popen(command, stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+    logfile.close()
+    if return_code != 0:
+        result = result + 1
+
+    found = False
+    for line in open(log_file_name):
+      if "Main_Solve: MeanValue of final solution" in line:
+        s = line[40:]
+        d = float(s)
+        print d
+        found = True
+        if (d > meanvalue + tolerance or d < meanvalue - tolerance):
+          result = result+1
+    if not found:
+        result = result+1
+        with open(log_file_name, 'r') as log_file:
+            print log_file.read()
+
+    # Newton iterations of all the nonlinear solves
+    with open(log_file_name, 'r') as log_file:
+        log = log_file.read()
+    steps = re.findall(r"-- Nonlinear Solver Step (\d+) --", log)
+    newton_iterations.append(len([s for s in steps if int(s) > 0]))
+    print "Newton iterations: %d" % newton_iterations[-1]
+
+    # Matrix-free blocks against their explicit matrices, checked by the
+    # matrix-free deck after each Jacobian fill
+    if name == "Cubes_Teko_GS_Matrix_Free":
+        differences = re.findall(
+            r"matrix-free and explicit apply differ by (\S+)", log)
+        print "off-diagonal block checks: %d" % len(differences)
+        if not differences:
+            result = result+1
+        for difference in differences:
+            if not float(difference) <= block_tolerance:
+                print "off-diagonal block differs by " + difference
+                result = result+1
+
+for i in [1, 2]:
+    if not newton_iterations[i] < newton_iterations[0]:
+        print "%s takes %d Newton iterations, %s %d" % \
+            (tests[i][0], newton_iterations[i], tests[0][0],
+             newton_iterations[0])
+        result = result+1
+
+if result != 0:
+    print "result is %s" % result
+    print "Teko test has failed"
+    sys.exit(result)
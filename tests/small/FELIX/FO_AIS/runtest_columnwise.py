@@ -0,0 +1,93 @@
+#! /usr/bin/env python
+
+# Runs inputMueLuShort3.xml (layerwise numbering, line detection set in the
+# input deck) and inputMueLuColumnwise3.xml (columnwise numbering, line
+# detection from the discretization), and compares their responses: the
+# numbering and the preconditioner must not change the solution.
+#
+# The columnwise deck is then run again with more layers. Line smoothing
+# along the columns makes the preconditioner insensitive to the vertical
+# resolution: the mean numbers of linear iterations per Newton step of the
+# runs must stay within a factor max_growth of each other.
+#
+# Usage: runtest_columnwise.py <AlbanyT command>
+
+import sys
+import re
+from subprocess import Popen
+
+albany = sys.argv[1:]
+rtol = 1.0e-4
+num_layers = [5, 10, 20]
+max_growth = 1.5
+
+# Value of response 0, as printed by Albany
+def response(log):
+    lines = log.splitlines()
+    for i, line in enumerate(lines):
+        if line.strip().startswith("Response vector 0"):
+            for value in lines[i+1:]:
+                if value.strip():
+                    return float(value.split()[-1])
+    return None
+
+# Mean number of iterations of the linear solves, as printed by AztecOO
+def linear_iterations(log):
+    counts = [int(n) for n in re.findall(r"total iterations:\s*(\d+)", log)]
+    if not counts:
+        return None
+    return float(sum(counts)) / len(counts)
+
+def run(name):
+    print "test - " + name
+    log_file_name = name + ".log"
+    with open(log_file_name, 'w') as logfile:
+        p = Popen(albany + [name + ".xml"], stdout=logfile, stderr=logfile)
+        return_code = p.wait()
+    with open(log_file_name, 'r') as log_file:
+        log = log_file.read()
+    if return_code != 0:
+        print log
+        sys.exit(1)
+    return log
+
+responses = []
+for name in ["inputMueLuShort3", "inputMueLuColumnwise3"]:
+    log = run(name)
+    responses.append(response(log))
+    if responses[-1] is None:
+        print log
+        sys.exit(1)
+    print "  response 0: " + repr(responses[-1])
+
+if abs(responses[1] - responses[0]) > rtol * abs(responses[0]):
+    print "FAILED: the responses differ"
+    sys.exit(1)
+
+# The columnwise deck with each number of layers, and its own output file
+with open("inputMueLuColumnwise3.xml", 'r') as deck_file:
+    deck = deck_file.read()
+iterations = []
+for layers in num_layers:
+    name = "inputMueLuColumnwise3_" + str(layers) + "layers"
+    layered = re.sub(r'(name="NumLayers"\s+type="int"\s+value=")\d+"',
+                     r'\g<1>' + str(layers) + '"', deck)
+    layered = layered.replace("antarctica_muelu_columnwise_out.exo",
+                              "antarctica_muelu_columnwise_" + str(layers) +
+                              "layers_out.exo")
+    with open(name + ".xml", 'w') as deck_file:
+        deck_file.write(layered)
+    log = run(name)
+    iterations.append(linear_iterations(log))
+    if iterations[-1] is None:
+        print log
+        print "FAILED: no linear iteration counts in " + name + ".log"
+        sys.exit(1)
+    print "  " + str(layers) + " layers: " + str(iterations[-1]) + \
+        " linear iterations per solve"
+
+if max(iterations) > max_growth * min(iterations):
+    print "FAILED: the linear iteration counts grow with the number of layers"
+    sys.exit(1)
+
+sys.exit(0)
@@ -0,0 +1,77 @@
+# 1. Run the native and the reordered Tpetra problems in parallel, so that the
+#    Reverse Cuthill-McKee ordering is applied to separate owned and overlap
+#    node sets. The serial cube is decomposed on the fly.
+
+foreach(RUN native reorder)
+  if(RUN STREQUAL "native")
+    set(INPUT inputT.xml)
+  else()
+    set(INPUT inputReorderT.xml)
+  endif()
+
+  file(READ ${INPUT} DECK)
+  string(REPLACE "<Parameter name=\"Method\" type=\"string\" value=\"Ioss\"/>"
+         "<Parameter name=\"Method\" type=\"string\" value=\"Ioss\"/>\n    <Parameter name=\"Use Serial Mesh\" type=\"bool\" value=\"1\"/>"
+         DECK "${DECK}")
+  string(REGEX REPLACE "cubeOut_[a-z_]*tpetra.exo" "cubeOut_${RUN}_parallel.exo"
+         DECK "${DECK}")
+  file(WRITE input_${RUN}_parallel.xml "${DECK}")
+
+  message("Running the command:")
+  message("${TEST_PROG} input_${RUN}_parallel.xml")
+
+  EXECUTE_PROCESS(COMMAND ${TEST_PROG} input_${RUN}_parallel.xml
+                  OUTPUT_FILE ${RUN}_parallel.log
+                  ERROR_FILE ${RUN}_parallel.log
+                  RESULT_VARIABLE HAD_ERROR)
+
+  file(READ ${RUN}_parallel.log ${RUN}_LOG)
+
+  if(HAD_ERROR)
+    message("${${RUN}_LOG}")
+    message(FATAL_ERROR "Albany didn't run with input_${RUN}_parallel.xml: test failed")
+  endif()
+endforeach()
+
+# 2. The reordering must have been applied, and it must not widen the local
+#    node graph
+
+string(REGEX MATCHALL "local node graph bandwidth [0-9]+ -> [0-9]+"
+       BANDWIDTHS "${reorder_LOG}")
+if(NOT BANDWIDTHS)
+  message(FATAL_ERROR "The Reverse Cuthill-McKee ordering was not applied: test failed")
+endif()
+
+foreach(BANDWIDTH ${BANDWIDTHS})
+  message("${BANDWIDTH}")
+  string(REGEX REPLACE ".* ([0-9]+) -> ([0-9]+)" "\\1;\\2" PAIR "${BANDWIDTH}")
+  list(GET PAIR 0 BEFORE)
+  list(GET PAIR 1 AFTER)
+  if(AFTER GREATER BEFORE)
+    message(FATAL_ERROR "Reverse Cuthill-McKee widened the local node graph: test failed")
+  endif()
+endforeach()
+
+# 3. Report the assembly and ILU timings with and without reordering. Both
+#    decks check the same responses, so only the timings differ.
+
+foreach(TIMER "> Albany Fill: Residual" "> Albany Fill: Jacobian")
+  foreach(RUN native reorder)
+    string(REGEX MATCH "${TIMER} +[0-9][^\n]*" LINE "${${RUN}_LOG}")
+    if(NOT LINE)
+      message(FATAL_ERROR "No '${TIMER}' timer in the ${RUN} run: test failed")
+    endif()
+    message("${RUN}: ${LINE}")
+  endforeach()
+endforeach()
+
+foreach(RUN native reorder)
+  string(REGEX MATCHALL "Ifpack2::[A-Za-z]+::(initialize|compute)[^\n]*"
+         LINES "${${RUN}_LOG}")
+  if(NOT LINES)
+    message("${RUN}: no Ifpack2 timers in the summary")
+  endif()
+  foreach(LINE ${LINES})
+    message("${RUN}: ${LINE}")
+  endforeach()
+endforeach()
@@ -0,0 +1,47 @@
+# 1. Run the Tempus "Newmark Explicit a-Form" reference and the central
+#    difference solver on the same problem
+
+foreach(INPUT clamped-ct-expl clamped-ct-central-difference)
+  message("Running the command:")
+  message("${TEST_PROG} ${INPUT}.yaml")
+
+  EXECUTE_PROCESS(COMMAND ${TEST_PROG} ${INPUT}.yaml
+                  RESULT_VARIABLE HAD_ERROR)
+
+  if(HAD_ERROR)
+    message(FATAL_ERROR "Albany didn't run with ${INPUT}.yaml: test failed")
+  endif()
+endforeach()
+
+if (NOT SEACAS_EXODIFF)
+  message(FATAL_ERROR "Cannot find exodiff")
+endif()
+
+# 2. The displacements must match at every output step, in every piece of a
+#    parallel run
+
+file(GLOB EXPL_OUTPUTS RELATIVE ${CMAKE_CURRENT_BINARY_DIR} "clamped_ct_expl.e*")
+list(LENGTH EXPL_OUTPUTS NUM_OUTPUTS)
+
+if(NUM_OUTPUTS LESS 1)
+  message(FATAL_ERROR "No output of clamped-ct-expl.yaml: test failed")
+endif()
+
+foreach(EXPL_OUTPUT ${EXPL_OUTPUTS})
+  string(REPLACE "clamped_ct_expl" "clamped_ct_central_difference" CD_OUTPUT ${EXPL_OUTPUT})
+
+  SET(EXODIFF_TEST ${SEACAS_EXODIFF} -f central-difference.exodiff
+                   ${EXPL_OUTPUT} ${CD_OUTPUT})
+
+  message("Running the command:")
+  message("${EXODIFF_TEST}")
+
+  EXECUTE_PROCESS(
+      COMMAND ${EXODIFF_TEST}
+      OUTPUT_FILE exodiff_${CD_OUTPUT}.out
+      RESULT_VARIABLE HAD_ERROR)
+
+  if(HAD_ERROR)
+    message(FATAL_ERROR "${CD_OUTPUT} differs from ${EXPL_OUTPUT}: test failed")
+  endif()
+endforeach()
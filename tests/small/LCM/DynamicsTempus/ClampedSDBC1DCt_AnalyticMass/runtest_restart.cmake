@@ -0,0 +1,51 @@
+# 1. Run the central difference problem without interruption, then stop it
+#    after 80 of its 150 steps with checkpoints and restart from the last one
+
+file(REMOVE_RECURSE checkpoint_clamped_ct)
+
+foreach(INPUT clamped-ct-central-difference
+              clamped-ct-central-difference-checkpoint
+              clamped-ct-central-difference-restart)
+  message("Running the command:")
+  message("${TEST_PROG} ${INPUT}.yaml")
+
+  EXECUTE_PROCESS(COMMAND ${TEST_PROG} ${INPUT}.yaml
+                  RESULT_VARIABLE HAD_ERROR)
+
+  if(HAD_ERROR)
+    message(FATAL_ERROR "Albany didn't run with ${INPUT}.yaml: test failed")
+  endif()
+endforeach()
+
+if (NOT SEACAS_EXODIFF)
+  message(FATAL_ERROR "Cannot find exodiff")
+endif()
+
+# 2. Every output of the restart must be identical to the output of the
+#    uninterrupted run at the same time, in every piece of a parallel run
+
+file(GLOB FULL_OUTPUTS RELATIVE ${CMAKE_CURRENT_BINARY_DIR} "clamped_ct_central_difference.e*")
+list(LENGTH FULL_OUTPUTS NUM_OUTPUTS)
+
+if(NUM_OUTPUTS LESS 1)
+  message(FATAL_ERROR "No output of clamped-ct-central-difference.yaml: test failed")
+endif()
+
+foreach(FULL_OUTPUT ${FULL_OUTPUTS})
+  string(REPLACE "clamped_ct_central_difference" "clamped_ct_restart" RESTART_OUTPUT ${FULL_OUTPUT})
+
+  SET(EXODIFF_TEST ${SEACAS_EXODIFF} -TM -f restart.exodiff
+                   ${FULL_OUTPUT} ${RESTART_OUTPUT})
+
+  message("Running the command:")
+  message("${EXODIFF_TEST}")
+
+  EXECUTE_PROCESS(
+      COMMAND ${EXODIFF_TEST}
+      OUTPUT_FILE exodiff_${RESTART_OUTPUT}.out
+      RESULT_VARIABLE HAD_ERROR)
+
+  if(HAD_ERROR)
+    message(FATAL_ERROR "${RESTART_OUTPUT} differs from ${FULL_OUTPUT}: test failed")
+  endif()
+endforeach()
@@ -0,0 +1,66 @@
+# 1. Run the problem with the full and the incremental discretization update,
+#    and report the time each one spent updating the discretization
+
+foreach(RUN full incremental)
+  message("Running the command:")
+  message("${TEST_PROG} input-${RUN}.yaml")
+
+  EXECUTE_PROCESS(COMMAND ${TEST_PROG} input-${RUN}.yaml
+                  OUTPUT_FILE ${RUN}.log
+                  ERROR_FILE ${RUN}.log
+                  RESULT_VARIABLE HAD_ERROR)
+
+  file(READ ${RUN}.log ${RUN}_LOG)
+
+  if(HAD_ERROR)
+    message("${${RUN}_LOG}")
+    message(FATAL_ERROR "Albany didn't run with input-${RUN}.yaml: test failed")
+  endif()
+
+  string(REGEX MATCH "AAdapt::TopologyMod: discretization update[^\n]*"
+         UPDATE_TIME "${${RUN}_LOG}")
+  message("${RUN} update: ${UPDATE_TIME}")
+endforeach()
+
+# 2. The incremental run must have patched the discretization, not rebuilt it
+
+if(NOT incremental_LOG MATCHES "STKDisc: incremental update of")
+  message(FATAL_ERROR "The incremental update did not run: test failed")
+endif()
+
+if(incremental_LOG MATCHES "topology change is not local")
+  message(FATAL_ERROR "The incremental update fell back to a rebuild: test failed")
+endif()
+
+# 3. Every output file of the full update, one per topology change, must have
+#    an identical incremental counterpart
+
+if (NOT SEACAS_EXODIFF)
+  message(FATAL_ERROR "Cannot find exodiff")
+endif()
+
+file(GLOB FULL_OUTPUTS RELATIVE ${CMAKE_CURRENT_BINARY_DIR} "full-out*.exo")
+list(LENGTH FULL_OUTPUTS NUM_OUTPUTS)
+
+if(NUM_OUTPUTS LESS 2)
+  message(FATAL_ERROR "The mesh was not fractured: test failed")
+endif()
+
+foreach(FULL_OUTPUT ${FULL_OUTPUTS})
+  string(REPLACE "full-out" "incremental-out" INCREMENTAL_OUTPUT ${FULL_OUTPUT})
+
+  SET(EXODIFF_TEST ${SEACAS_EXODIFF} -i -t 1.e-10 -F 1.e-14
+                   ${FULL_OUTPUT} ${INCREMENTAL_OUTPUT})
+
+  message("Running the command:")
+  message("${EXODIFF_TEST}")
+
+  EXECUTE_PROCESS(
+      COMMAND ${EXODIFF_TEST}
+      OUTPUT_FILE exodiff_${FULL_OUTPUT}.out
+      RESULT_VARIABLE HAD_ERROR)
+
+  if(HAD_ERROR)
+    message(FATAL_ERROR "${INCREMENTAL_OUTPUT} differs from ${FULL_OUTPUT}: test failed")
+  endif()
+endforeach()
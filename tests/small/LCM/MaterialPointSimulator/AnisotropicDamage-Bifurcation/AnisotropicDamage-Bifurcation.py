@@ -22,4 +22,12 @@ if result != 0:
     print "%s test has failed" % name
     sys.exit(result)
 
+print "test 3 - shear, warm started"
+name = "AnisotropicDamage-Bifurcation-shear-warm"
+result = runtest(name)
+if result != 0:
+    print "result is %s" % result
+    print "%s test has failed" % name
+    sys.exit(result)
+
 sys.exit(result)
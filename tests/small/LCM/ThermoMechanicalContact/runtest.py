@@ -0,0 +1,94 @@
+#! /usr/bin/env python
+
+# Runs the pellet and cladding problem and checks the contact conditions at
+# the end of the last continuation step.
+#
+# The heated pellet (block_2, surface_2) expands across the gap to the
+# cladding (block_1, surface_1), whose outer surface nodelist_1 is held. The
+# pellet is pinned at nodelist_2 and otherwise held by the contact alone, so
+# the problem only converges if the contact closes. At the end some slave
+# nodes must be active, all with a positive pressure, and no slave node may
+# penetrate the cladding. Albany also compares the solution average with the
+# Test Values of input.yaml.
+#
+# With --regenerate, the deck is run without that comparison and its Test
+# Values are replaced by the solution average of the run. Copy input.yaml
+# back to the source directory afterwards.
+#
+# Usage: runtest.py [--regenerate] <serial AlbanyT command>
+
+import sys
+import re
+from subprocess import Popen
+
+regenerate = len(sys.argv) > 1 and sys.argv[1] == "--regenerate"
+albany = sys.argv[2:] if regenerate else sys.argv[1:]
+name = "input"
+
+gap_tol = 1.0e-6
+
+# Value of response 0, as printed by Albany
+def response(log):
+    lines = log.splitlines()
+    for i, line in enumerate(lines):
+        if line.strip().startswith("Response vector 0"):
+            for value in lines[i+1:]:
+                if value.strip():
+                    return float(value.split()[-1])
+    return None
+
+if regenerate:
+    with open(name + ".yaml", 'r') as deck_file:
+        deck = deck_file.read()
+    with open(name + "_regenerate.yaml", 'w') as deck_file:
+        deck_file.write(re.sub(r"Number of Comparisons: \d+",
+                               "Number of Comparisons: 0", deck))
+    name = name + "_regenerate"
+
+log_file_name = name + ".log"
+with open(log_file_name, 'w') as logfile:
+    p = Popen(albany + [name + ".yaml"], stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+
+with open(log_file_name, 'r') as log_file:
+    log = log_file.read()
+
+converged = False
+for match in re.finditer(r"-- Nonlinear Solver Step (\d+) --\s*\n(.*)", log):
+    converged = "Converged" in match.group(2)
+
+contact = None
+for match in re.finditer(r"Contact: (\d+) active slave nodes, pressure (\S+) to (\S+), "
+                         r"smallest normal gap (\S+)", log):
+    contact = match
+
+if return_code != 0 or not converged or contact is None:
+    print log
+    print "FAILED: the contact problem did not converge, or the contact did not close"
+    sys.exit(1)
+
+num_active = int(contact.group(1))
+min_pressure = float(contact.group(2))
+max_pressure = float(contact.group(3))
+min_gap = float(contact.group(4))
+
+print "Contact: " + str(num_active) + " active slave nodes, pressure " + \
+    repr(min_pressure) + " to " + repr(max_pressure) + \
+    ", smallest normal gap " + repr(min_gap)
+
+if num_active == 0 or min_pressure <= 0.0 or min_gap < -gap_tol:
+    print "FAILED"
+    sys.exit(1)
+
+if regenerate:
+    value = response(log)
+    if value is None:
+        print "FAILED: no response 0 in " + log_file_name
+        sys.exit(1)
+    deck = re.sub(r"Test Values: \[[^]]*\]",
+                  "Test Values: [" + "%.8e" % value + "]", deck)
+    with open("input.yaml", 'w') as deck_file:
+        deck_file.write(deck)
+    print "input.yaml: Test Values: [" + "%.8e" % value + "]"
+
+sys.exit(0)
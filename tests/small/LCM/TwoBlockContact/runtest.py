@@ -0,0 +1,73 @@
+#! /usr/bin/env python
+
+# Runs the two block contact patch test and checks the contact against the
+# exact solution.
+#
+# Two elastic blocks of the same material, [0,1]x[0,1] with 4x4 elements and
+# [0,1]x[1,2] with 5x4, meet on the nonmatching interface y = 1. The bottom
+# is held in y, the left side in x, and the top is pressed down by 0.02. The
+# exact plane strain solution is a uniform compression with strain -0.01 in
+# y, so every active slave node carries the pressure E / (1 - nu^2) 0.01.
+# The first Newton step closes the gap and the second one finds the active
+# set and the exact solution.
+#
+# Usage: runtest.py <serial AlbanyT command>
+
+import sys
+import re
+from subprocess import Popen
+
+albany = sys.argv[1:]
+name = "input"
+
+E = 1000.0
+nu = 0.3
+pressure = E / (1.0 - nu * nu) * 0.01
+num_slave_nodes = 6
+rtol = 1.0e-6
+gap_tol = 1.0e-8
+max_iterations = 4
+
+log_file_name = name + ".log"
+with open(log_file_name, 'w') as logfile:
+    p = Popen(albany + [name + ".yaml"], stdout=logfile, stderr=logfile)
+    return_code = p.wait()
+
+with open(log_file_name, 'r') as log_file:
+    log = log_file.read()
+
+iterations = None
+converged = False
+for match in re.finditer(r"-- Nonlinear Solver Step (\d+) --\s*\n(.*)", log):
+    iterations = int(match.group(1))
+    converged = "Converged" in match.group(2)
+
+contact = None
+for match in re.finditer(r"Contact: (\d+) active slave nodes, pressure (\S+) to (\S+), "
+                         r"smallest normal gap (\S+)", log):
+    contact = match
+
+if return_code != 0 or not converged or contact is None:
+    print log
+    print "FAILED: the contact problem did not converge"
+    sys.exit(1)
+
+num_active = int(contact.group(1))
+min_pressure = float(contact.group(2))
+max_pressure = float(contact.group(3))
+min_gap = float(contact.group(4))
+
+print "Contact: " + str(iterations) + " Newton iterations, " + \
+    str(num_active) + " active slave nodes, pressure " + repr(min_pressure) + \
+    " to " + repr(max_pressure) + " (exact: " + repr(pressure) + \
+    "), smallest normal gap " + repr(min_gap)
+
+if num_active != num_slave_nodes or \
+        abs(min_pressure - pressure) > rtol * pressure or \
+        abs(max_pressure - pressure) > rtol * pressure or \
+        abs(min_gap) > gap_tol or \
+        iterations > max_iterations:
+    print "FAILED"
+    sys.exit(1)
+
+sys.exit(0)
@@ -0,0 +1,106 @@
+#! /usr/bin/env python
+
+# Runs the GF-CBR Vds sweep of input_pointcontact_2D_sweep.xml on 1 and on
+# 2 processors and compares the IV curves. The sweep has an odd number of
+# bias points, so the 2 processors compute different numbers of them.
+#
+# Then runs the sweep with a coarse energy grid refined by adaptive Simpson
+# ("GF-CBR Method Energy Refinement Tolerance" > 0) and with a fine uniform
+# energy grid, and compares their IV curves.
+#
+# Usage: runtest_sweep.py <Albany> <mpiexec> <num procs flag>
+
+import sys
+import os
+from subprocess import Popen
+
+albany = sys.argv[1]
+mpiexec = sys.argv[2:4]
+
+name = "input_pointcontact_2D_sweep"
+iv_file_name = "saddlePath_sweep.dat"
+rtol = 1.0e-5
+
+eigensolver_line = \
+    '<Parameter name="GF-CBR Method Eigensolver" type="string" value="tql2"  />'
+
+# Energy grids of the refinement check: (name, points per kT, tolerance)
+coarse_refined = ("refined", 2.0, 1.0e-6)
+fine_uniform = ("uniform", 200.0, 0.0)
+refine_rtol = 1.0e-3
+
+# Last IV curve written to the output file, as a list of (Vds, Ids)
+def read_iv_curve(file_name):
+    curve = []
+    with open(file_name, 'r') as iv_file:
+        for line in iv_file:
+            if line.startswith("% Current vs Voltage IV curve"):
+                curve = []
+                continue
+            words = line.split()
+            if len(words) == 3 and not line.startswith("%"):
+                curve.append((float(words[1]), float(words[2])))
+    return curve
+
+# Runs input_name on num_procs processors, returns its IV curve and log
+def run_sweep(input_name, num_procs, log_name):
+    print "test - " + input_name + " on " + str(num_procs) + " processor(s)"
+    if os.path.exists(iv_file_name):
+        os.remove(iv_file_name)
+    log_file_name = log_name + ".log"
+    with open(log_file_name, 'w') as logfile:
+        command = mpiexec + [str(num_procs), albany, input_name + ".xml"]
+        p = Popen(command, stdout=logfile, stderr=logfile)
+        return_code = p.wait()
+    with open(log_file_name, 'r') as log_file:
+        log = log_file.read()
+    if return_code != 0:
+        print log
+        sys.exit(return_code)
+    curve = read_iv_curve(iv_file_name)
+    if len(curve) != 5:
+        print "expected 5 bias points, got " + str(len(curve))
+        sys.exit(1)
+    return curve, log
+
+# Compares two IV curves; the current vanishes only at Vds = 0
+def compare(curve, curve2, tol):
+    result = 0
+    for (vds, ids), (vds2, ids2) in zip(curve, curve2):
+        print "Vds = " + str(vds) + " Ids = " + str(ids) + " vs " + str(ids2)
+        if vds != vds2 or abs(ids - ids2) > tol * abs(ids) or \
+                (ids == 0.0 and vds != 0.0):
+            print "  FAILED"
+            result = 1
+    return result
+
+result = 0
+
+curves = [run_sweep(name, num_procs, name + "_np" + str(num_procs))[0]
+          for num_procs in [1, 2]]
+result += compare(curves[0], curves[1], rtol)
+
+# The refined coarse grid must reproduce the fine uniform grid
+grid_curves = []
+with open(name + ".xml", 'r') as input_file:
+    deck = input_file.read()
+if eigensolver_line not in deck:
+    print "no tql2 eigensolver in " + name + ".xml"
+    sys.exit(1)
+for grid, pts_per_kT, tol in [coarse_refined, fine_uniform]:
+    grid_name = name + "_" + grid
+    with open(grid_name + ".xml", 'w') as grid_file:
+        grid_file.write(deck.replace(
+            eigensolver_line, eigensolver_line +
+            '\n        <Parameter name="GF-CBR Method Energy Points per kT" ' +
+            'type="double" value="' + repr(pts_per_kT) + '" />' +
+            '\n        <Parameter name="GF-CBR Method Energy Refinement ' +
+            'Tolerance" type="double" value="' + repr(tol) + '" />'))
+    curve, log = run_sweep(grid_name, 2, grid_name)
+    if (tol > 0.0) != ("energy intervals" in log):
+        print "the " + grid + " energy grid was not used"
+        result += 1
+    grid_curves.append(curve)
+result += compare(grid_curves[0], grid_curves[1], refine_rtol)
+
+sys.exit(min(result, 1))
@@ -0,0 +1,74 @@
+#! /usr/bin/env python
+
+# Run AlbanyT with "Profile Phalanx DAG" on and check the JSON profile it
+# writes at the end of the solve.
+# Usage: runtest_dag_profile.py <AlbanyT command...> <input file>
+
+import json
+import os
+import sys
+from subprocess import Popen
+
+name = "steady2d_dag_profile"
+command = sys.argv[1:]
+if os.path.exists(name + ".json"):
+    os.remove(name + ".json")
+
+with open(name + ".log", 'w') as logfile:
+    return_code = Popen(command, stdout=logfile, stderr=logfile).wait()
+if return_code != 0:
+    print(open(name + ".log").read())
+    print("AlbanyT failed with %s" % return_code)
+    sys.exit(return_code)
+
+def fail(msg):
+    print("%s: test failed" % msg)
+    sys.exit(1)
+
+if not os.path.exists(name + ".json"):
+    fail("No %s.json was written" % name)
+
+with open(name + ".json") as f:
+    profile = json.load(f)
+
+dags = profile["dags"]
+if not dags:
+    fail("The profile has no DAGs")
+
+eval_types = [dag["evaluation type"] for dag in dags]
+for expected in ["Residual", "Jacobian"]:
+    if not [t for t in eval_types if expected in t]:
+        fail("No %s DAG in the profile, got %s" % (expected, eval_types))
+
+for dag in dags:
+    label = "%s %s" % (dag["field manager"], dag["evaluation type"])
+    if dag["calls"] <= 0 or dag["seconds"] < 0:
+        fail("%s: bad call count or time" % label)
+    nodes = dag["nodes"]
+    if not nodes:
+        fail("%s: no evaluators" % label)
+    ids = set()
+    for i, node in enumerate(nodes):
+        if node["id"] != i or not node["name"]:
+            fail("%s: bad node %s" % (label, node))
+        if node["calls"] != dag["calls"] or node["seconds"] < 0:
+            fail("%s: bad cost for %s" % (label, node["name"]))
+        if not node["evaluates"]:
+            fail("%s: %s evaluates no field" % (label, node["name"]))
+        ids.add(i)
+    # Edges go from the evaluator of a field to one depending on it
+    evaluated = dict((f, n["id"]) for n in nodes for f in n["evaluates"])
+    for edge in dag["edges"]:
+        if edge["from"] not in ids or edge["to"] not in ids:
+            fail("%s: dangling edge %s" % (label, edge))
+        if evaluated.get(edge["field"]) != edge["from"] or \
+           edge["field"] not in nodes[edge["to"]]["depends on"]:
+            fail("%s: edge %s does not match the fields" % (label, edge))
+    if len(nodes) > 1 and not dag["edges"]:
+        fail("%s: no edges" % label)
+
+if "Phalanx DAG profile" not in open(name + ".log").read():
+    fail("The profile table was not printed")
+
+print("%d DAGs profiled: %s" % (len(dags), ", ".join(eval_types)))
+sys.exit(0)
@@ -0,0 +1,55 @@
+#! /usr/bin/env python
+
+# Run AlbanyT with "Jacobian Spectrum Estimate Frequency" set and check the
+# estimates it prints. The deck keeps the regression values of inputT.xml:
+# estimating the spectrum must not change the solution.
+# Usage: runtest_spectrum_estimate.py <AlbanyT command...> <input file>
+
+import re
+import sys
+from subprocess import Popen
+
+name = "steady2d_spectrum"
+frequency = 2
+tolerance = 1.0e-2
+command = sys.argv[1:]
+
+with open(name + ".log", 'w') as logfile:
+    return_code = Popen(command, stdout=logfile, stderr=logfile).wait()
+log = open(name + ".log").read()
+if return_code != 0:
+    print(log)
+    print("AlbanyT failed with %s" % return_code)
+    sys.exit(return_code)
+
+def fail(msg):
+    print("%s: test failed" % msg)
+    sys.exit(1)
+
+number = r"([-+0-9.eE]+|inf|nan)"
+estimates = re.findall(
+    r"Jacobian #(\d+) spectrum estimate: sigma_max = " + number +
+    r", sigma_min = " + number + r", condition number = " + number +
+    r" \((\d+) Lanczos iterations, (\d+) products, relative residuals " +
+    number + r" and " + number + r"\)", log)
+if not estimates:
+    fail("No spectrum estimate was printed")
+
+# One estimate for every frequency-th Jacobian, counting from the first
+for i, estimate in enumerate(estimates):
+    count = int(estimate[0])
+    sigma_max, sigma_min, condition_number = [float(v) for v in estimate[1:4]]
+    residual_max = float(estimate[6])
+    label = "Jacobian #%d" % count
+    if count != i * frequency:
+        fail("%s: expected an estimate of Jacobian #%d" % (label, i * frequency))
+    if not (0.0 < sigma_min <= sigma_max < float("inf")):
+        fail("%s: bad singular values %g and %g" % (label, sigma_max, sigma_min))
+    if abs(condition_number - sigma_max / sigma_min) > 1.0e-4 * condition_number:
+        fail("%s: the condition number is not sigma_max / sigma_min" % label)
+    if not residual_max <= tolerance:
+        fail("%s: sigma_max did not converge, relative residual %g" %
+             (label, residual_max))
+    print("%s: condition number %g" % (label, condition_number))
+
+sys.exit(0)
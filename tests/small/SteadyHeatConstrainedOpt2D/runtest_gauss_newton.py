@@ -0,0 +1,95 @@
+#! /usr/bin/env python
+
+# Runs the ROL inversion of input_conductivity_dist_param.xml and the
+# truncated Gauss-Newton inversion of the same problem in
+# input_conductivity_dist_param_gauss_newton.xml. Gauss-Newton has to reach
+# the objective that ROL reaches, and with fewer nonlinear solves:
+#
+# - ROL solves the state for each objective value and for each gradient
+#   (#fval + #grad in the last row of its iteration table),
+# - Gauss-Newton reports its own count, one per line search trial point.
+#
+# Usage: runtest_gauss_newton.py <AlbanyAnalysisT command> <Albany command>
+#
+# The commands are semicolon separated lists, as ctest passes them.
+
+import sys
+import re
+from subprocess import Popen
+
+gauss_newton = sys.argv[1].split(";")
+rol = sys.argv[2].split(";")
+
+rtol = 1.0e-3
+
+def run(command, name):
+    log_file_name = name + ".log"
+    with open(log_file_name, 'w') as logfile:
+        p = Popen(command + [name + ".xml"], stdout=logfile, stderr=logfile)
+        return_code = p.wait()
+    with open(log_file_name, 'r') as log_file:
+        log = log_file.read()
+    if return_code != 0:
+        print log
+        print "FAILED: " + name + " returned " + str(return_code)
+        sys.exit(1)
+    return log
+
+# Final objective and number of objective and gradient evaluations from the
+# iteration table that ROL prints
+def rol_results(log):
+    columns = None
+    last = None
+    for line in log.splitlines():
+        fields = line.split()
+        if "#fval" in fields and "#grad" in fields:
+            columns = fields
+        elif columns and len(fields) == len(columns) and \
+                re.match(r"^\d+$", fields[0]):
+            last = fields
+    if last is None:
+        return None, None
+    objective = float(last[columns.index("value")])
+    solves = int(last[columns.index("#fval")]) + \
+        int(last[columns.index("#grad")])
+    return objective, solves
+
+# The ROL deck, with its own output file: its own test may run at the same
+# time
+with open("input_conductivity_dist_param.xml", 'r') as deck_file:
+    deck = deck_file.read()
+with open("input_conductivity_dist_param_rol.xml", 'w') as deck_file:
+    deck_file.write(deck.replace("steady2d.exo", "steady2d_rol.exo"))
+
+log = run(rol, "input_conductivity_dist_param_rol")
+rol_objective, rol_solves = rol_results(log)
+if rol_objective is None:
+    print log
+    print "FAILED: no ROL iteration table"
+    sys.exit(1)
+print "ROL: objective " + repr(rol_objective) + ", " + str(rol_solves) + \
+    " nonlinear solves"
+
+log = run(gauss_newton, "input_conductivity_dist_param_gauss_newton")
+objective = None
+for match in re.finditer(r"Truncated Gauss-Newton iteration \d+: objective (\S+),", log):
+    objective = float(match.group(1))
+match = re.search(r"Truncated Gauss-Newton converged after (\d+) iterations: "
+                  r"(\d+) nonlinear solves, (\d+) linear solves", log)
+if objective is None or match is None:
+    print log
+    print "FAILED: the Gauss-Newton inversion did not converge"
+    sys.exit(1)
+solves = int(match.group(2))
+print "Truncated Gauss-Newton: objective " + repr(objective) + ", " + \
+    match.group(1) + " iterations, " + str(solves) + " nonlinear solves, " + \
+    match.group(3) + " linear solves"
+
+if abs(objective - rol_objective) > rtol * rol_objective:
+    print "FAILED: the objectives differ"
+    sys.exit(1)
+if solves >= rol_solves:
+    print "FAILED: Gauss-Newton needs as many nonlinear solves as ROL"
+    sys.exit(1)
+
+sys.exit(0)
@@ -0,0 +1,60 @@
+# 1. Run the variable step Backward Euler problem without interruption, then
+#    stop it after 10 steps with checkpoints and restart from the last one
+
+file(REMOVE_RECURSE checkpoint_tempus_be)
+
+file(READ tempus_be_no_piro_restart.xml DECK)
+
+string(REPLACE "<Parameter name=\"Write Interval\" type=\"int\" value=\"0\"/>"
+       "<Parameter name=\"Write Interval\" type=\"int\" value=\"4\"/>"
+       CHECKPOINT_DECK "${DECK}")
+string(REPLACE "<Parameter name=\"Final Time Index\"   type=\"int\"    value=\"10000\"/>"
+       "<Parameter name=\"Final Time Index\"   type=\"int\"    value=\"10\"/>"
+       CHECKPOINT_DECK "${CHECKPOINT_DECK}")
+string(REPLACE "tran2d_tempus_be_full.exo" "tran2d_tempus_be_checkpoint.exo"
+       CHECKPOINT_DECK "${CHECKPOINT_DECK}")
+file(WRITE tempus_be_no_piro_checkpoint.xml "${CHECKPOINT_DECK}")
+
+string(REPLACE "<Parameter name=\"Restart\" type=\"bool\" value=\"false\"/>"
+       "<Parameter name=\"Restart\" type=\"bool\" value=\"true\"/>"
+       RESTART_DECK "${DECK}")
+string(REPLACE "tran2d_tempus_be_full.exo" "tran2d_tempus_be_restart.exo"
+       RESTART_DECK "${RESTART_DECK}")
+file(WRITE tempus_be_no_piro_restarted.xml "${RESTART_DECK}")
+
+foreach(INPUT tempus_be_no_piro_restart
+              tempus_be_no_piro_checkpoint
+              tempus_be_no_piro_restarted)
+  message("Running the command:")
+  message("${TEST_PROG} ${INPUT}.xml")
+
+  EXECUTE_PROCESS(COMMAND ${TEST_PROG} ${INPUT}.xml
+                  RESULT_VARIABLE HAD_ERROR)
+
+  if(HAD_ERROR)
+    message(FATAL_ERROR "AlbanyTempus didn't run with ${INPUT}.xml: test failed")
+  endif()
+endforeach()
+
+if (NOT SEACAS_EXODIFF)
+  message(FATAL_ERROR "Cannot find exodiff")
+endif()
+
+# 2. Every output of the restart must be identical to the output of the
+#    uninterrupted run at the same time. Only the step sizes and failure
+#    counts restored with the solution history give the same steps.
+
+SET(EXODIFF_TEST ${SEACAS_EXODIFF} -TM -f restart.exodiff
+                 tran2d_tempus_be_full.exo tran2d_tempus_be_restart.exo)
+
+message("Running the command:")
+message("${EXODIFF_TEST}")
+
+EXECUTE_PROCESS(
+    COMMAND ${EXODIFF_TEST}
+    OUTPUT_FILE exodiff_tran2d_tempus_be_restart.out
+    RESULT_VARIABLE HAD_ERROR)
+
+if(HAD_ERROR)
+  message(FATAL_ERROR "tran2d_tempus_be_restart.exo differs from tran2d_tempus_be_full.exo: test failed")
+endif()